@@ -19,6 +19,8 @@ To compile TestMothur you need to uncomment
  
  //MothurOut* MothurOut::_uniqueInstance; in mothurout.cpp
  
+ //Profiler* Profiler::_uniqueInstance; in profiler.cpp
+ 
  //ReferenceDB* ReferenceDB::myInstance; in referencedb.cpp
  
  */
@@ -61,5 +61,108 @@ TEST_CASE("Testing FastqRead Class") {
         CHECK(read.getScores()[0] == testFastq.reads[0].getScores()[0]);
     }
     
+    SECTION("Testing convertQual") {
+        INFO("Using !5I, @TX and ;@h") // Only appears on a FAIL
+        
+        testFastq.setFormat("illumina1.8+");
+        vector<int> scores = testFastq.convertQual("!5I");
+        CHECK(scores[0] == 0); CHECK(scores[1] == 20); CHECK(scores[2] == 40);
+        CHECK(testFastq.convertQual(scores) == "!5I");
+        
+        testFastq.setFormat("illumina");
+        scores = testFastq.convertQual("@TX");
+        CHECK(scores[0] == 0); CHECK(scores[1] == 20); CHECK(scores[2] == 24);
+        CHECK(testFastq.convertQual(scores) == "@TX");
+        
+        testFastq.setFormat("solexa");
+        scores = testFastq.convertQual(";@h");
+        CHECK(scores[0] == 1); CHECK(scores[1] == 3); CHECK(scores[2] == 40);
+    }
+    
+    SECTION("Testing readLine") {
+        INFO("Using CRLF line ends, blank lines and no newline at the end of the file") // Only appears on a FAIL
+        
+        string filename = "testreadline.fastq.temp";
+        ofstream out; testFastq.m->openOutputFile(filename, out);
+        out << "@read1 comment\r\nACGT\r\n+\r\nIIII\r\n\r\n\n@read2\nTTGA\n+read2\n!5I!";
+        out.close();
+        
+        ifstream in; testFastq.m->openInputFile(filename, in);
+        string line = "";
+        testFastq.readLine(in, line); CHECK(line == "@read1 comment");
+        testFastq.readLine(in, line); CHECK(line == "ACGT");
+        testFastq.readLine(in, line); CHECK(line == "+");
+        testFastq.readLine(in, line); CHECK(line == "IIII");
+        testFastq.readLine(in, line); CHECK(line == "@read2"); //blank lines are skipped
+        testFastq.readLine(in, line); CHECK(line == "TTGA");
+        testFastq.readLine(in, line); CHECK(line == "+read2");
+        CHECK(!in.eof());
+        testFastq.readLine(in, line); CHECK(line == "!5I!"); //last line has no newline
+        CHECK(in.eof());
+        testFastq.readLine(in, line); CHECK(line == "");
+        in.close();
+        
+        //the same file read into one reused FastqRead
+        testFastq.m->openInputFile(filename, in);
+        FastqRead read; bool ignore;
+        read.read(in, ignore, "illumina1.8+");
+        CHECK(!ignore); CHECK(read.getName() == "read1"); CHECK(read.getSeq() == "ACGT"); CHECK(read.getScores()[0] == 40);
+        read.read(in, ignore, "illumina1.8+");
+        CHECK(!ignore); CHECK(read.getName() == "read2"); CHECK(read.getSeq() == "TTGA");
+        vector<int> scores = read.getScores();
+        REQUIRE(scores.size() == 4);
+        CHECK(scores[0] == 0); CHECK(scores[1] == 20); CHECK(scores[2] == 40); CHECK(scores[3] == 0);
+        CHECK(in.eof());
+        in.close();
+        testFastq.m->mothurRemove(filename);
+    }
+    
+    SECTION("Testing FastqBuffer") {
+        INFO("Using CRLF line ends, blank lines, no newline at the end of the file and records across block boundaries") // Only appears on a FAIL
+        
+        string filename = "testfastqbuffer.fastq.temp";
+        ofstream out; testFastq.m->openOutputFile(filename, out);
+        out << "@read1 comment\r\nACGT\r\n+\r\nIIII\r\n\r\n\n@read2\nTTGA\n+read2\n!5I!";
+        out.close();
+        
+        ifstream in; testFastq.m->openInputFile(filename, in);
+        FastqBuffer buffer(in);
+        FastqRead read; bool ignore;
+        read.read(buffer, ignore, "illumina1.8+");
+        CHECK(!ignore); CHECK(read.getName() == "read1"); CHECK(read.getSeq() == "ACGT"); CHECK(read.getScores()[0] == 40);
+        CHECK(!buffer.eof()); CHECK(buffer.tell() == 34); //start of read2
+        read.read(buffer, ignore, "illumina1.8+");
+        CHECK(!ignore); CHECK(read.getName() == "read2"); CHECK(read.getSeq() == "TTGA");
+        vector<int> scores = read.getScores();
+        REQUIRE(scores.size() == 4);
+        CHECK(scores[0] == 0); CHECK(scores[1] == 20); CHECK(scores[2] == 40); CHECK(scores[3] == 0);
+        CHECK(buffer.eof());
+        in.close();
+        
+        //more than one block of records, including one longer than a block
+        testFastq.m->openOutputFile(filename, out);
+        string longSeq(1500000, 'A'); string longQual(1500000, 'I');
+        int numReads = 20000;
+        for (int i = 0; i < numReads; i++) {
+            out << "@r" << i << endl << "ACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTAC" << endl << "+" << endl << "IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII" << endl;
+            if (i == 10000) { out << "@long" << endl << longSeq << endl << "+" << endl << longQual << endl; }
+        }
+        out.close();
+        
+        testFastq.m->openInputFile(filename, in);
+        FastqBuffer blocks(in);
+        int count = 0; bool allGood = true; bool foundLong = false;
+        while (!blocks.eof()) {
+            read.read(blocks, ignore, "illumina1.8+");
+            if (ignore) { allGood = false; }
+            if (read.getName() == "long") { foundLong = (read.getSeq() == longSeq); }
+            else if (read.getName() != ("r" + toString(count))) { allGood = false; }
+            else { count++; }
+        }
+        CHECK(allGood); CHECK(foundLong); CHECK(count == numReads);
+        in.close();
+        testFastq.m->mothurRemove(filename);
+    }
+    
 }
 /**************************************************************************************************/
@@ -18,6 +18,7 @@ public:
     ~TestFastqRead();
     
     using FastqRead::convertQual;
+    using FastqRead::readLine;
 
     MothurOut* m;
     vector<FastqRead> reads;
@@ -0,0 +1,75 @@
+//
+//  testdecalc.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "catch.hpp"
+#include "testdecalc.h"
+
+/**************************************************************************************************/
+TestDeCalculator::TestDeCalculator() {  //setup
+    m = MothurOut::getInstance();
+    
+    templateSeqs.push_back(new Sequence("seq1", "...TTTCCTCATGCA-ATTCAAAACCATGTCCGT--AATGTAGGCGAAAT.."));
+    templateSeqs.push_back(new Sequence("seq2", "...AGTAAACCATTT-TACGGAGGATACCAAATT--CCTCCTTATTCAGG.."));
+    templateSeqs.push_back(new Sequence("seq3", "...ACCTAACCTGAG-GTAAACCAGGTCTCTCCG--CCCCCTTATAAAAG.."));
+    templateSeqs.push_back(new Sequence("seq4", "...CTGTTGCACCTA-GCCAAGTTCAACGGCAGC--TGCAATGGAAATAG.."));
+    templateSeqs.push_back(new Sequence("seq5", "...GCAATGACGGAT-ATATATTAAAAAGTGTTT--TAAGATACATTGAG.."));
+    
+    query.setName("chimera");
+    query.setAligned("...AGTAAACCATTT-TACGGAGGATACGGCAGC--TGCAATGGAAATAG..");
+}
+/**************************************************************************************************/
+TestDeCalculator::~TestDeCalculator() {
+    for (int i = 0; i < templateSeqs.size(); i++) { delete templateSeqs[i]; }
+}
+/**************************************************************************************************/
+
+TEST_CASE("Testing DeCalculator Class") {
+    TestDeCalculator testDeCalc;
+    
+    SECTION("Testing findClosest with an indexed template") {
+        INFO("Using the chimera of seq2 and seq4") // Only appears on a FAIL
+        
+        testDeCalc.indexTemplate(testDeCalc.templateSeqs);
+        vector<Sequence> closest = testDeCalc.findClosest(testDeCalc.query, testDeCalc.templateSeqs, testDeCalc.templateSeqs, 1, 50);
+        
+        CHECK(closest.size() == 2);
+        if (closest.size() == 2) {
+            CHECK(closest[0].getName() == "seq2");
+            CHECK(closest[1].getName() == "seq4");
+        }
+    }
+    
+    SECTION("Testing findClosest without an index matches the indexed search") {
+        INFO("Using the chimera of seq2 and seq4") // Only appears on a FAIL
+        
+        DeCalculator notIndexed;
+        testDeCalc.indexTemplate(testDeCalc.templateSeqs);
+        vector<Sequence> closest = notIndexed.findClosest(testDeCalc.query, testDeCalc.templateSeqs, testDeCalc.templateSeqs, 3, 0);
+        vector<Sequence> indexedClosest = testDeCalc.findClosest(testDeCalc.query, testDeCalc.templateSeqs, testDeCalc.templateSeqs, 3, 0);
+        
+        CHECK(closest.size() == indexedClosest.size());
+        if (closest.size() == indexedClosest.size()) {
+            for (int i = 0; i < closest.size(); i++) { CHECK(closest[i].getName() == indexedClosest[i].getName()); }
+        }
+    }
+    
+    SECTION("Testing findClosest with a subset of the indexed template") {
+        INFO("Using seq1, seq2 and seq4, as template=self would") // Only appears on a FAIL
+        
+        testDeCalc.indexTemplate(testDeCalc.templateSeqs);
+        vector<Sequence*> subset;
+        subset.push_back(testDeCalc.templateSeqs[0]); subset.push_back(testDeCalc.templateSeqs[1]); subset.push_back(testDeCalc.templateSeqs[3]);
+        vector<Sequence> closest = testDeCalc.findClosest(testDeCalc.query, subset, subset, 1, 50);
+        
+        CHECK(closest.size() == 2);
+        if (closest.size() == 2) {
+            CHECK(closest[0].getName() == "seq2");
+            CHECK(closest[1].getName() == "seq4");
+        }
+    }
+}
+/**************************************************************************************************/
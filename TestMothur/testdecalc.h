@@ -0,0 +1,25 @@
+//
+//  testdecalc.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#ifndef __Mothur__testdecalc__
+#define __Mothur__testdecalc__
+
+#include "decalc.h"
+
+class TestDeCalculator : public DeCalculator {
+    
+public:
+    TestDeCalculator();
+    ~TestDeCalculator();
+    
+    MothurOut* m;
+    vector<Sequence*> templateSeqs;
+    Sequence query; //left third from seq2, right third from seq4
+    
+};
+
+#endif /* defined(__Mothur__testdecalc__) */
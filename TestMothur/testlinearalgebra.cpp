@@ -0,0 +1,66 @@
+//
+//  testlinearalgebra.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "catch.hpp"
+#include "testlinearalgebra.h"
+
+/**************************************************************************************************/
+TestLinearAlgebra::TestLinearAlgebra() {  //setup
+    m = MothurOut::getInstance();
+    
+    //3 features, 4 samples from each of 3 classes
+    double f0[] = { 2.1, 3.4, 1.8, 2.9, 5.6, 6.1, 4.9, 5.2, 3.3, 4.0, 3.8, 2.7 };
+    double f1[] = { 10.2, 8.7, 9.9, 11.4, 7.1, 6.5, 8.2, 7.7, 12.5, 13.1, 11.8, 12.0 };
+    double f2[] = { 0.5, 1.1, 0.7, 0.9, 1.3, 0.8, 1.6, 1.0, 2.2, 2.6, 1.9, 2.4 };
+    ldaValues.push_back(vector<double>(f0, f0+12));
+    ldaValues.push_back(vector<double>(f1, f1+12));
+    ldaValues.push_back(vector<double>(f2, f2+12));
+    
+    for (int i = 0; i < 4; i++) { ldaGroups.push_back("early"); }
+    for (int i = 0; i < 4; i++) { ldaGroups.push_back("late"); }
+    for (int i = 0; i < 4; i++) { ldaGroups.push_back("mid"); }
+    
+    //lda(x, grouping) from R's MASS package with x = t(ldaValues)
+    double ld0[] = { 0.5045635711, 1.0904431829 };
+    double ld1[] = { -0.8603497917, -0.0688811619 };
+    double ld2[] = { -1.1184120102, 2.3619889913 };
+    ldaScaling.push_back(vector<double>(ld0, ld0+2));
+    ldaScaling.push_back(vector<double>(ld1, ld1+2));
+    ldaScaling.push_back(vector<double>(ld2, ld2+2));
+}
+/**************************************************************************************************/
+TestLinearAlgebra::~TestLinearAlgebra() {}
+/**************************************************************************************************/
+
+TEST_CASE("Testing LinearAlgebra Class") {
+    TestLinearAlgebra testLinear;
+    
+    SECTION("Testing lda") {
+        INFO("Using 3 features from 12 samples in classes early, late and mid") // Only appears on a FAIL
+        
+        vector< vector<double> > means; bool ignore = false;
+        vector< vector<double> > scaling = testLinear.lda(testLinear.ldaValues, testLinear.ldaGroups, means, ignore);
+        
+        CHECK(!ignore);
+        REQUIRE(scaling.size() == 3);
+        REQUIRE(scaling[0].size() == 2);
+        
+        CHECK(means[0][0] == Approx(2.55)); CHECK(means[1][1] == Approx(7.375)); CHECK(means[2][2] == Approx(2.275));
+        
+        //svd leaves the sign of each discriminant free, so compare a column at a time up to sign
+        for (int j = 0; j < 2; j++) {
+            double sign = ((scaling[0][j] < 0) == (testLinear.ldaScaling[0][j] < 0)) ? 1.0 : -1.0;
+            for (int i = 0; i < 3; i++) {
+                double coef = sign * scaling[i][j];
+                CAPTURE(i);
+                CAPTURE(j);
+                CHECK(coef == Approx(testLinear.ldaScaling[i][j]).epsilon(1e-6));
+            }
+        }
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,26 @@
+//
+//  testlinearalgebra.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#ifndef __Mothur__testlinearalgebra__
+#define __Mothur__testlinearalgebra__
+
+#include "linearalgebra.h"
+
+class TestLinearAlgebra : public LinearAlgebra {
+    
+public:
+    TestLinearAlgebra();
+    ~TestLinearAlgebra();
+    
+    MothurOut* m;
+    vector< vector<double> > ldaValues; //[feature][sample]
+    vector<string> ldaGroups;
+    vector< vector<double> > ldaScaling; //MASS::lda coefficients of linear discriminants, [feature][LD]
+    
+};
+
+#endif /* defined(__Mothur__testlinearalgebra__) */
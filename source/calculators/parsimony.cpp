@@ -55,6 +55,9 @@ EstOutput Parsimony::getValues(Tree* t, int p, string o) {
 			}
 		}
         
+        //more processes than combos would only fork processes with nothing to score
+        if (processors > namesOfGroupCombos.size()) { processors = namesOfGroupCombos.size(); }
+        
         lines.clear();
         int remainingPairs = namesOfGroupCombos.size();
         int startIndex = 0;
@@ -257,56 +260,71 @@ EstOutput Parsimony::createProcesses(Tree* t, vector< vector<string> > namesOfGr
 	}
 }
 /**************************************************************************************************/
+//Fitch parsimony on the group bitsets. A node's groups are the groups its children share, or all their groups
+//if they share none, in which case there has been a change. Nodes with a child that has none of the combo's
+//groups are not scored. The nodes are numbered so children come before their parents.
 EstOutput Parsimony::driver(Tree* t, vector< vector<string> > namesOfGroupCombos, int start, int num, CountTable* ct) { 
 	try {
 		
 		EstOutput results; results.resize(num);
 		
-		Tree* copyTree = new Tree(ct);
+		numWords = (t->getNumGroups() + 63) / 64;
+		if (numWords == 0) { numWords = 1; }
+		
+		int numLeaves = t->getNumLeaves();
+		int numNodes = t->getNumNodes();
+		
+		//leaves start with their pGroups
+		leafStates.assign(numLeaves * numWords, 0);
+		for (int i = 0; i < numLeaves; i++) {
+			for (int j = 0; j < t->tree[i].pGroups.size(); j++) {
+				int group = t->tree[i].pGroups[j].first;
+				leafStates[i * numWords + (group / 64)] |= (1ULL << (group % 64));
+			}
+		}
+		
+		lChildren.resize(numNodes); rChildren.resize(numNodes);
+		for (int i = numLeaves; i < numNodes; i++) { lChildren[i] = t->tree[i].getLChild(); rChildren[i] = t->tree[i].getRChild(); }
+		
+		states.resize(numNodes * numWords);
+		mask.resize(numWords);
 		int count = 0;
 		
 		for (int h = start; h < (start+num); h++) {
 					
-			if (m->control_pressed) { delete copyTree; return results; }
+			if (m->control_pressed) { return results; }
 	
 			int score = 0;
 			
 			//groups in this combo
-			vector<string> groups = namesOfGroupCombos[h];
-			
-			//copy users tree so that you can redo pgroups 
-			copyTree->getCopy(t);
+			fill(mask.begin(), mask.end(), 0);
+			for (int j = 0; j < namesOfGroupCombos[h].size(); j++) {
+				int group = t->getGroupIndex(namesOfGroupCombos[h][j]);
+				if (group != -1) { mask[group / 64] |= (1ULL << (group % 64)); }
+			}
 			
-			//create pgroups that reflect the groups the user want to use
-			for(int i=copyTree->getNumLeaves();i<copyTree->getNumNodes();i++){
-				copyTree->tree[i].pGroups = (copyTree->mergeUserGroups(i, groups));
+			for (int i = 0; i < numLeaves; i++) {
+				for (int k = 0; k < numWords; k++) { states[i * numWords + k] = leafStates[i * numWords + k] & mask[k]; }
 			}
 			
-			for(int i=copyTree->getNumLeaves();i<copyTree->getNumNodes();i++){
+			for (int i = numLeaves; i < numNodes; i++) {
+				unsigned long long* left = &states[lChildren[i] * numWords];
+				unsigned long long* right = &states[rChildren[i] * numWords];
+				unsigned long long* node = &states[i * numWords];
 				
-				if (m->control_pressed) { return data; }
+				unsigned long long inLeft = 0; unsigned long long inRight = 0; unsigned long long shared = 0;
+				for (int k = 0; k < numWords; k++) { inLeft |= left[k]; inRight |= right[k]; shared |= (left[k] & right[k]); }
 				
-				int lc = copyTree->tree[i].getLChild();
-				int rc = copyTree->tree[i].getRChild();
-				
-				int iSize = copyTree->tree[i].pGroups.size();
-				int rcSize = copyTree->tree[rc].pGroups.size();
-				int lcSize = copyTree->tree[lc].pGroups.size();
-				
-				//if isize are 0 then that branch is to be ignored
-				if (iSize == 0) { }
-				else if ((rcSize == 0) || (lcSize == 0)) { }
-				//if you have more groups than either of your kids then theres been a change.
-				else if(iSize > rcSize || iSize > lcSize){
-					score++;
+				if (shared != 0) { for (int k = 0; k < numWords; k++) { node[k] = left[k] & right[k]; } }
+				else {
+					for (int k = 0; k < numWords; k++) { node[k] = left[k] | right[k]; }
+					if ((inLeft != 0) && (inRight != 0)) { score++; }
 				}
 			} 
 			
 			results[count] = score;
 			count++;
 		}
-					
-		delete copyTree;
 			
 		return results; 
 	}
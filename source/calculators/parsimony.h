@@ -23,6 +23,9 @@ class Parsimony : public TreeCalculator  {
 		~Parsimony() {};
 		EstOutput getValues(Tree*, int, string);
 		
+		//scores the combos from start to start+num, public so the windows threads can each use their own Parsimony
+		EstOutput driver(Tree*, vector< vector<string> >, int, int, CountTable*);
+		
 	private:
 		struct linePair {
 			int start;
@@ -35,7 +38,12 @@ class Parsimony : public TreeCalculator  {
 		int processors;
 		string outputDir;
 	
-		EstOutput driver(Tree*, vector< vector<string> >, int, int, CountTable*); 
+		//Each node's groups are kept as a bitset, one bit per group in the count table and numWords words per node.
+		//The buffers are kept between calls, so scoring many random trees doesn't reallocate them.
+		int numWords;
+		vector<unsigned long long> leafStates, states, mask;
+		vector<int> lChildren, rChildren;
+	
 		EstOutput createProcesses(Tree*, vector< vector<string> >, CountTable*);
 };
 /***********************************************************************/
@@ -66,54 +74,8 @@ static DWORD WINAPI MyParsimonyThreadFunction(LPVOID lpParam){
 	parsData* pDataArray;
 	pDataArray = (parsData*)lpParam;
 	try {
-        
-        pDataArray->results.resize(pDataArray->num);
-		
-		Tree* copyTree = new Tree(pDataArray->ct);
-		int count = 0;
-		
-		for (int h = pDataArray->start; h < (pDataArray->start+pDataArray->num); h++) {
-            
-			if (pDataArray->m->control_pressed) { delete copyTree; return 0; }
-            
-			int score = 0;
-			
-			//groups in this combo
-			vector<string> groups = pDataArray->namesOfGroupCombos[h];
-			
-			//copy users tree so that you can redo pgroups
-			copyTree->getCopy(pDataArray->t);
-			
-			//create pgroups that reflect the groups the user want to use
-			for(int i=copyTree->getNumLeaves();i<copyTree->getNumNodes();i++){
-				copyTree->tree[i].pGroups = (copyTree->mergeUserGroups(i, groups));
-			}
-			
-			for(int i=copyTree->getNumLeaves();i<copyTree->getNumNodes();i++){
-				
-				if (pDataArray->m->control_pressed) { return 0; }
-				
-				int lc = copyTree->tree[i].getLChild();
-				int rc = copyTree->tree[i].getRChild();
-				
-				int iSize = copyTree->tree[i].pGroups.size();
-				int rcSize = copyTree->tree[rc].pGroups.size();
-				int lcSize = copyTree->tree[lc].pGroups.size();
-				
-				//if isize are 0 then that branch is to be ignored
-				if (iSize == 0) { }
-				else if ((rcSize == 0) || (lcSize == 0)) { }
-				//if you have more groups than either of your kids then theres been a change.
-				else if(iSize > rcSize || iSize > lcSize){
-					score++;
-				}
-			}
-			
-			pDataArray->results[count] = score;
-			count++;
-		}
-        
-		delete copyTree;
+		Parsimony pars;
+		pDataArray->results = pars.driver(pDataArray->t, pDataArray->namesOfGroupCombos, pDataArray->start, pDataArray->num, pDataArray->ct);
         
         return 0;
         
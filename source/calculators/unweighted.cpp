@@ -319,6 +319,9 @@ EstOutput Unweighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombo
 				//if including the root this clears rootForGrouping[namesOfGroupCombos[h]]
 				getRoot(t, nodeBelonging, namesOfGroupCombos[h]);
 				//cout << "here" << endl;	
+				vector<int> groupIndexes;
+				for (int j = 0; j < namesOfGroupCombos[h].size(); j++) { groupIndexes.push_back(t->getGroupIndex(namesOfGroupCombos[h][j])); }
+				
 				for(int i=0;i<t->getNumNodes();i++){
 					
 					if (m->control_pressed) {  return data; }
@@ -329,8 +332,7 @@ EstOutput Unweighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombo
 					
 					int pcountSize = 0;
 					for (int j = 0; j < namesOfGroupCombos[h].size(); j++) {
-						map<string, int>::iterator itGroup = t->tree[i].pcount.find(namesOfGroupCombos[h][j]);
-						if (itGroup != t->tree[i].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } } 
+						if (t->tree[i].getPcount(groupIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } } 
 					}
 					
 					
@@ -680,6 +682,9 @@ EstOutput Unweighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombo
 				//if including the root this clears rootForGrouping[namesOfGroupCombos[h]]
 				getRoot(copyTree, nodeBelonging, namesOfGroupCombos[h]);
 				
+				vector<int> groupIndexes;
+				for (int j = 0; j < namesOfGroupCombos[h].size(); j++) { groupIndexes.push_back(copyTree->getGroupIndex(namesOfGroupCombos[h][j])); }
+				
 				for(int i=0;i<copyTree->getNumNodes();i++){
 					
 					if (m->control_pressed) {  return data; }
@@ -690,8 +695,7 @@ EstOutput Unweighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombo
 					
 					int pcountSize = 0;
 					for (int j = 0; j < namesOfGroupCombos[h].size(); j++) {
-						map<string, int>::iterator itGroup = copyTree->tree[i].pcount.find(namesOfGroupCombos[h][j]);
-						if (itGroup != copyTree->tree[i].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } } 
+						if (copyTree->tree[i].getPcount(groupIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } } 
 					}
 					
 					//unique calc
@@ -740,6 +744,10 @@ int Unweighted::getRoot(Tree* t, int v, vector<string> grouping) {
 			//my parent is a potential root
 			rootForGrouping[grouping].insert(index);
 			
+			//the nodes keep their groups by index
+			vector<int> groupingIndexes;
+			for (int j = 0; j < grouping.size(); j++) { groupingIndexes.push_back(t->getGroupIndex(grouping[j])); }
+			
 			//while you aren't at root
 			while(t->tree[index].getParent() != -1){
 				//cout << index << endl;	
@@ -755,11 +763,9 @@ int Unweighted::getRoot(Tree* t, int v, vector<string> grouping) {
 				int sib = lc;
 				if (lc == index) { sib = rc; }
 				
-				map<string, int>::iterator itGroup;
 				int pcountSize = 0;
 				for (int j = 0; j < grouping.size(); j++) {
-					map<string, int>::iterator itGroup = t->tree[sib].pcount.find(grouping[j]);
-					if (itGroup != t->tree[sib].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } } 
+					if (t->tree[sib].getPcount(groupingIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } } 
 				}
 				
 				//if yes, I am not the root
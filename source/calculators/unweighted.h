@@ -115,6 +115,10 @@ static DWORD WINAPI MyUnWeightedThreadFunction(LPVOID lpParam){
                     //my parent is a potential root
                     rootForGrouping[grouping].insert(index);
                     
+                    //the nodes keep their groups by index
+                    vector<int> groupingIndexes;
+                    for (int j = 0; j < grouping.size(); j++) { groupingIndexes.push_back(pDataArray->t->getGroupIndex(grouping[j])); }
+                    
                     //while you aren't at root
                     while(pDataArray->t->tree[index].getParent() != -1){
                         //cout << index << endl;
@@ -130,11 +134,9 @@ static DWORD WINAPI MyUnWeightedThreadFunction(LPVOID lpParam){
                         int sib = lc;
                         if (lc == index) { sib = rc; }
                         
-                        map<string, int>::iterator itGroup;
                         int pcountSize = 0;
                         for (int j = 0; j < grouping.size(); j++) {
-                            map<string, int>::iterator itGroup = pDataArray->t->tree[sib].pcount.find(grouping[j]);
-                            if (itGroup != pDataArray->t->tree[sib].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } }
+                            if (pDataArray->t->tree[sib].getPcount(groupingIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } }
                         }
                         
                         //if yes, I am not the root
@@ -157,6 +159,9 @@ static DWORD WINAPI MyUnWeightedThreadFunction(LPVOID lpParam){
                 }
                 /////////////////////////////////////////////////////////////////////////////
                 
+				vector<int> groupIndexes;
+				for (int j = 0; j < pDataArray->namesOfGroupCombos[h].size(); j++) { groupIndexes.push_back(pDataArray->t->getGroupIndex(pDataArray->namesOfGroupCombos[h][j])); }
+				
 				for(int i=0;i<pDataArray->t->getNumNodes();i++){
 					
 					if (pDataArray->m->control_pressed) {  return 0; }
@@ -167,8 +172,7 @@ static DWORD WINAPI MyUnWeightedThreadFunction(LPVOID lpParam){
 					
 					int pcountSize = 0;
 					for (int j = 0; j < pDataArray->namesOfGroupCombos[h].size(); j++) {
-						map<string, int>::iterator itGroup = pDataArray->t->tree[i].pcount.find(pDataArray->namesOfGroupCombos[h][j]);
-						if (itGroup != pDataArray->t->tree[i].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } }
+						if (pDataArray->t->tree[i].getPcount(groupIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } }
 					}
 					
 					
@@ -257,6 +261,10 @@ static DWORD WINAPI MyUnWeightedRandomThreadFunction(LPVOID lpParam){
                     //my parent is a potential root
                     rootForGrouping[grouping].insert(index);
                     
+                    //the nodes keep their groups by index
+                    vector<int> groupingIndexes;
+                    for (int j = 0; j < grouping.size(); j++) { groupingIndexes.push_back(copyTree->getGroupIndex(grouping[j])); }
+                    
                     //while you aren't at root
                     while(copyTree->tree[index].getParent() != -1){
                         //cout << index << endl;
@@ -272,11 +280,9 @@ static DWORD WINAPI MyUnWeightedRandomThreadFunction(LPVOID lpParam){
                         int sib = lc;
                         if (lc == index) { sib = rc; }
                         
-                        map<string, int>::iterator itGroup;
                         int pcountSize = 0;
                         for (int j = 0; j < grouping.size(); j++) {
-                            map<string, int>::iterator itGroup = copyTree->tree[sib].pcount.find(grouping[j]);
-                            if (itGroup != copyTree->tree[sib].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } }
+                            if (copyTree->tree[sib].getPcount(groupingIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } }
                         }
                         
                         //if yes, I am not the root
@@ -298,6 +304,9 @@ static DWORD WINAPI MyUnWeightedRandomThreadFunction(LPVOID lpParam){
                     }
                 }
                 /////////////////////////////////////////////////////////////////////////////
+				vector<int> groupIndexes;
+				for (int j = 0; j < pDataArray->namesOfGroupCombos[h].size(); j++) { groupIndexes.push_back(copyTree->getGroupIndex(pDataArray->namesOfGroupCombos[h][j])); }
+				
 				for(int i=0;i<copyTree->getNumNodes();i++){
 					
 					if (pDataArray->m->control_pressed) {  return 0; }
@@ -307,8 +316,7 @@ static DWORD WINAPI MyUnWeightedRandomThreadFunction(LPVOID lpParam){
 					//pcountSize = 1, unique to one group
                     int pcountSize = 0;
 					for (int j = 0; j < pDataArray->namesOfGroupCombos[h].size(); j++) {
-						map<string, int>::iterator itGroup = copyTree->tree[i].pcount.find(pDataArray->namesOfGroupCombos[h][j]);
-						if (itGroup != copyTree->tree[i].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } }
+						if (copyTree->tree[i].getPcount(groupIndexes[j]) != 0) { pcountSize++; if (pcountSize > 1) { break; } }
 					}
 					
 					//unique calc
@@ -268,8 +268,7 @@ EstOutput Weighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombos,
 			
 			//adding the wieghted sums from group i
 			for (int j = 0; j < t->groupNodeInfo[groupA].size(); j++) { //the leaf nodes that have seqs from group i
-				map<string, int>::iterator it = t->tree[t->groupNodeInfo[groupA][j]].pcount.find(groupA);
-				int numSeqsInGroupI = it->second;
+				int numSeqsInGroupI = t->getPcount(t->groupNodeInfo[groupA][j], groupA);
 				
 				double sum = getLengthToRoot(t, t->groupNodeInfo[groupA][j], groupA, groupB);
 				double weightedSum = ((numSeqsInGroupI * sum) / (double)ct->getGroupCount(groupA));
@@ -279,8 +278,7 @@ EstOutput Weighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombos,
 			
 			//adding the wieghted sums from group l
 			for (int j = 0; j < t->groupNodeInfo[groupB].size(); j++) { //the leaf nodes that have seqs from group l
-				map<string, int>::iterator it = t->tree[t->groupNodeInfo[groupB][j]].pcount.find(groupB);
-				int numSeqsInGroupL = it->second;
+				int numSeqsInGroupL = t->getPcount(t->groupNodeInfo[groupB][j], groupB);
 				
 				double sum = getLengthToRoot(t, t->groupNodeInfo[groupB][j], groupA, groupB);
 				double weightedSum = ((numSeqsInGroupL * sum) / (double)ct->getGroupCount(groupB));
@@ -297,6 +295,8 @@ EstOutput Weighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombos,
 						
 			string groupA = namesOfGroupCombos[h][0]; 
 			string groupB = namesOfGroupCombos[h][1];
+			int indexA = t->getGroupIndex(groupA);
+			int indexB = t->getGroupIndex(groupB);
 			
 			//calculate u for the group comb 
 			for(int i=0;i<t->getNumNodes();i++){
@@ -306,19 +306,19 @@ EstOutput Weighted::driver(Tree* t, vector< vector<string> > namesOfGroupCombos,
 				double u;
 				//int pcountSize = 0;
 				//does this node have descendants from groupA
-				it = t->tree[i].pcount.find(groupA);
+				int numA = t->tree[i].getPcount(indexA);
 				//if it does u = # of its descendants with a certain group / total number in tree with a certain group
-				if (it != t->tree[i].pcount.end()) {
-					u = (double) t->tree[i].pcount[groupA] / (double) ct->getGroupCount(groupA);
+				if (numA != 0) {
+					u = (double) numA / (double) ct->getGroupCount(groupA);
 				}else { u = 0.00; }
 				
 				
 				//does this node have descendants from group l
-				it = t->tree[i].pcount.find(groupB);
+				int numB = t->tree[i].getPcount(indexB);
 				
 				//if it does subtract their percentage from u
-				if (it != t->tree[i].pcount.end()) {
-					u -= (double) t->tree[i].pcount[groupB] / (double) ct->getGroupCount(groupB);
+				if (numB != 0) {
+					u -= (double) numB / (double) ct->getGroupCount(groupB);
 				}
 				
 				if (includeRoot) {
@@ -376,8 +376,7 @@ EstOutput Weighted::getValues(Tree* t, string groupA, string groupB) {
 		
 		//adding the wieghted sums from group i
 		for (int j = 0; j < t->groupNodeInfo[groups[0]].size(); j++) { //the leaf nodes that have seqs from group i
-			map<string, int>::iterator it = t->tree[t->groupNodeInfo[groups[0]][j]].pcount.find(groups[0]);
-			int numSeqsInGroupI = it->second;
+			int numSeqsInGroupI = t->getPcount(t->groupNodeInfo[groups[0]][j], groups[0]);
 			
 			double sum = getLengthToRoot(t, t->groupNodeInfo[groups[0]][j], groups[0], groups[1]);
 			double weightedSum = ((numSeqsInGroupI * sum) / (double)ct->getGroupCount(groups[0]));
@@ -387,8 +386,7 @@ EstOutput Weighted::getValues(Tree* t, string groupA, string groupB) {
 		
 		//adding the wieghted sums from group l
 		for (int j = 0; j < t->groupNodeInfo[groups[1]].size(); j++) { //the leaf nodes that have seqs from group l
-			map<string, int>::iterator it = t->tree[t->groupNodeInfo[groups[1]][j]].pcount.find(groups[1]);
-			int numSeqsInGroupL = it->second;
+			int numSeqsInGroupL = t->getPcount(t->groupNodeInfo[groups[1]][j], groups[1]);
 			
 			double sum = getLengthToRoot(t, t->groupNodeInfo[groups[1]][j], groups[0], groups[1]);
 			double weightedSum = ((numSeqsInGroupL * sum) / (double)ct->getGroupCount(groups[1]));
@@ -397,6 +395,8 @@ EstOutput Weighted::getValues(Tree* t, string groupA, string groupB) {
 		}
 				
 		//calculate u for the group comb 
+		int indexA = t->getGroupIndex(groupA);
+		int indexB = t->getGroupIndex(groupB);
 		for(int i=0;i<t->getNumNodes();i++){
 		 
 			if (m->control_pressed) { return data; }
@@ -404,18 +404,18 @@ EstOutput Weighted::getValues(Tree* t, string groupA, string groupB) {
 			double u;
 			//int pcountSize = 0;
 			//does this node have descendants from groupA
-			it = t->tree[i].pcount.find(groupA);
+			int numA = t->tree[i].getPcount(indexA);
 			//if it does u = # of its descendants with a certain group / total number in tree with a certain group
-			if (it != t->tree[i].pcount.end()) {
-				u = (double) t->tree[i].pcount[groupA] / (double) ct->getGroupCount(groupA);
+			if (numA != 0) {
+				u = (double) numA / (double) ct->getGroupCount(groupA);
 			}else { u = 0.00; }
 			
 			
 			//does this node have descendants from group l
-			it = t->tree[i].pcount.find(groupB);
+			int numB = t->tree[i].getPcount(indexB);
 			//if it does subtract their percentage from u
-			if (it != t->tree[i].pcount.end()) {
-				u -= (double) t->tree[i].pcount[groupB] / (double) ct->getGroupCount(groupB);
+			if (numB != 0) {
+				u -= (double) numB / (double) ct->getGroupCount(groupB);
 			}
 			
 			if (includeRoot) {
@@ -462,6 +462,8 @@ double Weighted::getLengthToRoot(Tree* t, int v, string groupA, string groupB) {
 		index = t->tree[index].getParent();	
 		
 		vector<string> grouping; grouping.push_back(groupA); grouping.push_back(groupB);
+		int indexA = t->getGroupIndex(groupA);
+		int indexB = t->getGroupIndex(groupB);
 		
 		rootForGrouping[grouping].insert(index);
 			
@@ -484,12 +486,9 @@ double Weighted::getLengthToRoot(Tree* t, int v, string groupA, string groupB) {
 				int sib = lc;
 				if (lc == index) { sib = rc; }
 				
-				map<string, int>::iterator itGroup;
 				int pcountSize = 0;
-				itGroup = t->tree[sib].pcount.find(groupA);
-				if (itGroup != t->tree[sib].pcount.end()) { pcountSize++;  } 
-				itGroup = t->tree[sib].pcount.find(groupB);
-				if (itGroup != t->tree[sib].pcount.end()) { pcountSize++;  } 
+				if (t->tree[sib].getPcount(indexA) != 0) { pcountSize++;  } 
+				if (t->tree[sib].getPcount(indexB) != 0) { pcountSize++;  } 
 				
 				//if yes, I am not the root so add me
 				if (pcountSize != 0) {
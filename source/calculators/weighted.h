@@ -34,7 +34,6 @@ class Weighted : public TreeCalculator  {
 		vector<linePair> lines;
 
 		EstOutput data;
-		map<string, int>::iterator it;
 		map<string, double> WScore; //a score for each group combination i.e. AB, AC, BC.
 		int processors;
 		string outputDir;
@@ -77,7 +76,6 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
 	weightedData* pDataArray;
 	pDataArray = (weightedData*)lpParam;
 	try {
-        map<string, int>::iterator it;
 		vector<double> D;
 		int count = 0;
         map< vector<string>, set<int> > rootForGrouping;
@@ -90,6 +88,8 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
 			//initialize weighted score
 			string groupA = pDataArray->namesOfGroupCombos[h][0];
 			string groupB = pDataArray->namesOfGroupCombos[h][1];
+			int indexA = pDataArray->t->getGroupIndex(groupA);
+			int indexB = pDataArray->t->getGroupIndex(groupB);
 			
 			set<int> validBranches;
 			WScore[groupA+groupB] = 0.0;
@@ -97,8 +97,7 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
 			
 			//adding the wieghted sums from group i
 			for (int j = 0; j < pDataArray->t->groupNodeInfo[groupA].size(); j++) { //the leaf nodes that have seqs from group i
-				map<string, int>::iterator it = pDataArray->t->tree[pDataArray->t->groupNodeInfo[groupA][j]].pcount.find(groupA);
-				int numSeqsInGroupI = it->second;
+				int numSeqsInGroupI = pDataArray->t->getPcount(pDataArray->t->groupNodeInfo[groupA][j], groupA);
 
 				//double sum = getLengthToRoot(pDataArray->t, pDataArray->t->groupNodeInfo[groupA][j], groupA, groupB);
                 /*************************************************************************************/
@@ -133,12 +132,9 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
                         int sib = lc;
                         if (lc == index) { sib = rc; }
                         
-                        map<string, int>::iterator itGroup;
                         int pcountSize = 0;
-                        itGroup = pDataArray->t->tree[sib].pcount.find(groupA);
-                        if (itGroup != pDataArray->t->tree[sib].pcount.end()) { pcountSize++;  }
-                        itGroup = pDataArray->t->tree[sib].pcount.find(groupB);
-                        if (itGroup != pDataArray->t->tree[sib].pcount.end()) { pcountSize++;  }
+                        if (pDataArray->t->tree[sib].getPcount(indexA) != 0) { pcountSize++;  }
+                        if (pDataArray->t->tree[sib].getPcount(indexB) != 0) { pcountSize++;  }
                         
                         //if yes, I am not the root so add me
                         if (pcountSize != 0) {
@@ -178,8 +174,7 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
 			
 			//adding the wieghted sums from group l
 			for (int j = 0; j < pDataArray->t->groupNodeInfo[groupB].size(); j++) { //the leaf nodes that have seqs from group l
-				map<string, int>::iterator it = pDataArray->t->tree[pDataArray->t->groupNodeInfo[groupB][j]].pcount.find(groupB);
-				int numSeqsInGroupL = it->second;
+				int numSeqsInGroupL = pDataArray->t->getPcount(pDataArray->t->groupNodeInfo[groupB][j], groupB);
 				
 				//double sum = getLengthToRoot(pDataArray->t, pDataArray->t->groupNodeInfo[groupB][j], groupA, groupB);
                 /*************************************************************************************/
@@ -214,12 +209,9 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
                         int sib = lc;
                         if (lc == index) { sib = rc; }
                         
-                        map<string, int>::iterator itGroup;
                         int pcountSize = 0;
-                        itGroup = pDataArray->t->tree[sib].pcount.find(groupA);
-                        if (itGroup != pDataArray->t->tree[sib].pcount.end()) { pcountSize++;  }
-                        itGroup = pDataArray->t->tree[sib].pcount.find(groupB);
-                        if (itGroup != pDataArray->t->tree[sib].pcount.end()) { pcountSize++;  }
+                        if (pDataArray->t->tree[sib].getPcount(indexA) != 0) { pcountSize++;  }
+                        if (pDataArray->t->tree[sib].getPcount(indexB) != 0) { pcountSize++;  }
                         
                         //if yes, I am not the root so add me
                         if (pcountSize != 0) {
@@ -267,6 +259,8 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
             
 			string groupA = pDataArray->namesOfGroupCombos[h][0];
 			string groupB = pDataArray->namesOfGroupCombos[h][1];
+			int indexA = pDataArray->t->getGroupIndex(groupA);
+			int indexB = pDataArray->t->getGroupIndex(groupB);
 			
 			//calculate u for the group comb
 			for(int i=0;i<pDataArray->t->getNumNodes();i++){
@@ -276,19 +270,19 @@ static DWORD WINAPI MyWeightedThreadFunction(LPVOID lpParam){
 				double u;
 				//int pcountSize = 0;
 				//does this node have descendants from groupA
-				it = pDataArray->t->tree[i].pcount.find(groupA);
+				int numA = pDataArray->t->tree[i].getPcount(indexA);
 				//if it does u = # of its descendants with a certain group / total number in tree with a certain group
-				if (it != pDataArray->t->tree[i].pcount.end()) {
-					u = (double) pDataArray->t->tree[i].pcount[groupA] / (double) pDataArray->ct->getGroupCount(groupA);
+				if (numA != 0) {
+					u = (double) numA / (double) pDataArray->ct->getGroupCount(groupA);
 				}else { u = 0.00; }
 				
 				
 				//does this node have descendants from group l
-				it = pDataArray->t->tree[i].pcount.find(groupB);
+				int numB = pDataArray->t->tree[i].getPcount(indexB);
 				
 				//if it does subtract their percentage from u
-				if (it != pDataArray->t->tree[i].pcount.end()) {
-					u -= (double) pDataArray->t->tree[i].pcount[groupB] / (double) pDataArray->ct->getGroupCount(groupB);
+				if (numB != 0) {
+					u -= (double) numB / (double) pDataArray->ct->getGroupCount(groupB);
 				}
 				
 				if (pDataArray->includeRoot) {
@@ -88,6 +88,7 @@ ChimeraSlayer::ChimeraSlayer(string file, string temp, bool trim, map<string, in
 				runFilter(newSeq);  
 				filteredTemplateSeqs.push_back(newSeq);
 			}
+			decalc.indexTemplate(filteredTemplateSeqs);
 		}
 	}
 	catch(exception& e) {
@@ -137,6 +138,7 @@ ChimeraSlayer::ChimeraSlayer(string file, string temp, bool trim, map<string, in
 				runFilter(newSeq);  
 				filteredTemplateSeqs.push_back(newSeq);
 			}
+			decalc.indexTemplate(filteredTemplateSeqs);
 		}
 	}
 	catch(exception& e) {
@@ -168,6 +170,7 @@ int ChimeraSlayer::doPrep() {
 				runFilter(newSeq);  
 				filteredTemplateSeqs.push_back(newSeq);
 			}
+			decalc.indexTemplate(filteredTemplateSeqs);
 		}
 		string 	kmerDBNameLeft;
 		string 	kmerDBNameRight;
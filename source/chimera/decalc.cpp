@@ -692,8 +692,6 @@ vector<Sequence> DeCalculator::findClosest(Sequence querySeq, vector<Sequence*>&
 		vector<SeqDist> distsLeft;
 		vector<SeqDist> distsRight;
 		
-		Dist* distcalculator = new eachGapDist();
-		
 		string queryUnAligned = querySeq.getUnaligned();
 		int numBases = int(queryUnAligned.length() * 0.33);
 		
@@ -745,20 +743,28 @@ vector<Sequence> DeCalculator::findClosest(Sequence querySeq, vector<Sequence*>&
 		
 //cout << querySeq->getName() << '\t' << leftSpot << '\t' << rightSpot << '\t' << firstBaseSpot << '\t' << lastBaseSpot << endl;
 //cout << queryUnAligned.length() << '\t' << queryLeft.getUnaligned().length() << '\t' << queryRight.getUnaligned().length() << endl;
+		string leftWindow = queryLeft.getAligned();
+		string rightWindow = queryRight.getAligned();
+		int leftLength = leftSpot-firstBaseSpot+1;
+		int rightLength = lastBaseSpot-rightSpot+1;
+		
+		//the filtered template is usually the indexed one, or in order a subset of it for template=self
+		int row = 0;
+		
 		for(int j = 0; j < thisFilteredTemplate.size(); j++){
 			
-			string dbAligned = thisFilteredTemplate[j]->getAligned();
-			string leftDB = dbAligned.substr(firstBaseSpot, (leftSpot-firstBaseSpot+1)); //first 1/3 of the sequence
-			string rightDB = dbAligned.substr(rightSpot, (lastBaseSpot-rightSpot+1)); //last 1/3 of the sequence
-
-			Sequence dbLeft(thisFilteredTemplate[j]->getName(), leftDB);
-			Sequence dbRight(thisFilteredTemplate[j]->getName(), rightDB);
-
-			distcalculator->calcDist(queryLeft, dbLeft);
-			float distLeft = distcalculator->getDist();
+			while ((row < indexedSeqs.size()) && (indexedSeqs[row] != thisFilteredTemplate[j])) { row++; }
 			
-			distcalculator->calcDist(queryRight, dbRight);
-			float distRight = distcalculator->getDist();
+			float distLeft, distRight;
+			if (row < indexedSeqs.size()) {
+				const char* dbRow = &templateBlock[rowStarts[row]];
+				distLeft = windowDist(leftWindow, dbRow, rowLengths[row], firstBaseSpot, leftLength);
+				distRight = windowDist(rightWindow, dbRow, rowLengths[row], rightSpot, rightLength);
+			}else {
+				string dbAligned = thisFilteredTemplate[j]->getAligned();
+				distLeft = windowDist(leftWindow, dbAligned.c_str(), dbAligned.length(), firstBaseSpot, leftLength);
+				distRight = windowDist(rightWindow, dbAligned.c_str(), dbAligned.length(), rightSpot, rightLength);
+			}
 
 			SeqDist subjectLeft;
 			subjectLeft.seq = NULL;
@@ -776,8 +782,6 @@ vector<Sequence> DeCalculator::findClosest(Sequence querySeq, vector<Sequence*>&
 
 		}
 		
-		delete distcalculator;
-		
 		//sort by smallest distance
 		sort(distsRight.begin(), distsRight.end(), compareSeqDist);
 		sort(distsLeft.begin(), distsLeft.end(), compareSeqDist);
@@ -857,6 +861,86 @@ vector<Sequence> DeCalculator::findClosest(Sequence querySeq, vector<Sequence*>&
 	}
 }
 //***************************************************************************************************************
+void DeCalculator::indexTemplate(vector<Sequence*>& thisFilteredTemplate) {
+	try {
+		indexedSeqs = thisFilteredTemplate;
+		rowStarts.clear(); rowLengths.clear();
+		
+		long long blockSize = 0;
+		for (int i = 0; i < indexedSeqs.size(); i++) { blockSize += indexedSeqs[i]->getAlignLength(); }
+		
+		vector<char> temp;
+		temp.reserve(blockSize);
+		
+		for (int i = 0; i < indexedSeqs.size(); i++) {
+			if (m->control_pressed) { break; }
+			
+			string aligned = indexedSeqs[i]->getAligned();
+			rowStarts.push_back(temp.size());
+			rowLengths.push_back(aligned.length());
+			temp.insert(temp.end(), aligned.begin(), aligned.end());
+		}
+		
+		templateBlock.swap(temp);
+		
+		if (m->control_pressed) { indexedSeqs.clear(); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DeCalculator", "indexTemplate");
+		exit(1);
+	}
+}
+//***************************************************************************************************************
+//eachGapDist between the query window and the same columns of a template row. A window that starts with a gap
+//has its end gaps read as '.', which is what making a Sequence from the window would do.
+float DeCalculator::windowDist(string& query, const char* dbRow, int rowLength, int start, int length) {
+	try {
+		if (start > rowLength) { start = rowLength; }
+		if ((length < 0) || (length > (rowLength - start))) { length = rowLength - start; }
+		
+		const char* db = dbRow + start;
+		int firstBase = 0; int lastBase = length; //end gaps are outside [firstBase, lastBase)
+		if ((length != 0) && (db[0] == '-')) {
+			while ((firstBase < length) && (db[firstBase] == '-')) { firstBase++; }
+			while ((lastBase > firstBase) && (db[lastBase-1] == '-')) { lastBase--; }
+		}
+		
+		int alignLength = query.length();
+		const char* q = query.c_str();
+		int diff = 0;
+		int compared = 0;
+		bool started = false; //the '.' both share at the start are skipped, the next ones end the comparison
+		
+		for (int i = 0; i < alignLength; i++) {
+			char a = q[i];
+			char b = '.';
+			if (i < length) {
+				b = db[i];
+				if ((b == '-') && ((i < firstBase) || (i >= lastBase))) { b = '.'; }
+			}
+			
+			if ((a == '.') && (b == '.')) {
+				if (started) { break; }
+				continue;
+			}
+			started = true;
+			
+			if ((a == '.') && (b == '-')) { continue; }
+			if ((a == '-') && ((b == '-') || (b == '.'))) { continue; }
+			
+			if (a != b) { diff++; }
+			compared++;
+		}
+		
+		if (compared == 0) { return 1.0000; }
+		return ((double)diff / (double)compared);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DeCalculator", "windowDist");
+		exit(1);
+	}
+}
+//***************************************************************************************************************
 Sequence* DeCalculator::findClosest(Sequence* querySeq, vector<Sequence*> db) {
 	try {
 		
@@ -40,6 +40,7 @@ class DeCalculator {
 		~DeCalculator() {};
 		
 		vector<Sequence> findClosest(Sequence, vector<Sequence*>&, vector<Sequence*>&, int, int);  //takes querySeq, a reference db, filteredRefDB, numWanted, minSim 
+		void indexTemplate(vector<Sequence*>&); //filteredRefDB, saves the aligned rows so findClosest doesn't copy them for each query
 		Sequence* findClosest(Sequence*, vector<Sequence*>);
 		set<int> getPos() {  return h;  }
 		void setMask(string); 
@@ -72,6 +73,13 @@ class DeCalculator {
 		int alignLength;
 		map<int, int> maskMap;
 		MothurOut* m;
+		
+		//aligned rows of the indexed template back to back, findClosest reads windows of them in place
+		vector<Sequence*> indexedSeqs;
+		vector<char> templateBlock;
+		vector<long long> rowStarts;
+		vector<int> rowLengths;
+		float windowDist(string&, const char*, int, int, int); //query window, template row, row length, window start, window length
 
 };
 
@@ -13,10 +13,19 @@
 Slayer::Slayer(int win, int increment, int parentThreshold, float div, int i, int snp, int mi) :
 		minBS(mi), windowSize(win), windowStep(increment), parentFragmentThreshold(parentThreshold), divRThreshold(div), iters(i), percentSNPSample(snp){ m = MothurOut::getInstance(); }
 /***********************************************************************/
-string Slayer::getResults(Sequence query, vector<Sequence> refSeqs) {
+string Slayer::getResults(Sequence& query, vector<Sequence>& refSeqs) {
 	try {
 		vector<data_struct> all; all.clear();
-		myQuery = query;
+		
+		string queryAligned = query.getAligned();
+		getBaseCounts(queryAligned, queryBases);
+		
+		vector<string> refAligned; refAligned.resize(refSeqs.size());
+		refBases.resize(refSeqs.size());
+		for (int i = 0; i < refSeqs.size(); i++) {
+			refAligned[i] = refSeqs[i].getAligned();
+			getBaseCounts(refAligned[i], refBases[i]);
+		}
 
 		for (int i = 0; i < refSeqs.size(); i++) {
 		
@@ -24,35 +33,31 @@ string Slayer::getResults(Sequence query, vector<Sequence> refSeqs) {
 			
 				if (m->control_pressed) { return "no";  }
 	
-				//make copies of query and each parent because runBellerophon removes gaps and messes them up
-				Sequence q(query.getName(), query.getAligned());
-				Sequence leftParent(refSeqs[i].getName(), refSeqs[i].getAligned());
-				Sequence rightParent(refSeqs[j].getName(), refSeqs[j].getAligned());
+				//columns where the query and both parents have a base
+				verticalFilter(queryBases, refBases[i], refBases[j]);
 				
-				//cout << q->getName() << endl << q->getAligned() << endl << endl;	
-				//cout << leftParent.getName() << '\t' << leftParent.getAligned().length() << endl << endl;
-				//cout << rightParent.getName() << '\t' << rightParent.getAligned().length() << endl << endl;
-				//cout << q.getName() << '\t' << q.getAligned().length() << endl << endl;
-				//cout << rightParent->getName() << endl << rightParent->getAligned() << endl << endl;	
-				//cout << " length = " << rightParent->getAligned().length() << endl;
-	
-				map<int, int> spots;  //map from spot in original sequence to spot in filtered sequence for query and both parents
-				vector<data_struct> divs = runBellerophon(q, leftParent, rightParent, spots);
+				getIdentities(queryAligned, refAligned[i], qaBases, qaIdentical);
+				getIdentities(queryAligned, refAligned[j], qbBases, qbIdentical);
+				getIdentities(refAligned[i], refAligned[j], abBases, abIdentical);
+				
+				runBellerophon();
 	
 				if (m->control_pressed) { return "no"; }
-//				cout << "examining:\t" << refSeqs[i]->getName() << '\t' << refSeqs[j]->getName() << endl;
-				vector<data_struct> selectedDivs;
+				
+				//filtered copies are only made for pairs with a result
+				bool madeFiltered = false;
+				Sequence q, leftParent, rightParent;
+				
 				for (int k = 0; k < divs.size(); k++) {
 					
-					vector<snps> snpsLeft = getSNPS(divs[k].parentA.getAligned(), divs[k].querySeq.getAligned(), divs[k].parentB.getAligned(), divs[k].winLStart, divs[k].winLEnd);
-					vector<snps> snpsRight = getSNPS(divs[k].parentA.getAligned(), divs[k].querySeq.getAligned(), divs[k].parentB.getAligned(), divs[k].winRStart, divs[k].winREnd);
+					getSNPS(refAligned[i], queryAligned, refAligned[j], refBases[i], refBases[j], divs[k].winLStart, divs[k].winLEnd, snpsLeft);
+					getSNPS(refAligned[i], queryAligned, refAligned[j], refBases[i], refBases[j], divs[k].winRStart, divs[k].winREnd, snpsRight);
 	
 					if (m->control_pressed) {  return "no"; }
 					
 					int numSNPSLeft = snpsLeft.size();
 					int numSNPSRight = snpsRight.size();
 					
-//					cout << numSNPSLeft << '\t' << numSNPSRight << endl;
 					//require at least 4 SNPs on each side of the break
 					if ((numSNPSLeft >= 4) && (numSNPSRight >= 4)) {
 							
@@ -66,31 +71,25 @@ string Slayer::getResults(Sequence query, vector<Sequence> refSeqs) {
 						divs[k].bsMax = max(BS_A, BS_B);
 						divs[k].chimeraMax = max(divs[k].qla_qrb, divs[k].qlb_qra);
 						
-						
-						//are we within 10 points of the bootstrap cutoff?
-//						if ((divs[k].bsMax >= (minBS-10)) && (iters < 1000)) {
-//							bootstrapSNPS(snpsLeft, snpsRight, BS_A, BS_B, 1000);
-//								
-//							if (m->control_pressed) { delete q; delete leftParent; delete rightParent; return "no"; }
-//								
-//							divs[k].bsa = BS_A;
-//							divs[k].bsb = BS_B;
-//							divs[k].bsMax = max(BS_A, BS_B);
-//							divs[k].chimeraMax = max(divs[k].qla_qrb, divs[k].qlb_qra);
-//						}
-						
 						//so results reflect orignal alignment
-						divs[k].winLStart = spots[divs[k].winLStart];
-						divs[k].winLEnd = spots[divs[k].winLEnd];  
-						divs[k].winRStart = spots[divs[k].winRStart]; 
-						divs[k].winREnd = spots[divs[k].winREnd]; 
+						divs[k].winLStart = filteredCols[divs[k].winLStart];
+						divs[k].winLEnd = filteredCols[divs[k].winLEnd];  
+						divs[k].winRStart = filteredCols[divs[k].winRStart]; 
+						divs[k].winREnd = filteredCols[divs[k].winREnd]; 
+						
+						if (!madeFiltered) {
+							q = Sequence(query.getName(), getFiltered(queryAligned));
+							leftParent = Sequence(refSeqs[i].getName(), getFiltered(refAligned[i]));
+							rightParent = Sequence(refSeqs[j].getName(), getFiltered(refAligned[j]));
+							madeFiltered = true;
+						}
+						divs[k].querySeq = q;
+						divs[k].parentA = leftParent;
+						divs[k].parentB = rightParent;
 						
-						selectedDivs.push_back(divs[k]);
+						all.push_back(divs[k]);
 					}
 				}
-
-				//save selected
-				for (int mi = 0; mi < selectedDivs.size(); mi++) {  all.push_back(selectedDivs[mi]);	}
 			}
 		}
 		
@@ -114,51 +113,35 @@ string Slayer::getResults(Sequence query, vector<Sequence> refSeqs) {
 	}
 }
 /***********************************************************************/
-vector<data_struct> Slayer::runBellerophon(Sequence q, Sequence pA, Sequence pB, map<int, int>& spots) {
+//windows are scored on the columns kept by verticalFilter
+int Slayer::runBellerophon() {
 	try{
 		
-		vector<data_struct> data;
-		
-		//vertical filter
-		//cout << q.getName() << endl << q.getAligned() << endl << endl;	
-		//cout << pA.getName() << endl << pA.getUnaligned() << endl << endl;		
-		//cout << pB.getName() << endl << pB.getUnaligned() << endl << endl;	
-		
-		//maps spot in new alignment to spot in alignment before filter
-		spots = verticalFilter(q, pA, pB);  //fills baseSpots
-		
-		//get these to avoid numerous function calls
-		string query = q.getAligned();
-		string parentA = pA.getAligned();
-		string parentB = pB.getAligned();
-		int length = query.length();
-//cout << q.getName() << endl << q.getAligned() << endl << endl;	
-//cout << pA.getName() << endl << pA.getUnaligned() << endl << endl;		
-//cout << pB.getName() << endl << pB.getUnaligned() << endl << endl;	
-//cout << " length = " << length << endl;
+		divs.clear();
+		
+		int length = filteredCols.size();
 	
 		//check window size
 		if (length < (2*windowSize+windowStep)) { 
-//			m->mothurOut("Your window size is too large for " + q->getName() + ". I will make the window size " + toString(length/4) + " which is 1/4 the filtered length."); m->mothurOutEndLine();	
 			windowSize = length / 4;
 		}
 		
 		for (int i = windowSize-1; i <= (length - windowSize); i += windowStep) {
 		
-			if (m->control_pressed) { return data; }
+			if (m->control_pressed) { return 0; }
 		
 			int breakpoint = i;
 			int leftLength = breakpoint + 1;
 			int rightLength = length - leftLength;
 				
-			float QLA = computePercentID(query, parentA, 0, breakpoint);
-			float QRB = computePercentID(query, parentB, breakpoint+1, length-1);
+			float QLA = computePercentID(qaBases, qaIdentical, 0, breakpoint);
+			float QRB = computePercentID(qbBases, qbIdentical, breakpoint+1, length-1);
 		
-			float QLB = computePercentID(query, parentB, 0, breakpoint);
-			float QRA = computePercentID(query, parentA, breakpoint+1, length-1);
+			float QLB = computePercentID(qbBases, qbIdentical, 0, breakpoint);
+			float QRA = computePercentID(qaBases, qaIdentical, breakpoint+1, length-1);
 		
-			float LAB = computePercentID(parentA, parentB, 0, breakpoint);
-			float RAB = computePercentID(parentA, parentB, breakpoint+1, length-1);	
+			float LAB = computePercentID(abBases, abIdentical, 0, breakpoint);
+			float RAB = computePercentID(abBases, abIdentical, breakpoint+1, length-1);	
 			
 			float AB = ((LAB*leftLength) + (RAB*rightLength)) / (float) length;
 			float QA = ((QLA*leftLength) + (QRA*rightLength)) / (float) length;
@@ -173,16 +156,6 @@ vector<data_struct> Slayer::runBellerophon(Sequence q, Sequence pA, Sequence pB,
 			float divR_QLA_QRB = min((QLA_QRB/QA), (QLA_QRB/QB));
 			float divR_QLB_QRA = min((QLB_QRA/QA), (QLB_QRA/QB));
 			
-			
-			//cout << q->getName() << '\t';
-			//cout << pA->getName() << '\t';
-			//cout << pB->getName() << '\t';
-		    //cout << "bp: " << breakpoint << " CHIM_TYPE_A\t" << divR_QLA_QRB << "\tQLA: " << QLA << "\tQRB: " << QRB << "\tQLA_QRB: " << QLA_QRB;
-			//cout << "\tCHIM_TYPE_B\t" << divR_QLB_QRA << "\tQLB: " << QLB << "\tQRA: " << QRA << "\tQLB_QRA: " << QLB_QRA << endl;
-//cout << leftLength << '\t' << rightLength << '\t' << QLA << '\t' << QRB << '\t' << QLB << '\t' << QRA  << '\t' << LAB << '\t' << RAB << '\t' << AB << '\t' << QA << '\t' << QB << '\t' << QLA_QRB << '\t' <<  QLB_QRA <<    endl;    		
-
-//cout << divRThreshold << endl;
-//cout << breakpoint << '\t' << divR_QLA_QRB << '\t' << divR_QLB_QRA << endl;
 			//is one of them above the 
 			if (divR_QLA_QRB >= divRThreshold || divR_QLB_QRA >= divRThreshold) {
 				
@@ -208,22 +181,18 @@ vector<data_struct> Slayer::runBellerophon(Sequence q, Sequence pA, Sequence pB,
 					member.winLEnd = breakpoint;  
 					member.winRStart = breakpoint+1; 
 					member.winREnd = length-1; 
-					member.querySeq = q;
-					member.parentA = pA;
-					member.parentB = pB;
 					member.bsa = 0;
 					member.bsb = 0;
 					member.bsMax = 0;
 					member.chimeraMax = 0;
 					
-					data.push_back(member);
+					divs.push_back(member);
 					
 				}//if
 			}//if
 		}//for
 		
-		
-		return data;
+		return 0;
 		
 	}
 	catch(exception& e) {
@@ -232,36 +201,35 @@ vector<data_struct> Slayer::runBellerophon(Sequence q, Sequence pA, Sequence pB,
 	}
 }
 /***********************************************************************/
-vector<snps> Slayer::getSNPS(string parentA, string query, string parentB, int left, int right) {
+//left and right are positions in the filtered columns
+void Slayer::getSNPS(string& parentA, string& query, string& parentB, vector<int>& aBases, vector<int>& bBases, int left, int right, vector<snps>& data) {
 	try {
 	
-		vector<snps> data;
+		data.clear();
+		int last = filteredCols.size()-1;
 
 		for (int i = left; i <= right; i++) {
 			
-			char A = parentA[i];
-			char Q = query[i];
-			char B = parentB[i];
+			int col = filteredCols[i];
+			char A = parentA[col];
+			char Q = query[col];
+			char B = parentB[col];
 			
 			if ((A != Q) || (B != Q)) {
 
 				//ensure not neighboring a gap. change to 12/09 release of chimeraSlayer - not sure what this adds, but it eliminates alot of SNPS
-
+				//a sequence lost a base here during the filter if its base count jumps by more than one between kept columns
+				bool leftOk = true; bool rightOk = true;
+				if (i != 0) {
+					int prev = filteredCols[i-1];
+					leftOk = ((abs(queryBases[col] - queryBases[prev]) == 1) && (abs(aBases[col] - aBases[prev]) == 1) && (abs(bBases[col] - bBases[prev]) == 1));
+				}
+				if (i != last) {
+					int next = filteredCols[i+1];
+					rightOk = ((abs(queryBases[col] - queryBases[next]) == 1) && (abs(aBases[col] - aBases[next]) == 1) && (abs(bBases[col] - bBases[next]) == 1));
+				}
 				
-				if (
-					//did query loose a base here during filter??
-					( i == 0 || abs (baseSpots[0][i] - baseSpots[0][i-1]) == 1) &&
-					( i == query.length()-1 || abs (baseSpots[0][i] - baseSpots[0][i+1]) == 1)
-					&&
-					//did parentA loose a base here during filter??
-					( i == 0 || abs (baseSpots[1][i] - baseSpots[1][i-1]) == 1) &&
-					( i == parentA.length()-1 || abs (baseSpots[1][i] - baseSpots[1][i+1]) == 1) 
-					&&
-					//did parentB loose a base here during filter??
-					( i == 0 || abs (baseSpots[2][i] - baseSpots[2][i-1]) == 1) &&
-					( i == parentB.length()-1 || abs (baseSpots[2][i] - baseSpots[2][i+1]) == 1)
-					) 
-				{ 
+				if (leftOk && rightOk) { 
 					snps member;
 					member.queryChar = Q;
 					member.parentAChar = A;
@@ -270,9 +238,6 @@ vector<snps> Slayer::getSNPS(string parentA, string query, string parentB, int l
 				}
 			}
 		}
-		
-		return data;
-		
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Slayer", "getSNPS");
@@ -280,7 +245,7 @@ vector<snps> Slayer::getSNPS(string parentA, string query, string parentB, int l
 	}
 }
 /***********************************************************************/
-int Slayer::bootstrapSNPS(vector<snps> left, vector<snps> right, float& BSA, float& BSB, int numIters) {
+int Slayer::bootstrapSNPS(vector<snps>& left, vector<snps>& right, float& BSA, float& BSB, int numIters) {
 	try {
 
 		srand((unsigned)time( NULL ));
@@ -292,21 +257,22 @@ int Slayer::bootstrapSNPS(vector<snps> left, vector<snps> right, float& BSA, flo
 		int numRight = max(1, int(right.size() * percentSNPSample/(float)100 + 0.5));
 
 		for (int i = 0; i < numIters; i++) {
-			//random sampling with replacement.
+			//random sampling with replacement. only the matches to each parent are needed, so the samples are counted instead of copied
 		
 			if (m->control_pressed) { return 0;  }
 			
-			vector<snps> selectedLeft;
-
+			int leftA = 0; int leftB = 0;
 			for (int j = 0; j < numLeft; j++) {
 				int index = int(rand() % left.size());
-				selectedLeft.push_back(left[index]);
+				if (left[index].parentAChar == left[index].queryChar) { leftA++; }
+				if (left[index].parentBChar == left[index].queryChar) { leftB++; }
 			}
 
-			vector<snps> selectedRight;
+			int rightA = 0; int rightB = 0;
 			for (int j = 0; j < numRight; j++) {
 				int index = int(rand() % right.size());
-				selectedRight.push_back(right[index]);
+				if (right[index].parentAChar == right[index].queryChar) { rightA++; }
+				if (right[index].parentBChar == right[index].queryChar) { rightB++; }
 			}
 		
 			/* A  ------------------------------------------
@@ -318,16 +284,11 @@ int Slayer::bootstrapSNPS(vector<snps> left, vector<snps> right, float& BSA, flo
 			#       QLB                     QRB
 			# B  ------------------------------------------ */
 		
+			float QLA = (leftA / (float) numLeft) * 100;
+			float QRA = (rightA / (float) numRight) * 100;
 		
-			float QLA = snpQA(selectedLeft);
-			float QRA = snpQA(selectedRight);
-		
-			float QLB = snpQB(selectedLeft);
-			float QRB = snpQB(selectedRight);
-	
-			//in original - not used - not sure why?
-			//float ALB = snpAB(selectedLeft);
-			//float ARB = snpAB(selectedRight);
+			float QLB = (leftB / (float) numLeft) * 100;
+			float QRB = (rightB / (float) numRight) * 100;
 		
 			if ((QLA > QLB) && (QRB > QRA)) {
 				count_A++;
@@ -336,29 +297,10 @@ int Slayer::bootstrapSNPS(vector<snps> left, vector<snps> right, float& BSA, flo
 			if ((QLB > QLA) && (QRA > QRB)) {
 				count_B++;
 			}
-			
-//cout << "selected left snp: \n";
-//for (int j = 0; j < selectedLeft.size(); j++) {  cout << selectedLeft[j].parentAChar;  } 
-//cout << endl;
-//for (int j = 0; j < selectedLeft.size(); j++) {  cout << selectedLeft[j].queryChar;  }
-//cout << endl;
-//for (int j = 0; j < selectedLeft.size(); j++) {  cout << selectedLeft[j].parentBChar;  }
-//cout << endl;
-//cout << "selected right snp: \n";
-//for (int j = 0; j < selectedRight.size(); j++) {  cout << selectedRight[j].parentAChar;  } 
-//cout << endl;
-//for (int i = 0; i < selectedRight.size(); i++) {  cout << selectedRight[i].queryChar;  }
-//cout << endl;
-//for (int i = 0; i < selectedRight.size(); i++) {  cout << selectedRight[i].parentBChar;  }
-//cout << endl;		
 		}
 
-
-		//cout << count_A << '\t' << count_B << endl;
-
 		BSA = (float) count_A / (float) numIters * 100;
 		BSB = (float) count_B / (float) numIters * 100;
-//cout << "bsa = " << BSA << " bsb = " << BSB << endl;
 
 		return 0;
 	
@@ -369,77 +311,18 @@ int Slayer::bootstrapSNPS(vector<snps> left, vector<snps> right, float& BSA, flo
 	}
 }
 /***********************************************************************/
-float Slayer::snpQA(vector<snps> data) {
-	try {
-	
-		int numIdentical = 0;
-	
-		for (int i = 0; i < data.size(); i++) {
-			if (data[i].parentAChar == data[i].queryChar) {
-				numIdentical++;
-			}
-		}
-
-		float percentID = (numIdentical / (float) data.size()) * 100;
-		
-		return percentID;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "Slayer", "snpQA");
-		exit(1);
-	}
-}
-/***********************************************************************/
-float Slayer::snpQB(vector<snps> data) {
+//running totals of the bases and identical bases of two sequences over the kept columns, 
+//so a window's percent identity is a difference of two totals
+void Slayer::getIdentities(string& queryAlign, string& chimera, vector<int>& bases, vector<int>& identical) {
 	try {
-	
-		int numIdentical = 0;
-	
-		for (int i = 0; i < data.size(); i++) {
-			if (data[i].parentBChar == data[i].queryChar) {
-				numIdentical++;
-			}
-		}
-
-		float percentID = (numIdentical / (float) data.size()) * 100;
+		int length = filteredCols.size();
+		bases.resize(length+1); identical.resize(length+1);
+		bases[0] = 0; identical[0] = 0;
 		
-		return percentID;
-
-	}
-	catch(exception& e) {
-		m->errorOut(e, "Slayer", "snpQB");
-		exit(1);
-	}
-}
-/***********************************************************************/
-float Slayer::snpAB(vector<snps> data) {
-	try {
-		int numIdentical = 0;
-	
-		for (int i = 0; i < data.size(); i++) {
-			if (data[i].parentAChar == data[i].parentBChar) {
-				numIdentical++;
-			}
-		}
-
-		float percentID = (numIdentical / (float) data.size()) * 100;
-		
-		return percentID;
-
-	}
-	catch(exception& e) {
-		m->errorOut(e, "Slayer", "snpAB");
-		exit(1);
-	}
-}
-/***********************************************************************/
-float Slayer::computePercentID(string queryAlign, string chimera, int left, int right) {
-	try {
-				
-		int numIdentical = 0;
-		int countA = 0;
-		int countB = 0;
-		for (int i = left; i <= right; i++) {
+		for (int k = 0; k < length; k++) {
+			int i = filteredCols[k];
+			bases[k+1] = bases[k]; identical[k+1] = identical[k];
+			
 			if (((queryAlign[i] != 'G') && (queryAlign[i] != 'T') && (queryAlign[i] != 'A') && (queryAlign[i] != 'C')&& (queryAlign[i] != '.') && (queryAlign[i] != '-')) ||
 				((chimera[i] != 'G') && (chimera[i] != 'T') && (chimera[i] != 'A') && (chimera[i] != 'C')&& (chimera[i] != '.') && (chimera[i] != '-'))) {}
 			else {
@@ -450,18 +333,30 @@ float Slayer::computePercentID(string queryAlign, string chimera, int left, int
 				
 				if (charA || charB) {
 					
-					if (charA) { countA++; }
-					if (charB) { countB++; }
+					if (charA) { bases[k+1]++; }
+					if (charB) { bases[k+1]++; }
 					
 					if (queryAlign[i] == chimera[i]) {
-						numIdentical++;
+						identical[k+1]++;
 					}
 				}
 			}
-			
 		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Slayer", "getIdentities");
+		exit(1);
+	}
+}
+/***********************************************************************/
+float Slayer::computePercentID(vector<int>& bases, vector<int>& identical, int left, int right) {
+	try {
 		
-		float numBases = (countA + countB) /(float) 2;
+		if (right < left) { return 0; }
+		
+		int numIdentical = identical[right+1] - identical[left];
+		
+		float numBases = (bases[right+1] - bases[left]) /(float) 2;
 		
 		if (numBases == 0) { return 0; }
 		
@@ -476,108 +371,40 @@ float Slayer::computePercentID(string queryAlign, string chimera, int left, int
 	}
 }
 /***********************************************************************/
-//remove columns that contain any gaps
-map<int, int> Slayer::verticalFilter(Sequence& q, Sequence& pA, Sequence& pB) {
+//number of bases up to and including each column
+void Slayer::getBaseCounts(string& seqAligned, vector<int>& bases) {
 	try {
-		//find baseSpots
-		baseSpots.clear(); 
-		baseSpots.resize(3);  //query, parentA, parentB
-	
-		vector<int> gaps;	gaps.resize(q.getAligned().length(), 0);
-		
-		string filterString = (string(q.getAligned().length(), '1'));
+		bases.resize(seqAligned.length());
 		
-		string seqAligned = q.getAligned();
-		for (int j = 0; j < seqAligned.length(); j++) {
-			//if this spot is a gap
-			if ((seqAligned[j] == '-') || (seqAligned[j] == '.') || (toupper(seqAligned[j]) == 'N'))	{   gaps[j]++;	}
-		}
-		
-		seqAligned = pA.getAligned();
-		for (int j = 0; j < seqAligned.length(); j++) {
-			//if this spot is a gap
-			if ((seqAligned[j] == '-') || (seqAligned[j] == '.') || (toupper(seqAligned[j]) == 'N'))	{   gaps[j]++;	}
-		}
-		
-		seqAligned = pB.getAligned();
-		for (int j = 0; j < seqAligned.length(); j++) {
-			//if this spot is a gap
-			if ((seqAligned[j] == '-') || (seqAligned[j] == '.') || (toupper(seqAligned[j]) == 'N'))	{   gaps[j]++;	}
-		}
-		
-		
-		//zero out spot where any sequences have blanks
-		int numColRemoved = 0;
-		int count = 0;
-		map<int, int> maskMap; maskMap.clear();
-
-		for(int i = 0; i < q.getAligned().length(); i++){
-			if(gaps[i] != 0)	{	filterString[i] = '0'; 	numColRemoved++;  }
-			else {
-				maskMap[count] = i;
-				count++;
-			}
-		}
-
-		seqAligned = q.getAligned();
-		string newAligned = "";
-			
 		int baseCount = 0;
-		count = 0;
 		for (int j = 0; j < seqAligned.length(); j++) {
 			//are you a base
 			if ((seqAligned[j] != '-') && (seqAligned[j] != '.') && (toupper(seqAligned[j]) != 'N'))	{ baseCount++; }
-			
-			//if this spot is not a gap
-			if (filterString[j] == '1') { 
-				newAligned += seqAligned[j]; 
-				baseSpots[0][count] = baseCount;
-				count++;
-			}
+			bases[j] = baseCount;
 		}
-			
-		q.setAligned(newAligned);
-		
-		seqAligned = pA.getAligned();
-		newAligned = "";
-		
-		baseCount = 0;
-		count = 0;
-		for (int j = 0; j < seqAligned.length(); j++) {
-			//are you a base
-			if ((seqAligned[j] != '-') && (seqAligned[j] != '.') && (toupper(seqAligned[j]) != 'N'))	{ baseCount++; }
-			
-			//if this spot is not a gap
-			if (filterString[j] == '1') { 
-				newAligned += seqAligned[j]; 
-				baseSpots[1][count] = baseCount;
-				count++;
-			}
-		}
-		
-		pA.setAligned(newAligned);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Slayer", "getBaseCounts");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//remove columns that contain any gaps. A column is a base if the count goes up there
+int Slayer::verticalFilter(vector<int>& qBases, vector<int>& aBases, vector<int>& bBases) {
+	try {
+		filteredCols.clear();
 		
-		seqAligned = pB.getAligned();
-		newAligned = "";
+		int length = qBases.size();
+		if (aBases.size() < length) { length = aBases.size(); }
+		if (bBases.size() < length) { length = bBases.size(); }
 		
-		baseCount = 0;
-		count = 0;
-		for (int j = 0; j < seqAligned.length(); j++) {
-			//are you a base
-			if ((seqAligned[j] != '-') && (seqAligned[j] != '.') && (toupper(seqAligned[j]) != 'N'))	{ baseCount++; }
-			
-			//if this spot is not a gap
-			if (filterString[j] == '1') { 
-				newAligned += seqAligned[j]; 
-				baseSpots[2][count] = baseCount;
-				count++;
-			}
+		for (int i = 0; i < length; i++) {
+			if (i == 0) {
+				if ((qBases[0] == 1) && (aBases[0] == 1) && (bBases[0] == 1)) { filteredCols.push_back(0); }
+			}else if ((qBases[i] != qBases[i-1]) && (aBases[i] != aBases[i-1]) && (bBases[i] != bBases[i-1])) { filteredCols.push_back(i); }
 		}
 		
-		pB.setAligned(newAligned);
-		
-		
-		return maskMap;
+		return filteredCols.size();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Slayer", "verticalFilter");
@@ -585,3 +412,15 @@ map<int, int> Slayer::verticalFilter(Sequence& q, Sequence& pA, Sequence& pB) {
 	}
 }
 /***********************************************************************/
+string Slayer::getFiltered(string& seqAligned) {
+	try {
+		string filtered(filteredCols.size(), ' ');
+		for (int i = 0; i < filteredCols.size(); i++) { filtered[i] = seqAligned[filteredCols[i]]; }
+		return filtered;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Slayer", "getFiltered");
+		exit(1);
+	}
+}
+/***********************************************************************/
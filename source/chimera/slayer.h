@@ -32,7 +32,7 @@ class Slayer {
 		Slayer(int, int, int, float, int, int, int);
 		~Slayer() {};
 		
-		string getResults(Sequence, vector<Sequence>);
+		string getResults(Sequence&, vector<Sequence>&);
 		vector<data_struct> getOutput()  {	return outputResults;			}
 		
 				
@@ -41,18 +41,26 @@ class Slayer {
 		int windowSize, windowStep, parentFragmentThreshold, iters, percentSNPSample, minBS;
 		float divRThreshold; 
 		vector<data_struct>  outputResults;
-		vector< map<int, int> > baseSpots;
-		Sequence myQuery;
 		
-		map<int, int> verticalFilter(Sequence&, Sequence&, Sequence&);
-		float computePercentID(string, string, int, int);
+		//bases up to and including each column of the query and each reference, found once per query and shared by every parent pair
+		vector<int> queryBases;
+		vector< vector<int> > refBases;
 		
-		vector<data_struct> runBellerophon(Sequence, Sequence, Sequence, map<int, int>&);
-		vector<snps> getSNPS(string, string, string, int, int);
-		int bootstrapSNPS(vector<snps>, vector<snps>, float&, float&, int);
-		float snpQA(vector<snps>);
-		float snpQB(vector<snps>);
-		float snpAB(vector<snps>);
+		//reused for each parent pair
+		vector<int> filteredCols; //column in the original alignment of each column kept by the vertical filter
+		vector<int> qaBases, qaIdentical, qbBases, qbIdentical, abBases, abIdentical; //running totals over the kept columns for computePercentID
+		vector<data_struct> divs;
+		vector<snps> snpsLeft, snpsRight;
+		
+		void getBaseCounts(string&, vector<int>&);
+		int verticalFilter(vector<int>&, vector<int>&, vector<int>&); //query, parentA, parentB base counts. fills filteredCols
+		void getIdentities(string&, string&, vector<int>&, vector<int>&);
+		float computePercentID(vector<int>&, vector<int>&, int, int);
+		string getFiltered(string&);
+		
+		int runBellerophon(); //fills divs
+		void getSNPS(string&, string&, string&, vector<int>&, vector<int>&, int, int, vector<snps>&); //parentA, query, parentB, parentA bases, parentB bases
+		int bootstrapSNPS(vector<snps>&, vector<snps>&, float&, float&, int);
 		MothurOut* m;
 				
 };
@@ -29,13 +29,13 @@ KmerNode::KmerNode(string s, int l, int n) : TaxonomyNode(s, l), kmerSize(n) {
 
 /**********************************************************************************************************************/
 
-void KmerNode::loadSequence(vector<int>& kmerProfile){
+void KmerNode::loadSequence(vector<int>& kmers){
 	try {
-        for(int i=0;i<numPossibleKmers;i++){
+        for(int i=0;i<kmers.size();i++){
             if (m->control_pressed) { break; }
-            if(kmerVector[i] == 0 && kmerProfile[i] != 0)	{	numUniqueKmers++;	}
+            if(kmerVector[kmers[i]] == 0)	{	numUniqueKmers++;	}
             
-            kmerVector[i] += kmerProfile[i];
+            kmerVector[kmers[i]]++;
         }
         
         numSeqs++;
@@ -89,7 +89,7 @@ string KmerNode::getKmerBases(int kmerNumber){
 
 /**************************************************************************************************/
 
-void KmerNode::addThetas(vector<int> newTheta, int newNumSeqs){
+void KmerNode::addThetas(vector<int>& newTheta, int newNumSeqs){
 	try {
         for(int i=0;i<numPossibleKmers;i++){
             if (m->control_pressed) { break; }
@@ -163,18 +163,19 @@ void KmerNode::printTheta(){
 }
 /**************************************************************************************************/
 
-double KmerNode::getSimToConsensus(vector<int>& queryKmerProfile){
+double KmerNode::getSimToConsensus(vector<int>& queryKmers){
 	try {
         double present = 0;
         
-        for(int i=0;i<numPossibleKmers;i++){
+        for(int i=0;i<queryKmers.size();i++){
             if (m->control_pressed) { return present; }
-            if(queryKmerProfile[i] != 0 && kmerVector[i] != 0){
+            if(kmerVector[queryKmers[i]] != 0){
                 present++;
             }
         }	
         
-        return present / double(queryKmerProfile.size() - kmerSize + 1);
+        //	the dense query profile this used to take had numPossibleKmers+1 entries
+        return present / double(numPossibleKmers + 1 - kmerSize + 1);
     }
 	catch(exception& e) {
 		m->errorOut(e, "KmerNode", "getSimToConsensus");
@@ -184,18 +185,31 @@ double KmerNode::getSimToConsensus(vector<int>& queryKmerProfile){
 
 /**********************************************************************************************************************/
 
-double KmerNode::getPxGivenkj_D_j(vector<int>& queryKmerProfile)	{	
+void KmerNode::setLogProbs(){
 	try {
-        double sumLogProb = 0.0000;
         double alpha = 1.0 / (double)totalSeqs;	//flat prior
         //	double alpha = pow((1.0 / (double)numUniqueKmers), numSeqs)+0.0001;	//non-flat prior
         
-        for(int i=0;i<numPossibleKmers;i++){
-            if (m->control_pressed) { return sumLogProb; }
-            if(queryKmerProfile[i] != 0){		//numUniqueKmers needs to be the value from Root;
-                sumLogProb += log((kmerVector[i] + alpha) / (numSeqs + numUniqueKmers * alpha));
-            }
-            
+        //	a kmer can be in at most every sequence in the node
+        logProbs.resize(numSeqs + 1);
+        for(int i=0;i<=numSeqs;i++){	//numUniqueKmers needs to be the value from Root;
+            logProbs[i] = log((i + alpha) / (numSeqs + numUniqueKmers * alpha));
+        }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "KmerNode", "setLogProbs");
+		exit(1);
+	}
+}
+
+/**********************************************************************************************************************/
+
+double KmerNode::getPxGivenkj_D_j(vector<int>& queryKmers)	{	
+	try {
+        double sumLogProb = 0.0000;
+        
+        for(int i=0;i<queryKmers.size();i++){
+            sumLogProb += logProbs[kmerVector[queryKmers[i]]];
         }
         return sumLogProb;
     }
@@ -19,15 +19,16 @@ class KmerNode : public TaxonomyNode {
 	
 public:
 	KmerNode(string, int, int);
-	void loadSequence(vector<int>&);
+	void loadSequence(vector<int>&);			//	sorted kmers present in the sequence
 	void printTheta();
-	double getPxGivenkj_D_j(vector<int>&);
+	double getPxGivenkj_D_j(vector<int>&);		//	sorted kmers present in the query
 	double getSimToConsensus(vector<int>&);
 	void checkTheta(){};
 	void setNumUniqueKmers(int num)	{	numUniqueKmers = num;	}
 	int getNumUniqueKmers();
-	void addThetas(vector<int>, int);
-	vector<int> getTheta()	{	return kmerVector;	}
+	void addThetas(vector<int>&, int);
+	vector<int>& getTheta()	{	return kmerVector;	}
+	void setLogProbs();							//	call once numUniqueKmers and totalSeqs are set
 
 
 private:
@@ -37,6 +38,7 @@ private:
 	int numUniqueKmers;							//	number of unique kmers seen in a group ~ O_kj
 	int numKmers;								//	number of kmers in a sequence
 	vector<int> kmerVector;						//	counts of kmers across all sequences in a node
+	vector<double> logProbs;					//	log probability of a kmer seen in count sequences, indexed by count
 };
 
 /**********************************************************************************************************************/
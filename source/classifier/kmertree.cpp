@@ -37,7 +37,7 @@ KmerTree::KmerTree(string referenceFileName, string taxonomyFileName, int k, int
                 
                 if (it != taxonomy.end()) {
                     refTaxonomy = it->second;		//	lookup the taxonomy string for the current reference sequence
-                    vector<int> kmerProfile = ripKmerProfile(seq.getUnaligned());	//convert to kmer vector
+                    vector<int> kmerProfile = ripKmerProfile(seq.getUnaligned());	//convert to sorted kmer list
                     addTaxonomyToTree(seq.getName(), refTaxonomy, kmerProfile);
                 }else {
                     m->mothurOut(seq.getName() + " is in your reference file, but not in your taxonomy file, please correct.\n"); error = true;
@@ -64,6 +64,7 @@ KmerTree::KmerTree(string referenceFileName, string taxonomyFileName, int k, int
             tree[i]->checkTheta();
             tree[i]->setNumUniqueKmers(tree[0]->getNumUniqueKmers());
             tree[i]->setTotalSeqs(dbSize);
+            tree[i]->setLogProbs();
         }
     }
 	catch(exception& e) {
@@ -83,6 +84,7 @@ KmerTree::~KmerTree(){
 }	
 /**********************************************************************************************************************/
 
+//returns the kmers present in the sequence, sorted and without repeats. Kmers with an N in them are left out
 vector<int> KmerTree::ripKmerProfile(string sequence){
     try {
         //	assume all input sequences are unaligned
@@ -91,7 +93,8 @@ vector<int> KmerTree::ripKmerProfile(string sequence){
         
         int nKmers = (int)sequence.length() - kmerSize + 1;
         
-        vector<int> kmerProfile(numPossibleKmers + 1, 0);
+        vector<int> kmers;
+        if (nKmers > 0) { kmers.reserve(nKmers); }
         
         for(int i=0;i<nKmers;i++){
             
@@ -106,10 +109,13 @@ vector<int> KmerTree::ripKmerProfile(string sequence){
                 else if(toupper(sequence[j+i]) == 'T')	{	kmer += (3 * power4s[kmerSize-j-1]);	}
                 else									{	kmer = power4s[kmerSize]; j = kmerSize;	}
             }
-            kmerProfile[kmer] = 1;
+            if (kmer != numPossibleKmers) { kmers.push_back(kmer); }
         }
         
-        return kmerProfile;	
+        sort(kmers.begin(), kmers.end());
+        kmers.erase(unique(kmers.begin(), kmers.end()), kmers.end());
+        
+        return kmers;	
     }
 	catch(exception& e) {
 		m->errorOut(e, "KmerTree", "ripKmerProfile");
@@ -272,7 +278,7 @@ string KmerTree::getTaxonomy(Sequence* thisSeq){
         
         double logPOutlier = (querySequence.length() - kmerSize + 1) * log(1.0/(double)tree[0]->getNumUniqueKmers());
         
-        vector<int> queryProfile = ripKmerProfile(unalignedSeq);	//convert to kmer vector
+        vector<int> queryProfile = ripKmerProfile(unalignedSeq);	//convert to sorted kmer list
         
         vector<vector<double> > pXgivenKj_D_j(numLevels);
         vector<vector<int> > indices(numLevels);
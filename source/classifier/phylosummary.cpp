@@ -35,6 +35,7 @@ PhyloSummary::PhyloSummary(string refTfile, CountTable* c, bool r, int p){
 		tree[0].rank = "0";
 		assignRank(0);
         
+        setGroups();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloSummary", "PhyloSummary");
@@ -58,6 +59,8 @@ PhyloSummary::PhyloSummary(CountTable* c, bool r, int p){
 		
 		tree.push_back(rawTaxNode("Root"));
 		tree[0].rank = "0";
+        
+        setGroups();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloSummary", "PhyloSummary");
@@ -89,7 +92,8 @@ PhyloSummary::PhyloSummary(string refTfile, GroupMap* g, bool r, int p){
 		
 		tree[0].rank = "0";
 		assignRank(0);
-
+        
+        setGroups();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloSummary", "PhyloSummary");
@@ -113,6 +117,8 @@ PhyloSummary::PhyloSummary(GroupMap* g, bool r, int p){
 		
 		tree.push_back(rawTaxNode("Root"));
 		tree[0].rank = "0";
+        
+        setGroups();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloSummary", "PhyloSummary");
@@ -165,137 +171,38 @@ int PhyloSummary::addSeqToTree(string seqName, string seqTaxonomy){
 				
 		numSeqs++;
 		
-		map<string, int>::iterator childPointer;
+		//are there confidence scores, if so remove them
+		if (seqTaxonomy.find_first_of('(') != -1) {  m->removeConfidences(seqTaxonomy);	}
 		
-		int currentNode = 0;
-		string taxon;
+		int index = getLineage(seqTaxonomy);
 		
-		int level = 0;
+		if (m->control_pressed) { return 0; }
 		
-		//are there confidence scores, if so remove them
-		if (seqTaxonomy.find_first_of('(') != -1) {  m->removeConfidences(seqTaxonomy);	}
+		if (lineages[index].missingTaxon != "") {
+			m->mothurOut("Warning: cannot find taxon " + lineages[index].missingTaxon + " in reference taxonomy tree at level " + toString(lineages[index].missingLevel) + " for " + seqName + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
+		}
 		
-		while (seqTaxonomy != "") {
-			
-			if (m->control_pressed) { return 0; }
-			
-			//somehow the parent is getting one too many accnos
-			//use print to reassign the taxa id
-			taxon = getNextTaxon(seqTaxonomy);
-			
-			childPointer = tree[currentNode].children.find(taxon);
+		int thisCount = 1;
+		
+		if (groupmap != NULL) {
+			//find out the sequences group
+			string group = groupmap->getGroup(seqName);
 			
-			if(childPointer != tree[currentNode].children.end()){	//if the node already exists, update count and move on
-				int thisCount = 1;
-                
-                if (groupmap != NULL) {
-					//find out the sequences group
-					string group = groupmap->getGroup(seqName);
-					
-					if (group == "not found") {  m->mothurOut("[WARNING]: " + seqName + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
-					
-					//do you have a count for this group?
-					map<string, int>::iterator itGroup = tree[childPointer->second].groupCount.find(group);
-					
-					//if yes, increment it - there should not be a case where we can't find it since we load group in read
-					if (itGroup != tree[childPointer->second].groupCount.end()) {
-						tree[childPointer->second].groupCount[group]++;
-					}
-				}else if (ct != NULL) {
-                    if (ct->hasGroupInfo()) {
-                        vector<int> groupCounts = ct->getGroupCounts(seqName);
-                        vector<string> groups = ct->getNamesOfGroups();
-                        for (int i = 0; i < groups.size(); i++) {
-                            
-                            if (groupCounts[i] != 0) {
-                                //do you have a count for this group?
-                                map<string, int>::iterator itGroup = tree[childPointer->second].groupCount.find(groups[i]);
-                                
-                                //if yes, increment it - there should not be a case where we can't find it since we load group in read
-                                if (itGroup != tree[childPointer->second].groupCount.end()) {
-                                    tree[childPointer->second].groupCount[groups[i]] += groupCounts[i];
-                                }
-                            }
-                        }
-                    }
-                    thisCount = ct->getNumSeqs(seqName);
-                }
-				
-				tree[childPointer->second].total += thisCount;
-
-				currentNode = childPointer->second;
-			}else{	
-				if (ignore) {
-						
-					tree.push_back(rawTaxNode(taxon));
-					int index = tree.size() - 1;
-				
-					tree[index].parent = currentNode;
-					tree[index].level = (level+1);
-					tree[currentNode].children[taxon] = index;
-                    int thisCount = 1;
-					
-					//initialize groupcounts
-					if (groupmap != NULL) {
-						vector<string> mGroups = groupmap->getNamesOfGroups();
-						for (int j = 0; j < mGroups.size(); j++) {
-							tree[index].groupCount[mGroups[j]] = 0;
-						}
-						
-						//find out the sequences group
-						string group = groupmap->getGroup(seqName);
-						
-						if (group == "not found") {  m->mothurOut("[WARNING]: " + seqName + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
-						
-						//do you have a count for this group?
-						map<string, int>::iterator itGroup = tree[index].groupCount.find(group);
-						
-						//if yes, increment it - there should not be a case where we can't find it since we load group in read
-						if (itGroup != tree[index].groupCount.end()) {
-							tree[index].groupCount[group]++;
-						}
-					}else if (ct != NULL) {
-                        if (ct->hasGroupInfo()) {
-                            vector<string> mGroups = ct->getNamesOfGroups();
-                            for (int j = 0; j < mGroups.size(); j++) {
-                                tree[index].groupCount[mGroups[j]] = 0;
-                            }
-                            vector<int> groupCounts = ct->getGroupCounts(seqName);
-                            vector<string> groups = ct->getNamesOfGroups();
-                        
-                            for (int i = 0; i < groups.size(); i++) {
-                                if (groupCounts[i] != 0) {
-                                   
-                                    //do you have a count for this group?
-                                    map<string, int>::iterator itGroup = tree[index].groupCount.find(groups[i]);
-                                     
-                                    //if yes, increment it - there should not be a case where we can't find it since we load group in read
-                                    if (itGroup != tree[index].groupCount.end()) {
-                                        tree[index].groupCount[groups[i]]+=groupCounts[i];
-                                    }
-                                }
-                            }
-                        }
-                        thisCount = ct->getNumSeqs(seqName);
-                    }
-					
-                    tree[index].total = thisCount;
-					currentNode = index;
-					
-				}else{ //otherwise, error
-					m->mothurOut("Warning: cannot find taxon " + taxon + " in reference taxonomy tree at level " + toString(tree[currentNode].level) + " for " + seqName + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
-					break;
-				}
-			}
+			if ((group == "not found") && (lineages[index].nodes.size() != 0)) {  m->mothurOut("[WARNING]: " + seqName + " is not in your groupfile, and will be included in the overall total, but not any group total."); m->mothurOutEndLine();  }
 			
-			level++;
-            
-            if (level > maxLevel) { maxLevel = level; }
+			map<string, int>::iterator itGroup = groupIndex.find(group);
+			if (itGroup != groupIndex.end()) { lineageGroupCounts[index][itGroup->second]++; }
 			
-			if ((seqTaxonomy == "") && (level < maxLevel)) {  //if you think you are done and you are not.
-				for (int k = level; k < maxLevel; k++) {  seqTaxonomy += "unclassified;";   }
+		}else if (ct != NULL) {
+			if (ct->hasGroupInfo()) {
+				vector<int> groupCounts = ct->getGroupCounts(seqName);
+				for (int i = 0; i < groupCounts.size(); i++) { lineageGroupCounts[index][i] += groupCounts[i]; }
 			}
+			thisCount = ct->getNumSeqs(seqName);
 		}
+		
+		lineageTotals[index] += thisCount;
+		
 		return 0;
 	}
 	catch(exception& e) {
@@ -309,6 +216,87 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 	try {
 		numSeqs++;
 		
+		//are there confidence scores, if so remove them
+		if (seqTaxonomy.find_first_of('(') != -1) {  m->removeConfidences(seqTaxonomy);	}
+		
+		int index = getLineage(seqTaxonomy);
+		
+		if (m->control_pressed) { return 0; }
+		
+		if (lineages[index].missingTaxon != "") {
+			m->mothurOut("Warning: cannot find taxon " + lineages[index].missingTaxon + " in reference taxonomy tree at level " + toString(lineages[index].missingLevel) + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
+		}
+		
+		//groups we are not printing are not counted
+		for (map<string, bool>::iterator itGroup = containsGroup.begin(); itGroup != containsGroup.end(); itGroup++) {
+			if (itGroup->second == true) {
+				map<string, int>::iterator itIndex = groupIndex.find(itGroup->first);
+				if (itIndex != groupIndex.end()) { lineageGroupCounts[index][itIndex->second]++; }
+			}
+		}
+		
+		lineageTotals[index]++;
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "addSeqToTree");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the groups printed, in the order they are printed
+void PhyloSummary::setGroups(){
+	try {
+		groupNames.clear(); groupIndex.clear();
+		
+		if (groupmap != NULL) { groupNames = groupmap->getNamesOfGroups(); }
+		else if (ct != NULL) { if (ct->hasGroupInfo()) { groupNames = ct->getNamesOfGroups(); } }
+		
+		for (int i = 0; i < groupNames.size(); i++) { groupIndex[groupNames[i]] = i; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "setGroups");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//index of the lineage for this taxonomy, resolving it against the tree the first time it is seen
+int PhyloSummary::getLineage(string& seqTaxonomy){
+	try {
+		map<string, int>::iterator it = lineageIndex.find(seqTaxonomy);
+		
+		if (it == lineageIndex.end()) {
+			int index = lineages.size();
+			lineageIndex[seqTaxonomy] = index;
+			lineages.push_back(taxLineage());
+			lineageTotals.push_back(0);
+			lineageGroupCounts.push_back(vector<int>(groupNames.size(), 0));
+			resolveLineage(seqTaxonomy, lineages[index]);
+			return index;
+		}
+		
+		//short taxonomies are padded with unclassified to the deepest level seen so far, so if that has grown since, resolve it again.
+		//the sequences already counted stay on the shorter path
+		taxLineage& lineage = lineages[it->second];
+		if ((lineage.missingTaxon == "") && (lineage.nodes.size() < maxLevel)) {
+			addLineageCounts(it->second);
+			resolveLineage(seqTaxonomy, lineage);
+		}
+		
+		return it->second;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "getLineage");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void PhyloSummary::resolveLineage(string seqTaxonomy, taxLineage& lineage){
+	try {
+		lineage.nodes.clear(); lineage.missingTaxon = ""; lineage.missingLevel = 0;
+		
 		map<string, int>::iterator childPointer;
 		
 		int currentNode = 0;
@@ -316,12 +304,9 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 		
 		int level = 0;
 		
-		//are there confidence scores, if so remove them
-		if (seqTaxonomy.find_first_of('(') != -1) {  m->removeConfidences(seqTaxonomy);	}
-		
 		while (seqTaxonomy != "") {
 			
-			if (m->control_pressed) { return 0; }
+			if (m->control_pressed) { return; }
 			
 			//somehow the parent is getting one too many accnos
 			//use print to reassign the taxa id
@@ -329,15 +314,7 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 			
 			childPointer = tree[currentNode].children.find(taxon);
 			
-			if(childPointer != tree[currentNode].children.end()){	//if the node already exists, update count and move on
-                for (map<string, bool>::iterator itGroup = containsGroup.begin(); itGroup != containsGroup.end(); itGroup++) {
-                    if (itGroup->second == true) {
-                        tree[childPointer->second].groupCount[itGroup->first]++;
-                    }
-                }
-					
-				tree[childPointer->second].total++;
-				
+			if(childPointer != tree[currentNode].children.end()){	//if the node already exists, move on
 				currentNode = childPointer->second;
 			}else{	
 				if (ignore) {
@@ -347,23 +324,23 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 					
 					tree[index].parent = currentNode;
 					tree[index].level = (level+1);
-					tree[index].total = 1;
+					tree[index].total = 0;
 					tree[currentNode].children[taxon] = index;
-						
-                    for (map<string, bool>::iterator itGroup = containsGroup.begin(); itGroup != containsGroup.end(); itGroup++) {
-                        if (itGroup->second == true) {
-                            tree[index].groupCount[itGroup->first]++;
-                        }
-                    }
+					
+					//initialize groupcounts
+					for (int j = 0; j < groupNames.size(); j++) { tree[index].groupCount[groupNames[j]] = 0; }
 					
 					currentNode = index;
 					
 				}else{ //otherwise, error
-					m->mothurOut("Warning: cannot find taxon " + taxon + " in reference taxonomy tree at level " + toString(tree[currentNode].level) + ". This may cause totals of daughter levels not to add up in summary file."); m->mothurOutEndLine();
+					lineage.missingTaxon = taxon;
+					lineage.missingLevel = tree[currentNode].level;
 					break;
 				}
 			}
 			
+			lineage.nodes.push_back(currentNode);
+			
 			level++;
             
             if (level > maxLevel) { maxLevel = level; }
@@ -372,14 +349,64 @@ int PhyloSummary::addSeqToTree(string seqTaxonomy, map<string, bool> containsGro
 				for (int k = level; k < maxLevel; k++) {  seqTaxonomy += "unclassified;";   }
 			}
 		}
-		return 0;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "PhyloSummary", "addSeqToTree");
+		m->errorOut(e, "PhyloSummary", "resolveLineage");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//moves one lineage's counts onto its nodes
+void PhyloSummary::addLineageCounts(int index){
+	try {
+		if (lineageTotals[index] == 0) { return; }
+		
+		for (int j = 0; j < lineages[index].nodes.size(); j++) {
+			int node = lineages[index].nodes[j];
+			tree[node].total += lineageTotals[index];
+			for (int k = 0; k < groupNames.size(); k++) { tree[node].groupCount[groupNames[k]] += lineageGroupCounts[index][k]; }
+		}
+		
+		lineageTotals[index] = 0;
+		for (int k = 0; k < groupNames.size(); k++) { lineageGroupCounts[index][k] = 0; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "addLineageCounts");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//moves the lineage counts onto every node of each lineage
+void PhyloSummary::addLineageCounts(){
+	try {
+		vector< vector<int> > nodeGroupCounts; nodeGroupCounts.resize(tree.size());
+		
+		for (int i = 0; i < lineages.size(); i++) {
+			if (lineageTotals[i] == 0) { continue; }
+			
+			for (int j = 0; j < lineages[i].nodes.size(); j++) {
+				int node = lineages[i].nodes[j];
+				tree[node].total += lineageTotals[i];
+				
+				if (groupNames.size() != 0) {
+					if (nodeGroupCounts[node].size() == 0) { nodeGroupCounts[node].resize(groupNames.size(), 0); }
+					for (int k = 0; k < groupNames.size(); k++) { nodeGroupCounts[node][k] += lineageGroupCounts[i][k]; }
+				}
+			}
+			
+			lineageTotals[i] = 0;
+			for (int k = 0; k < groupNames.size(); k++) { lineageGroupCounts[i][k] = 0; }
+		}
+		
+		for (int i = 0; i < nodeGroupCounts.size(); i++) {
+			for (int k = 0; k < nodeGroupCounts[i].size(); k++) { tree[i].groupCount[groupNames[k]] += nodeGroupCounts[i][k]; }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloSummary", "addLineageCounts");
 		exit(1);
 	}
 }
-
 /**************************************************************************************************/
 
 void PhyloSummary::assignRank(int index){
@@ -446,6 +473,8 @@ string PhyloSummary::getTaxons(vector<int> indexes, int index, int i, string& ta
 void PhyloSummary::print(ofstream& out, string output){
 	try {
 		
+		addLineageCounts();
+        
 		if (ignore)     {  assignRank(0); }
         vector<string> mGroups;
         
@@ -551,6 +580,8 @@ void PhyloSummary::print(ofstream& out, string output){
 void PhyloSummary::print(ofstream& out, bool relabund){
 	try {
 		
+		addLineageCounts();
+        
 		if (ignore) { assignRank(0); }
 	
 		int totalChildrenInTree = 0;
@@ -28,6 +28,16 @@ struct rawTaxNode {
 	rawTaxNode(){}
 };
 
+/**************************************************************************************************/
+//a taxonomy string resolved to the nodes it counts toward, so each distinct string is only parsed once
+struct taxLineage {
+	vector<int> nodes;  //tree index at each level
+	string missingTaxon; //first taxon not in the reference tree, "" if the whole string was found
+	int missingLevel;
+	
+	taxLineage() : missingTaxon(""), missingLevel(0) {}
+};
+
 /**************************************************************************************************/
 class PhyloSummary {
 
@@ -54,6 +64,20 @@ private:
     string getTaxons(vector<int> indexes, int index, int i, string&);
 	void readTreeStruct(ifstream&);
     string findTaxon(string);
+	
+	//counts are kept per lineage and per group index, and added to the tree nodes when it is printed
+	map<string, int> lineageIndex; //taxonomy -> index into lineages
+	vector<taxLineage> lineages;
+	vector<int> lineageTotals;
+	vector< vector<int> > lineageGroupCounts;
+	vector<string> groupNames;
+	map<string, int> groupIndex;
+	void setGroups();
+	int getLineage(string&);
+	void resolveLineage(string, taxLineage&);
+	void addLineageCounts();
+	void addLineageCounts(int);
+	
 	GroupMap* groupmap;
     CountTable* ct;
 	bool ignore, relabund;
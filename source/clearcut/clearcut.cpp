@@ -77,14 +77,7 @@
 int clearcut_main(int argc, char *argv[]) {
 
   DMAT *dmat;         /* The working distance matrix */
-  DMAT *dmat_backup = NULL;/* A backup distance matrix    */
-  NJ_TREE *tree;      /* The phylogenetic tree       */
   NJ_ARGS *nj_args;   /* Structure for holding command-line arguments */
-  long int i;
-
-  /* some variables for tracking time */
-  struct timeval tv;
-  unsigned long long startUs, endUs;
   
 
   /* check and parse supplied command-line arguments */
@@ -143,6 +136,45 @@ int clearcut_main(int argc, char *argv[]) {
     NJ_output_matrix(nj_args, dmat);
   }
   
+  return(NJ_run(nj_args, dmat));
+}
+
+
+
+
+/*
+ * NJ_run() - Build and output the requested trees from a distance matrix
+ *
+ * INPUTS:
+ * -------
+ *    nj_args -- The arguments, filled in by NJ_handle_args() or by the caller
+ *       dmat -- A distance matrix already in memory, which NJ_run() frees
+ *
+ * RETURNS:
+ * --------
+ *      <int> -- 0 on success, -1 if a tree could not be built
+ *
+ * DESCRIPTION:
+ * ------------
+ *
+ * This is the part of clearcut_main() after the distance matrix
+ * has been parsed or built, so a caller that already has its
+ * arguments can skip the command-line round trip.  The PRNG
+ * should be seeded with init_genrand() before the matrix is made.
+ *
+ */
+int
+NJ_run(NJ_ARGS *nj_args,
+       DMAT *dmat) {
+
+  DMAT *dmat_backup = NULL;/* A backup distance matrix    */
+  NJ_TREE *tree;      /* The phylogenetic tree       */
+  long int i;
+
+  /* some variables for tracking time */
+  struct timeval tv;
+  unsigned long long startUs, endUs;
+
   /* 
    * If we are going to generate multiple trees from
    * the same distance matrix, we need to make a backup 
@@ -181,7 +213,11 @@ int clearcut_main(int argc, char *argv[]) {
   
     if(!tree) {
       fprintf(stderr, "Clearcut: Failed to construct tree.\n");
-      exit(0);
+      NJ_free_dmat(dmat);
+      if(dmat_backup) {
+	NJ_free_dmat(dmat_backup);
+      }
+      return(-1);
     }
 
     /* RECORD THE PRECISE TIME OF THE END OF THE NEIGHBOR-JOINING */
@@ -2116,6 +2152,8 @@ NJ_min_transform(DMAT *dmat,
   long int tmp_j = 0;/* to limit pointer dereferencing  */
   float smallest;  /* track the smallest trans. dist  */
   float curval;    /* the current trans. dist in loop */
+  float r2i;       /* r2 of the current row */
+  int below;       /* set if the row holds a value below the known minimum */
 
   float *ptr;      /* pointer into distance matrix    */
   float *r2;       /* pointer to r2 matrix for computing transformed dists */
@@ -2129,19 +2167,36 @@ NJ_min_transform(DMAT *dmat,
   /* for every row */
   for(i=0;i<dmat->size;i++) {
     ptr++;  /* skip diagonal */
-    for(j=i+1;j<dmat->size;j++) {   /* for every column */
+    r2i = r2[i];
 
-      /* find transformed distance in matrix at i, j */
-      curval = *(ptr++) - (r2[i] + r2[j]);
+    /* 
+     * first check whether anything on the row beats the known minimum.
+     * This loop has no branches, so the compiler can vectorize it, and
+     * only the few rows which hold a new minimum are scanned again 
+     * in order, which picks the same join as scanning every row.
+     */
+    below = 0;
+    for(j=i+1;j<dmat->size;j++) {
+      below |= ((ptr[j-i-1] - (r2i + r2[j])) < smallest);
+    }
+
+    if(below) {
+      for(j=i+1;j<dmat->size;j++) {   /* for every column */
+
+	/* find transformed distance in matrix at i, j */
+	curval = ptr[j-i-1] - (r2i + r2[j]);
 
-      /* if the transformed distanance is less than the known minimum */
-      if(curval < smallest) {
+	/* if the transformed distanance is less than the known minimum */
+	if(curval < smallest) {
 
-	smallest = curval;
-	tmp_i = i;
-	tmp_j = j;
+	  smallest = curval;
+	  tmp_i = i;
+	  tmp_j = j;
+	}
       }
     }
+
+    ptr += dmat->size - i - 1;
   }
   
   /* pass back (by reference) the coords of the min. transformed distance */
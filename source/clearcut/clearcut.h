@@ -187,6 +187,10 @@ typedef struct _STRUCT_NJ_VERTEX {
 /* some function prototypes */
 int clearcut_main(int, char**);  
 
+/* build and output the trees from a distance matrix already in memory */
+int
+NJ_run(NJ_ARGS *nj_args, DMAT *dmat);
+
 /* core function for performing Relaxed Neighbor Joining */
 NJ_TREE *
 NJ_relaxed_nj(NJ_ARGS *nj_args, DMAT *dmat);
@@ -108,28 +108,7 @@ NJ_handle_args(int argc,
   };
   
   /* initializes options to their default */
-  nj_args.infilename       = NULL;
-  nj_args.outfilename      = NULL;
-  nj_args.matrixout        = NULL;
-  nj_args.seed             = time(0);
-  nj_args.verbose_flag     = 0;
-  nj_args.quiet_flag       = 0;
-  nj_args.input_mode       = NJ_INPUT_MODE_DISTANCE;
-  nj_args.help             = 0;
-  nj_args.version          = 0;
-  nj_args.norandom         = 0;
-  nj_args.shuffle          = 0;
-  nj_args.stdin_flag       = 0;
-  nj_args.stdout_flag      = 0;
-  nj_args.dna_flag         = 0;
-  nj_args.protein_flag     = 0;
-  nj_args.correction_model = NJ_MODEL_NONE;
-  nj_args.jukes_flag       = 0;
-  nj_args.kimura_flag      = 0;
-  nj_args.neighbor         = 0;
-  nj_args.ntrees           = 1;
-  nj_args.expblen          = 0;
-  nj_args.expdist          = 0;
+  NJ_init_args(&nj_args);
 
   while(1) {
 
@@ -400,6 +379,44 @@ NJ_handle_args(int argc,
 
 
 
+/*
+ * NJ_init_args() - Set every option to its default
+ *
+ * Used by NJ_handle_args() and by callers that fill in 
+ * the arguments themselves before calling NJ_run().
+ *
+ */
+void
+NJ_init_args(NJ_ARGS *nj_args) {
+  
+  nj_args->infilename       = NULL;
+  nj_args->outfilename      = NULL;
+  nj_args->matrixout        = NULL;
+  nj_args->seed             = time(0);
+  nj_args->verbose_flag     = 0;
+  nj_args->quiet_flag       = 0;
+  nj_args->input_mode       = NJ_INPUT_MODE_DISTANCE;
+  nj_args->aligned_flag     = 0;
+  nj_args->help             = 0;
+  nj_args->version          = 0;
+  nj_args->norandom         = 0;
+  nj_args->shuffle          = 0;
+  nj_args->stdin_flag       = 0;
+  nj_args->stdout_flag      = 0;
+  nj_args->dna_flag         = 0;
+  nj_args->protein_flag     = 0;
+  nj_args->correction_model = NJ_MODEL_NONE;
+  nj_args->jukes_flag       = 0;
+  nj_args->kimura_flag      = 0;
+  nj_args->neighbor         = 0;
+  nj_args->ntrees           = 1;
+  nj_args->expblen          = 0;
+  nj_args->expdist          = 0;
+}
+
+
+
+
 
 /*
  * NJ_print_args() - 
@@ -102,6 +102,9 @@ NJ_ARGS *
 NJ_handle_args(int argc,
 	       char *argv[]);
 
+void
+NJ_init_args(NJ_ARGS *nj_args);
+
 void
 NJ_print_args(NJ_ARGS *nj_args);
 
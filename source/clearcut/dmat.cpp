@@ -162,7 +162,7 @@ static inline
 int
 NJ_is_distance(char *token) {
   
-  int i;
+  int i, len;
   char c;
   int exponent_state;
   int expsign_state;
@@ -172,6 +172,8 @@ NJ_is_distance(char *token) {
   if(!token) {
     return(0);
   }
+
+  len = strlen(token);
   
   exponent_state = 0;
   expsign_state  = 0;
@@ -191,13 +193,13 @@ NJ_is_distance(char *token) {
    * if the first character is not a number, and string is only one 
    * character long, then we return failure.
    */
-  if(strlen(token) == 1) {
+  if(len == 1) {
     if(!NJ_is_number(c)) {
       goto BAD;
     }
   }
   
-  for(i=0;i<strlen(token);i++) {
+  for(i=0;i<len;i++) {
 
     c = token[i];
     
@@ -277,7 +279,7 @@ NJ_is_distance(char *token) {
   }
   
   /* the token must end in a number char */
-  if(!NJ_is_number(token[strlen(token)-1])) {
+  if(!NJ_is_number(token[len-1])) {
     goto BAD;
   }
   
@@ -311,6 +313,31 @@ NJ_is_label(char *token) {
 
 
 
+/*
+ * NJ_getc() - get the next character from the input buffer, refilling 
+ *             it from the stream when it runs out.  Returns -1 at the
+ *             end of the input.
+ *
+ */
+static inline
+int
+NJ_getc(FILE *fp,
+	NJ_DIST_BUFFER *inbuf) {
+
+  if(inbuf->pos == inbuf->len) {
+    inbuf->len = fread(inbuf->buf, sizeof(char), NJ_READ_BUFSIZE, fp);
+    inbuf->pos = 0;
+    if(inbuf->len <= 0) {
+      inbuf->len = 0;
+      return(-1);
+    }
+  }
+
+  return((unsigned char)inbuf->buf[inbuf->pos++]);
+}
+
+
+
 /*
  * NJ_get_token() - get a token from an input stream 
  *
@@ -318,16 +345,19 @@ NJ_is_label(char *token) {
 static inline
 int
 NJ_get_token(FILE *fp,
+	     NJ_DIST_BUFFER *inbuf,
 	     NJ_DIST_TOKEN *token) {
 
+  int next;
   char c;
   int index;
 
-  c = fgetc(fp);
-  if(feof(fp)) {
+  next = NJ_getc(fp, inbuf);
+  if(next == -1) {
     token->type = NJ_EOF_STATE;
     return(token->type);
   }
+  c = (char)next;
 
   if(NJ_is_whitespace(c)) {
     token->buf[0] = c;
@@ -352,11 +382,12 @@ NJ_get_token(FILE *fp,
 
     token->buf[index++] = c;
     
-    c = fgetc(fp);
-    if(feof(fp)) {
+    next = NJ_getc(fp, inbuf);
+    if(next == -1) {
       token->type = NJ_EOF_STATE;
       break;
     }
+    c = (char)next;
   }
   
   token->buf[index] = '\0';
@@ -437,6 +468,7 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
   DMAT *dmat           = NULL;
   FILE *fp            = NULL;
   NJ_DIST_TOKEN *token = NULL;
+  NJ_DIST_BUFFER inbuf;
 
   int state, dmat_type;
   int row;
@@ -448,14 +480,17 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
   int first_state = 0;
 
 
-  /* allocate our distance matrix and token structure */
+  /* allocate our distance matrix, token structure and input buffer */
+  inbuf.len = 0;
+  inbuf.pos = 0;
+  inbuf.buf = (char *)calloc(NJ_READ_BUFSIZE, sizeof(char));
   dmat = (DMAT *)calloc(1, sizeof(DMAT));
   token = (NJ_DIST_TOKEN *)calloc(1, sizeof(NJ_DIST_TOKEN));
   if(token) {
     token->bufsize = NJ_INITIAL_BUFSIZE;
     token->buf     = (char *)calloc(token->bufsize, sizeof(char));
   }
-  if(!dmat || !token || !token->buf) {
+  if(!dmat || !token || !token->buf || !inbuf.buf) {
     fprintf(stderr, "Clearcut: Memory allocation error in NJ_parse_distance_matrix()\n");
     goto XIT_BAD;
   }
@@ -506,7 +541,7 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
 
 
   /* read the input one character at a time to drive simple state machine */
-  state = NJ_get_token(fp, token);
+  state = NJ_get_token(fp, &inbuf, token);
   while(state != NJ_EOF_STATE) {
     
     switch(state) {
@@ -667,7 +702,7 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
     }
 
     /* get next token from stream */
-    state = NJ_get_token(fp, token);
+    state = NJ_get_token(fp, &inbuf, token);
   }
 
 
@@ -713,6 +748,7 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
     }
     free(token);
   }
+  free(inbuf.buf);
 
   return(dmat);
 
@@ -722,7 +758,7 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
  XIT_BAD:
 
   if(fp) {
-    fprintf(stderr, "Clearcut: Syntax error in distance matrix at offset %ld.\n", ftell(fp));
+    fprintf(stderr, "Clearcut: Syntax error in distance matrix at offset %ld.\n", ftell(fp) - (inbuf.len - inbuf.pos));
   }
 
   /* close matrix file here */
@@ -743,6 +779,9 @@ NJ_parse_distance_matrix(NJ_ARGS *nj_args) {
     }
     free(token);
   }
+  if(inbuf.buf) {
+    free(inbuf.buf);
+  }
   
   return(NULL);
 }
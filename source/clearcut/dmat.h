@@ -58,6 +58,7 @@ extern "C" {
 
 
 #define NJ_INITIAL_BUFSIZE 32
+#define NJ_READ_BUFSIZE    65536
 
 #define NJ_NAME_STATE  100
 #define NJ_FLOAT_STATE 101
@@ -80,6 +81,16 @@ typedef struct _NJ_DIST_TOKEN_STRUCT {
 } NJ_DIST_TOKEN;
 
 
+/* the input is read a block at a time instead of with fgetc() */
+typedef struct _NJ_DIST_BUFFER_STRUCT {
+
+  char *buf;
+  long int len;
+  long int pos;
+
+} NJ_DIST_BUFFER;
+
+
 
 /* some function prototypes */
 
@@ -295,6 +295,9 @@ int AlignCommand::execute(){
 	try {
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 
+		Profiler* profiler = Profiler::getInstance();
+		profiler->startPhase("read template");
+		
 		templateDB = new AlignmentDB(templateFileName, search, kmerSize, gapOpen, gapExtend, match, misMatch, rand());
 		
 		for (int s = 0; s < candidateFileNames.size(); s++) {
@@ -336,11 +339,14 @@ int AlignCommand::execute(){
 			}
 		#endif
 			
+			profiler->startPhase("align");
 			if(processors == 1){
 				numFastaSeqs = driver(lines[0], alignFileName, reportFileName, accnosFileName, candidateFileNames[s]);
 			}else{
 				numFastaSeqs = createProcesses(alignFileName, reportFileName, accnosFileName, candidateFileNames[s]); 
 			}
+			profiler->addRecords(numFastaSeqs);
+			profiler->endPhase();
 				
 			if (m->control_pressed) { m->mothurRemove(accnosFileName); m->mothurRemove(alignFileName); m->mothurRemove(reportFileName); outputTypes.clear();  return 0; }
 			
@@ -555,6 +561,7 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				num = driver(lines[process], alignFileName + toString(m->mothurGetpid(process)) + ".temp", reportFileName + toString(m->mothurGetpid(process)) + ".temp", accnosFName + m->mothurGetpid(process) + ".temp", filename);
 				
 				//pass numSeqs to parent
@@ -564,6 +571,8 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
 				out << num << endl;
 				out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
 				m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -598,6 +607,7 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     num = driver(lines[process], alignFileName + toString(m->mothurGetpid(process)) + ".temp", reportFileName + toString(m->mothurGetpid(process)) + ".temp", accnosFName + m->mothurGetpid(process) + ".temp", filename);
                     
                     //pass numSeqs to parent
@@ -607,6 +617,8 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
                     out << num << endl;
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else {
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
@@ -624,6 +636,7 @@ int AlignCommand::createProcesses(string alignFileName, string reportFileName, s
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		vector<string> nonBlankAccnosFiles;
 		if (!(m->isBlank(accnosFName))) { nonBlankAccnosFiles.push_back(accnosFName); }
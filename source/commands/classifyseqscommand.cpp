@@ -594,6 +594,9 @@ int ClassifySeqsCommand::execute(){
 	try {
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
         
+        Profiler* profiler = Profiler::getInstance();
+        profiler->startPhase("read template");
+        
         string outputMethodTag = method;
 		if(method == "wang"){	classify = new Bayesian(taxonomyFileName, templateFileName, search, kmerSize, cutoff, iters, rand(), flip, writeShortcuts);	}
 		else if(method == "knn"){	classify = new Knn(taxonomyFileName, templateFileName, search, kmerSize, gapOpen, gapExtend, match, misMatch, numWanted, rand());				}
@@ -668,11 +671,13 @@ int ClassifySeqsCommand::execute(){
 				}
 			}
 #endif
+			profiler->startPhase("classify");
 			if(processors == 1){
 				numFastaSeqs = driver(lines[0], newTaxonomyFile, tempTaxonomyFile, newaccnosFile, fastaFileNames[s]);
 			}else{
 				numFastaSeqs = createProcesses(newTaxonomyFile, tempTaxonomyFile, newaccnosFile, fastaFileNames[s]); 
 			}
+			profiler->addRecords(numFastaSeqs);
 			
 			if (!m->isBlank(newaccnosFile)) { m->mothurOutEndLine(); m->mothurOut("[WARNING]: mothur reversed some your sequences for a better classification.  If you would like to take a closer look, please check " + newaccnosFile + " for the list of the sequences."); m->mothurOutEndLine(); 
                 outputNames.push_back(newaccnosFile); outputTypes["accnos"].push_back(newaccnosFile);
@@ -682,6 +687,8 @@ int ClassifySeqsCommand::execute(){
             m->mothurOut("It took " + toString(time(NULL) - start) + " secs to classify " + toString(numFastaSeqs) + " sequences."); m->mothurOutEndLine(); m->mothurOutEndLine();
             start = time(NULL);
             
+            profiler->startPhase("summarize");
+            
             //read namefile
             if(namefile != "") {
                 
@@ -814,6 +821,7 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				num = driver(lines[process], taxFileName + m->mothurGetpid(process) + ".temp", tempTaxFile + m->mothurGetpid(process) + ".temp", accnos + m->mothurGetpid(process) + ".temp", filename);
 
 				//pass numSeqs to parent
@@ -823,6 +831,8 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
 				out << num << endl;
 				out.close();
 
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
             }else {
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -856,6 +866,7 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     num = driver(lines[process], taxFileName + m->mothurGetpid(process) + ".temp", tempTaxFile + m->mothurGetpid(process) + ".temp", accnos + m->mothurGetpid(process) + ".temp", filename);
                     
                     //pass numSeqs to parent
@@ -865,6 +876,8 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
                     out << num << endl;
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else {
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
@@ -883,6 +896,7 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		for (int i = 0; i < processIDS.size(); i++) {
 			ifstream in;
@@ -495,7 +495,7 @@ map<string, set<string> > ClassifyTreeCommand::getDescendantList(Tree*& T, int i
        // TreeMap* tmap = T->getTreeMap();
 		
 		if (lc == -1) { //you are a leaf your only descendant is yourself
-            vector<string> groups = T->tree[i].getGroup();
+            vector<string> groups = T->getGroups(i);
             set<string> mynames; mynames.insert(T->tree[i].getName());
             for (int j = 0; j < groups.size(); j++) { names[groups[j]] = mynames;   } //mygroup -> me
             names["AllGroups"] = mynames;
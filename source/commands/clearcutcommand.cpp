@@ -12,6 +12,9 @@
 extern "C" {
 #endif
 #include "clearcut.h"
+#include "dmat.h"
+#include "distclearcut.h"
+#include "prng.h"
 #ifdef __cplusplus
 }
 #endif
@@ -245,6 +248,15 @@ ClearcutCommand::ClearcutCommand(string option)  {
 			expdist = m->isTrue(temp);
 			
 			if ((fastafile != "") && ((!DNA) && (!protein))) { m->mothurOut("You must specify the type of sequences you are using: DNA or protein"); m->mothurOutEndLine(); abort=true; }
+			
+			//clearcut's own command line checks, which would otherwise end mothur from inside clearcut
+			if ((fastafile != "") && DNA && protein) { m->mothurOut("The DNA and protein parameters are mutually exclusive."); m->mothurOutEndLine(); abort=true; }
+			if ((phylipfile != "") && (DNA || protein)) { m->mothurOut("The DNA and protein parameters only apply to fasta input."); m->mothurOutEndLine(); abort=true; }
+			if ((phylipfile != "") && (jukes || kimura)) { m->mothurOut("The jukes and kimura parameters only apply to fasta input."); m->mothurOutEndLine(); abort=true; }
+			if (jukes && kimura) { m->mothurOut("You may only specify one correction model, jukes or kimura."); m->mothurOutEndLine(); abort=true; }
+			if (verbose && quiet) { m->mothurOut("The verbose and quiet parameters are mutually exclusive."); m->mothurOutEndLine(); abort=true; }
+			if ((phylipfile != "") && expdist) { m->mothurOut("The expdist parameter requires fasta input."); m->mothurOutEndLine(); abort=true; }
+			if (atoi(ntrees.c_str()) <= 0) { m->mothurOut("The ntrees parameter must be a positive integer."); m->mothurOutEndLine(); abort=true; }
 		}
 
 	}
@@ -265,81 +277,65 @@ int ClearcutCommand::execute() {
 		string outputName = getOutputFileName("tree", variables);
 		outputNames.push_back(outputName); outputTypes["tree"].push_back(outputName);
 		
-        int numArgs = 4; //clearcut, in, out and fastafile or phylipfile
-        if (version) { numArgs++; } if (verbose) { numArgs++; } if (quiet) { numArgs++; } if (seed != "*")	{ numArgs++; } if (norandom) { numArgs++; }
-        if (shuffle) { numArgs++; } if (neighbor) { numArgs++; } if (stdoutWanted) { numArgs++; } if (DNA)	{ numArgs++; } if (protein) { numArgs++; }
-        if (jukes) { numArgs++; } if (kimura) { numArgs++; } if (matrixout != "") { numArgs++; } if (ntrees != "1")	{ numArgs++; } if (expblen) { numArgs++; } if (expdist) { numArgs++; }
+        //fill in the arguments clearcut would have parsed from its command line
+        NJ_ARGS nj_args;
+        NJ_init_args(&nj_args);
         
+        if (phylipfile != "")   { nj_args.input_mode = NJ_INPUT_MODE_DISTANCE;             }
+        else                    { nj_args.input_mode = NJ_INPUT_MODE_ALIGNED_SEQUENCES;    }
         
-        char** clearcutParameters;
-		clearcutParameters = new char*[numArgs];
+        if (seed != "*")        { nj_args.seed = atoi(seed.c_str());    }
+        nj_args.ntrees = atoi(ntrees.c_str());
         
-        clearcutParameters[0] = new char[9];
-		*clearcutParameters[0] = '\0'; strncat(clearcutParameters[0], "clearcut", 8);
-				
-		//you gave us a distance matrix
-        if (phylipfile != "") {  clearcutParameters[1] = new char[11];  *clearcutParameters[1] = '\0'; strncat(clearcutParameters[1], "--distance", 10); 	}
-		
-		//you gave us a fastafile
-		if (fastafile != "") { clearcutParameters[1] = new char[12];  *clearcutParameters[1] = '\0'; strncat(clearcutParameters[1], "--alignment", 11);  	}
-		
-        int parameterCount = 2;
-		if (version)			{  clearcutParameters[parameterCount] = new char[10];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--version", 9);  	parameterCount++; }
-		if (verbose)			{  clearcutParameters[parameterCount] = new char[10];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--verbose", 9);  parameterCount++;	}
-		if (quiet)				{  clearcutParameters[parameterCount] = new char[8];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--quiet", 7);  parameterCount++;	}
-		if (seed != "*")		{  
-			string tempSeed = "--seed=" + seed;
-			clearcutParameters[parameterCount] = new char[tempSeed.length()+1];
-			*clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], tempSeed.c_str(), tempSeed.length());
-			parameterCount++;
-		}
-		if (norandom)			{  clearcutParameters[parameterCount] = new char[11];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--norandom", 10);  parameterCount++;	}
-		if (shuffle)			{  clearcutParameters[parameterCount] = new char[10];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--shuffle", 9);  parameterCount++;	}
-		if (neighbor)			{  clearcutParameters[parameterCount] = new char[11];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--neighbor", 10);  parameterCount++;	}
-		
-		string tempIn = "--in=" + inputFile;  
-        clearcutParameters[parameterCount] = new char[tempIn.length()+1];
-		*clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], tempIn.c_str(), tempIn.length());
-        parameterCount++;
-		
-		if (stdoutWanted)		{  clearcutParameters[parameterCount] = new char[9];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--stdout", 8);  parameterCount++;	}
-		else{  
-            string tempOut = "--out=" + outputName;
-			clearcutParameters[parameterCount] = new char[tempOut.length()+1];
-			*clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], tempOut.c_str(), tempOut.length());
-			parameterCount++;
-            
-		}
-			
-		if (DNA)				{  clearcutParameters[parameterCount] = new char[6];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--DNA", 5);  parameterCount++;		}
-		if (protein)			{  clearcutParameters[parameterCount] = new char[10];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--protein", 9);  parameterCount++;	}
-		if (jukes)				{  clearcutParameters[parameterCount] = new char[8];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--jukes", 7);  parameterCount++;	}
-		if (kimura)				{ clearcutParameters[parameterCount] = new char[9];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--kimura", 8);  parameterCount++;		}
-		if (matrixout != "")	{  
-			string tempMatrix =  "--matrixout=" + outputDir + matrixout; 
-			clearcutParameters[parameterCount] = new char[tempMatrix.length()+1];
-			*clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], tempMatrix.c_str(), tempMatrix.length());
-			parameterCount++;
-			outputNames.push_back((outputDir + matrixout));
-			outputTypes["matrixout"].push_back((outputDir + matrixout));
-		}
-
-		if (ntrees != "1")		{  
-			string tempNtrees = "--ntrees=" + ntrees; 
-			clearcutParameters[parameterCount] = new char[tempNtrees.length()+1];
-			*clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], tempNtrees.c_str(), tempNtrees.length());
-			parameterCount++;
-		}
-
-		if (expblen)			{ clearcutParameters[parameterCount] = new char[10];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--expblen", 9);  parameterCount++; 	}
-		if (expdist)			{ clearcutParameters[parameterCount] = new char[10];  *clearcutParameters[parameterCount] = '\0'; strncat(clearcutParameters[parameterCount], "--expdist", 9);  parameterCount++;	}
+        nj_args.verbose_flag = verbose;     nj_args.quiet_flag = quiet;
+        nj_args.norandom = norandom;        nj_args.shuffle = shuffle;          nj_args.neighbor = neighbor;
+        nj_args.dna_flag = DNA;             nj_args.protein_flag = protein;
+        nj_args.jukes_flag = jukes;         nj_args.kimura_flag = kimura;
+        nj_args.expblen = expblen;          nj_args.expdist = expdist;
+        
+        if (jukes)          { nj_args.correction_model = NJ_MODEL_JUKES;    }
+        else if (kimura)    { nj_args.correction_model = NJ_MODEL_KIMURA;   }
+        
+        nj_args.infilename = new char[inputFile.length()+1];
+        strcpy(nj_args.infilename, inputFile.c_str());
+        
+        if (stdoutWanted)   { nj_args.stdout_flag = 1; }
+        else {
+            nj_args.outfilename = new char[outputName.length()+1];
+            strcpy(nj_args.outfilename, outputName.c_str());
+        }
+        
+        if (matrixout != "") {
+            string matrixName = outputDir + matrixout;
+            nj_args.matrixout = new char[matrixName.length()+1];
+            strcpy(nj_args.matrixout, matrixName.c_str());
+            outputNames.push_back(matrixName); outputTypes["matrixout"].push_back(matrixName);
+        }
+        
+        if (version)    { m->mothurOut("Clearcut Version: " + string(NJ_VERSION)); m->mothurOutEndLine(); }
+        if (verbose)    { m->mothurOut("PRNG SEED: " + toString(nj_args.seed)); m->mothurOutEndLine(); }
         
+        init_genrand(nj_args.seed);
+        
+        //the matrix is built in memory and handed straight to the tree building
         errno = 0;
-		clearcut_main(numArgs, clearcutParameters); 
-		
-		//free memory
-		for(int i = 0; i < numArgs; i++)  {  delete[] clearcutParameters[i];  }
-		delete[] clearcutParameters; 
+        DMAT* dmat = NULL;
+        if (phylipfile != "")   { dmat = NJ_parse_distance_matrix(&nj_args);    }
+        else                    { dmat = NJ_build_distance_matrix(&nj_args);    }
+        
+        int error = -1;
+        if (dmat != NULL) {
+            if (nj_args.matrixout != NULL) { NJ_output_matrix(&nj_args, dmat); }
+            error = NJ_run(&nj_args, dmat);
+        }
+        
+        delete[] nj_args.infilename; delete[] nj_args.outfilename; delete[] nj_args.matrixout;
+        
+        if (error != 0) {
+            m->mothurOut("[ERROR]: clearcut was unable to build a tree from " + inputFile + "."); m->mothurOutEndLine();
+            for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]);	}
+            return 0;
+        }
 		
 		if (!stdoutWanted) {	
 			
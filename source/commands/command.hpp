@@ -18,6 +18,7 @@
 #include "validparameter.h"
 #include "mothurout.h"
 #include "commandparameter.h"
+#include "profiler.h"
 
 
 class Command {
@@ -16,6 +16,7 @@ vector<string> CooccurrenceCommand::setParameters() {
 		CommandParameter pmetric("metric", "Multiple", "cscore-checker-combo-vratio", "cscore", "", "", "","",false,false); parameters.push_back(pmetric);
 		CommandParameter pmatrix("matrixmodel", "Multiple", "sim1-sim2-sim3-sim4-sim5-sim6-sim7-sim8-sim9", "sim2", "", "", "","",false,false); parameters.push_back(pmatrix);
         CommandParameter pruns("iters", "Number", "", "1000", "", "", "","",false,false); parameters.push_back(pruns);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -35,9 +36,10 @@ vector<string> CooccurrenceCommand::setParameters() {
 string CooccurrenceCommand::getHelpString(){	
 	try {
 		string helpString = "The cooccurrence command calculates four metrics and tests their significance to assess whether presence-absence patterns are different than what one would expect by chance.";
-        helpString += "The cooccurrence command parameters are shared, metric, matrixmodel, iters, label and groups.";
+        helpString += "The cooccurrence command parameters are shared, metric, matrixmodel, iters, processors, label and groups.";
         helpString += "The matrixmodel parameter options are sim1, sim2, sim3, sim4, sim5, sim6, sim7, sim8 and sim9. Default=sim2";
         helpString += "The metric parameter options are cscore, checker, combo and vratio. Default=cscore";
+        helpString += "The processors parameter allows you to specify the number of processors to use. The iters are divided between them, each with its own random number stream, and for sim9 each runs its own swap chain. The default is 1.\n";
         helpString += "The label parameter is used to analyze specific labels in your input.\n";
 		helpString += "The groups parameter allows you to specify which of the groups you would like analyzed.\n";
         helpString += "The cooccurrence command should be in the following format: \n";
@@ -167,7 +169,10 @@ CooccurrenceCommand::CooccurrenceCommand(string option) {
             
             string temp = validParameter.validFile(parameters, "iters", false);			if (temp == "not found") { temp = "1000"; }
 			m->mothurConvert(temp, runs); 
-
+            
+            temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
 		}
 
 	}
@@ -322,7 +327,6 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
        
         vector<double> stats;
         vector<double> probabilityMatrix; probabilityMatrix.resize(ncols * nrows, 0);
-        vector<vector<int> > nullmatrix(nrows, vector<int>(ncols, 0));
        
         TrialSwap2 trial;
         
@@ -425,22 +429,69 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
         
         m->mothurOut("Initial c score: " + toString(initscore)); m->mothurOutEndLine();
         
-        double previous;
-        double current;
-        double randnum;
-        int count;
-
         //burn-in for sim9    
         if(matrix == "sim9") {
             for(int i=0;i<10000;i++) trial.swap_checkerboards (co_matrix, ncols, nrows);
+            
+            //from here the swaps keep the pair counts up to date
+            if ((metric == "cscore") || (metric == "checker")) { trial.startChain(co_matrix, rowtotal, ncols, nrows); }
         }
+        
+        createProcesses(co_matrix, rowtotal, columntotal, probabilityMatrix, n, trial, stats);
+        
+        if (m->control_pressed) { return 0; }
+        
+        double total = 0.0;
+        for (int i=0; i<stats.size();i++) { total+=stats[i]; }
+        
+        double nullMean = double (total/(double)stats.size());
+        
+        m->mothurOutEndLine(); m->mothurOut("average metric score: " + toString(nullMean)); m->mothurOutEndLine();
+        
+        //calc_p_value is not a statistical p-value, it's just the average that are either > or < the initscore.
+        //All it does is show what is expected in a competitively structured community
+        //zscore is output so p-value can be looked up in a ztable
+        double pvalue = 0.0;
+        if (metric == "cscore" || metric == "checker") { pvalue = trial.calc_pvalue_greaterthan (stats, initscore); }
+        else{ pvalue = trial.calc_pvalue_lessthan (stats, initscore); }
 
+        double sd = trial.getSD(runs, stats, nullMean);
+
+        double zscore = trial.get_zscore(sd, nullMean, initscore);
+        
+        m->mothurOut("zscore: " + toString(zscore)); m->mothurOutEndLine();
+        m->mothurOut("standard deviation: " + toString(sd)); m->mothurOutEndLine();
+        m->mothurOut("non-parametric p-value: " + toString(pvalue)); m->mothurOutEndLine();
+        out << metric << '\t' << thisLookUp[0]->getLabel() << '\t' << nullMean << '\t' << zscore << '\t' << sd << '\t' << pvalue << endl;
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CooccurrenceCommand", "Cooccurrence");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//fills stats with the scores of numRuns null matrices
+int CooccurrenceCommand::driver(vector<vector<int> >& co_matrix, vector<int>& rowtotal, vector<int>& columntotal, vector<double>& probabilityMatrix, int n, int numRuns, TrialSwap2& trial, vector<double>& stats){
+    try {
+        int nrows = co_matrix.size();
+        int ncols = columntotal.size();
+        
+        double previous;
+        double current;
+        double randnum;
+        int count;
+        vector<vector<int> > nullmatrix;
+        
         //populate null matrix from probability matrix, do this a lot.
-        for(int k=0;k<runs;k++){
-            nullmatrix.clear();
+        for(int k=0;k<numRuns;k++){
             //zero-fill the null matrix
             nullmatrix.assign(nrows, vector<int>(ncols, 0));
             
+            //sim2 and sim9 change the original matrix in place, so score that
+            vector<vector<int> >* scoreMatrix = &nullmatrix;
+            
             if(matrix == "sim1" || matrix == "sim6" || matrix == "sim8" || matrix == "sim7") {
                 count = 0;
                 while(count < n) {
@@ -468,9 +519,7 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
                 for(int i=0;i<nrows;i++) {
                     random_shuffle( co_matrix[i].begin(), co_matrix[i].end() ); 
                 }
-                //do this for the scoring since those all have nullmatrix as a parameter
-                //nullmatrix gets cleared at the begining of each run
-                nullmatrix = co_matrix;
+                scoreMatrix = &co_matrix;
             }
             
             else if(matrix == "sim4") {
@@ -518,7 +567,7 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
             //swap_checkerboards takes the original matrix and swaps checkerboards
             else if(matrix == "sim9") {
                 trial.swap_checkerboards (co_matrix, ncols, nrows);
-                nullmatrix = co_matrix;
+                scoreMatrix = &co_matrix;
             }
             else {
                 m->mothurOut("[ERROR]: No null model selected!\n\n"); m->control_pressed = true;
@@ -526,17 +575,23 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
             }
             
             //run metric on null matrix and add score to the stats vector
-            if (metric == "cscore"){
-                stats.push_back(trial.calc_c_score(nullmatrix, rowtotal, ncols, nrows));
+            if ((matrix == "sim9") && (metric == "cscore")) {
+                stats.push_back(trial.getChainCScore());
+            }
+            else if ((matrix == "sim9") && (metric == "checker")) {
+                stats.push_back(trial.getChainChecker());
+            }
+            else if (metric == "cscore"){
+                stats.push_back(trial.calc_c_score(*scoreMatrix, rowtotal, ncols, nrows));
             }
             else if (metric == "checker") {
-                stats.push_back(trial.calc_checker(nullmatrix, rowtotal, ncols, nrows));
+                stats.push_back(trial.calc_checker(*scoreMatrix, rowtotal, ncols, nrows));
             }
             else if (metric == "vratio") {
                 stats.push_back(trial.calc_vratio(nrows, ncols, rowtotal, columntotal));
             }
             else if (metric == "combo") {
-                stats.push_back(trial.calc_combo(nrows, ncols, nullmatrix));
+                stats.push_back(trial.calc_combo(nrows, ncols, *scoreMatrix));
             }
             else {
                 m->mothurOut("[ERROR]: No metric selected!\n\n"); m->control_pressed = true;
@@ -545,38 +600,91 @@ int CooccurrenceCommand::getCooccurrence(vector<SharedRAbundVector*>& thisLookUp
             
         }
         
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CooccurrenceCommand", "driver");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//the runs are divided between processes. Each child gets its own random number stream, so for sim9 each runs an
+//independent swap chain from the burned in matrix. With one processor the runs are the same as before.
+int CooccurrenceCommand::createProcesses(vector<vector<int> >& co_matrix, vector<int>& rowtotal, vector<int>& columntotal, vector<double>& probabilityMatrix, int n, TrialSwap2& trial, vector<double>& stats){
+    try {
+        #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        #else
+        processors=1; //runs are only divided between forked processes
+        #endif
         
+        int numProcs = processors;
+        if (runs < numProcs) { numProcs = runs; }
+        if (numProcs < 1) { numProcs = 1; }
         
-        double total = 0.0;
-        for (int i=0; i<stats.size();i++) { total+=stats[i]; }
-        
-        double nullMean = double (total/(double)stats.size());
-        
-        m->mothurOutEndLine(); m->mothurOut("average metric score: " + toString(nullMean)); m->mothurOutEndLine();
+        vector<int> runsPerProcess(numProcs, runs / numProcs);
+        for (int i = 0; i < (runs % numProcs); i++) { runsPerProcess[i]++; }
         
-        //calc_p_value is not a statistical p-value, it's just the average that are either > or < the initscore.
-        //All it does is show what is expected in a competitively structured community
-        //zscore is output so p-value can be looked up in a ztable
-        double pvalue = 0.0;
-        if (metric == "cscore" || metric == "checker") { pvalue = trial.calc_pvalue_greaterthan (stats, initscore); }
-        else{ pvalue = trial.calc_pvalue_lessthan (stats, initscore); }
-
-        double sd = trial.getSD(runs, stats, nullMean);
-
-        double zscore = trial.get_zscore(sd, nullMean, initscore);
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        vector<int> processIDS;
+        int process = 1;
+        unsigned int seedBase = 0;
+        if (numProcs > 1) { seedBase = rand(); }
+		
+		//loop through and create all the processes you want
+		while (process != numProcs) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
+				process++;
+			}else if (pid == 0){
+                srand(seedBase + process);
+                
+                vector<double> childStats;
+                driver(co_matrix, rowtotal, columntotal, probabilityMatrix, n, runsPerProcess[process], trial, childStats);
+                
+                //pass stats to parent
+				ofstream out;
+				string tempFile = m->mothurGetpid(process) + ".cooccurrence.temp";
+				m->openOutputFile(tempFile, out);
+                out << setprecision(17);
+				for (int i = 0; i < childStats.size(); i++) { out << childStats[i] << endl; }
+				out.close();
+                
+				exit(0);
+			}else {
+				m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+				for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+				exit(0);
+			}
+		}
+		
+		//do my part
+		driver(co_matrix, rowtotal, columntotal, probabilityMatrix, n, runsPerProcess[0], trial, stats);
+		
+		//force parent to wait until all the processes are done
+		for (int i=0;i<processIDS.size();i++) {
+			int temp = processIDS[i];
+			wait(&temp);
+		}
         
-        m->mothurOut("zscore: " + toString(zscore)); m->mothurOutEndLine();
-        m->mothurOut("standard deviation: " + toString(sd)); m->mothurOutEndLine();
-        m->mothurOut("non-parametric p-value: " + toString(pvalue)); m->mothurOutEndLine();
-        out << metric << '\t' << thisLookUp[0]->getLabel() << '\t' << nullMean << '\t' << zscore << '\t' << sd << '\t' << pvalue << endl;
+        for (int i=0;i<processIDS.size();i++) {
+            ifstream in;
+			string tempFile = toString(processIDS[i]) + ".cooccurrence.temp";
+			m->openInputFile(tempFile, in);
+            double score;
+            while (in >> score) { stats.push_back(score); }
+			in.close(); m->mothurRemove(tempFile);
+        }
+#else
+		driver(co_matrix, rowtotal, columntotal, probabilityMatrix, n, runsPerProcess[0], trial, stats);
+#endif
         
         return 0;
     }
     catch(exception& e) {
-        m->errorOut(e, "CooccurrenceCommand", "Cooccurrence");
+        m->errorOut(e, "CooccurrenceCommand", "createProcesses");
         exit(1);
     }
 }
 //**********************************************************************************************************************
-
-
@@ -44,9 +44,11 @@ private:
     bool abort, allLines;
     set<string> labels;
     vector<string> outputNames, Groups;
-    int runs;
+    int runs, processors;
     
     int getCooccurrence(vector<SharedRAbundVector*>&, ofstream&);
+    int createProcesses(vector<vector<int> >&, vector<int>&, vector<int>&, vector<double>&, int, TrialSwap2&, vector<double>&);
+    int driver(vector<vector<int> >&, vector<int>&, vector<int>&, vector<double>&, int, int, TrialSwap2&, vector<double>&);
 	
 };
 
@@ -9,6 +9,7 @@
 
 #include "deconvolutecommand.h"
 #include "sequence.hpp"
+#include "dereplicator.h"
 
 //**********************************************************************************************************************
 vector<string> DeconvoluteCommand::setParameters(){	
@@ -234,18 +235,25 @@ int DeconvoluteCommand::execute() {
 		
 		if (m->control_pressed) { return 0; }
 		
+        Profiler* profiler = Profiler::getInstance();
+        profiler->startPhase("dereplicate");
+        
 		ifstream in; 
 		m->openInputFile(fastafile, in);
 		
 		ofstream outFasta;
 		m->openOutputFile(outFastaFile, outFasta);
 		
-		map<string, string> sequenceStrings; //sequenceString -> list of names.  "atgc...." -> seq1,seq2,seq3.
-		map<string, string>::iterator itStrings;
+		//uniques are numbered in the order they are found, which is the order of the output files
+		Dereplicator uniques((format == "name"), outputDir + m->getRootName(m->getSimpleName(fastafile)));
+		vector<string> repNames; //first sequence name for each unique
+		vector<int> uniqueTotals; //only used for the count format
+		vector< vector<int> > uniqueGroupCounts;
+		bool hasGroups = false;
+		if ((countfile != "") && (format == "count")) { hasGroups = ct.hasGroupInfo(); }
+		
 		set<string> nameInFastaFile; //for sanity checking
 		set<string>::iterator itname;
-		vector<string> nameFileOrder;
-        CountTable newCt;
 		int count = 0;
 		while (!in.eof()) {
 			
@@ -259,108 +267,109 @@ int DeconvoluteCommand::execute() {
 				itname = nameInFastaFile.find(seq.getName());
 				if (itname == nameInFastaFile.end()) { nameInFastaFile.insert(seq.getName());  }
 				else { m->mothurOut("[ERROR]: You already have a sequence named " + seq.getName() + " in your fasta file, sequence names must be unique, please correct."); m->mothurOutEndLine(); }
-
-				itStrings = sequenceStrings.find(seq.getAligned());
 				
-				if (itStrings == sequenceStrings.end()) { //this is a new unique sequence
-					//output to unique fasta file
-					seq.printSequence(outFasta);
+				//how many reads does this sequence represent
+				bool inNameFile = true;
+				int numReps = 1;
+				vector<int> groupCounts;
+				if (namefile != "") {
+					itNames = nameMap.find(seq.getName());
 					
-					if (namefile != "") {
-						itNames = nameMap.find(seq.getName());
-						
-						if (itNames == nameMap.end()) { //namefile and fastafile do not match
-							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine();
-						}else {
-                            if (format == "name") { sequenceStrings[seq.getAligned()] = itNames->second;  nameFileOrder.push_back(seq.getAligned());
-                            }else {  newCt.push_back(seq.getName(), m->getNumNames(itNames->second)); sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
-						}
-					}else if (countfile != "") {
-                        if (format == "name") {
-                            int numSeqs = ct.getNumSeqs(seq.getName());
-                            string expandedName = seq.getName()+"_0";
-                            for (int i = 1; i < numSeqs; i++) {  expandedName += "," + seq.getName() + "_" + toString(i);  }
-                            sequenceStrings[seq.getAligned()] = expandedName;  nameFileOrder.push_back(seq.getAligned());
-                        }else {
-                            ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
-                            sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned());
-                        }
-                    }else {
-                        if (format == "name") { sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
-                        else {  newCt.push_back(seq.getName()); sequenceStrings[seq.getAligned()] = seq.getName();	nameFileOrder.push_back(seq.getAligned()); }
-                    }
-				}else { //this is a dup
-					if (namefile != "") {
-						itNames = nameMap.find(seq.getName());
-						
-						if (itNames == nameMap.end()) { //namefile and fastafile do not match
-							m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine();
-						}else {
-                            if (format == "name") { sequenceStrings[seq.getAligned()] += "," + itNames->second;  }
-                            else {  int currentReps = newCt.getNumSeqs(itStrings->second);  newCt.setNumSeqs(itStrings->second, currentReps+(m->getNumNames(itNames->second)));  }
+					if (itNames == nameMap.end()) { //namefile and fastafile do not match
+						m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct."); m->mothurOutEndLine();
+						inNameFile = false;
+					}else { numReps = m->getNumNames(itNames->second); }
+				}else if (countfile != "") {
+					numReps = ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
+					if (hasGroups && (numReps != 0)) { groupCounts = ct.getGroupCounts(seq.getName()); }
+				}
+				
+				if (inNameFile) {
+					string aligned = seq.getAligned();
+					bool isNew = false;
+					int index = uniques.add(aligned, seq.getName(), isNew);
+					
+					if (isNew) { //this is a new unique sequence
+						//output to unique fasta file
+						seq.printSequence(outFasta);
+						repNames.push_back(seq.getName());
+						if (format == "count") {
+							uniqueTotals.push_back(0);
+							if (hasGroups) { uniqueGroupCounts.push_back(vector<int>(ct.getNumGroups(), 0)); }
 						}
-                    }else if (countfile != "") {
-                        if (format == "name") {
-                            int numSeqs = ct.getNumSeqs(seq.getName());
-                            string expandedName = seq.getName()+"_0";
-                            for (int i = 1; i < numSeqs; i++) {  expandedName += "," + seq.getName() + "_" + toString(i);  }
-                            sequenceStrings[seq.getAligned()] += "," + expandedName;
-                        }else {
-                            int num = ct.getNumSeqs(seq.getName()); //checks to make sure seq is in table
-                            if (num != 0) { //its in the table
-                                ct.mergeCounts(itStrings->second, seq.getName()); //merges counts and saves in uniques name
-                            }
-                        }
-                    }else {
-                        if (format == "name") {  sequenceStrings[seq.getAligned()] += "," + seq.getName(); }
-                        else {  int currentReps = newCt.getNumSeqs(itStrings->second); newCt.setNumSeqs(itStrings->second, currentReps+1);  }
-                    }
+					}
+					
+					if (format == "count") {
+						uniqueTotals[index] += numReps;
+						for (int i = 0; i < groupCounts.size(); i++) { uniqueGroupCounts[index][i] += groupCounts[i]; }
+					}
 				}
 				count++;
 			}
 			
 			m->gobble(in);
 			
-			if(count % 1000 == 0)	{ m->mothurOutJustToScreen(toString(count) + "\t" + toString(sequenceStrings.size()) + "\n");	}
+			if(count % 1000 == 0)	{ m->mothurOutJustToScreen(toString(count) + "\t" + toString(uniques.getNumUniques()) + "\n");	}
 		}
 		
-		if(count % 1000 != 0)	{ m->mothurOut(toString(count) + "\t" + toString(sequenceStrings.size())); m->mothurOutEndLine();	}
+		if(count % 1000 != 0)	{ m->mothurOut(toString(count) + "\t" + toString(uniques.getNumUniques())); m->mothurOutEndLine();	}
 		
 		in.close();
 		outFasta.close();
+        profiler->addRecords(count);
 		
 		if (m->control_pressed) { m->mothurRemove(outFastaFile); return 0; }
         
+        profiler->startPhase("write");
+        
 		//print new names file
 		ofstream outNames;
 		if (format == "name") { m->openOutputFile(outNameFile, outNames); outputNames.push_back(outNameFile); outputTypes["name"].push_back(outNameFile);   }
         else { m->openOutputFile(outCountFile, outNames); outputTypes["count"].push_back(outCountFile); outputNames.push_back(outCountFile);                }
         
         if ((countfile != "") && (format == "count")) { ct.printHeaders(outNames); }
-        else if ((countfile == "") && (format == "count")) { newCt.printHeaders(outNames); }
+        else if ((countfile == "") && (format == "count")) { CountTable newCt; newCt.printHeaders(outNames); }
 		
-		for (int i = 0; i < nameFileOrder.size(); i++) {
-			if (m->control_pressed) { outputTypes.clear(); m->mothurRemove(outFastaFile); outNames.close(); for (int j = 0; j < outputNames.size(); j++) { m->mothurRemove(outputNames[j]); } return 0; }
-			
-			itStrings = sequenceStrings.find(nameFileOrder[i]);
-			
-			if (itStrings != sequenceStrings.end()) {
-                if (format == "name") {
-                    //get rep name
-                    int pos = (itStrings->second).find_first_of(',');
+        if (format == "name") {
+            uniques.startNames();
+            
+            int index;
+            vector<string> names;
+            while (uniques.getNextNames(index, names)) {
+                if (m->control_pressed) { outputTypes.clear(); m->mothurRemove(outFastaFile); outNames.close(); for (int j = 0; j < outputNames.size(); j++) { m->mothurRemove(outputNames[j]); } return 0; }
+                
+                //expand each sequence to the reads it represents
+                string nameList = "";
+                for (int i = 0; i < names.size(); i++) {
+                    if (i != 0) { nameList += ","; }
                     
-                    if (pos == string::npos) { // only reps itself
-                        outNames << itStrings->second << '\t' << itStrings->second << endl;
-                    }else {
-                        outNames << (itStrings->second).substr(0, pos) << '\t' << itStrings->second << endl;
-                    }
+                    if (namefile != "") { nameList += nameMap[names[i]]; }
+                    else if (countfile != "") {
+                        int numSeqs = ct.getNumSeqs(names[i]);
+                        nameList += names[i] + "_0";
+                        for (int j = 1; j < numSeqs; j++) {  nameList += "," + names[i] + "_" + toString(j);  }
+                    }else { nameList += names[i]; }
+                }
+                
+                //get rep name
+                int pos = nameList.find_first_of(',');
+                if (pos == string::npos) { // only reps itself
+                    outNames << nameList << '\t' << nameList << endl;
                 }else {
-                    if (countfile != "") {  ct.printSeq(outNames, itStrings->second);  }
-                    else if (format == "count")  {  newCt.printSeq(outNames, itStrings->second);  }
+                    outNames << nameList.substr(0, pos) << '\t' << nameList << endl;
                 }
-			}else{ m->mothurOut("[ERROR]: mismatch in namefile print."); m->mothurOutEndLine(); m->control_pressed = true; }
-		}
+            }
+        }else {
+            for (int i = 0; i < repNames.size(); i++) {
+                if (m->control_pressed) { outputTypes.clear(); m->mothurRemove(outFastaFile); outNames.close(); for (int j = 0; j < outputNames.size(); j++) { m->mothurRemove(outputNames[j]); } return 0; }
+                
+                outNames << repNames[i] << '\t' << uniqueTotals[i];
+                if (hasGroups) { for (int j = 0; j < uniqueGroupCounts[i].size(); j++) { outNames << '\t' << uniqueGroupCounts[i][j]; } }
+                outNames << endl;
+            }
+        }
 		outNames.close();
+        profiler->endPhase();
 		
 		if (m->control_pressed) { outputTypes.clear(); m->mothurRemove(outFastaFile); for (int j = 0; j < outputNames.size(); j++) { m->mothurRemove(outputNames[j]); }  return 0; }
 		
@@ -272,6 +272,9 @@ int DistanceCommand::execute(){
 			outputTypes["phylip"].push_back(outputFile);
 		}
 
+		Profiler* profiler = Profiler::getInstance();
+		profiler->startPhase("calculate");
+		
 		//if you don't need to fork anything
 		if(processors == 1){
 			if (output != "square") {  driver(0, numSeqs, outputFile, cutoff); }
@@ -279,6 +282,8 @@ int DistanceCommand::execute(){
 		}else{ //you have multiple processors
 			createProcesses(outputFile, numSeqs);
 		}
+		profiler->addRecords(numSeqs);
+		profiler->endPhase();
 
 		if (m->control_pressed) { outputTypes.clear();  m->mothurRemove(outputFile); return 0; }
 		
@@ -392,8 +397,10 @@ void DistanceCommand::createProcesses(string filename, int numSeqs) {
                 process++;
                 if (m->debug) { m->mothurOut("[DEBUG]: parent process is saving child pid " + toString(pid) + ".\n"); }
             }else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				if (output != "square") {  driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", cutoff); }
 				else { driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", "square"); }
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -441,8 +448,10 @@ void DistanceCommand::createProcesses(string filename, int numSeqs) {
                     process++;
                     if (m->debug) { m->mothurOut("[DEBUG]: parent process is saving child pid " + toString(pid) + ".\n"); }
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     if (output != "square") {  driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", cutoff); }
                     else { driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", "square"); }
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else {
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes. Error code: " + toString(pid)); m->mothurOutEndLine();
@@ -463,6 +472,7 @@ void DistanceCommand::createProcesses(string filename, int numSeqs) {
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 #else
 		//////////////////////////////////////////////////////////////////////////////////////////////////////
 		//Windows version shared memory, so be careful when passing variables through the distanceData struct. 
@@ -169,10 +169,7 @@ GetMetaCommunityCommand::GetMetaCommunityCommand(string option)  {
 			m->mothurConvert(temp, optimizegap);
             
             temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
-			//set processors to 1 until we figure out whats going on with this command.
-            temp = "1";
-            //m->setProcessors(temp);
-            m->mothurOut("Using 1 processor\n");
+			m->setProcessors(temp);
 			m->mothurConvert(temp, processors);
             
             string groups = validParameter.validFile(parameters, "groups", false);
@@ -354,20 +351,23 @@ int GetMetaCommunityCommand::execute(){
 int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislookup){
 	try {
         
-        //#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-       // #else
-        //until bug is resolved
-        processors=1; //qFinderDMM not thread safe
-        //#endif
+        #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        #else
+        processors=1; //partitions are only divided between forked processes
+        #endif
         
         vector<int> processIDS;
 		int process = 1;
-		int num = 0;
         int minPartition = 0;
+        int lastPartition = maxpartitions;
 		
 		//sanity check
 		if (maxpartitions < processors) { processors = maxpartitions; }
         
+        //each partition reseeds from this so a fit does not depend on which process ran it or what ran before it
+        seedBase = rand();
+        partitionScores.clear();
+        
         map<string, string> variables;
         variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(sharedfile));
         variables["[distance]"] = thislookup[0]->getLabel();
@@ -378,7 +378,6 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 		//divide the partitions between the processors
 		vector< vector<int> > dividedPartitions;
         vector< vector<string> > rels, matrix;
-        vector<string> doneFlags;
         dividedPartitions.resize(processors);
         rels.resize(processors);
         matrix.resize(processors);
@@ -400,14 +399,25 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             matrix[(processToAssign-1)].push_back(mName);
         }
         
-        for (int i = 0; i < processors; i++) { //read from everyone elses, just write to yours
-            string tempDoneFile = m->getRootName(m->getSimpleName(sharedfile)) + toString(i) + ".done.temp";
-            doneFlags.push_back(tempDoneFile);
-            ofstream out;
-            m->openOutputFile(tempDoneFile, out); //clear out 
-            out.close();
+        //each process adds the score of every partition it fits to its done flag, so the others can stop
+        //once the partitions fitted so far show a single process would have stopped
+        vector<string> doneFlags;
+        if ((processors > 1) && (optimizegap != -1)) {
+            for (int i = 0; i < processors; i++) {
+                string tempDoneFile = outputDir + m->getRootName(m->getSimpleName(sharedfile)) + toString(i) + ".done.temp";
+                doneFlags.push_back(tempDoneFile);
+                ofstream out;
+                m->openOutputFile(tempDoneFile, out); //clear out
+                out.close();
+            }
         }
         
+        if (method == "dmm") {  m->mothurOut("K\tNLE\t\tlogDet\tBIC\t\tAIC\t\tLaplace\n");  }
+        else {
+            m->mothurOut("K\tCH");
+            for (int i = 0; i < thislookup.size(); i++) {  m->mothurOut('\t' + thislookup[i]->getGroup()); }
+            m->mothurOut("\n");
+        }
 
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 		
@@ -420,15 +430,17 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 				process++;
 			}else if (pid == 0){
                 outputNames.clear();
-				num = processDriver(thislookup, dividedPartitions[process], (outputFileName + m->mothurGetpid(process)), rels[process], matrix[process], doneFlags, process);
+				processDriver(thislookup, dividedPartitions[process], (outputFileName + m->mothurGetpid(process)), rels[process], matrix[process], doneFlags, process);
                 
-                //pass numSeqs to parent
+                //pass output files and partition scores to parent
 				ofstream out;
 				string tempFile = m->mothurGetpid(process) + ".outputNames.temp";
 				m->openOutputFile(tempFile, out);
-                out << num << endl;
                 out << outputNames.size() << endl;
 				for (int i = 0; i < outputNames.size(); i++) { out << outputNames[i] << endl; }
+                out << partitionScores.size() << endl;
+                out << setprecision(17);
+                for (map<int, double>::iterator it = partitionScores.begin(); it != partitionScores.end(); it++) { out << it->first << '\t' << it->second << endl; }
 				out.close();
                 
 				exit(0);
@@ -440,13 +452,7 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 		}
 		
 		//do my part
-        if (method == "dmm") {  m->mothurOut("K\tNLE\t\tlogDet\tBIC\t\tAIC\t\tLaplace\n");  }
-        else {
-            m->mothurOut("K\tCH");
-            for (int i = 0; i < thislookup.size(); i++) {  m->mothurOut('\t' + thislookup[i]->getGroup()); }
-            m->mothurOut("\n");
-        }
-		minPartition = processDriver(thislookup, dividedPartitions[0], outputFileName, rels[0], matrix[0], doneFlags, 0);
+		processDriver(thislookup, dividedPartitions[0], outputFileName, rels[0], matrix[0], doneFlags, 0);
 		
 		//force parent to wait until all the processes are done
 		for (int i=0;i<processIDS.size();i++) {
@@ -454,7 +460,6 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 			wait(&temp);
 		}
         
-        vector<string> tempOutputNames = outputNames;
         for (int i=0;i<processIDS.size();i++) {
             ifstream in;
 			string tempFile = toString(processIDS[i]) + ".outputNames.temp";
@@ -462,12 +467,16 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 			if (!in.eof()) {
                 int tempNum = 0;
                 in >> tempNum; m->gobble(in);
-                if (tempNum < minPartition) { minPartition = tempNum; }
-                in >> tempNum; m->gobble(in);
-                for (int i = 0; i < tempNum; i++) {
+                for (int j = 0; j < tempNum; j++) {
                     string tempName = "";
                     in >> tempName; m->gobble(in);
-                    tempOutputNames.push_back(tempName);
+                    outputNames.push_back(tempName);
+                }
+                in >> tempNum; m->gobble(in);
+                for (int j = 0; j < tempNum; j++) {
+                    int partition; double score;
+                    in >> partition >> score; m->gobble(in);
+                    partitionScores[partition] = score;
                 }
             }
 			in.close(); m->mothurRemove(tempFile);
@@ -475,23 +484,38 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             m->appendFilesWithoutHeaders(outputFileName + toString(processIDS[i]), outputFileName);
             m->mothurRemove(outputFileName + toString(processIDS[i]));
         }
+#else
+		processDriver(thislookup, dividedPartitions[0], outputFileName, rels[0], matrix[0], doneFlags, 0);
+#endif
+        
+        for (int i = 0; i < doneFlags.size(); i++) { m->mothurRemove(doneFlags[i]); }
+        
+        if (m->control_pressed) { return 0; }
+        
+        //pick the best partition the same way a single process walking up from K=1 would
+        minPartition = findMinPartition(lastPartition);
         
-        if (processors > 1) { 
+        if (processors > 1) {
+            //partitions past the point a single process would have stopped at are not reported
+            set<string> extraFiles;
+            for (int i = lastPartition+1; i <= maxpartitions; i++) {
+                variables["[tag]"] = toString(i);
+                extraFiles.insert(getOutputFileName("relabund", variables));
+                extraFiles.insert(getOutputFileName("matrix", variables));
+            }
+            
+            vector<string> tempOutputNames = outputNames;
             outputNames.clear();
-            for (int i = 0; i < tempOutputNames.size(); i++) { //remove files if needed
-                string name = tempOutputNames[i];
-                vector<string> parts;
-                m->splitAtChar(name, parts, '.');
-                bool keep = true;
-                if (((parts[parts.size()-1] == "relabund") || (parts[parts.size()-1] == "posterior")) && (parts[parts.size()-2] == "mix")) {
-                    string tempNum = parts[parts.size()-3];
-                    int num;  m->mothurConvert(tempNum, num);
-                    //if (num > minPartition) {
-                     //   m->mothurRemove(tempOutputNames[i]);
-                    //    keep = false; if (m->debug) { m->mothurOut("[DEBUG]: removing " + tempOutputNames[i] + ".\n"); }
-                    //}
-                }
-                if (keep) { outputNames.push_back(tempOutputNames[i]); }
+            for (int i = 0; i < tempOutputNames.size(); i++) {
+                if (extraFiles.count(tempOutputNames[i]) != 0) {
+                    m->mothurRemove(tempOutputNames[i]);
+                    if (m->debug) { m->mothurOut("[DEBUG]: removing " + tempOutputNames[i] + ".\n"); }
+                }else { outputNames.push_back(tempOutputNames[i]); }
+            }
+            for (map<string, vector<string> >::iterator it = outputTypes.begin(); it != outputTypes.end(); it++) {
+                vector<string> temp;
+                for (int i = 0; i < (it->second).size(); i++) { if (extraFiles.count((it->second)[i]) == 0) { temp.push_back((it->second)[i]); } }
+                it->second = temp;
             }
             
             //reorder fit file
@@ -503,9 +527,9 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             while (!in.eof()) {
                 string numString, line;
                 int num;
-                in >> numString; line = m->getline(in); m->gobble(in);
+                in >> numString; m->gobble(in); line = m->getline(in); m->gobble(in);
                 m->mothurConvert(numString, num);
-                file[num] = line;
+                if (num <= lastPartition) { file[num] = line; }
             }
             in.close();
             ofstream out;
@@ -518,17 +542,6 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
             out.close();
         }
         
-#else
-        m->mothurOut("K\tNLE\t\tlogDet\tBIC\t\tAIC\t\tLaplace\n");
-		minPartition = processDriver(thislookup, dividedPartitions[0], outputFileName, rels[0], matrix[0], doneFlags, 0);
-#endif
-        for (int i = 0; i < processors; i++) { //read from everyone elses, just write to yours
-            string tempDoneFile = m->getRootName(m->getSimpleName(sharedfile)) + toString(i) + ".done.temp";
-            m->mothurRemove(tempDoneFile);
-        }
-        
-        if (m->control_pressed) { return 0; }
-        
         if (m->debug) { m->mothurOut("[DEBUG]: minPartition = " + toString(minPartition) + "\n"); }
         
         //run generate Summary function for smallest minPartition
@@ -545,7 +558,78 @@ int GetMetaCommunityCommand::createProcesses(vector<SharedRAbundVector*>& thislo
 	}
 }
 //**********************************************************************************************************************
-int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislookup, vector<int>& parts, string outputFileName, vector<string> relabunds, vector<string> matrix, vector<string> doneFlags, int processID){
+//walks the partition scores in order applying the optimizegap stopping rule. Returns the best partition and sets the last partition evaluated.
+int GetMetaCommunityCommand::findMinPartition(int& lastPartition){
+	try {
+        double minLaplace = 1e10;
+        if ((method == "pam") || (method == "kmeans")) { minLaplace = 0; } //because ch is looking of maximal value
+        int minPartition = 1;
+        lastPartition = maxpartitions;
+        
+        for (map<int, double>::iterator it = partitionScores.begin(); it != partitionScores.end(); it++) {
+            int numPartitions = it->first;
+            
+            if ((method == "pam") || (method == "kmeans")) {
+                if (it->second > minLaplace) { minPartition = numPartitions; minLaplace = it->second; }
+            }else {
+                if (it->second < minLaplace) { minPartition = numPartitions; minLaplace = it->second; }
+            }
+            
+            if(optimizegap != -1 && (numPartitions - minPartition) >= optimizegap && numPartitions >= minpartitions){
+                lastPartition = numPartitions;
+                break;
+            }
+        }
+        
+        return minPartition;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetMetaCommunityCommand", "findMinPartition");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//reads the scores in the done flags and walks them up from K=1 while there are no gaps, applying the optimizegap rule.
+//True if a single process would have stopped before numPartitions.
+bool GetMetaCommunityCommand::pastStoppingPoint(int numPartitions, vector<string>& doneFlags){
+	try {
+        map<int, double> scores;
+        for (int i = 0; i < doneFlags.size(); i++) {
+            ifstream in;
+            m->openInputFile(doneFlags[i], in, "");
+            int partition; double score; string marker;
+            while (in >> partition >> score >> marker) {
+                if (marker == "end") { scores[partition] = score; }
+            }
+            in.close();
+        }
+        
+        double minLaplace = 1e10;
+        if ((method == "pam") || (method == "kmeans")) { minLaplace = 0; } //because ch is looking of maximal value
+        int minPartition = 1;
+        
+        for (int k = 1; k < numPartitions; k++) {
+            map<int, double>::iterator it = scores.find(k);
+            if (it == scores.end()) { return false; } //a lower partition is still being fitted
+            
+            if ((method == "pam") || (method == "kmeans")) {
+                if (it->second > minLaplace) { minPartition = k; minLaplace = it->second; }
+            }else {
+                if (it->second < minLaplace) { minPartition = k; minLaplace = it->second; }
+            }
+            
+            if((k - minPartition) >= optimizegap && k >= minpartitions){ return true; }
+        }
+        
+        return false;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetMetaCommunityCommand", "pastStoppingPoint");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislookup, vector<int>& parts, string outputFileName, vector<string> relabunds, vector<string> matrix, vector<string>& doneFlags, int processID){
 	try {
         
         double minLaplace = 1e10;
@@ -596,18 +680,14 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
             
             if (m->control_pressed) { break; }
             
-            //check to see if anyone else is done
-            for (int j = 0; j < doneFlags.size(); j++) {
-                if (!m->isBlank(doneFlags[j])) { //another process has finished
-                    //are they done at a lower partition?
-                    ifstream in;
-                    m->openInputFile(doneFlags[j], in);
-                    int tempNum;
-                    in >> tempNum; in.close();
-                    if (tempNum < numPartitions) { break; } //quit, because someone else has finished
-                }
+            //check to see if the partitions the processes have fitted already stop the search before this one
+            if ((doneFlags.size() != 0) && pastStoppingPoint(numPartitions, doneFlags)) {
+                if (m->debug) { m->mothurOut("[DEBUG]: stopping before partition " + toString(numPartitions) + "\n"); }
+                break;
             }
             
+            srand(seedBase + numPartitions);
+            
             CommunityTypeFinder* finder = NULL;
             if (method == "dmm")            {   finder = new qFinderDMM(sharedMatrix, numPartitions);   }
             else if (method == "kmeans")    {   finder = new KMeans(sharedMatrix, numPartitions);       }
@@ -626,6 +706,7 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
             double chi; vector<double> silhouettes;
             if (method == "dmm") {
                 double laplace = finder->getLaplace();
+                partitionScores[numPartitions] = laplace;
                 if(laplace < minLaplace){
                     minPartition = numPartitions;
                     minLaplace = laplace;
@@ -633,6 +714,7 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
             }else {
                 chi = finder->calcCHIndex(dists);
                 silhouettes = finder->calcSilhouettes(dists);
+                partitionScores[numPartitions] = chi;
                 if (chi > minLaplace) { //save partition with maximum ch index score
                     minPartition = numPartitions;
                     minLaplace = chi;
@@ -655,12 +737,16 @@ int GetMetaCommunityCommand::processDriver(vector<SharedRAbundVector*>& thislook
             }
             delete finder;
             
-            if(optimizegap != -1 && (numPartitions - minPartition) >= optimizegap && numPartitions >= minpartitions){
-                string tempDoneFile = m->getRootName(m->getSimpleName(sharedfile)) + toString(processID) + ".done.temp";
+            if (doneFlags.size() != 0) {
+                //the end marker lets a reader skip a line that is still being written
                 ofstream outDone;
-                m->openOutputFile(tempDoneFile, outDone);
-                outDone << minPartition << endl;
+                m->openOutputFileAppend(doneFlags[processID], outDone);
+                outDone << setprecision(17) << numPartitions << '\t' << partitionScores[numPartitions] << "\tend" << endl;
                 outDone.close();
+            }
+            
+            //with several processes the partitions are interleaved, so the stopping rule is applied to the shared scores instead
+            if(processors == 1 && optimizegap != -1 && (numPartitions - minPartition) >= optimizegap && numPartitions >= minpartitions){
                 break;
             }
         }
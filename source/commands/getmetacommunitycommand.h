@@ -83,13 +83,16 @@ private:
     string outputDir;
     vector<string> outputNames;
     string sharedfile, method, calc;
-    int minpartitions, maxpartitions, optimizegap, processors, iters, subsampleSize;
+    int minpartitions, maxpartitions, optimizegap, processors, iters, subsampleSize, seedBase;
+    map<int, double> partitionScores; //partition -> laplace for dmm, ch index for pam and kmeans
     vector<string> Groups, Estimators;
     set<string> labels;
     
     vector<vector<double> > generateDistanceMatrix(vector<SharedRAbundVector*>& lookup);
     int driver(vector<SharedRAbundVector*> thisLookup, vector< vector<seqDist> >& calcDists, Calculator*);
-    int processDriver(vector<SharedRAbundVector*>&, vector<int>&, string, vector<string>, vector<string>, vector<string>, int);
+    int processDriver(vector<SharedRAbundVector*>&, vector<int>&, string, vector<string>, vector<string>, vector<string>&, int);
+    int findMinPartition(int&);
+    bool pastStoppingPoint(int, vector<string>&);
     int createProcesses(vector<SharedRAbundVector*>&);
     vector<double> generateDesignFile(int, map<string,string>);
     int generateSummaryFile(int, map<string,string>, vector<double>);
@@ -54,6 +54,7 @@ vector<string> GetOTURepCommand::setParameters(){
 		CommandParameter psorted("sorted", "Multiple", "none-name-bin-size-group", "none", "", "", "","",false,false); parameters.push_back(psorted);
         CommandParameter pmethod("method", "Multiple", "distance-abundance", "distance", "", "", "","",false,false); parameters.push_back(pmethod);
 		CommandParameter plarge("large", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(plarge);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -71,7 +72,7 @@ vector<string> GetOTURepCommand::setParameters(){
 string GetOTURepCommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The get.oturep command parameters are phylip, column, list, fasta, name, group, count, large, weighted, cutoff, precision, groups, sorted, method and label.  The list parameter is required, as well as phylip or column and name if you are using method=distance. If method=abundance a name or count file is required.\n";
+		helpString += "The get.oturep command parameters are phylip, column, list, fasta, name, group, count, large, weighted, cutoff, precision, groups, sorted, method, processors and label.  The list parameter is required, as well as phylip or column and name if you are using method=distance. If method=abundance a name or count file is required.\n";
 		helpString += "The label parameter allows you to select what distance levels you would like a output files created for, and is separated by dashes.\n";
 		helpString += "The phylip or column parameter is required for method=distance, but only one may be used.  If you use a column file the name or count filename is required. \n";
         helpString += "The method parameter allows you to select the method of selecting the representative sequence. Choices are distance and abundance.  The distance method finds the sequence with the smallest maximum distance to the other sequences. If tie occurs the sequence with smallest average distance is selected.  The abundance method chooses the most abundant sequence in the OTU as the representative.\n";
@@ -81,6 +82,7 @@ string GetOTURepCommand::getHelpString(){
 		helpString += "The default value for label is all labels in your inputfile.\n";
 		helpString += "The sorted parameter allows you to indicate you want the output sorted. You can sort by sequence name, bin number, bin size or group. The default is no sorting, but your options are name, number, size, or group.\n";
 		helpString += "The large parameter allows you to indicate that your distance matrix is too large to fit in RAM.  The default value is false.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use when finding the representatives with method=distance. The default is 1.\n";
 		helpString += "The weighted parameter allows you to indicate that want to find the weighted representative. You must provide a namesfile to set weighted to true.  The default value is false.\n";
 		helpString += "The representative is found by selecting the sequence that has the smallest total distance to all other sequences in the OTU. If a tie occurs the smallest average distance is used.\n";
 		helpString += "For weighted = false, mothur assumes the distance file contains only unique sequences, the list file may contain all sequences, but only the uniques are considered to become the representative. If your distance file contains all the sequences it would become weighted=true.\n";
@@ -383,6 +385,10 @@ GetOTURepCommand::GetOTURepCommand(string option)  {
 			temp = validParameter.validFile(parameters, "cutoff", false);			if (temp == "not found") { temp = "10.0"; }
 			m->mothurConvert(temp, cutoff); 
 			cutoff += (5 / (precision * 10.0));
+			
+			temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
 		}
 	}
 	catch(exception& e) {
@@ -408,7 +414,7 @@ int GetOTURepCommand::execute(){
             if (namefile != "") { nameToIndex = m->readNames(namefile); }
         }
         
-        if (m->control_pressed) { if (method=="distance") { if (large) {  inRow.close(); m->mothurRemove(distFile);  } }return 0; }
+        if (m->control_pressed) { if (method=="distance") { if (large) {  m->mothurRemove(distFile);  } }return 0; }
         
         if (groupfile != "") {
             //read in group map info.
@@ -441,7 +447,7 @@ int GetOTURepCommand::execute(){
         set<string> processedLabels;
         set<string> userLabels = labels;
         
-        if (m->control_pressed) { if (method=="distance") {  if (large) {  inRow.close(); m->mothurRemove(distFile);  } }  delete list; return 0; }
+        if (m->control_pressed) { if (method=="distance") {  if (large) {  m->mothurRemove(distFile);  } }  delete list; return 0; }
         
         while((list != NULL) && ((allLines == 1) || (userLabels.size() != 0))) {
             
@@ -451,7 +457,7 @@ int GetOTURepCommand::execute(){
                 if (error == 1) { return 0; } //there is an error in hte input files, abort command
                 
                 if (m->control_pressed) {
-                    if (method=="distance") { if (large) {  inRow.close(); m->mothurRemove(distFile);  } }
+                    if (method=="distance") { if (large) {  m->mothurRemove(distFile);  } }
                     for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]);  } outputTypes.clear();
                     delete list; return 0;
                 }
@@ -470,7 +476,7 @@ int GetOTURepCommand::execute(){
                 if (error == 1) { return 0; } //there is an error in hte input files, abort command
                 
                 if (m->control_pressed) {
-                    if (method=="distance") { if (large) {  inRow.close(); m->mothurRemove(distFile);  } }
+                    if (method=="distance") { if (large) {  m->mothurRemove(distFile);  } }
                     for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]);  } outputTypes.clear();
                     delete list; return 0;
                 }
@@ -510,14 +516,14 @@ int GetOTURepCommand::execute(){
             if (error == 1) { return 0; } //there is an error in hte input files, abort command
             
             if (m->control_pressed) {
-                if (method=="distance") { if (large) {  inRow.close(); m->mothurRemove(distFile);  } }
+                if (method=="distance") { if (large) {  m->mothurRemove(distFile);  } }
                 for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]);  } outputTypes.clear();
                 delete list; return 0;
             }
         }
         
         //close and remove formatted matrix file
-        if (method=="distance") { if (large) { inRow.close(); m->mothurRemove(distFile); } if (!weighted) { nameFileMap.clear(); } }
+        if (method=="distance") { if (large) { m->mothurRemove(distFile); } if (!weighted) { nameFileMap.clear(); } }
          
         if (fastafile != "") {
             //read fastafile
@@ -656,10 +662,7 @@ int GetOTURepCommand::readDist() {
 			delete formatMatrix;
 			delete nameMap;
 			
-			//openfile for getMap to use
-			m->openInputFile(distFile, inRow);
-			
-			if (m->control_pressed) { inRow.close(); m->mothurRemove(distFile); return 0; }
+			if (m->control_pressed) { m->mothurRemove(distFile); return 0; }
 		}
 		
 		
@@ -680,7 +683,7 @@ int GetOTURepCommand::readDist() {
 			}
 		} else { m->mothurOut("error, no listvector."); m->mothurOutEndLine(); }
 
-        if (m->control_pressed) { if (large) {  inRow.close(); m->mothurRemove(distFile);  }return 0; }
+        if (m->control_pressed) { if (large) {  m->mothurRemove(distFile);  }return 0; }
         
         return 0;
     }
@@ -815,118 +818,269 @@ string GetOTURepCommand::findRepAbund(vector<string> names, string group) {
 	}
 }
 //**********************************************************************************************************************
-string GetOTURepCommand::findRep(vector<string> names, string group) {
+//collapses the names in a bin to the distinct rows of the distance matrix they use. Each row keeps the first name
+//that used it and the number of reads it stands for, so abundant sequences are weighted without being repeated.
+int GetOTURepCommand::getRepUnits(vector<string>& names, string group, vector<int>& rows, vector<int>& weights, vector<string>& unitNames) {
+	try{
+        map<int, int> rowToUnit;
+        map<string, string>::iterator itNameFile;
+        map<string, int>::iterator itNameIndex;
+        
+        int dummyRow = seqVec.size()-1;
+        if (large) { dummyRow = rowPositions.size()-1; }
+        
+        for (size_t i = 0; i < names.size(); i++) {
+            int row = dummyRow;
+            int weight = 1;
+            
+            if (weighted) {
+                row = nameToIndex[names[i]];
+                if (countfile != "") {  //if countfile is not blank then we can assume the list file contains only uniques, otherwise we assume list file contains everyone.
+                    int numRep = 0;
+                    if (group != "") {  numRep = ct.getGroupCount(names[i], group);  }
+                    else { numRep = ct.getNumSeqs(names[i]);  }
+                    if (numRep > 1) { weight = numRep; }
+                }
+            }else {
+                if (namefile == "") {
+                    itNameIndex = nameToIndex.find(names[i]);
+                    
+                    // you are not in the distance file and no namesfile, then assume you are not unique
+                    if (itNameIndex != nameToIndex.end()) { row = itNameIndex->second; }
+                    
+                }else {
+                    itNameFile = nameFileMap.find(names[i]);
+                    
+                    if (itNameFile == nameFileMap.end()) {
+                        m->mothurOut("[ERROR]: " + names[i] + " is not in your namefile, please correct."); m->mothurOutEndLine(); m->control_pressed = true; continue;
+                    }else{
+                        //if you are unique add your real dists, otherwise the dummy
+                        if (itNameFile->first == itNameFile->second) {  row = nameToIndex[names[i]]; }
+                    }
+                }
+            }
+            
+            map<int, int>::iterator it = rowToUnit.find(row);
+            if (it == rowToUnit.end()) {
+                rowToUnit[row] = rows.size();
+                rows.push_back(row); weights.push_back(weight); unitNames.push_back(names[i]);
+            }else { weights[it->second] += weight; }
+        }
+        
+        return rows.size();
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "getRepUnits");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+// sequence with the smallest maximum distance is the representative
+//if tie occurs pick sequence with smallest average distance
+string GetOTURepCommand::pickRep(vector<string>& unitNames, vector<float>& maxDists, vector<double>& totals) {
+	try{
+        int minIndex = 0;
+        for (int i = 1; i < maxDists.size(); i++) {
+            if (maxDists[i] < maxDists[minIndex]) { minIndex = i; }
+            else if ((maxDists[i] == maxDists[minIndex]) && (totals[i] < totals[minIndex])) { minIndex = i; }
+        }
+        
+        return unitNames[minIndex];
+    }
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "pickRep");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//finds the reps for bins start to end. A missing distance counts as the cutoff, so each row's total starts at
+//cutoff * reads in the bin and every distance found takes off (cutoff - distance) * reads of that row.
+int GetOTURepCommand::driverFindReps(vector< vector<string> >& repNames, vector<string>& repGroups, int start, int end, vector<string>& reps) {
 	try{
-        //if using abundance 
-        if (method == "abundance") { return (findRepAbund(names, group)); }
-        else { //find rep based on distance
+        int numBins = end - start;
+        vector< vector<int> > rows(numBins), weights(numBins);
+        vector< vector<string> > unitNames(numBins);
+        vector< vector<float> > maxDists(numBins);
+        vector< vector<double> > totals(numBins);
+        vector< map<int, int> > rowToUnit(numBins);
+        multimap<int, pair<int, int> > rowToBinUnit; //row in distance file -> bin, unit. only used for large
+        
+        for (int b = 0; b < numBins; b++) {
+            if (m->control_pressed) { return 0; }
             
             // if only 1 sequence in bin or processing the "unique" label, then
             // the first sequence of the OTU is the representative one
-            if ((names.size() == 1)) {
-                return names[0];
-            }else{
-                vector<int> seqIndex; //(names.size());
-                map<string, string>::iterator itNameFile;
-                map<string, int>::iterator itNameIndex;
+            if (repNames[start+b].size() == 1) { continue; }
+            
+            getRepUnits(repNames[start+b], repGroups[start+b], rows[b], weights[b], unitNames[b]);
+            
+            double binSize = 0;
+            for (int u = 0; u < weights[b].size(); u++) { binSize += weights[b][u]; }
+            
+            maxDists[b].resize(rows[b].size(), cutoff);
+            totals[b].resize(rows[b].size(), cutoff * binSize);
+            for (int u = 0; u < rows[b].size(); u++) {
+                rowToUnit[b][rows[b][u]] = u;
+                if (large) { rowToBinUnit.insert(make_pair(rows[b][u], make_pair(b, u))); }
+            }
+        }
+        
+        if (!large) {
+            //seqVec only holds the distances to higher rows, so each pair is found once and counted for both
+            for (int b = 0; b < numBins; b++) {
+                if (m->control_pressed) { return 0; }
                 
-                //fill seqIndex and initialize sums
-                for (size_t i = 0; i < names.size(); i++) {
-                    if (weighted) {
-                        seqIndex.push_back(nameToIndex[names[i]]);
-                        if (countfile != "") {  //if countfile is not blank then we can assume the list file contains only uniques, otherwise we assume list file contains everyone.
-                            int numRep = 0;
-                            if (group != "") {  numRep = ct.getGroupCount(names[i], group);  }
-                            else { numRep = ct.getNumSeqs(names[i]);  }
-                            for (int j = 1; j < numRep; j++) { //don't add yourself again
-                                seqIndex.push_back(nameToIndex[names[i]]);
-                            }
-                        }
-                    }else {
-                        if (namefile == "") {
-                            itNameIndex = nameToIndex.find(names[i]);
-                            
-                            if (itNameIndex == nameToIndex.end()) { // you are not in the distance file and no namesfile, then assume you are not unique
-                                if (large) {  seqIndex.push_back((rowPositions.size()-1)); }
-                                else {  seqIndex.push_back((seqVec.size()-1)); }
-                            }else {
-                                seqIndex.push_back(itNameIndex->second);
-                            }
-                            
-                        }else {
-                            itNameFile = nameFileMap.find(names[i]);
-                            
-                            if (itNameFile == nameFileMap.end()) {
-                                m->mothurOut("[ERROR]: " + names[i] + " is not in your namefile, please correct."); m->mothurOutEndLine(); m->control_pressed = true;
-                            }else{
-                                string name1 = itNameFile->first;
-                                string name2 = itNameFile->second;
-                                
-                                if (name1 == name2) { //then you are unique so add your real dists
-                                    seqIndex.push_back(nameToIndex[names[i]]);
-                                }else { //add dummy
-                                    if (large) {  seqIndex.push_back((rowPositions.size()-1)); }
-                                    else {  seqIndex.push_back((seqVec.size()-1)); }
-                                }
-                            }
-                        }
+                for (int u = 0; u < rows[b].size(); u++) {
+                    SeqMap& rowDists = seqVec[rows[b][u]];
+                    for (SeqMap::iterator it = rowDists.begin(); it != rowDists.end(); it++) {
+                        map<int, int>::iterator itUnit = rowToUnit[b].find(it->first);
+                        if (itUnit == rowToUnit[b].end()) { continue; }
+                        
+                        int v = itUnit->second;
+                        totals[b][u] -= weights[b][v] * (cutoff - it->second);
+                        totals[b][v] -= weights[b][u] * (cutoff - it->second);
+                        maxDists[b][u] = max(maxDists[b][u], it->second);
+                        maxDists[b][v] = max(maxDists[b][v], it->second);
                     }
                 }
+            }
+        }else if (rowToBinUnit.size() != 0) {
+            //the formatted file holds both halves of the matrix, so read it through once and use the rows we need
+            ifstream inDist;
+            m->openInputFile(distFile, inDist);
+            
+            int rowNum = -1; int numDists = 0; int colNum;
+            float dist;
+            vector< pair<int, float> > rowDists;
+            
+            while (inDist >> rowNum >> numDists) {
+                if (m->control_pressed) { inDist.close(); return 0; }
                 
-                vector<float> max_dist(seqIndex.size(), 0.0);
-                vector<float> total_dist(seqIndex.size(), 0.0);
+                pair<multimap<int, pair<int, int> >::iterator, multimap<int, pair<int, int> >::iterator> binUnits = rowToBinUnit.equal_range(rowNum);
+                if (binUnits.first == binUnits.second) { m->getline(inDist); m->gobble(inDist); continue; }
                 
-                // loop through all entries in seqIndex
-                SeqMap::iterator it;
-                SeqMap currMap;
-                for (size_t i=0; i < seqIndex.size(); i++) {
-                    if (m->control_pressed) {  return  "control"; }
-                    
-                    if (!large) {	currMap = seqVec[seqIndex[i]];  }
-                    else		{	currMap = getMap(seqIndex[i]);	}
-                    
-                    for (size_t j=0; j < seqIndex.size(); j++) {
-                        it = currMap.find(seqIndex[j]);
-                        if (it != currMap.end()) {
-                            max_dist[i] = max(max_dist[i], it->second);
-                            max_dist[j] = max(max_dist[j], it->second);
-                            total_dist[i] += it->second;
-                            total_dist[j] += it->second;
-                        }else{ //if you can't find the distance make it the cutoff
-                            max_dist[i] = max(max_dist[i], cutoff);
-                            max_dist[j] = max(max_dist[j], cutoff);
-                            total_dist[i] += cutoff;
-                            total_dist[j] += cutoff;
-                        }
-                    }
+                rowDists.clear();
+                for (int i = 0; i < numDists; i++) {
+                    inDist >> colNum >> dist;
+                    rowDists.push_back(make_pair(colNum, dist));
                 }
+                m->gobble(inDist);
                 
-                // sequence with the smallest maximum distance is the representative
-                //if tie occurs pick sequence with smallest average distance
-                float min = 10000;
-                int minIndex;
-                for (size_t i=0; i < max_dist.size(); i++) {
-                    if (m->control_pressed) {  return  "control"; }
-                    if (max_dist[i] < min) {
-                        min = max_dist[i];
-                        minIndex = i;
-                    }else if (max_dist[i] == min) {
-                        float currentAverage = total_dist[minIndex] / (float) total_dist.size();
-                        float newAverage = total_dist[i] / (float) total_dist.size();
+                for (multimap<int, pair<int, int> >::iterator it = binUnits.first; it != binUnits.second; it++) {
+                    int b = it->second.first; int u = it->second.second;
+                    for (int i = 0; i < rowDists.size(); i++) {
+                        map<int, int>::iterator itUnit = rowToUnit[b].find(rowDists[i].first);
+                        if (itUnit == rowToUnit[b].end()) { continue; }
                         
-                        if (newAverage < currentAverage) {
-                            min = max_dist[i];
-                            minIndex = i;
-                        }
+                        totals[b][u] -= weights[b][itUnit->second] * (cutoff - rowDists[i].second);
+                        maxDists[b][u] = max(maxDists[b][u], rowDists[i].second);
                     }
                 }
+            }
+            inDist.close();
+        }
+        
+        for (int b = 0; b < numBins; b++) {
+            if (repNames[start+b].size() == 1) { reps.push_back(repNames[start+b][0]); }
+            else { reps.push_back(pickRep(unitNames[b], maxDists[b], totals[b])); }
+        }
+        
+        return reps.size();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "GetOTURepCommand", "driverFindReps");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int GetOTURepCommand::findReps(vector< vector<string> >& repNames, vector<string>& repGroups, vector<string>& reps) {
+	try{
+        //abundance ties are broken randomly, so those stay in bin order
+        if (method == "abundance") {
+            for (int i = 0; i < repNames.size(); i++) {
+                if (m->control_pressed) { return 0; }
+                reps.push_back(findRepAbund(repNames[i], repGroups[i]));
+            }
+            return reps.size();
+        }
+        
+        #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        #else
+        processors=1; //bins are only divided between forked processes
+        #endif
+        
+        int numProcs = processors;
+        if (repNames.size() < numProcs) { numProcs = repNames.size(); }
+        if (numProcs < 1) { numProcs = 1; }
+        
+        //divide the bins between the processors
+        vector<int> starts, ends;
+        int binsPerProcessor = repNames.size() / numProcs;
+        for (int i = 0; i < numProcs; i++) {
+            starts.push_back(i * binsPerProcessor);
+            if (i == (numProcs - 1)) { ends.push_back(repNames.size()); }
+            else { ends.push_back((i+1) * binsPerProcessor); }
+        }
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        vector<int> processIDS;
+        int process = 1;
+        
+		//loop through and create all the processes you want
+		while (process != numProcs) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
+				process++;
+			}else if (pid == 0){
+                vector<string> childReps;
+                driverFindReps(repNames, repGroups, starts[process], ends[process], childReps);
                 
-                return(names[minIndex]);
+                //pass reps to parent
+				ofstream out;
+				string tempFile = m->mothurGetpid(process) + ".oturep.temp";
+				m->openOutputFile(tempFile, out);
+				for (int i = 0; i < childReps.size(); i++) { out << childReps[i] << endl; }
+				out.close();
+                
+				exit(0);
+			}else {
+				m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
+				for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+				exit(0);
+			}
+		}
+		
+		//do my part
+		driverFindReps(repNames, repGroups, starts[0], ends[0], reps);
+		
+		//force parent to wait until all the processes are done
+		for (int i=0;i<processIDS.size();i++) {
+			int temp = processIDS[i];
+			wait(&temp);
+		}
+        
+        for (int i=0;i<processIDS.size();i++) {
+            ifstream in;
+			string tempFile = toString(processIDS[i]) + ".oturep.temp";
+			m->openInputFile(tempFile, in);
+            while (!in.eof()) {
+                string rep = ""; in >> rep; m->gobble(in);
+                if (rep != "") { reps.push_back(rep); }
             }
+			in.close(); m->mothurRemove(tempFile);
         }
+        
+        if ((!m->control_pressed) && (reps.size() != repNames.size())) { m->mothurOut("[ERROR]: did not find a representative for every bin, quitting.\n"); m->control_pressed = true; }
+#else
+		driverFindReps(repNames, repGroups, starts[0], ends[0], reps);
+#endif
+        
+        return reps.size();
 	}
 	catch(exception& e) {
-		m->errorOut(e, "GetOTURepCommand", "FindRep");
+		m->errorOut(e, "GetOTURepCommand", "findReps");
 		exit(1);
 	}
 }
@@ -979,8 +1133,11 @@ int GetOTURepCommand::process(ListVector* processList) {
 			}
 		}
 		
-		//for each bin in the list vector
+		//for each bin in the list vector, collect the names a rep is needed for
         vector<string> binLabels = processList->getLabels();
+        vector< vector<string> > repNames; //names in the bin, or in the part of the bin from one group
+        vector<string> repGroups;
+        vector<int> repBins;
 		for (int i = 0; i < processList->size(); i++) {
         
 			if (m->control_pressed) { out.close(); if (Groups.size() == 0) { newNamesOutput.close(); } return 0; }
@@ -990,22 +1147,7 @@ int GetOTURepCommand::process(ListVector* processList) {
 			m->splitAtComma(temp, namesInBin);
 			
 			if (Groups.size() == 0) {
-				nameRep = findRep(namesInBin, "");
-				newNamesOutput << binLabels[i] << '\t' << nameRep << '\t';
-                
-                //put rep at first position in names line
-                string outputString = nameRep + ",";
-                for (int k=0; k<namesInBin.size()-1; k++) {//output list of names in this otu
-                    if (namesInBin[k] != nameRep) { outputString += namesInBin[k] + ","; }
-                }
-                
-                //output last name
-                if (namesInBin[namesInBin.size()-1] != nameRep) { outputString += namesInBin[namesInBin.size()-1]; }
-                
-                if (outputString[outputString.length()-1] == ',') { //rip off comma
-                    outputString = outputString.substr(0, outputString.length()-1);
-                }
-                newNamesOutput << outputString << endl;
+				repNames.push_back(namesInBin); repGroups.push_back(""); repBins.push_back(i);
 			}else{
 				map<string, vector<string> > NamesInGroup;
 				for (int j=0; j<Groups.size(); j++) { //initialize groups
@@ -1027,35 +1169,45 @@ int GetOTURepCommand::process(ListVector* processList) {
                     }
 				}
 				
-				//get rep for each group in otu
+				//are there members from this group in this otu?
 				for (int j=0; j<Groups.size(); j++) {
-					if (NamesInGroup[Groups[j]].size() != 0) { //are there members from this group in this otu?
-						//get rep for each group
-						nameRep = findRep(NamesInGroup[Groups[j]], Groups[j]);
-						
-						//output group rep and other members of this group
-                        ofstream outGroup;
-                        m->openOutputFileAppend(files[Groups[j]], outGroup);
-						outGroup << binLabels[i] << '\t' << nameRep << '\t';
-						
-                        //put rep at first position in names line
-                        string outputString = nameRep + ",";
-                        for (int k=0; k<NamesInGroup[Groups[j]].size()-1; k++) {//output list of names in this otu from this group
-                            if (NamesInGroup[Groups[j]][k] != nameRep) { outputString +=  NamesInGroup[Groups[j]][k] + ","; }
-                        }
-                        
-                        //output last name
-                        if (NamesInGroup[Groups[j]][NamesInGroup[Groups[j]].size()-1] != nameRep) { outputString += NamesInGroup[Groups[j]][NamesInGroup[Groups[j]].size()-1]; }
-                        
-                        if (outputString[outputString.length()-1] == ',') { //rip off comma
-                            outputString = outputString.substr(0, outputString.length()-1);
-                        }
-                        outGroup << outputString << endl; outGroup.close();
-					}
+					if (NamesInGroup[Groups[j]].size() != 0) { repNames.push_back(NamesInGroup[Groups[j]]); repGroups.push_back(Groups[j]); repBins.push_back(i); }
 				}
 			}
 		}
 		
+		vector<string> reps;
+		findReps(repNames, repGroups, reps);
+		
+		if (m->control_pressed) { out.close(); if (Groups.size() == 0) { newNamesOutput.close(); } return 0; }
+		
+		for (int i = 0; i < repNames.size(); i++) {
+			nameRep = reps[i];
+			vector<string>& namesInRep = repNames[i];
+			
+            //put rep at first position in names line
+            string outputString = nameRep + ",";
+            for (int k=0; k<namesInRep.size()-1; k++) {//output list of names in this otu
+                if (namesInRep[k] != nameRep) { outputString += namesInRep[k] + ","; }
+            }
+            
+            //output last name
+            if (namesInRep[namesInRep.size()-1] != nameRep) { outputString += namesInRep[namesInRep.size()-1]; }
+            
+            if (outputString[outputString.length()-1] == ',') { //rip off comma
+                outputString = outputString.substr(0, outputString.length()-1);
+            }
+			
+			if (Groups.size() == 0) {
+				newNamesOutput << binLabels[repBins[i]] << '\t' << nameRep << '\t' << outputString << endl;
+			}else{
+				//output group rep and other members of this group
+				ofstream outGroup;
+				m->openOutputFileAppend(files[repGroups[i]], outGroup);
+				outGroup << binLabels[repBins[i]] << '\t' << nameRep << '\t' << outputString << endl; outGroup.close();
+			}
+		}
+		
         //you don't want to use groups
 		if (Groups.size() == 0) { newNamesOutput.close(); }
 		
@@ -1282,33 +1434,4 @@ int GetOTURepCommand::processNames(string filename, string label) {
 	}
 }
 //**********************************************************************************************************************
-SeqMap GetOTURepCommand::getMap(int row) {
-	try {
-		SeqMap rowMap;
-		
-		//make sure this row exists in the file, it may not if the seq did not have any distances below the cutoff
-		if (rowPositions[row] != -1){
-			//go to row in file
-			inRow.seekg(rowPositions[row]);
-			
-			int rowNum, numDists, colNum;
-			float dist;
-			
-			inRow >> rowNum >> numDists;
-			
-			for(int i = 0; i < numDists; i++) {
-				inRow >> colNum >> dist;
-				rowMap[colNum] = dist;
-				
-			}
-		}
-		
-		return rowMap;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "GetOTURepCommand", "getMap");
-		exit(1);
-	}
-}
-//**********************************************************************************************************************
 
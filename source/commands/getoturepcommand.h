@@ -64,7 +64,7 @@ private:
     CountTable ct;
 	string filename, fastafile, listfile, namefile, groupfile, label, sorted, phylipfile, countfile, columnfile, distFile, format, outputDir, groups, method;
 	ofstream out;
-	ifstream in, inNames, inRow;
+	ifstream in, inNames;
 	bool abort, allLines, groupError, large, weighted, hasGroups;
 	set<string> labels; //holds labels to be used
 	map<string, int> nameToIndex;  //maps sequence name to index in sparsematrix
@@ -72,7 +72,7 @@ private:
 	vector<string> outputNames, Groups;
 	map<string, string> outputNameFiles;
 	float cutoff;
-	int precision;
+	int precision, processors;
 	vector<SeqMap> seqVec;			// contains maps with sequence index and distance
 									// for all distances related to a certain sequence
 	vector<int> rowPositions;
@@ -80,9 +80,11 @@ private:
 	void readNamesFile(FastaMap*&);
 	void readNamesFile(bool);
 	int process(ListVector*);
-	SeqMap getMap(int);
-	string findRep(vector<string>, string); 	// returns the name of the "representative" sequence of given bin or subset of a bin, for groups
     string findRepAbund(vector<string>, string);
+    int findReps(vector< vector<string> >&, vector<string>&, vector<string>&); //names in each bin or subset of a bin for groups, group, reps found
+    int driverFindReps(vector< vector<string> >&, vector<string>&, int, int, vector<string>&);
+    int getRepUnits(vector<string>&, string, vector<int>&, vector<int>&, vector<string>&);
+    string pickRep(vector<string>&, vector<float>&, vector<double>&);
 	int processNames(string, string);
 	int processFastaNames(string, string, FastaMap*&);
     int readDist();
@@ -12,6 +12,7 @@
 #include "listvector.hpp"
 #include "counttable.h"
 #include "fastqread.h"
+#include "seqindexfile.h"
 
 //**********************************************************************************************************************
 vector<string> GetSeqsCommand::setParameters(){	
@@ -27,6 +28,7 @@ vector<string> GetSeqsCommand::setParameters(){
 		CommandParameter pqfile("qfile", "InputTypes", "", "", "none", "FNGLT", "none","qfile",false,false); parameters.push_back(pqfile);
 		CommandParameter paccnos("accnos", "InputTypes", "", "", "none", "none", "none","",false,true,true); parameters.push_back(paccnos);
 		CommandParameter pdups("dups", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pdups);
+        CommandParameter pindex("index", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pindex);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
         CommandParameter pformat("format", "Multiple", "sanger-illumina-solexa-illumina1.8+", "illumina1.8+", "", "", "","",false,false,true); parameters.push_back(pformat);
@@ -48,9 +50,10 @@ string GetSeqsCommand::getHelpString(){
 		string helpString = "";
 		helpString += "The get.seqs command reads an .accnos file and any of the following file types: fasta, name, group, count, list, taxonomy, quality, fastq or alignreport file.\n";
 		helpString += "It outputs a file containing only the sequences in the .accnos file.\n";
-		helpString += "The get.seqs command parameters are accnos, fasta, name, group, list, taxonomy, qfile, alignreport, fastq and dups.  You must provide accnos unless you have a valid current accnos file, and at least one of the other parameters.\n";
+		helpString += "The get.seqs command parameters are accnos, fasta, name, group, list, taxonomy, qfile, alignreport, fastq, dups and index.  You must provide accnos unless you have a valid current accnos file, and at least one of the other parameters.\n";
 		helpString += "The dups parameter allows you to add the entire line from a name file if you add any name from the line. default=true. \n";
         helpString += "The format parameter is used to indicate whether your sequences are sanger, solexa, illumina1.8+ or illumina, default=illumina1.8+.\n";
+		helpString += "The index parameter allows you to save an index of your fasta, quality or fastq file as filename.idx in the output directory. Later runs with index=t on the same unchanged file use it to read only the sequences they need. default=false.\n";
 		helpString += "The get.seqs command should be in the following format: get.seqs(accnos=yourAccnos, fasta=yourFasta).\n";
 		helpString += "Example get.seqs(accnos=amazon.accnos, fasta=amazon.fasta).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. fasta), '=' and parameters (i.e.yourFasta).\n";
@@ -316,6 +319,9 @@ GetSeqsCommand::GetSeqsCommand(string option)  {
 			string temp = validParameter.validFile(parameters, "dups", false);	if (temp == "not found") { temp = "true"; usedDups = ""; }
 			dups = m->isTrue(temp);
             
+            temp = validParameter.validFile(parameters, "index", false);		if (temp == "not found") { temp = "f"; }
+            index = m->isTrue(temp);
+            
             format = validParameter.validFile(parameters, "format", false);		if (format == "not found"){	format = "illumina1.8+";	}
             
             if ((format != "sanger") && (format != "illumina") && (format != "illumina1.8+") && (format != "solexa"))  {
@@ -444,8 +450,14 @@ int GetSeqsCommand::readFastq(){
 		ofstream out;
 		m->openOutputFile(outputFileName, out);
 
+        //with a current index only the reads wanted are read
+        string indexFile = "";
+        if (index) { indexFile = thisOutputDir + m->getSimpleName(fastqfile) + ".idx"; }
+        SeqIndexFile seqIndex(fastqfile, indexFile);
+        seqIndex.select(names, true);
+        
         set<string> uniqueNames;
-		while(!in.eof()){
+		while(seqIndex.nextRecord(in)){
 			
 			if (m->control_pressed) { in.close(); out.close(); m->mothurRemove(outputFileName); return 0; }
 			
@@ -455,6 +467,7 @@ int GetSeqsCommand::readFastq(){
             
 			if (!ignore) {
                 string name = fread.getName();
+                seqIndex.add(name);
                 
                 if (names.count(name) != 0) {
                     if (uniqueNames.count(name) == 0) { //this name hasn't been seen yet
@@ -472,6 +485,7 @@ int GetSeqsCommand::readFastq(){
 		}
 		in.close();
 		out.close();
+        if (seqIndex.save()) { outputNames.push_back(indexFile); }
         
 		if (wroteSomething == false) { m->mothurOut("Your file does not contain any sequence from the .accnos file."); m->mothurOutEndLine();  }
 		outputNames.push_back(outputFileName);  outputTypes["fastq"].push_back(outputFileName);
@@ -508,13 +522,20 @@ int GetSeqsCommand::readFasta(){
         
         if (m->debug) { set<string> temp; sanity["fasta"] = temp; }
 		
+        //with a current index only the sequences wanted are read. The index is by the names in the file, so not when they are being changed
+        string indexFile = "";
+        if (index) { indexFile = thisOutputDir + m->getSimpleName(fastafile) + ".idx"; }
+        SeqIndexFile seqIndex(fastafile, indexFile);
+        if (uniqueMap.size() == 0) { seqIndex.select(names, true); }
+        
         set<string> uniqueNames;
-		while(!in.eof()){
+		while(seqIndex.nextRecord(in)){
 		
 			if (m->control_pressed) { in.close(); out.close(); m->mothurRemove(outputFileName);  return 0; }
 			
 			Sequence currSeq(in);
 			name = currSeq.getName();
+            seqIndex.add(name);
             
             if (!dups) {//adjust name if needed
                 map<string, string>::iterator it = uniqueMap.find(name);
@@ -543,7 +564,7 @@ int GetSeqsCommand::readFasta(){
 		}
 		in.close();	
 		out.close();
-		
+		if (seqIndex.save()) { outputNames.push_back(indexFile); }
 		
 		if (wroteSomething == false) { m->mothurOut("Your file does not contain any sequence from the .accnos file."); m->mothurOutEndLine();  }
 		outputNames.push_back(outputFileName);  outputTypes["fasta"].push_back(outputFileName); 
@@ -580,13 +601,20 @@ int GetSeqsCommand::readQual(){
 		
         if (m->debug) { set<string> temp; sanity["qual"] = temp; }
 		
+        //with a current index only the scores wanted are read
+        string indexFile = "";
+        if (index) { indexFile = thisOutputDir + m->getSimpleName(qualfile) + ".idx"; }
+        SeqIndexFile seqIndex(qualfile, indexFile);
+        if (uniqueMap.size() == 0) { seqIndex.select(names, true); }
+        
         set<string> uniqueNames;
-		while(!in.eof()){	
+		while(seqIndex.nextRecord(in)){	
 			string saveName = "";
 			string name = "";
 			string scores = "";
 			
 			in >> name;
+            if (name.length() != 0) { seqIndex.add(name.substr(1)); }
             
             if (!dups) {//adjust name if needed
                 map<string, string>::iterator it = uniqueMap.find(name);
@@ -628,7 +656,7 @@ int GetSeqsCommand::readQual(){
 		}
 		in.close();
 		out.close();
-		
+		if (seqIndex.save()) { outputNames.push_back(indexFile); }
 		
 		if (wroteSomething == false) { m->mothurOut("Your file does not contain any sequence from the .accnos file."); m->mothurOutEndLine();  }
 		outputNames.push_back(outputFileName);  outputTypes["qfile"].push_back(outputFileName); 
@@ -427,7 +427,7 @@ int IndicatorCommand::GetIndicatorSpecies(){
 		vector<float> indicatorValues; //size of numBins
 		vector<float> pValues;
         vector<string> indicatorGroups;
-		map< vector<int>, vector<int> > randomGroupingsMap; //maps location in groupings to location in groupings, ie, [0][0] -> [1][2]. This is so we don't have to actually move the sharedRabundVectors.
+        vector<string> groupingNames;
 			
 		if (sharedfile != "") {
 			vector< vector<SharedRAbundVector*> > groupings;
@@ -450,9 +450,7 @@ int IndicatorCommand::GetIndicatorSpecies(){
 				
 			if (groupsAlreadyAdded.size() != lookup.size()) {  m->mothurOut("[ERROR]: could not make proper groupings."); m->mothurOutEndLine(); }
 				
-			indicatorValues = getValues(groupings, indicatorGroups, randomGroupingsMap);
-			
-			pValues = getPValues(groupings, lookup.size(), indicatorValues);				
+			fillAbundances(groupings, groupingNames);
 		}else {
 			vector< vector<SharedRAbundFloatVector*> > groupings;
 			set<string> groupsAlreadyAdded;
@@ -473,10 +471,17 @@ int IndicatorCommand::GetIndicatorSpecies(){
 			
 			if (groupsAlreadyAdded.size() != lookupFloat.size()) {  m->mothurOut("[ERROR]: could not make proper groupings."); m->mothurOutEndLine(); }
 			
-			indicatorValues = getValues(groupings, indicatorGroups, randomGroupingsMap);
-			
-			pValues = getPValues(groupings, lookupFloat.size(), indicatorValues);
+			fillAbundances(groupings, groupingNames);
 		}
+		
+		vector<int> samples(groupingStarts[groupingStarts.size()-1]);
+		for (int j = 0; j < samples.size(); j++) { samples[j] = j; }
+		
+		indicatorValues = getValues(samples, groupingNames, indicatorGroups);
+		
+		int numSamples = lookupFloat.size();
+		if (sharedfile != "") { numSamples = lookup.size(); }
+		pValues = getPValues(numSamples, indicatorValues);
 			
 		if (m->control_pressed) { out.close(); return 0; }
 			
@@ -547,19 +552,21 @@ int IndicatorCommand::GetIndicatorSpecies(Tree*& T){
         variables["[filename]"] = treeOutputDir + m->getRootName(m->getSimpleName(treefile));
 		string outputTreeFileName = getOutputFileName("tree", variables);
 		
+		//find the leaf each sample is under and order the nodes root first, so each node's groupings take one pass over the tree
+		vector<string> sampleGroups;
+		if (sharedfile != "") { for (int k = 0; k < lookup.size(); k++) { sampleGroups.push_back(lookup[k]->getGroup()); } }
+		else { for (int k = 0; k < lookupFloat.size(); k++) { sampleGroups.push_back(lookupFloat[k]->getGroup()); } }
 		
-		//create a map from tree node index to names of descendants, save time later to know which sharedRabund you need
-		map<int, set<string> > nodeToDescendants;
-		map<int, set<int> > descendantNodes;
-		for (int i = 0; i < T->getNumNodes(); i++) {
-			if (m->control_pressed) { return 0; }
-			
-			nodeToDescendants[i] = getDescendantList(T, i, nodeToDescendants, descendantNodes);
-		}
+		vector<int> sampleLeaves = getSampleLeaves(T, sampleGroups);
+		vector<int> parentsFirst = getParentsFirst(T);
+		
+		if (m->control_pressed) { out.close(); return 0; }
 		
 		//you need the distances to leaf to decide grouping below
 		//this will also set branch lengths if the tree does not include them
 		map<int, float> distToRoot = getDistToRoot(T);
+		vector<float> nodeDists(T->getNumNodes(), 0);
+		for (int i = 0; i < T->getNumNodes(); i++) { nodeDists[i] = distToRoot[i]; }
 			
 		//for each node
 		for (int i = T->getNumLeaves(); i < T->getNumNodes(); i++) {
@@ -573,117 +580,42 @@ int IndicatorCommand::GetIndicatorSpecies(Tree*& T){
 			vector<float> indicatorValues; //size of numBins
 			vector<float> pValues;
             vector<string> indicatorGroups;
-			map< vector<int>, vector<int> > randomGroupingsMap; //maps location in groupings to location in groupings, ie, [0][0] -> [1][2]. This is so we don't have to actually move the sharedRabundVectors.
 			
+			vector< vector<int> > nodeGroupings = getNodeGroupings(T, i, sampleLeaves, parentsFirst, nodeDists);
+			
+			int numAdded = 0;
+			for (int j = 0; j < nodeGroupings.size(); j++) { numAdded += nodeGroupings[j].size(); }
+			if (numAdded != sampleGroups.size()) {  m->mothurOut("[ERROR]: could not make proper groupings."); m->mothurOutEndLine(); }
+			
+			vector<string> groupingNames;
 			if (sharedfile != "") {
-				vector< vector<SharedRAbundVector*> > groupings;
-				
-				//get nodes that will be a valid grouping
-				//you are valid if you are not one of my descendants
-				//AND your distToRoot is >= mine
-				//AND you were not added as part of a larger grouping. Largest nodes are added first.
-				
-				set<string> groupsAlreadyAdded;
-				//create a grouping with my grouping
-				vector<SharedRAbundVector*> subset;
-				int count = 0;
-				int doneCount = nodeToDescendants[i].size();
-				for (int k = 0; k < lookup.size(); k++) {
-					//is this descendant of i
-					if ((nodeToDescendants[i].count(lookup[k]->getGroup()) != 0)) { 
-						subset.push_back(lookup[k]);
-						groupsAlreadyAdded.insert(lookup[k]->getGroup());
-						count++;
-					}
-					if (count == doneCount) { break; } //quit once you get the rabunds for this grouping
+				vector< vector<SharedRAbundVector*> > groupings(nodeGroupings.size());
+				for (int j = 0; j < nodeGroupings.size(); j++) {
+					for (int k = 0; k < nodeGroupings[j].size(); k++) { groupings[j].push_back(lookup[nodeGroupings[j][k]]); }
 				}
-				if (subset.size() != 0) { groupings.push_back(subset); }
-				
-				
-				for (int j = (T->getNumNodes()-1); j >= 0; j--) {
-	
-					
-					if ((descendantNodes[i].count(j) == 0) && (distToRoot[j] >= distToRoot[i])) { 
-						vector<SharedRAbundVector*> subset;
-						int count = 0;
-						int doneCount = nodeToDescendants[j].size();
-						for (int k = 0; k < lookup.size(); k++) {
-							//is this descendant of j, and we didn't already add this as part of a larger grouping
-							if ((nodeToDescendants[j].count(lookup[k]->getGroup()) != 0) && (groupsAlreadyAdded.count(lookup[k]->getGroup()) == 0)) { 
-								subset.push_back(lookup[k]);
-								groupsAlreadyAdded.insert(lookup[k]->getGroup());
-								count++;
-							}
-							if (count == doneCount) { break; } //quit once you get the rabunds for this grouping
-						}
-						
-						//if subset.size == 0 then the node was added as part of a larger grouping
-						if (subset.size() != 0) { groupings.push_back(subset); }
-					}
-				}
-				
-				if (groupsAlreadyAdded.size() != lookup.size()) {  m->mothurOut("[ERROR]: could not make proper groupings."); m->mothurOutEndLine(); }
-								
-				indicatorValues = getValues(groupings, indicatorGroups, randomGroupingsMap);
-				
-				pValues = getPValues(groupings, lookup.size(), indicatorValues);				
+				fillAbundances(groupings, groupingNames);
 			}else {
-				vector< vector<SharedRAbundFloatVector*> > groupings;
-				
-				//get nodes that will be a valid grouping
-				//you are valid if you are not one of my descendants
-				//AND your distToRoot is >= mine
-				//AND you were not added as part of a larger grouping. Largest nodes are added first.
-				
-				set<string> groupsAlreadyAdded;
-				//create a grouping with my grouping
-				vector<SharedRAbundFloatVector*> subset;
-				int count = 0;
-				int doneCount = nodeToDescendants[i].size();
-				for (int k = 0; k < lookupFloat.size(); k++) {
-					//is this descendant of i
-					if ((nodeToDescendants[i].count(lookupFloat[k]->getGroup()) != 0)) { 
-						subset.push_back(lookupFloat[k]);
-						groupsAlreadyAdded.insert(lookupFloat[k]->getGroup());
-						count++;
-					}
-					if (count == doneCount) { break; } //quit once you get the rabunds for this grouping
-				}
-				if (subset.size() != 0) { groupings.push_back(subset); }
-				
-				for (int j = (T->getNumNodes()-1); j >= 0; j--) {
-					if ((descendantNodes[i].count(j) == 0) && (distToRoot[j] >= distToRoot[i])) {
-						vector<SharedRAbundFloatVector*> subset;
-						int count = 0;
-						int doneCount = nodeToDescendants[j].size();
-						for (int k = 0; k < lookupFloat.size(); k++) {
-							//is this descendant of j, and we didn't already add this as part of a larger grouping
-							if ((nodeToDescendants[j].count(lookupFloat[k]->getGroup()) != 0) && (groupsAlreadyAdded.count(lookupFloat[k]->getGroup()) == 0)) { 
-								subset.push_back(lookupFloat[k]);
-								groupsAlreadyAdded.insert(lookupFloat[k]->getGroup());
-								count++;
-							}
-							if (count == doneCount) { break; } //quit once you get the rabunds for this grouping
-						}
-						
-						//if subset.size == 0 then the node was added as part of a larger grouping
-						if (subset.size() != 0) { groupings.push_back(subset); }
-					}
+				vector< vector<SharedRAbundFloatVector*> > groupings(nodeGroupings.size());
+				for (int j = 0; j < nodeGroupings.size(); j++) {
+					for (int k = 0; k < nodeGroupings[j].size(); k++) { groupings[j].push_back(lookupFloat[nodeGroupings[j][k]]); }
 				}
-				
-				if (groupsAlreadyAdded.size() != lookupFloat.size()) { m->mothurOut("[ERROR]: could not make proper groupings."); m->mothurOutEndLine(); }
-				
-				indicatorValues = getValues(groupings, indicatorGroups, randomGroupingsMap);
-				
-				pValues = getPValues(groupings, lookupFloat.size(), indicatorValues);
+				fillAbundances(groupings, groupingNames);
 			}
 			
+			vector<int> samples(groupingStarts[groupingStarts.size()-1]);
+			for (int j = 0; j < samples.size(); j++) { samples[j] = j; }
+			
+			indicatorValues = getValues(samples, groupingNames, indicatorGroups);
+			
+			pValues = getPValues(sampleGroups.size(), indicatorValues);
+			
 			if (m->control_pressed) { out.close(); return 0; }
 			
 			
 			/******************************************************/
 			//output indicator values to table form + label tree  //
 			/*****************************************************/
+			/*****************************************************/
 			out << (i+1);
 			for (int j = 0; j < indicatorValues.size(); j++) {
 				
@@ -725,151 +657,152 @@ int IndicatorCommand::GetIndicatorSpecies(Tree*& T){
 	}
 }
 //**********************************************************************************************************************
-vector<float> IndicatorCommand::getValues(vector< vector<SharedRAbundFloatVector*> >& groupings, vector<string>& indicatorGroupings, map< vector<int>, vector<int> > groupingsMap){
+//fills abunds with the otu by sample abundances, samples in grouping order, so a permutation only moves sample positions
+int IndicatorCommand::fillAbundances(vector< vector<SharedRAbundFloatVector*> >& groupings, vector<string>& groupingNames){
 	try {
-		vector<float> values;
-		map< vector<int>, vector<int> >::iterator it;
-        
-        indicatorGroupings.clear();
-        
-        //create grouping strings
-        vector<string> groupingsGroups;
-        for (int j = 0; j < groupings.size(); j++) {
-            string tempGrouping = "";
-            for (int k = 0; k < groupings[j].size()-1; k++) { 
-                tempGrouping += groupings[j][k]->getGroup() + "-";
-            }
-            tempGrouping += groupings[j][groupings[j].size()-1]->getGroup();
-            groupingsGroups.push_back(tempGrouping);
-        }
-        
-        
-		//for each otu
-		for (int i = 0; i < groupings[0][0]->getNumBins(); i++) {
-			
-			if (m->control_pressed) { return values; }
-			
-			vector<float> terms; 
-			float AijDenominator = 0.0;
-			vector<float> Bij;
-			
-			//get overall abundance of each grouping
-			for (int j = 0; j < groupings.size(); j++) {
-				
-				float totalAbund = 0;
-				int numNotZero = 0;
-				for (int k = 0; k < groupings[j].size(); k++) { 
-					vector<int> temp; temp.push_back(j); temp.push_back(k);
-					it = groupingsMap.find(temp);
-					
-					if (it == groupingsMap.end()) { //this one didnt get moved
-						totalAbund += groupings[j][k]->getAbundance(i); 
-						if (groupings[j][k]->getAbundance(i) != 0.0) { numNotZero++; }
-					}else {
-						totalAbund += groupings[(it->second)[0]][(it->second)[1]]->getAbundance(i); 
-						if (groupings[(it->second)[0]][(it->second)[1]]->getAbundance(i) != 0.0) { numNotZero++; }
-					}
-					
-				}
-				
-				//mean abundance
-				float Aij = (totalAbund / (float) groupings[j].size());
-				terms.push_back(Aij);
-				
-				//percentage of sites represented
-				Bij.push_back(numNotZero / (float) groupings[j].size());
-				
-				AijDenominator += Aij;
+		groupingNames.clear(); groupingStarts.clear();
+		integerAbunds = false;
+		
+		//create grouping strings
+		int numSamples = 0;
+		for (int j = 0; j < groupings.size(); j++) {
+			groupingStarts.push_back(numSamples);
+			numSamples += groupings[j].size();
+			
+			string tempGrouping = "";
+			for (int k = 0; k < groupings[j].size()-1; k++) { 
+				tempGrouping += groupings[j][k]->getGroup() + "-";
 			}
-			
-			float maxIndVal = 0.0;
-            string maxGrouping = "";
-			for (int j = 0; j < terms.size(); j++) { 
-				float thisAij = (terms[j] / AijDenominator); //relative abundance
-				float thisValue = thisAij * Bij[j] * 100.0;
-				
-				//save largest
-				if (thisValue > maxIndVal) { maxIndVal = thisValue;  maxGrouping = groupingsGroups[j]; }
+			tempGrouping += groupings[j][groupings[j].size()-1]->getGroup();
+			groupingNames.push_back(tempGrouping);
+		}
+		groupingStarts.push_back(numSamples);
+		
+		int numBins = groupings[0][0]->getNumBins();
+		abunds.assign(numBins, vector<double>(numSamples, 0.0));
+		
+		for (int j = 0; j < groupings.size(); j++) {
+			for (int k = 0; k < groupings[j].size(); k++) {
+				int sample = groupingStarts[j] + k;
+				for (int i = 0; i < numBins; i++) { abunds[i][sample] = groupings[j][k]->getAbundance(i); }
 			}
-			
-			values.push_back(maxIndVal);
-            indicatorGroupings.push_back(maxGrouping);
 		}
 		
-		return values;
+		return 0;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "IndicatorCommand", "getValues");	
+		m->errorOut(e, "IndicatorCommand", "fillAbundances");	
 		exit(1);
 	}
 }
 //**********************************************************************************************************************
 //same as above, just data type difference
-vector<float> IndicatorCommand::getValues(vector< vector<SharedRAbundVector*> >& groupings, vector<string>& indicatorGroupings, map< vector<int>, vector<int> > groupingsMap){
+int IndicatorCommand::fillAbundances(vector< vector<SharedRAbundVector*> >& groupings, vector<string>& groupingNames){
+	try {
+		groupingNames.clear(); groupingStarts.clear();
+		integerAbunds = true;
+		
+		//create grouping strings
+		int numSamples = 0;
+		for (int j = 0; j < groupings.size(); j++) {
+			groupingStarts.push_back(numSamples);
+			numSamples += groupings[j].size();
+			
+			string tempGrouping = "";
+			for (int k = 0; k < groupings[j].size()-1; k++) { 
+				tempGrouping += groupings[j][k]->getGroup() + "-";
+			}
+			tempGrouping += groupings[j][groupings[j].size()-1]->getGroup();
+			groupingNames.push_back(tempGrouping);
+		}
+		groupingStarts.push_back(numSamples);
+		
+		int numBins = groupings[0][0]->getNumBins();
+		abunds.assign(numBins, vector<double>(numSamples, 0.0));
+		
+		for (int j = 0; j < groupings.size(); j++) {
+			for (int k = 0; k < groupings[j].size(); k++) {
+				int sample = groupingStarts[j] + k;
+				for (int i = 0; i < numBins; i++) { abunds[i][sample] = groupings[j][k]->getAbundance(i); }
+			}
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "IndicatorCommand", "fillAbundances");	
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//indicator value of each otu, reading the abundances of sample samples[p] at position p. 
+//indicatorGroupings is only filled when groupingNames is given
+vector<float> IndicatorCommand::getValues(vector<int>& samples, vector<string>& groupingNames, vector<string>& indicatorGroupings){
 	try {
 		vector<float> values;
-		map< vector<int>, vector<int> >::iterator it;
-        
         indicatorGroupings.clear();
-        
-        //create grouping strings
-        vector<string> groupingsGroups;
-        for (int j = 0; j < groupings.size(); j++) {
-            string tempGrouping = "";
-            for (int k = 0; k < groupings[j].size()-1; k++) { 
-                tempGrouping += groupings[j][k]->getGroup() + "-";
-            }
-            tempGrouping += groupings[j][groupings[j].size()-1]->getGroup();
-            groupingsGroups.push_back(tempGrouping);
-        }
-
 		
+		int numGroupings = groupingStarts.size()-1;
+		vector<float> terms(numGroupings, 0.0);
+		vector<float> Bij(numGroupings, 0.0);
+        
 		//for each otu
-		for (int i = 0; i < groupings[0][0]->getNumBins(); i++) {
-			vector<float> terms; 
+		for (int i = 0; i < abunds.size(); i++) {
+			
+			if (m->control_pressed) { return values; }
+			
+			vector<double>& otuAbunds = abunds[i];
 			float AijDenominator = 0.0;
-			vector<float> Bij;
+			
 			//get overall abundance of each grouping
-			for (int j = 0; j < groupings.size(); j++) {
-	
-				int totalAbund = 0.0;
+			for (int j = 0; j < numGroupings; j++) {
+				int size = groupingStarts[j+1] - groupingStarts[j];
 				int numNotZero = 0;
-				for (int k = 0; k < groupings[j].size(); k++) { 
-					vector<int> temp; temp.push_back(j); temp.push_back(k);
-					it = groupingsMap.find(temp);
-					
-					if (it == groupingsMap.end()) { //this one didnt get moved
-						totalAbund += groupings[j][k]->getAbundance(i); 
-						if (groupings[j][k]->getAbundance(i) != 0.0) { numNotZero++; }
-					}else {
-						totalAbund += groupings[(it->second)[0]][(it->second)[1]]->getAbundance(i); 
-						if (groupings[(it->second)[0]][(it->second)[1]]->getAbundance(i) != 0.0) { numNotZero++; }
+				float Aij = 0.0;
+				
+				//sum as the shared or relabund values would have been summed
+				if (integerAbunds) {
+					int totalAbund = 0;
+					for (int p = groupingStarts[j]; p < groupingStarts[j+1]; p++) { 
+						int abund = (int)otuAbunds[samples[p]];
+						totalAbund += abund;
+						if (abund != 0) { numNotZero++; }
 					}
-					
+					Aij = (totalAbund / (float) size);
+				}else {
+					float totalAbund = 0;
+					for (int p = groupingStarts[j]; p < groupingStarts[j+1]; p++) { 
+						float abund = (float)otuAbunds[samples[p]];
+						totalAbund += abund;
+						if (abund != 0.0) { numNotZero++; }
+					}
+					Aij = (totalAbund / (float) size);
 				}
 				
-				//mean abundance	
-				float Aij = (totalAbund / (float) groupings[j].size());
-				terms.push_back(Aij);
+				//mean abundance
+				terms[j] = Aij;
 				
 				//percentage of sites represented
-				Bij.push_back(numNotZero / (float) groupings[j].size());
+				Bij[j] = numNotZero / (float) size;
 				
 				AijDenominator += Aij;
 			}
 			
 			float maxIndVal = 0.0;
-            string maxGrouping = "";
-			for (int j = 0; j < terms.size(); j++) { 
+            int maxGrouping = -1;
+			for (int j = 0; j < numGroupings; j++) { 
 				float thisAij = (terms[j] / AijDenominator); //relative abundance
 				float thisValue = thisAij * Bij[j] * 100.0;
-					
+				
 				//save largest
-				if (thisValue > maxIndVal) { maxIndVal = thisValue;  maxGrouping = groupingsGroups[j]; }
+				if (thisValue > maxIndVal) { maxIndVal = thisValue;  maxGrouping = j; }
 			}
 			
 			values.push_back(maxIndVal);
-            indicatorGroupings.push_back(maxGrouping);
+            if (groupingNames.size() != 0) {
+                if (maxGrouping == -1) { indicatorGroupings.push_back(""); }
+                else { indicatorGroupings.push_back(groupingNames[maxGrouping]); }
+            }
 		}
 		
 		return values;
@@ -944,46 +877,101 @@ map<int, float> IndicatorCommand::getDistToRoot(Tree*& T){
 	}
 }
 //**********************************************************************************************************************
-set<string> IndicatorCommand::getDescendantList(Tree*& T, int i, map<int, set<string> > descendants, map<int, set<int> >& nodes){
+//the leaf each sample is under, -1 if it is not in the tree. With a design file the leaves are categories
+vector<int> IndicatorCommand::getSampleLeaves(Tree*& T, vector<string>& sampleGroups){
 	try {
-		set<string> names;
+		map<string, int> groupLeaves;
 		
-		set<string>::iterator it;
-		
-		int lc = T->tree[i].getLChild();
-		int rc = T->tree[i].getRChild();
-		
-		if (lc == -1) { //you are a leaf your only descendant is yourself
-			set<int> temp; temp.insert(i);
-			nodes[i] = temp;
-			
+		for (int i = 0; i < T->getNumLeaves(); i++) {
 			if (designfile == "") {
-				names.insert(T->tree[i].getName());
+				if (groupLeaves.count(T->tree[i].getName()) == 0) { groupLeaves[T->tree[i].getName()] = i; }
 			}else {
 				vector<string> myGroup; myGroup.push_back(T->tree[i].getName());
 				vector<string> myReps = designMap->getNamesGroups(myGroup);
 				for (int k = 0; k < myReps.size(); k++) {
-					names.insert(myReps[k]);
+					if (groupLeaves.count(myReps[k]) == 0) { groupLeaves[myReps[k]] = i; }
 				}
 			}
+		}
+		
+		vector<int> sampleLeaves(sampleGroups.size(), -1);
+		for (int k = 0; k < sampleGroups.size(); k++) {
+			map<string, int>::iterator it = groupLeaves.find(sampleGroups[k]);
+			if (it != groupLeaves.end()) { sampleLeaves[k] = it->second; }
+		}
+		
+		return sampleLeaves;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "IndicatorCommand", "getSampleLeaves");	
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//nodes ordered so every parent comes before its children
+vector<int> IndicatorCommand::getParentsFirst(Tree*& T){
+	try {
+		vector<int> order;
+		vector<int> toVisit;
+		
+		for (int i = 0; i < T->getNumNodes(); i++) {
+			if (T->tree[i].getParent() == -1) { toVisit.push_back(i); }
+		}
+		
+		while (toVisit.size() != 0) {
+			int node = toVisit.back(); toVisit.pop_back();
+			order.push_back(node);
 			
-		}else{ //your descedants are the combination of your childrens descendants
-			names = descendants[lc];
-			nodes[i] = nodes[lc];
-			for (it = descendants[rc].begin(); it != descendants[rc].end(); it++) {
-				names.insert(*it);
-			}
-			for (set<int>::iterator itNum = nodes[rc].begin(); itNum != nodes[rc].end(); itNum++) {
-				nodes[i].insert(*itNum);
-			}
-			//you are your own descendant
-			nodes[i].insert(i);
+			int lc = T->tree[node].getLChild();
+			int rc = T->tree[node].getRChild();
+			if (lc != -1) { toVisit.push_back(lc); }
+			if (rc != -1) { toVisit.push_back(rc); }
+		}
+		
+		return order;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "IndicatorCommand", "getParentsFirst");	
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//the groupings for node i, as indexes into lookup. The first grouping is the samples under i. 
+//The rest come from the nodes that are not under i and whose distToRoot is >= i's, largest node first, 
+//each taking the samples under it that were not already taken. So a sample goes to the largest of those 
+//nodes above it, which is passed down from the root in one pass.
+vector< vector<int> > IndicatorCommand::getNodeGroupings(Tree*& T, int i, vector<int>& sampleLeaves, vector<int>& parentsFirst, vector<float>& distToRoot){
+	try {
+		int numNodes = T->getNumNodes();
+		
+		vector<int> owner(numNodes, -1);
+		for (int p = 0; p < parentsFirst.size(); p++) {
+			int node = parentsFirst[p];
+			int parent = T->tree[node].getParent();
+			
+			if (parent != -1) { owner[node] = owner[parent]; }
+			
+			if (node == i) { owner[node] = i; }
+			else if (owner[node] == i) { } //under i
+			else if ((distToRoot[node] >= distToRoot[i]) && (node > owner[node])) { owner[node] = node; }
+		}
+		
+		vector< vector<int> > nodeSamples(numNodes);
+		for (int k = 0; k < sampleLeaves.size(); k++) {
+			if (sampleLeaves[k] == -1) { continue; }
+			if (owner[sampleLeaves[k]] != -1) { nodeSamples[owner[sampleLeaves[k]]].push_back(k); }
 		}
 		
-		return names;
+		vector< vector<int> > groupings;
+		if (nodeSamples[i].size() != 0) { groupings.push_back(nodeSamples[i]); }
+		for (int j = (numNodes-1); j >= 0; j--) {
+			if ((j != i) && (nodeSamples[j].size() != 0)) { groupings.push_back(nodeSamples[j]); }
+		}
+		
+		return groupings;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "IndicatorCommand", "getDescendantList");	
+		m->errorOut(e, "IndicatorCommand", "getNodeGroupings");	
 		exit(1);
 	}
 }
@@ -1141,16 +1129,19 @@ int IndicatorCommand::getSharedFloat(){
 	}
 }
 //**********************************************************************************************************************
-vector<float> IndicatorCommand::driver(vector< vector<SharedRAbundFloatVector*> >& groupings, int num, vector<float> indicatorValues, int numIters){
+vector<float> IndicatorCommand::driver(int num, vector<float>& indicatorValues, int numIters){
 	try {
 		vector<float> pvalues;
 		pvalues.resize(indicatorValues.size(), 0);
+        vector<string> noNames;
         vector<string> notUsedGroupings;  //we dont care about the grouping for the pvalues since they are randomized, but we need to pass the function something to make it work.
 		
+		vector<int> samples(groupingStarts[groupingStarts.size()-1]);
+		
 		for(int i=0;i<numIters;i++){
 			if (m->control_pressed) { break; }
-			map< vector<int>, vector<int> > groupingsMap = randomizeGroupings(groupings, num);
-			vector<float> randomIndicatorValues = getValues(groupings, notUsedGroupings, groupingsMap);
+			randomizeGroupings(samples, num);
+			vector<float> randomIndicatorValues = getValues(samples, noNames, notUsedGroupings);
 			
 			for (int j = 0; j < indicatorValues.size(); j++) {
 				if (randomIndicatorValues[j] >= indicatorValues[j]) { pvalues[j]++; }
@@ -1165,13 +1156,14 @@ vector<float> IndicatorCommand::driver(vector< vector<SharedRAbundFloatVector*>
 	}
 }
 //**********************************************************************************************************************
-vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVector*> >& groupings, int num, vector<float> indicatorValues){
+//each process gets its own seed so the processes don't repeat each others permutations
+vector<float> IndicatorCommand::getPValues(int num, vector<float>& indicatorValues){
 	try {
 		vector<float> pvalues;
         bool recalc = false;
 
 		if(processors == 1){
-			pvalues = driver(groupings, num, indicatorValues, iters);
+			pvalues = driver(num, indicatorValues, iters);
             for (int i = 0; i < pvalues.size(); i++) { pvalues[i] /= (double)iters; }
 		}else{
             //divide iters between processors
@@ -1186,6 +1178,7 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
             
             vector<int> processIDS;
             int process = 1;
+            unsigned int seedBase = rand();
 			
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 						
@@ -1197,7 +1190,8 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
 					processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 					process++;
 				}else if (pid == 0){
-					pvalues = driver(groupings, num, indicatorValues, procIters[process]);
+                    srand(seedBase + process);
+					pvalues = driver(num, indicatorValues, procIters[process]);
 					
 					//pass pvalues to parent
 					ofstream out;
@@ -1251,7 +1245,8 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
                         processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                         process++;
                     }else if (pid == 0){
-                        pvalues = driver(groupings, num, indicatorValues, procIters[process]);
+                        srand(seedBase + process);
+                        pvalues = driver(num, indicatorValues, procIters[process]);
                         
                         //pass pvalues to parent
                         ofstream out;
@@ -1273,7 +1268,7 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
             }
 
 			//do my part
-			pvalues = driver(groupings, num, indicatorValues, procIters[0]);
+			pvalues = driver(num, indicatorValues, procIters[0]);
 			
 			//force parent to wait until all the processes are done
 			for (int i=0;i<processIDS.size();i++) { 
@@ -1304,34 +1299,12 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
             HANDLE  hThreadArray[processors-1];
             
             //Create processor worker threads.
+            //the abundances are only read, so the threads share them
             for( int i=1; i<processors; i++ ){
                 
-                //make copy of lookup so we don't get access violations
-                vector< vector<SharedRAbundFloatVector*> > newGroupings;
-
-                for (int k = 0; k < groupings.size(); k++) {
-                    vector<SharedRAbundFloatVector*> newLookup;
-                    for (int l = 0; l < groupings[k].size(); l++) {
-                        SharedRAbundFloatVector* temp = new SharedRAbundFloatVector();
-                        temp->setLabel(groupings[k][l]->getLabel());
-                        temp->setGroup(groupings[k][l]->getGroup());
-                        newLookup.push_back(temp);
-                    }
-                    newGroupings.push_back(newLookup);
-                }
-                
-                //for each bin
-                for (int l = 0; l < groupings.size(); l++) {
-                    for (int k = 0; k < groupings[l][0]->getNumBins(); k++) {
-                        if (m->control_pressed) { for (int j = 0; j < newGroupings.size(); j++) { for (int u = 0; u < newGroupings[j].size(); u++) { delete newGroupings[j][u];  } } return pvalues; }
-                        
-                        for (int j = 0; j < groupings[l].size(); j++) { newGroupings[l][j]->push_back(groupings[l][j]->getAbundance(k), groupings[l][j]->getGroup()); }
-                    }
-                }
-        
                 vector<float> copyIValues = indicatorValues;
 
-                indicatorData* temp = new indicatorData(m, procIters[i], newGroupings, num, copyIValues);
+                indicatorData* temp = new indicatorData(m, procIters[i], &abunds, groupingStarts, integerAbunds, num, copyIValues, seedBase + i);
                 pDataArray.push_back(temp);
                 processIDS.push_back(i);
                 
@@ -1339,7 +1312,7 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
             }
             
             //do my part
-			pvalues = driver(groupings, num, indicatorValues, procIters[0]);
+			pvalues = driver(num, indicatorValues, procIters[0]);
            
             //Wait until all threads have terminated.
             WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
@@ -1348,10 +1321,6 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
             for(int i=0; i < pDataArray.size(); i++){
                 for (int j = 0; j < pDataArray[i]->pvalues.size(); j++) { pvalues[j] += pDataArray[i]->pvalues[j];  }
                 
-                for (int l = 0; l < pDataArray[i]->groupings.size(); l++) {
-                    for (int j = 0; j < pDataArray[i]->groupings[l].size(); j++) { delete pDataArray[i]->groupings[l][j]; }
-                }
-                
                 CloseHandle(hThreadArray[i]);
                 delete pDataArray[i];
             }
@@ -1368,309 +1337,33 @@ vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundFloatVecto
 		exit(1);
 	}
 }
-
 //**********************************************************************************************************************
-//same as above, just data type difference
-vector<float> IndicatorCommand::driver(vector< vector<SharedRAbundVector*> >& groupings, int num, vector<float> indicatorValues, int numIters){
+//swap groups between groupings, in essence randomizing the second column of the design file.
+//each swap reads the abundances of sample b of grouping x at position a of grouping z
+int IndicatorCommand::randomizeGroupings(vector<int>& samples, int numLookupGroups){
 	try {
-		vector<float> pvalues;
-		pvalues.resize(indicatorValues.size(), 0);
-        vector<string> notUsedGroupings;  //we dont care about the grouping for the pvalues since they are randomized, but we need to pass the function something to make it work.
-		
-		for(int i=0;i<numIters;i++){
-			if (m->control_pressed) { break; }
-			map< vector<int>, vector<int> > groupingsMap = randomizeGroupings(groupings, num);
-			vector<float> randomIndicatorValues = getValues(groupings, notUsedGroupings, groupingsMap);
-			
-			for (int j = 0; j < indicatorValues.size(); j++) {
-				if (randomIndicatorValues[j] >= indicatorValues[j]) { pvalues[j]++; }
-			}
-		}
-		
-		return pvalues;
-		
-	}catch(exception& e) {
-		m->errorOut(e, "IndicatorCommand", "driver");	
-		exit(1);
-	}
-}
-//**********************************************************************************************************************
-//same as above, just data type difference
-vector<float> IndicatorCommand::getPValues(vector< vector<SharedRAbundVector*> >& groupings, int num, vector<float> indicatorValues){
-	try {
-		vector<float> pvalues;
-        bool recalc = false;
-        
-		if(processors == 1){
-			pvalues = driver(groupings, num, indicatorValues, iters);
-            for (int i = 0; i < pvalues.size(); i++) { pvalues[i] /= (double)iters; }
-		}else{
-            //divide iters between processors
-			vector<int> procIters;
-            int numItersPerProcessor = iters / processors;
-            
-            //divide iters between processes
-            for (int h = 0; h < processors; h++) {
-                if(h == processors - 1){ numItersPerProcessor = iters - h * numItersPerProcessor; }
-                procIters.push_back(numItersPerProcessor);
-            }
-            
-            vector<int> processIDS;
-            int process = 1;
-			
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-            
-			//loop through and create all the processes you want
-			while (process != processors) {
-				pid_t pid = fork();
-				
-				if (pid > 0) {
-					processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-					process++;
-				}else if (pid == 0){
-					pvalues = driver(groupings, num, indicatorValues, procIters[process]);
-					
-					//pass pvalues to parent
-					ofstream out;
-					string tempFile = m->mothurGetpid(process) + ".pvalues.temp";
-					m->openOutputFile(tempFile, out);
-					
-					//pass values
-					for (int i = 0; i < pvalues.size(); i++) {
-						out << pvalues[i] << '\t';
-					}
-					out << endl;
-					
-					out.close();
-					
-					exit(0);
-				}else {
-                    m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
-                    for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                    //wait to die
-                    for (int i=0;i<processIDS.size();i++) {
-                        int temp = processIDS[i];
-                        wait(&temp);
-                    }
-                    m->control_pressed = false;
-                    for (int i=0;i<processIDS.size();i++) {
-                        m->mothurRemove((toString(processIDS[i]) + ".pvalues.temp"));
-                    }
-                    recalc = true;
-                    break;
-				}
-			}
-			
-            if (recalc) {
-                //test line, also set recalc to true.
-                //for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); } for (int i=0;i<processIDS.size();i++) { int temp = processIDS[i]; wait(&temp); } m->control_pressed = false;  for (int i=0;i<processIDS.size();i++) {m->mothurRemove((toString(processIDS[i]) + ".pvalues.temp"));}processors=3; m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(processors) + "\n");
-                
-                //divide iters between processors
-                processIDS.resize(0);
-                process = 1;
-                procIters.clear();
-                int numItersPerProcessor = iters / processors;
-                
-                //divide iters between processes
-                for (int h = 0; h < processors; h++) {
-                    if(h == processors - 1){ numItersPerProcessor = iters - h * numItersPerProcessor; }
-                    procIters.push_back(numItersPerProcessor);
-                }
-                
-                //loop through and create all the processes you want
-                while (process != processors) {
-                    pid_t pid = fork();
-                    
-                    if (pid > 0) {
-                        processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-                        process++;
-                    }else if (pid == 0){
-                        pvalues = driver(groupings, num, indicatorValues, procIters[process]);
-                        
-                        //pass pvalues to parent
-                        ofstream out;
-                        string tempFile = m->mothurGetpid(process) + ".pvalues.temp";
-                        m->openOutputFile(tempFile, out);
-                        
-                        //pass values
-                        for (int i = 0; i < pvalues.size(); i++) {  out << pvalues[i] << '\t'; } out << endl;
-                        
-                        out.close();
-                        
-                        exit(0);
-                    }else {
-                        m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
-                        for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                        exit(0);
-                    }
-                }
-            }
-
-			//do my part
-			pvalues = driver(groupings, num, indicatorValues, procIters[0]);
-			
-			//force parent to wait until all the processes are done
-			for (int i=0;i<processIDS.size();i++) {
-				int temp = processIDS[i];
-				wait(&temp);
-			}
-			
-			//combine results
-			for (int i = 0; i < processIDS.size(); i++) {
-				ifstream in;
-				string tempFile =  toString(processIDS[i]) + ".pvalues.temp";
-				m->openInputFile(tempFile, in);
-				
-				////// to do ///////////
-				int numTemp; numTemp = 0;
-				for (int j = 0; j < pvalues.size(); j++) {
-					in >> numTemp; m->gobble(in);
-					pvalues[j] += numTemp;
-				}
-				in.close(); m->mothurRemove(tempFile);
-			}
-			for (int i = 0; i < pvalues.size(); i++) { pvalues[i] /= (double)iters; }
-#else
-            
-            //fill in functions
-            vector<indicatorData*> pDataArray;
-            DWORD   dwThreadIdArray[processors-1];
-            HANDLE  hThreadArray[processors-1];
-            
-            //Create processor worker threads.
-            for( int i=1; i<processors; i++ ){
-                
-                //make copy of lookup so we don't get access violations
-                vector< vector<SharedRAbundFloatVector*> > newGroupings;
-                
-                for (int k = 0; k < groupings.size(); k++) {
-                    vector<SharedRAbundFloatVector*> newLookup;
-                    for (int l = 0; l < groupings[k].size(); l++) {
-                        SharedRAbundFloatVector* temp = new SharedRAbundFloatVector();
-                        temp->setLabel(groupings[k][l]->getLabel());
-                        temp->setGroup(groupings[k][l]->getGroup());
-                        newLookup.push_back(temp);
-                    }
-                    newGroupings.push_back(newLookup);
-                }
-                
-                //for each bin
-                for (int l = 0; l < groupings.size(); l++) {
-                    for (int k = 0; k < groupings[l][0]->getNumBins(); k++) {
-                        if (m->control_pressed) { for (int j = 0; j < newGroupings.size(); j++) { for (int u = 0; u < newGroupings[j].size(); u++) { delete newGroupings[j][u];  } } return pvalues; }
-                        
-                        for (int j = 0; j < groupings[l].size(); j++) { newGroupings[l][j]->push_back((float)(groupings[l][j]->getAbundance(k)), groupings[l][j]->getGroup()); }
-                    }
-                }
-                
-                vector<float> copyIValues = indicatorValues;
-                
-                indicatorData* temp = new indicatorData(m, procIters[i], newGroupings, num, copyIValues);
-                pDataArray.push_back(temp);
-                processIDS.push_back(i);
-                
-                hThreadArray[i-1] = CreateThread(NULL, 0, MyIndicatorThreadFunction, pDataArray[i-1], 0, &dwThreadIdArray[i-1]);
-            }
-            
-            //do my part
-			pvalues = driver(groupings, num, indicatorValues, procIters[0]);
-            
-            //Wait until all threads have terminated.
-            WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
-            
-            //Close all thread handles and free memory allocations.
-            for(int i=0; i < pDataArray.size(); i++){
-                for (int j = 0; j < pDataArray[i]->pvalues.size(); j++) { pvalues[j] += pDataArray[i]->pvalues[j];  }
-                
-                for (int l = 0; l < pDataArray[i]->groupings.size(); l++) {
-                    for (int j = 0; j < pDataArray[i]->groupings[l].size(); j++) { delete pDataArray[i]->groupings[l][j]; }
-                }
-                
-                CloseHandle(hThreadArray[i]);
-                delete pDataArray[i];
-            }
-            
-            for (int i = 0; i < pvalues.size(); i++) { pvalues[i] /= (double)iters; }
-#endif
-		}
-        
-		
-		return pvalues;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "IndicatorCommand", "getPValues");
-		exit(1);
-	}
-}
-//**********************************************************************************************************************
-//swap groups between groupings, in essence randomizing the second column of the design file
-map< vector<int>, vector<int> > IndicatorCommand::randomizeGroupings(vector< vector<SharedRAbundVector*> >& groupings, int numLookupGroups){
-	try {
-		
-		map< vector<int>, vector<int> > randomGroupings; 
+		int numGroupings = groupingStarts.size()-1;
+		for (int p = 0; p < samples.size(); p++) { samples[p] = p; }
 		
 		for (int i = 0; i < numLookupGroups; i++) {
 			if (m->control_pressed) {break;}
 			
 			//get random groups to swap to switch with
 			//generate random int between 0 and groupings.size()-1
-			int z = m->getRandomIndex(groupings.size()-1);
-			int x = m->getRandomIndex(groupings.size()-1);
-			int a = m->getRandomIndex(groupings[z].size()-1);
-			int b = m->getRandomIndex(groupings[x].size()-1);
-			//cout << i << '\t' << z << '\t' << x << '\t' << a << '\t' << b << endl;	
-			//if ((z < 0) || (z > 1) || x<0 || x>1 || a <0 || a>groupings[z].size()-1 || b<0 || b>groupings[x].size()-1) { cout << "probelm" << i << '\t' << z << '\t' << x << '\t' << a << '\t' << b << endl;	}
-			
-			vector<int> from;
-			vector<int> to;
-			
-			from.push_back(z); from.push_back(a);
-			to.push_back(x); to.push_back(b);
-			
-			randomGroupings[from] = to;
-		}
-		//cout << "done" << endl;	
-		return randomGroupings;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "IndicatorCommand", "randomizeGroupings");	
-		exit(1);
-	}
-}	
-//**********************************************************************************************************************
-//swap groups between groupings, in essence randomizing the second column of the design file
-map< vector<int>, vector<int> > IndicatorCommand::randomizeGroupings(vector< vector<SharedRAbundFloatVector*> >& groupings, int numLookupGroups){
-	try {
-		
-		map< vector<int>, vector<int> > randomGroupings; 
-		
-		for (int i = 0; i < numLookupGroups; i++) {
-			
-			//get random groups to swap to switch with
-			//generate random int between 0 and groupings.size()-1
-			int z = m->getRandomIndex(groupings.size()-1);
-			int x = m->getRandomIndex(groupings.size()-1);
-			int a = m->getRandomIndex(groupings[z].size()-1);
-			int b = m->getRandomIndex(groupings[x].size()-1);
-			//cout << i << '\t' << z << '\t' << x << '\t' << a << '\t' << b << endl;		
-			
-			vector<int> from;
-			vector<int> to;
-			
-			from.push_back(z); from.push_back(a);
-			to.push_back(x); to.push_back(b);
+			int z = m->getRandomIndex(numGroupings-1);
+			int x = m->getRandomIndex(numGroupings-1);
+			int a = m->getRandomIndex(groupingStarts[z+1]-groupingStarts[z]-1);
+			int b = m->getRandomIndex(groupingStarts[x+1]-groupingStarts[x]-1);
 			
-			randomGroupings[from] = to;
+			samples[groupingStarts[z]+a] = groupingStarts[x]+b;
 		}
 		
-		return randomGroupings;
+		return 0;
 	}
 	catch(exception& e) {
 		m->errorOut(e, "IndicatorCommand", "randomizeGroupings");	
 		exit(1);
 	}
-}			
-								
+}	
 /*****************************************************************/
 
-
@@ -51,19 +51,22 @@ private:
 	int getSharedFloat();
 	int GetIndicatorSpecies(Tree*&);
 	int GetIndicatorSpecies();
-	set<string> getDescendantList(Tree*&, int, map<int, set<string> >, map<int, set<int> >&);
-	vector<float> getValues(vector< vector<SharedRAbundVector*> >&, vector<string>&, map< vector<int>, vector<int> >);
-	vector<float> getValues(vector< vector<SharedRAbundFloatVector*> >&, vector<string>&, map< vector<int>, vector<int> >);
-    
+	vector<int> getSampleLeaves(Tree*&, vector<string>&);
+	vector<int> getParentsFirst(Tree*&);
+	vector< vector<int> > getNodeGroupings(Tree*&, int, vector<int>&, vector<int>&, vector<float>&); //node, leaf of each sample, parents first order, distToRoot
 	map<int, float> getDistToRoot(Tree*&);
-	map< vector<int>, vector<int> > randomizeGroupings(vector< vector<SharedRAbundVector*> >&, int);
-	map< vector<int>, vector<int> > randomizeGroupings(vector< vector<SharedRAbundFloatVector*> >&, int);
-    
-	vector<float> driver(vector< vector<SharedRAbundFloatVector*> >&, int, vector<float>, int);
-	vector<float> driver(vector< vector<SharedRAbundVector*> >&, int, vector<float>, int);
     
-	vector<float> getPValues(vector< vector<SharedRAbundFloatVector*> >&, int, vector<float>);
-	vector<float> getPValues(vector< vector<SharedRAbundVector*> >&, int, vector<float>);
+	//the groupings being tested, as a dense otu by sample matrix with the samples in grouping order
+	vector< vector<double> > abunds;
+	vector<int> groupingStarts; //position of each grouping's first sample, then the number of samples
+	bool integerAbunds;
+	
+	int fillAbundances(vector< vector<SharedRAbundVector*> >&, vector<string>&);
+	int fillAbundances(vector< vector<SharedRAbundFloatVector*> >&, vector<string>&);
+	vector<float> getValues(vector<int>&, vector<string>&, vector<string>&); //sample used at each position, grouping names, indicator groups
+	int randomizeGroupings(vector<int>&, int);
+	vector<float> driver(int, vector<float>&, int);
+	vector<float> getPValues(int, vector<float>&);
 
 	
 };
@@ -71,19 +74,25 @@ private:
 /**************************************************************************************************/
 
 struct indicatorData {
-    vector< vector<SharedRAbundFloatVector*> > groupings;
+    vector< vector<double> >* abunds;  //shared with the other threads, only read
+    vector<int> groupingStarts;
+    bool integerAbunds;
    	MothurOut* m;
     int iters, num;
+    unsigned int seed;
     vector<float> indicatorValues;
     vector<float> pvalues;
 	
 	indicatorData(){}
-	indicatorData(MothurOut* mout, int it, vector< vector<SharedRAbundFloatVector*> > ng, int n, vector<float> iv) {
+	indicatorData(MothurOut* mout, int it, vector< vector<double> >* ab, vector<int> gs, bool ia, int n, vector<float> iv, unsigned int se) {
 		m = mout;
         iters = it;
-        groupings = ng;
+        abunds = ab;
+        groupingStarts = gs;
+        integerAbunds = ia;
         indicatorValues = iv;
         num = n;
+        seed = se;
     }
 };
 /**************************************************************************************************/
@@ -94,81 +103,83 @@ static DWORD WINAPI MyIndicatorThreadFunction(LPVOID lpParam){
 	pDataArray = (indicatorData*)lpParam;
 	
 	try {
+        srand(pDataArray->seed);
         
 		pDataArray->pvalues.resize(pDataArray->indicatorValues.size(), 0);
+        
+        vector<int>& groupingStarts = pDataArray->groupingStarts;
+        int numGroupings = groupingStarts.size()-1;
+        vector<int> samples(groupingStarts[numGroupings]);
+        vector<float> terms(numGroupings, 0.0);
+        vector<float> Bij(numGroupings, 0.0);
 		
 		for(int i=0;i<pDataArray->iters;i++){
 			if (pDataArray->m->control_pressed) { break; }
             
-			//groupingsMap = randomizeGroupings(groupings, num);
+			//randomizeGroupings(samples, num);
             ///////////////////////////////////////////////////////////////////////
-            map< vector<int>, vector<int> > randomGroupings;
+            for (int p = 0; p < samples.size(); p++) { samples[p] = p; }
             
             for (int j = 0; j < pDataArray->num; j++) {
                 
                 //get random groups to swap to switch with
                 //generate random int between 0 and groupings.size()-1
-                int z = pDataArray->m->getRandomIndex(pDataArray->groupings.size()-1);
-                int x = pDataArray->m->getRandomIndex(pDataArray->groupings.size()-1);
-                int a = pDataArray->m->getRandomIndex(pDataArray->groupings[z].size()-1);
-                int b = pDataArray->m->getRandomIndex(pDataArray->groupings[x].size()-1);
-                //cout << i << '\t' << z << '\t' << x << '\t' << a << '\t' << b << endl;
-                
-                vector<int> from;
-                vector<int> to;
+                int z = pDataArray->m->getRandomIndex(numGroupings-1);
+                int x = pDataArray->m->getRandomIndex(numGroupings-1);
+                int a = pDataArray->m->getRandomIndex(groupingStarts[z+1]-groupingStarts[z]-1);
+                int b = pDataArray->m->getRandomIndex(groupingStarts[x+1]-groupingStarts[x]-1);
                 
-                from.push_back(z); from.push_back(a);
-                to.push_back(x); to.push_back(b);
-                
-                randomGroupings[from] = to;
+                samples[groupingStarts[z]+a] = groupingStarts[x]+b;
             }
             ///////////////////////////////////////////////////////////////////////
             
-			//vector<float> randomIndicatorValues = getValues(groupings, notUsedGroupings, randomGroupings);
+			//vector<float> randomIndicatorValues = getValues(samples, noNames, notUsedGroupings);
             ///////////////////////////////////////////////////////////////////////
             vector<float> randomIndicatorValues;
-            map< vector<int>, vector<int> >::iterator it;
             
             //for each otu
-            for (int i = 0; i < pDataArray->groupings[0][0]->getNumBins(); i++) {
+            for (int o = 0; o < pDataArray->abunds->size(); o++) {
                 
                 if (pDataArray->m->control_pressed) { return 0; }
                 
-                vector<float> terms;
+                vector<double>& otuAbunds = (*pDataArray->abunds)[o];
                 float AijDenominator = 0.0;
-                vector<float> Bij;
                 
                 //get overall abundance of each grouping
-                for (int j = 0; j < pDataArray->groupings.size(); j++) {
-                    
-                    float totalAbund = 0;
+                for (int j = 0; j < numGroupings; j++) {
+                    int size = groupingStarts[j+1] - groupingStarts[j];
                     int numNotZero = 0;
-                    for (int k = 0; k < pDataArray->groupings[j].size(); k++) {
-                        vector<int> temp; temp.push_back(j); temp.push_back(k);
-                        it = randomGroupings.find(temp);
-                        
-                        if (it == randomGroupings.end()) { //this one didnt get moved
-                            totalAbund += pDataArray->groupings[j][k]->getAbundance(i);
-                            if (pDataArray->groupings[j][k]->getAbundance(i) != 0.0) { numNotZero++; }
-                        }else {
-                            totalAbund += pDataArray->groupings[(it->second)[0]][(it->second)[1]]->getAbundance(i);
-                            if (pDataArray->groupings[(it->second)[0]][(it->second)[1]]->getAbundance(i) != 0.0) { numNotZero++; }
+                    float Aij = 0.0;
+                    
+                    if (pDataArray->integerAbunds) {
+                        int totalAbund = 0;
+                        for (int p = groupingStarts[j]; p < groupingStarts[j+1]; p++) {
+                            int abund = (int)otuAbunds[samples[p]];
+                            totalAbund += abund;
+                            if (abund != 0) { numNotZero++; }
+                        }
+                        Aij = (totalAbund / (float) size);
+                    }else {
+                        float totalAbund = 0;
+                        for (int p = groupingStarts[j]; p < groupingStarts[j+1]; p++) {
+                            float abund = (float)otuAbunds[samples[p]];
+                            totalAbund += abund;
+                            if (abund != 0.0) { numNotZero++; }
                         }
-                        
+                        Aij = (totalAbund / (float) size);
                     }
                     
                     //mean abundance
-                    float Aij = (totalAbund / (float) pDataArray->groupings[j].size());
-                    terms.push_back(Aij);
+                    terms[j] = Aij;
                     
                     //percentage of sites represented
-                    Bij.push_back(numNotZero / (float) pDataArray->groupings[j].size());
+                    Bij[j] = numNotZero / (float) size;
                     
                     AijDenominator += Aij;
                 }
                 
                 float maxIndVal = 0.0;
-                for (int j = 0; j < terms.size(); j++) { 
+                for (int j = 0; j < numGroupings; j++) { 
                     float thisAij = (terms[j] / AijDenominator); //relative abundance
                     float thisValue = thisAij * Bij[j] * 100.0;
                     
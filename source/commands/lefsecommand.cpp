@@ -32,6 +32,7 @@ vector<string> LefseCommand::setParameters(){
         CommandParameter pstrict("strict", "Multiple", "0-1-2", "0", "", "", "","",false,false); parameters.push_back(pstrict);
         CommandParameter pminc("minc", "Number", "", "10", "", "", "","",false,false); parameters.push_back(pminc);
         CommandParameter pmulticlass_strat("multiclass", "Multiple", "onevone-onevall", "onevall", "", "", "","",false,false); parameters.push_back(pmulticlass_strat);
+        CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
         //CommandParameter psubject("subject", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(psubject);
 
 
@@ -60,7 +61,7 @@ string LefseCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The lefse command allows you to ....\n";
-		helpString += "The lefse command parameters are: shared, design, class, subclass, label, walpha, aalpha, lda, wilc, iters, curv, fboots, strict, minc, multiclass and norm.\n";
+		helpString += "The lefse command parameters are: shared, design, class, subclass, label, walpha, aalpha, lda, wilc, iters, curv, fboots, strict, minc, multiclass, processors and norm.\n";
 		helpString += "The class parameter is used to indicate the which category you would like used for the Kruskal Wallis analysis. If none is provided first category is used.\n";
         helpString += "The subclass parameter is used to indicate the .....If none is provided, second category is used, or if only one category subclass is ignored. \n";
         helpString += "The aalpha parameter is used to set the alpha value for the Krukal Wallis Anova test Default=0.05. \n";
@@ -73,6 +74,7 @@ string LefseCommand::getHelpString(){
         helpString += "The curv parameter is used to set whether perform the wilcoxon testing the Curtis's approach [BETA VERSION] Default=F. \n";
         helpString += "The norm parameter is used to multiply relative abundances by 1000000. Recommended when very low values are present. Default=T. \n";
         helpString += "The fboots parameter is used to set the subsampling fraction value for each bootstrap iteration. Default=0.67. \n";
+        helpString += "The processors parameter allows you to specify how many processors you would like to use for the LDA bootstrap iterations.  The default is 1. \n";
         helpString += "The strict parameter is used to set the multiple testing correction options. 0 no correction (more strict, default), 1 correction for independent comparisons, 2 correction for independent comparison. Options = 0,1,2. Default=0. \n";
         helpString += "The minc parameter is used to minimum number of samples per subclass for performing wilcoxon test. Default=10. \n";
         helpString += "The multiclass parameter is used to (for multiclass tasks) set whether the test is performed in a one-against-one ( onevone - more strict!) or in a one-against-all setting ( onevall - less strict). Default=onevall. \n";
@@ -260,6 +262,10 @@ LefseCommand::LefseCommand(string option)  {
             multiClassStrat = validParameter.validFile(parameters, "multiclass", false);
             if (multiClassStrat == "not found"){	multiClassStrat = "onevall";		}
 			if ((multiClassStrat != "onevall") && (multiClassStrat != "onevone")) { m->mothurOut("Invalid multiclass option: choices are onevone or onevall."); m->mothurOutEndLine(); abort=true; }
+            
+            temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
 		}
 		
 	}
@@ -431,10 +437,26 @@ int LefseCommand::process(vector<SharedRAbundFloatVector*>& lookup, DesignMap& d
         //sort classes so order is right
         sort(classes.begin(), classes.end());
         
-        vector< vector<double> > means = getMeans(lookup, class2GroupIndex); //[numOTUs][classes] - classes in same order as class2GroupIndex
+        //the tests below walk each otu across the groups, so copy the abundances once into [numOTUs][numGroups]
+        int numBins = lookup[0]->getNumBins();
+        vector< vector<double> > abunds; abunds.resize(numBins);
+        for (int i = 0; i < numBins; i++) {
+            abunds[i].resize(lookup.size());
+            for (int j = 0; j < lookup.size(); j++) { abunds[i][j] = lookup[j]->getAbundance(i); }
+        }
+        
+        //class of each group as an index into classes, which is the same order as class2GroupIndex
+        vector<int> groupClass; groupClass.resize(lookup.size(), 0);
+        int count = 0;
+        for (map<string, vector<int> >::iterator it = class2GroupIndex.begin(); it != class2GroupIndex.end(); it++) {
+            for (int j = 0; j < (it->second).size(); j++) { groupClass[(it->second)[j]] = count; }
+            count++;
+        }
+        
+        vector< vector<double> > means = getMeans(abunds, groupClass, classes.size()); //[numOTUs][classes] - classes in same order as class2GroupIndex
         
         //run kruskal wallis on each otu
-        map<int, double> significantOtuLabels = runKruskalWallis(lookup, designMap);
+        map<int, double> significantOtuLabels = runKruskalWallis(abunds, groupClass, classes.size());
         
         int numSigBeforeWilcox = significantOtuLabels.size();
         
@@ -442,7 +464,7 @@ int LefseCommand::process(vector<SharedRAbundFloatVector*>& lookup, DesignMap& d
         
         //check for subclass
         string wilcoxString = "";
-        if ((subclass != "") && wilc) {  significantOtuLabels = runWilcoxon(lookup, designMap, significantOtuLabels, class2SubClasses, subClass2GroupIndex, subclass2Class);  wilcoxString += " ( " + toString(numSigBeforeWilcox) + " ) before internal wilcoxon"; }
+        if ((subclass != "") && wilc) {  significantOtuLabels = runWilcoxon(abunds, significantOtuLabels, class2SubClasses, subClass2GroupIndex, subclass2Class);  wilcoxString += " ( " + toString(numSigBeforeWilcox) + " ) before internal wilcoxon"; }
         
         int numSigAfterWilcox = significantOtuLabels.size();
         
@@ -452,7 +474,7 @@ int LefseCommand::process(vector<SharedRAbundFloatVector*>& lookup, DesignMap& d
         
         map<int, double> sigOTUSLDA;
         if (numSigAfterWilcox > 0) {
-            sigOTUSLDA = testLDA(lookup, significantOtuLabels, class2GroupIndex, subClass2GroupIndex);
+            sigOTUSLDA = testLDA(abunds, significantOtuLabels, class2GroupIndex, groupClass);
             m->mothurOut("Number of discriminative features with abs LDA score > " + toString(ldaThreshold) + " : " + toString(significantOtuLabels.size()) + ".\n");
         }
         else { m->mothurOut("No features with significant differences between the classes.\n"); }
@@ -492,33 +514,18 @@ int LefseCommand::normalize(vector<SharedRAbundFloatVector*>& lookup) {
 	}
 }
 //**********************************************************************************************************************
-map<int, double> LefseCommand::runKruskalWallis(vector<SharedRAbundFloatVector*>& lookup, DesignMap& designMap) {
+map<int, double> LefseCommand::runKruskalWallis(vector< vector<double> >& abunds, vector<int>& groupClass, int numClasses) {
 	try {        
         map<int, double> significantOtuLabels;
-        int numBins = lookup[0]->getNumBins();
         //sanity check to make sure each treatment has a group in the shared file
-        set<string> treatments;
-        for (int j = 0; j < lookup.size(); j++) {
-            string group = lookup[j]->getGroup();
-            string treatment = designMap.get(group, mclass); //get value for this group in this category
-            treatments.insert(treatment);
-        }
-        if (treatments.size() < 2) { m->mothurOut("[ERROR]: need at least 2 things to classes to compare, quitting.\n"); m->control_pressed = true; }
+        if (numClasses < 2) { m->mothurOut("[ERROR]: need at least 2 things to classes to compare, quitting.\n"); m->control_pressed = true; }
         
         LinearAlgebra linear;
-        for (int i = 0; i < numBins; i++) {
+        for (int i = 0; i < abunds.size(); i++) {
             if (m->control_pressed) { break; }
             
-            vector<spearmanRank> values;
-            for (int j = 0; j < lookup.size(); j++) {
-                string group = lookup[j]->getGroup();
-                string treatment = designMap.get(group, mclass); //get value for this group in this category
-                spearmanRank temp(treatment, lookup[j]->getAbundance(i));
-                values.push_back(temp);
-            }
-            
             double pValue = 0.0;
-            linear.calcKruskalWallis(values, pValue);
+            linear.calcKruskalWallis(abunds[i], groupClass, numClasses, pValue);
              
             if (pValue < anovaAlpha) {  significantOtuLabels[i] = pValue;  }
         }
@@ -532,7 +539,7 @@ map<int, double> LefseCommand::runKruskalWallis(vector<SharedRAbundFloatVector*>
 }
 //**********************************************************************************************************************
 //assumes not neccessarily paired
-map<int, double> LefseCommand::runWilcoxon(vector<SharedRAbundFloatVector*>& lookup, DesignMap& designMap, map<int, double> bins, map<string, set<string> >& class2SubClasses, map<string, vector<int> >& subClass2GroupIndex, map<string, string> subclass2Class) {
+map<int, double> LefseCommand::runWilcoxon(vector< vector<double> >& abunds, map<int, double>& bins, map<string, set<string> >& class2SubClasses, map<string, vector<int> >& subClass2GroupIndex, map<string, string>& subclass2Class) {
     try {
         map<int, double> significantOtuLabels;
         map<int, double>::iterator it;
@@ -542,19 +549,11 @@ map<int, double> LefseCommand::runWilcoxon(vector<SharedRAbundFloatVector*>& loo
          anything else
         */
         
-        int numBins = lookup[0]->getNumBins();
-        for (int i = 0; i < numBins; i++) {
+        for (it = bins.begin(); it != bins.end(); it++) { //flagged in Kruskal Wallis
             if (m->control_pressed) { break; }
             
-            it = bins.find(i);
-            if (it != bins.end()) { //flagged in Kruskal Wallis
-                
-                vector<float> abunds;  for (int j = 0; j < lookup.size(); j++) { abunds.push_back(lookup[j]->getAbundance(i)); }
-                
-                bool sig = testOTUWilcoxon(class2SubClasses, abunds, subClass2GroupIndex, subclass2Class);
-                if (sig) { significantOtuLabels[i] = it->second;  }
-                
-            }//bins flagged from kw
+            bool sig = testOTUWilcoxon(class2SubClasses, abunds[it->first], subClass2GroupIndex, subclass2Class);
+            if (sig) { significantOtuLabels[it->first] = it->second;  }
         }//for bins
         
         return significantOtuLabels;
@@ -566,7 +565,7 @@ map<int, double> LefseCommand::runWilcoxon(vector<SharedRAbundFloatVector*>& loo
 }
 //**********************************************************************************************************************
 //lefse.py - test_rep_wilcoxon_r function
-bool LefseCommand::testOTUWilcoxon(map<string, set<string> >& class2SubClasses, vector<float> abunds, map<string, vector<int> >& subClass2GroupIndex, map<string, string> subclass2Class) {
+bool LefseCommand::testOTUWilcoxon(map<string, set<string> >& class2SubClasses, vector<double>& abunds, map<string, vector<int> >& subClass2GroupIndex, map<string, string>& subclass2Class) {
     try {
         int totalOk = 0;
         double alphaMtc = wilcoxonAlpha;
@@ -606,8 +605,8 @@ bool LefseCommand::testOTUWilcoxon(map<string, set<string> >& class2SubClasses,
                         vector<double> x; vector<double> y;
                         
                         //fill x and y
-                        vector<int> xIndexes = subClass2GroupIndex[subclass1]; //indexes in lookup for this subclass
-                        vector<int> yIndexes = subClass2GroupIndex[subclass2]; //indexes in lookup for this subclass
+                        vector<int>& xIndexes = subClass2GroupIndex[subclass1]; //indexes in lookup for this subclass
+                        vector<int>& yIndexes = subClass2GroupIndex[subclass2]; //indexes in lookup for this subclass
                         for (int k = 0; k < yIndexes.size(); k++) { y.push_back(abunds[yIndexes[k]]);  }
                         for (int k = 0; k < xIndexes.size(); k++) { x.push_back(abunds[xIndexes[k]]);  }
                         
@@ -721,75 +720,66 @@ bool LefseCommand::testOTUWilcoxon(map<string, set<string> >& class2SubClasses,
 }
 //**********************************************************************************************************************
 //modelled after lefse.py test_lda_r function
-map<int, double> LefseCommand::testLDA(vector<SharedRAbundFloatVector*>& lookup, map<int, double> bins, map<string, vector<int> >& class2GroupIndex, map<string, vector<int> >& subClass2GroupIndex) {
+map<int, double> LefseCommand::testLDA(vector< vector<double> >& abunds, map<int, double>& bins, map<string, vector<int> >& class2GroupIndex, vector<int>& groupClass) {
     try {
         map<int, double> sigOTUS;
         map<int, double>::iterator it;
         LinearAlgebra linear;
     
-        int numBins = lookup[0]->getNumBins();
         vector< vector<double> > adjustedLookup;
         
-        for (int i = 0; i < numBins; i++) {
+        for (it = bins.begin(); it != bins.end(); it++) { //flagged in Kruskal Wallis and Wilcoxon(if we ran it)
             if (m->control_pressed) { break; }
             
-            if (m->debug) { m->mothurOut("[DEBUG]: bin = " + toString(i) + "\n."); }
+            if (m->debug) { m->mothurOut("[DEBUG]:flagged bin = " + toString(it->first) + "\n."); }
+            
+            //fill x with this OTUs abundances
+            vector<double> x = abunds[it->first];
             
-            it = bins.find(i);
-            if (it != bins.end()) { //flagged in Kruskal Wallis and Wilcoxon(if we ran it)
+            //go through classes
+            for (map<string, vector<int> >::iterator itClass = class2GroupIndex.begin(); itClass != class2GroupIndex.end(); itClass++) {
                 
-                if (m->debug) { m->mothurOut("[DEBUG]:flagged bin = " + toString(i) + "\n."); }
+                if (m->debug) { m->mothurOut("[DEBUG]: class = " + itClass->first + "\n."); }
                 
-                //fill x with this OTUs abundances
-                vector<double> x;
-                for (int j = 0; j < lookup.size(); j++) {  x.push_back(lookup[j]->getAbundance(i));  } 
+                //max(float(feats['class'].count(c))*0.5,4)
+                //max(numGroups in this class*0.5, 4.0)
+                double necessaryNum = ((double)((itClass->second).size())*0.5);
+                if (4.0 > necessaryNum) { necessaryNum = 4.0; }
                 
-                //go through classes
-                for (map<string, vector<int> >::iterator it = class2GroupIndex.begin(); it != class2GroupIndex.end(); it++) {
-                    
-                    if (m->debug) { m->mothurOut("[DEBUG]: class = " + it->first + "\n."); }
-                    
-                    //max(float(feats['class'].count(c))*0.5,4)
-                    //max(numGroups in this class*0.5, 4.0)
-                    double necessaryNum = ((double)((it->second).size())*0.5);
-                    if (4.0 > necessaryNum) { necessaryNum = 4.0; }
-                    
-                    set<double> uniques;
-                    for (int j = 0; j < (it->second).size(); j++) { uniques.insert(x[(it->second)[j]]); }
-                    
-                    //if len(set([float(v[1]) for v in ff if v[0] == c])) > max(float(feats['class'].count(c))*0.5,4): continue
-                    if ((double)(uniques.size()) > necessaryNum) {  }
-                    else {
-                        //feats[k][i] = math.fabs(feats[k][i] + lrand.normalvariate(0.0,max(feats[k][i]*0.05,0.01)))
-                        for (int j = 0; j < (it->second).size(); j++) { //(it->second) contains indexes of abundance for this class
-                            double sigma = max((x[(it->second)[j]]*0.05), 0.01);
-                            x[(it->second)[j]] = abs(x[(it->second)[j]] + linear.normalvariate(0.0, sigma));
-                        }
+                set<double> uniques;
+                for (int j = 0; j < (itClass->second).size(); j++) { uniques.insert(x[(itClass->second)[j]]); }
+                
+                //if len(set([float(v[1]) for v in ff if v[0] == c])) > max(float(feats['class'].count(c))*0.5,4): continue
+                if ((double)(uniques.size()) > necessaryNum) {  }
+                else {
+                    //feats[k][i] = math.fabs(feats[k][i] + lrand.normalvariate(0.0,max(feats[k][i]*0.05,0.01)))
+                    for (int j = 0; j < (itClass->second).size(); j++) { //(itClass->second) contains indexes of abundance for this class
+                        double sigma = max((x[(itClass->second)[j]]*0.05), 0.01);
+                        x[(itClass->second)[j]] = abs(x[(itClass->second)[j]] + linear.normalvariate(0.0, sigma));
                     }
                 }
-                adjustedLookup.push_back(x); 
             }
+            adjustedLookup.push_back(x); 
         }
                 
         //go through classes
         int minCl = 1e6;
-        map<int, string> indexToClass;
         vector<string> classes;
-        for (map<string, vector<int> >::iterator it = class2GroupIndex.begin(); it != class2GroupIndex.end(); it++) {
+        for (map<string, vector<int> >::iterator itClass = class2GroupIndex.begin(); itClass != class2GroupIndex.end(); itClass++) {
             //class with minimum number of groups
-            if ((it->second).size() < minCl) { minCl = (it->second).size(); }
-            for (int i = 0; i < (it->second).size(); i++) { indexToClass[(it->second)[i]] = it->first; }
-            classes.push_back(it->first);
+            if ((itClass->second).size() < minCl) { minCl = (itClass->second).size(); }
+            classes.push_back(itClass->first);
         }
         
-        int numGroups = lookup.size(); //lfk
+        int numGroups = groupClass.size(); //lfk
         int fractionNumGroups = numGroups * fBoots; //rfk
         minCl = (int)((float)(minCl*fBoots*fBoots*0.05));
         minCl = max(minCl, 1);
  
         if (m->debug) { m->mothurOut("[DEBUG]: about to start iters. FractionGroups = " + toString(fractionNumGroups) + "\n."); }
         
-        vector< vector< vector<double> > > results;//[iters][numComparison][numOTUs]
+        //the random samplings are drawn up front so the random number stream, and therefore the results, do not depend on the number of processors
+        vector< vector<int> > randSamples; randSamples.resize(iters); //left empty for skipped iters
         for (int j = 0; j < iters; j++) {
             if (m->control_pressed) { return sigOTUS; }
             
@@ -801,34 +791,27 @@ map<int, double> LefseCommand::testLDA(vector<SharedRAbundFloatVector*>& lookup,
             for (int h = 0; h < 1000; h++) { //generate a vector of length fractionNumGroups with range 0 to numGroups-1
                 save = h;
                 rand_s.clear();
-                for (int k = 0; k < fractionNumGroups; k++) {  int index = m->getRandomIndex(numGroups-1); rand_s.push_back(index);
-                    //if (m->debug) { m->mothurOut("[DEBUG]: index = " + toString(index) + "\n."); }
-                }
-                if (!contastWithinClassesOrFewPerClass(adjustedLookup, rand_s, minCl, class2GroupIndex, indexToClass)) { h+=1000; save += 1000; } //break out of loop
+                for (int k = 0; k < fractionNumGroups; k++) {  int index = m->getRandomIndex(numGroups-1); rand_s.push_back(index); }
+                if (!contastWithinClassesOrFewPerClass(adjustedLookup, rand_s, minCl, groupClass, classes.size())) { h+=1000; save += 1000; } //break out of loop
             }
             if (m->control_pressed) { return sigOTUS; }
             
             if (m->debug) { m->mothurOut("[DEBUG]: after 1000. \n."); }
             
-            //print data in R input format for testing
-            if (false) {
-                vector<string> groups; for (int h = 0; h < rand_s.size(); h++) {  groups.push_back(lookup[rand_s[h]]->getGroup()); }
-                for (int h = 0; h < groups.size(); h++) { cout << groups[h]<< endl; }
-                //printToCoutForRTesting(adjustedLookup, rand_s, class2GroupIndex, bins, subClass2GroupIndex, groups);
-            }
             if (save < 1000) { m->mothurOut("[WARNING]: Skipping iter " + toString(j+1) + " in LDA test. This can be caused by too few groups per class or not enough contrast within the classes. \n"); }
-            else {
-                //for each pair of classes
-                vector< vector<double> > temp = lda(adjustedLookup, rand_s, indexToClass, classes); //[numComparison][numOTUs]
-                if (temp.size() != 0) { results.push_back(temp); }
-                if (m->debug) { m->mothurOut("[DEBUG]: after lda. \n."); }
-            }
+            else { randSamples[j] = rand_s; }
         }
         
-        if (results.size() == 0) { return sigOTUS; }
+        vector< vector< vector<double> > > iterResults;//[iters][numComparison][numOTUs]
+        createProcessesLDA(adjustedLookup, randSamples, groupClass, classes, iterResults);
         
         if (m->control_pressed) { return sigOTUS; }
         
+        vector< vector< vector<double> > > results;//[iters][numComparison][numOTUs]
+        for (int j = 0; j < iterResults.size(); j++) { if (iterResults[j].size() != 0) { results.push_back(iterResults[j]); } }
+        
+        if (results.size() == 0) { return sigOTUS; }
+        
         //m = max([numpy.mean([means[k][kk][p] for kk in range(boots)]) for p in range(len(pairs))])
         int k = 0;
         for (it = bins.begin(); it != bins.end(); it++) { //[numOTUs] - need to go through bins so we can tie adjustedLookup back to the binNumber. adjustedLookup[0] ->bins entry[0]. 
@@ -856,30 +839,132 @@ map<int, double> LefseCommand::testLDA(vector<SharedRAbundFloatVector*>& lookup,
     }
 }
 //**********************************************************************************************************************
-vector< vector<double> > LefseCommand::getMeans(vector<SharedRAbundFloatVector*>& lookup, map<string, vector<int> >& class2GroupIndex) {
+//the lda fits do not use the random number generator, so the iters can be split between processes in any way
+int LefseCommand::createProcessesLDA(vector< vector<double> >& adjustedLookup, vector< vector<int> >& randSamples, vector<int>& groupClass, vector<string>& classes, vector< vector< vector<double> > >& results) {
     try {
-        int numBins = lookup[0]->getNumBins();
-        int numClasses = class2GroupIndex.size();
+        results.clear(); results.resize(randSamples.size());
+        
+        //divide iters between processes
+        vector<linePair> lines;
+        int numItersPerProcessor = randSamples.size() / processors;
+        for (int h = 0; h < processors; h++) {
+            int start = h * numItersPerProcessor;
+            int end = (h+1) * numItersPerProcessor;
+            if(h == processors - 1){ end = randSamples.size(); }
+            lines.push_back(linePair(start, end));
+        }
+        
+        vector<int> processIDS;
+        int process = 1;
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        
+        //loop through and create all the processes you want
+        while (process != processors) {
+            pid_t pid = fork();
+            
+            if (pid > 0) {
+                processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
+                process++;
+            }else if (pid == 0){
+                driverLDA(adjustedLookup, randSamples, groupClass, classes, lines[process].start, lines[process].end, results);
+                
+                //pass results to parent
+                ofstream out;
+                string tempFile = m->mothurGetpid(process) + ".lda.temp";
+                m->openOutputFile(tempFile, out);
+                out << setprecision(17);
+                
+                for (int j = lines[process].start; j < lines[process].end; j++) {
+                    int numComparisons = results[j].size();
+                    int numOtus = 0; if (numComparisons != 0) { numOtus = results[j][0].size(); }
+                    out << numComparisons << '\t' << numOtus << endl;
+                    for (int i = 0; i < numComparisons; i++) {
+                        for (int k = 0; k < numOtus; k++) {  out << results[j][i][k] << '\t'; } out << endl;
+                    }
+                }
+                out.close();
+                
+                exit(0);
+            }else {
+                //the parent picks up the iters of the processes that could not be started
+                m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n");
+                break;
+            }
+        }
+        
+        //do my part
+        driverLDA(adjustedLookup, randSamples, groupClass, classes, lines[0].start, lines[0].end, results);
+        for (int h = process; h < processors; h++) { driverLDA(adjustedLookup, randSamples, groupClass, classes, lines[h].start, lines[h].end, results); }
+        
+        //force parent to wait until all the processes are done
+        for (int i=0;i<processIDS.size();i++) {
+            int temp = processIDS[i];
+            wait(&temp);
+        }
+        
+        //combine results
+        for (int h = 0; h < processIDS.size(); h++) {
+            ifstream in;
+            string tempFile =  toString(processIDS[h]) + ".lda.temp";
+            m->openInputFile(tempFile, in);
+            
+            for (int j = lines[h+1].start; j < lines[h+1].end; j++) {
+                int numComparisons, numOtus;
+                in >> numComparisons >> numOtus; m->gobble(in);
+                results[j].resize(numComparisons);
+                for (int i = 0; i < numComparisons; i++) {
+                    results[j][i].resize(numOtus, 0.0);
+                    for (int k = 0; k < numOtus; k++) { in >> results[j][i][k]; } m->gobble(in);
+                }
+            }
+            in.close(); m->mothurRemove(tempFile);
+        }
+#else
+        driverLDA(adjustedLookup, randSamples, groupClass, classes, 0, randSamples.size(), results);
+#endif
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "LefseCommand", "createProcessesLDA");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+int LefseCommand::driverLDA(vector< vector<double> >& adjustedLookup, vector< vector<int> >& randSamples, vector<int>& groupClass, vector<string>& classes, int start, int end, vector< vector< vector<double> > >& results) {
+    try {
+        for (int j = start; j < end; j++) {
+            if (m->control_pressed) { break; }
+            
+            if (randSamples[j].size() == 0) { continue; } //skipped iter
+            
+            //for each pair of classes
+            results[j] = lda(adjustedLookup, randSamples[j], groupClass, classes); //[numComparison][numOTUs]
+            if (m->debug) { m->mothurOut("[DEBUG]: after lda. \n."); }
+        }
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "LefseCommand", "driverLDA");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+vector< vector<double> > LefseCommand::getMeans(vector< vector<double> >& abunds, vector<int>& groupClass, int numClasses) {
+    try {
+        int numBins = abunds.size();
         vector< vector<double> > means; //[numOTUS][classes]
         means.resize(numBins);
         for (int i = 0; i < means.size(); i++) {  means[i].resize(numClasses, 0.0); }
         
-        map<int, string> indexToClass;
-        int count = 0;
-        //shortcut for vectors below
-        map<string, int> quickIndex;
-        vector<int> classCounts;
-        for (map<string, vector<int> >::iterator it = class2GroupIndex.begin(); it != class2GroupIndex.end(); it++) {
-            for (int i = 0; i < (it->second).size(); i++) { indexToClass[(it->second)[i]] = it->first; }
-            quickIndex[it->first] = count; count++;
-            classCounts.push_back((it->second).size());
-        }
+        vector<int> classCounts; classCounts.resize(numClasses, 0);
+        for (int j = 0; j < groupClass.size(); j++) { classCounts[groupClass[j]]++; }
         
         for (int i = 0; i < numBins; i++) {
-            for (int j = 0; j < lookup.size(); j++) {
-                if (m->control_pressed) { return means; }
-                means[i][quickIndex[indexToClass[j]]] += lookup[j]->getAbundance(i);
-            }
+            if (m->control_pressed) { return means; }
+            for (int j = 0; j < groupClass.size(); j++) { means[i][groupClass[j]] += abunds[i][j]; }
         }
         
         for (int i = 0; i < numBins; i++) {
@@ -894,47 +979,44 @@ vector< vector<double> > LefseCommand::getMeans(vector<SharedRAbundFloatVector*>
     }
 }
 //**********************************************************************************************************************
-vector< vector<double> > LefseCommand::lda(vector< vector<double> >& adjustedLookup, vector<int> rand_s, map<int, string>& indexToClass, vector<string> classes) {
+vector< vector<double> > LefseCommand::lda(vector< vector<double> >& adjustedLookup, vector<int>& rand_s, vector<int>& groupClass, vector<string>& classes) {
     try {
-        //shortcut for vectors below
-        map<string, int> quickIndex;
-        for (int i = 0; i < classes.size(); i++) { quickIndex[classes[i]] = i; }
-        
         vector<string> randClass; //classes for rand sample
+        vector<int> randClassIndex; //index into classes for rand sample
         vector<int> counts; counts.resize(classes.size(), 0);
         for (int i = 0; i < rand_s.size(); i++) {
-            string thisClass = indexToClass[rand_s[i]];
-            randClass.push_back(thisClass);
-            counts[quickIndex[thisClass]]++;
+            int thisClass = groupClass[rand_s[i]];
+            randClass.push_back(classes[thisClass]);
+            randClassIndex.push_back(thisClass);
+            counts[thisClass]++;
         }
 
-        vector< vector<double> > a; //[numOTUs][numSampled]
+        vector< vector<double> > a; a.resize(adjustedLookup.size()); //[numOTUs][numSampled]
         for (int i = 0; i < adjustedLookup.size(); i++) {
-            vector<double> temp;
-            for (int j = 0; j < rand_s.size(); j++) {
-                temp.push_back(adjustedLookup[i][rand_s[j]]);
-            }
-            a.push_back(temp);
+            a[i].resize(rand_s.size());
+            for (int j = 0; j < rand_s.size(); j++) { a[i][j] = adjustedLookup[i][rand_s[j]]; }
         }
         
         LinearAlgebra linear;
         vector< vector<double> > means; bool ignore;
-        vector< vector<double> > scaling = linear.lda(a, randClass, means, ignore); //means are returned sorted, quickIndex sorts as well since it uses a map. means[class][otu] =
+        vector< vector<double> > scaling = linear.lda(a, randClass, means, ignore); //means are returned sorted, classes is sorted as well since it comes from a map. means[class][otu] =
         if (ignore) { scaling.clear(); return scaling; }
         if (m->control_pressed) { return scaling; }
         
-        vector< vector<double> > w; w.resize(a.size()); //w.unit <- w/sqrt(sum(w^2))
+        vector<double> w; w.resize(a.size()); //w.unit <- w/sqrt(sum(w^2))
         double denom = 0.0;
-        for (int i = 0; i < scaling.size(); i++) { w[i].push_back(scaling[i][0]); denom += (w[i][0]*w[i][0]); }
+        for (int i = 0; i < scaling.size(); i++) { w[i] = scaling[i][0]; denom += (w[i]*w[i]); }
         denom = sqrt(denom);
-        for (int i = 0; i < w.size(); i++) {  w[i][0] /= denom;  } //[numOTUs][1] - w.unit
+        for (int i = 0; i < w.size(); i++) {  w[i] /= denom;  } //[numOTUs] - w.unit
         
         //robjects.r('LD <- xy.matrix%*%w.unit') [numSampled][numOtus] * [numOTUs][1]
-        vector< vector<double> > LD = linear.matrix_mult(linear.transpose(a), w);
-        
         //find means for each groups LDs
         vector<double> LDMeans; LDMeans.resize(classes.size(), 0.0); //means[0] -> average for [group0].
-        for (int i = 0; i < LD.size(); i++) {  LDMeans[quickIndex[randClass[i]]] += LD[i][0]; } 
+        for (int j = 0; j < rand_s.size(); j++) {
+            double LD = 0.0;
+            for (int i = 0; i < a.size(); i++) { LD += a[i][j] * w[i]; }
+            LDMeans[randClassIndex[j]] += LD;
+        }
         for (int i = 0; i < LDMeans.size(); i++) { LDMeans[i] /= (double) counts[i];  }
    
 		//calculate for each comparisons i.e. with groups A,B,C = AB, AC, BC = 3;
@@ -946,14 +1028,14 @@ vector< vector<double> > LefseCommand::lda(vector< vector<double> >& adjustedLoo
                 //robjects.r('effect.size <- abs(mean(LD[sub_d[,"class"]=="'+p[0]+'"]) - mean(LD[sub_d[,"class"]=="'+p[1]+'"]))')
                 double effectSize = abs(LDMeans[i] - LDMeans[l]);
                 //scal = robjects.r('wfinal <- w.unit * effect.size')
-                vector<double> compResults;
-                for (int j = 0; j < w.size(); j++) { //[numOTUs][1]
+                vector<double> compResults; compResults.resize(w.size());
+                for (int j = 0; j < w.size(); j++) { //[numOTUs]
                     //coeff = [abs(float(v)) if not math.isnan(float(v)) else 0.0 for v in scal]
-                    double coeff = abs(w[j][0]*effectSize); if (isnan(coeff) || isinf(coeff)) { coeff = 0.0; }
+                    double coeff = abs(w[j]*effectSize); if (isnan(coeff) || isinf(coeff)) { coeff = 0.0; }
                     //gm = abs(res[p[0]][j] - res[p[1]][j]) - res is the means for each group for each otu
                     double gm = abs(means[i][j] - means[l][j]);
                     //means[k][i].append((gm+coeff[j])*0.5)
-                    compResults.push_back((gm+coeff)*0.5);
+                    compResults[j] = (gm+coeff)*0.5;
                 }
                 results.push_back(compResults);
             }
@@ -969,46 +1051,34 @@ vector< vector<double> > LefseCommand::lda(vector< vector<double> >& adjustedLoo
 
 //**********************************************************************************************************************
 //modelled after lefse.py contast_within_classes_or_few_per_class function
-bool LefseCommand::contastWithinClassesOrFewPerClass(vector< vector<double> >& lookup, vector<int> rands, int minCl, map<string, vector<int> > class2GroupIndex, map<int, string> indexToClass) {
+bool LefseCommand::contastWithinClassesOrFewPerClass(vector< vector<double> >& lookup, vector<int>& rands, int minCl, vector<int>& groupClass, int numClasses) {
     try {
-        map<string, int> cls;
-        int countFound = 0;
-        
-        for (int i = 0; i < rands.size(); i++) { //fill cls with the classes represented in the random selection
-            for (map<string, vector<int> >::iterator it = class2GroupIndex.begin(); it != class2GroupIndex.end(); it++) {
-                if (m->inUsersGroups(rands[i], (it->second))) {
-                    map<string, int>::iterator itClass = cls.find(it->first);
-                    if (itClass != cls.end()) { itClass->second++; }
-                    else { cls[it->first] = 1;  }
-                    countFound++;
-                }
-            }
-        }
-        
-        //sanity check
-        if (rands.size() != countFound) { m->mothurOut("oops, should never get here, missing something.\n"); }
-        
-        if (cls.size() < class2GroupIndex.size()) { return true; } //some classes are not present in sampling
+        vector<int> cls; cls.resize(numClasses, 0); //number of times each class is represented in the random selection
+        for (int i = 0; i < rands.size(); i++) { cls[groupClass[rands[i]]]++; }
         
-        for (map<string, int>::iterator itClass = cls.begin(); itClass != cls.end(); itClass++) {
-            if (itClass->second < minCl) { return true; } //this sampling has class count below minimum
+        for (int i = 0; i < numClasses; i++) {
+            if (cls[i] == 0) { return true; } //some classes are not present in sampling
+        }
+        for (int i = 0; i < numClasses; i++) {
+            if (cls[i] < minCl) { return true; } //this sampling has class count below minimum
         }
         
         //for this otu
+        vector< vector<double> > classValues; classValues.resize(numClasses); //abunds present in random sampling for each class. F003Early -> 0.001, 0.003...
         int numBins = lookup.size();
         for (int i = 0; i < numBins; i++) {
             if (m->control_pressed) { break; }
                 
             //break up random sampling by class
-            map<string, set<double> > class2Values; //maps class name -> set of abunds present in random sampling. F003Early -> 0.001, 0.003... 
-            for (int j = 0; j < rands.size(); j++) {
-                class2Values[indexToClass[rands[j]]].insert(lookup[i][rands[j]]);
-                //rands[j] = index of randomly selected group in lookup, randIndex2Class[rands[j]] = class this group belongs to. lookup[rands[j]]->getAbundance(i) = abundance of this group for this OTU.
-            }
+            for (int j = 0; j < numClasses; j++) { classValues[j].clear(); }
+            for (int j = 0; j < rands.size(); j++) { classValues[groupClass[rands[j]]].push_back(lookup[i][rands[j]]); }
+            
             //are the unique values less than we want
             //if (len(set(col)) <= min_cl and min_cl > 1) or (min_cl == 1 and len(set(col)) <= 1):
-            for (map<string, set<double> >::iterator it = class2Values.begin(); it != class2Values.end(); it++) {
-                if (((it->second).size() <= minCl && minCl > 1) || (minCl == 1 && (it->second).size() <= 1)) {  return true; }
+            for (int j = 0; j < numClasses; j++) {
+                sort(classValues[j].begin(), classValues[j].end());
+                int numUnique = unique(classValues[j].begin(), classValues[j].end()) - classValues[j].begin();
+                if ((numUnique <= minCl && minCl > 1) || (minCl == 1 && numUnique <= 1)) {  return true; }
             }
         }
         
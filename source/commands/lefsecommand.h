@@ -53,17 +53,19 @@ private:
     vector<string> outputNames, Sets;
     set<string> labels;
     double anovaAlpha, wilcoxonAlpha, fBoots, ldaThreshold;
-    int nlogs, iters, strict, minC;
+    int nlogs, iters, strict, minC, processors;
     
     int process(vector<SharedRAbundFloatVector*>&, DesignMap&);
     int normalize(vector<SharedRAbundFloatVector*>&);
-    map<int, double> runKruskalWallis(vector<SharedRAbundFloatVector*>&, DesignMap&);
-    map<int, double> runWilcoxon(vector<SharedRAbundFloatVector*>&, DesignMap&, map<int, double>, map<string, set<string> >& class2SubClasses, map<string, vector<int> >& subClass2GroupIndex, map<string, string>);
-    bool testOTUWilcoxon(map<string, set<string> >& class2SubClasses, vector<float> abunds, map<string, vector<int> >& subClass2GroupIndex, map<string, string>);
-    map<int, double> testLDA(vector<SharedRAbundFloatVector*>&, map<int, double>, map<string, vector<int> >& class2GroupIndex, map<string, vector<int> >&);
-    bool contastWithinClassesOrFewPerClass(vector< vector<double> >&, vector<int> rands, int minCl, map<string, vector<int> > class2GroupIndex,  map<int, string> indexToClass);
-    vector< vector<double> > lda(vector< vector<double> >& adjustedLookup, vector<int> rand_s, map<int, string>& indexToClass, vector<string>);
-    vector< vector<double> > getMeans(vector<SharedRAbundFloatVector*>& lookup, map<string, vector<int> >& class2GroupIndex);
+    map<int, double> runKruskalWallis(vector< vector<double> >&, vector<int>& groupClass, int numClasses);
+    map<int, double> runWilcoxon(vector< vector<double> >&, map<int, double>&, map<string, set<string> >& class2SubClasses, map<string, vector<int> >& subClass2GroupIndex, map<string, string>&);
+    bool testOTUWilcoxon(map<string, set<string> >& class2SubClasses, vector<double>& abunds, map<string, vector<int> >& subClass2GroupIndex, map<string, string>&);
+    map<int, double> testLDA(vector< vector<double> >&, map<int, double>&, map<string, vector<int> >& class2GroupIndex, vector<int>& groupClass);
+    bool contastWithinClassesOrFewPerClass(vector< vector<double> >&, vector<int>& rands, int minCl, vector<int>& groupClass, int numClasses);
+    vector< vector<double> > lda(vector< vector<double> >& adjustedLookup, vector<int>& rand_s, vector<int>& groupClass, vector<string>& classes);
+    int createProcessesLDA(vector< vector<double> >&, vector< vector<int> >& randSamples, vector<int>& groupClass, vector<string>& classes, vector< vector< vector<double> > >& results);
+    int driverLDA(vector< vector<double> >&, vector< vector<int> >& randSamples, vector<int>& groupClass, vector<string>& classes, int start, int end, vector< vector< vector<double> > >& results);
+    vector< vector<double> > getMeans(vector< vector<double> >&, vector<int>& groupClass, int numClasses);
     int printResults(vector< vector<double> >, map<int, double>, map<int, double>, string, vector<string>);
     
     //for testing
@@ -421,11 +421,16 @@ int MakeContigsCommand::execute(){
         vector<string> theseOutputFileNames;
         map<string, string> theseAllFileNames;
    
+        Profiler* profiler = Profiler::getInstance();
+        profiler->startPhase("assemble");
+        
         if (file != "") {
             numReads = processMultipleFileOption(totalGroupCounts, theseOutputFileNames, theseAllFileNames);
         }else if ((ffastqfile != "") || (ffastafile != "")) {
             numReads = processSingleFileOption(totalGroupCounts, theseOutputFileNames, theseAllFileNames);
         }else {  return 0; }
+        profiler->addRecords(numReads);
+        profiler->endPhase();
         
         m->mothurOut("It took " + toString(time(NULL) - start) + " secs to process " + toString(numReads) + " sequences.\n");
         
@@ -433,6 +438,8 @@ int MakeContigsCommand::execute(){
     
         
         if (renameSeq) {
+            profiler->startPhase("rename");
+            
             //do we have qualfiles
             bool hasQualFiles = false;
             itTypes = outputTypes.find("qfile");
@@ -976,6 +983,7 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
                 processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                 process++;
             }else if (pid == 0){
+                Profiler::getInstance()->startChild();
                 
                 num = driverGroups(fileInputs, startEndIndexes[process].start, startEndIndexes[process].end,
                                    compositeGroupFile + m->mothurGetpid(process) + ".temp",
@@ -1011,6 +1019,8 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
                 }
                 out.close();
                 
+                Profiler::getInstance()->addRecords(num);
+                Profiler::getInstance()->endChild();
                 exit(0);
             }else {
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -1058,6 +1068,7 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     
                     num = driverGroups(fileInputs, startEndIndexes[process].start, startEndIndexes[process].end,
                                        compositeGroupFile + m->mothurGetpid(process) + ".temp",
@@ -1093,6 +1104,8 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
                     }
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else {
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
@@ -1110,6 +1123,7 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
             int temp = processIDS[i];
             wait(&temp);
         }
+        Profiler::getInstance()->addChildren(processIDS);
         
         for (int i = 0; i < processIDS.size(); i++) {
             ifstream in;
@@ -1319,7 +1333,7 @@ unsigned long long MakeContigsCommand::driverGroups(vector< vector<string> > fil
             
             m->mothurOut("Making contigs...\n");
             
-            unsigned long long thisNumReads = driver(thisFileInputs, thisQualOrIndexInputs, outFastaFile, outScrapFastaFile,  outQualFile, outScrapQualFile, outMisMatchFile, fastaFileNames, qualFileNames, thisLines[0], thisLines[1], thisQLines[0], thisQLines[1], group);
+            unsigned long long thisNumReads = driver(thisFileInputs, thisQualOrIndexInputs, outFastaFile, outScrapFastaFile,  outQualFile, outScrapQualFile, outMisMatchFile, fastaFileNames, qualFileNames, thisLines[0], thisLines[1], thisQLines[0], thisQLines[1], group, "");
             
             numReads += thisNumReads;
             
@@ -1459,26 +1473,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
-                vector<vector<string> > tempFASTAFileNames = fastaFileNames;
-                vector<vector<string> > tempQUALFileNames = qualFileNames;
-                
-				if(allFiles){
-					ofstream temp;
-                    
-					for(int i=0;i<tempFASTAFileNames.size();i++){
-						for(int j=0;j<tempFASTAFileNames[i].size();j++){
-							if (tempFASTAFileNames[i][j] != "") {
-								tempFASTAFileNames[i][j] += m->mothurGetpid(process) + ".temp";
-								m->openOutputFile(tempFASTAFileNames[i][j], temp);			temp.close();
-							}
-                            if (tempQUALFileNames[i][j] != "") {
-                                tempQUALFileNames[i][j] += m->mothurGetpid(process) + ".temp";
-                                m->openOutputFile(tempQUALFileNames[i][j], temp);			temp.close();
-                            }
-						}
-					}
-				}
-                
+                Profiler::getInstance()->startChild();
                 int spot = process*2;
                 
                 num = driver(fileInputs, qualOrIndexFiles,
@@ -1487,7 +1482,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                              outputQual + m->mothurGetpid(process) + ".temp",
                              outputScrapQual + m->mothurGetpid(process) + ".temp",
                              outputMisMatches + m->mothurGetpid(process) + ".temp",
-                             tempFASTAFileNames, tempQUALFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group);
+                             fastaFileNames, qualFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group, m->mothurGetpid(process) + ".demux.temp");
                 
 				//pass groupCounts to parent
                 ofstream out;
@@ -1508,6 +1503,8 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
 				}
                 out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -1520,6 +1517,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                 m->control_pressed = false;
                 for (int i=0;i<processIDS.size();i++) {
                     m->mothurRemove((toString(processIDS[i]) + ".num.temp"));
+                    m->mothurRemove((toString(processIDS[i]) + ".demux.temp"));
                 }
                 recalc = true;
                 break;
@@ -1546,26 +1544,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
-                    vector<vector<string> > tempFASTAFileNames = fastaFileNames;
-                    vector<vector<string> > tempQUALFileNames = qualFileNames;
-                    
-                    if(allFiles){
-                        ofstream temp;
-                        
-                        for(int i=0;i<tempFASTAFileNames.size();i++){
-                            for(int j=0;j<tempFASTAFileNames[i].size();j++){
-                                if (tempFASTAFileNames[i][j] != "") {
-                                    tempFASTAFileNames[i][j] += m->mothurGetpid(process) + ".temp";
-                                    m->openOutputFile(tempFASTAFileNames[i][j], temp);			temp.close();
-                                }
-                                if (tempQUALFileNames[i][j] != "") {
-                                    tempQUALFileNames[i][j] += m->mothurGetpid(process) + ".temp";
-                                    m->openOutputFile(tempQUALFileNames[i][j], temp);			temp.close();
-                                }
-                            }
-                        }
-                    }
-                    
+                    Profiler::getInstance()->startChild();
                     int spot = process*2;
                     
                     num = driver(fileInputs, qualOrIndexFiles,
@@ -1574,7 +1553,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                                  outputQual + m->mothurGetpid(process) + ".temp",
                                  outputScrapQual + m->mothurGetpid(process) + ".temp",
                                  outputMisMatches + m->mothurGetpid(process) + ".temp",
-                                 tempFASTAFileNames, tempQUALFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group);
+                                 fastaFileNames, qualFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group, m->mothurGetpid(process) + ".demux.temp");
                     
                     //pass groupCounts to parent
                     ofstream out;
@@ -1595,6 +1574,8 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                     }
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else { 
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
@@ -1615,13 +1596,14 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
 		//do my part
         int spot = 0;
         
-        num = driver(fileInputs, qualOrIndexFiles, outputFasta, outputScrapFasta,  outputQual, outputScrapQual, outputMisMatches, fastaFileNames, qualFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group);
+        num = driver(fileInputs, qualOrIndexFiles, outputFasta, outputScrapFasta,  outputQual, outputScrapQual, outputMisMatches, fastaFileNames, qualFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group, "");
         
 		//force parent to wait until all the processes are done
 		for (int i=0;i<processIDS.size();i++) { 
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
         
 		for (int i = 0; i < processIDS.size(); i++) {
             ifstream in;
@@ -1734,7 +1716,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         processIDS.push_back(processors-1);
         
         
-        num = driver(fileInputs, qualOrIndexFiles, (outputFasta+ toString(processors-1) + ".temp"),  (outputScrapFasta+ toString(processors-1) + ".temp"),  (outputQual+ toString(processors-1) + ".temp"),  (outputScrapQual+ toString(processors-1) + ".temp"), (outputMisMatches+ toString(processors-1) + ".temp"), tempFASTAFileNames, tempQUALFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group);
+        num = driver(fileInputs, qualOrIndexFiles, (outputFasta+ toString(processors-1) + ".temp"),  (outputScrapFasta+ toString(processors-1) + ".temp"),  (outputQual+ toString(processors-1) + ".temp"),  (outputScrapQual+ toString(processors-1) + ".temp"), (outputMisMatches+ toString(processors-1) + ".temp"), tempFASTAFileNames, tempQUALFileNames, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1], group, "");
         
         
 		//Wait until all threads have terminated.
@@ -1762,6 +1744,9 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
 				
     #endif	
         
+    #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        DemuxWriter groupFiles;
+    #endif
         for (int i = 0; i < processIDS.size(); i++) {
 			m->appendFiles((outputFasta + toString(processIDS[i]) + ".temp"), outputFasta);
 			m->mothurRemove((outputFasta + toString(processIDS[i]) + ".temp"));
@@ -1781,6 +1766,9 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
 			m->mothurRemove((outputMisMatches + toString(processIDS[i]) + ".temp"));
             
             if(allFiles){
+            #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+                groupFiles.appendSpool(toString(processIDS[i]) + ".demux.temp");
+            #else
 				for(int j=0;j<fastaFileNames.size();j++){
 					for(int k=0;k<fastaFileNames[j].size();k++){
 						if (fastaFileNames[j][k] != "") {
@@ -1793,8 +1781,12 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                         }
 					}
 				}
+            #endif
 			}
 		}
+    #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        groupFiles.flush();
+    #endif
 		
 		return num;
 	}
@@ -1804,7 +1796,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
 	}
 }
 //**********************************************************************************************************************
-unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<string> qualOrIndexFiles, string outputFasta, string outputScrapFasta, string outputQual, string outputScrapQual,  string outputMisMatches, vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, linePair linesInput, linePair linesInputReverse, linePair qlinesInput, linePair qlinesInputReverse, string group){
+unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<string> qualOrIndexFiles, string outputFasta, string outputScrapFasta, string outputQual, string outputScrapQual,  string outputMisMatches, vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, linePair linesInput, linePair linesInputReverse, linePair qlinesInput, linePair qlinesInputReverse, string group, string demuxFileName){
     try {
         
         vector< vector<double> > qual_match_simple_bayesian;
@@ -1817,6 +1809,11 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
         
         loadQmatchValues(qual_match_simple_bayesian, qual_mismatch_simple_bayesian);
         
+        //a child process spools its group output for the parent, otherwise the group files are written here
+        DemuxWriter* groupFiles = NULL;
+        if (allFiles && (demuxFileName != "")) { groupFiles = new DemuxWriter(demuxFileName); }
+        else if (allFiles) { groupFiles = new DemuxWriter(); }
+        
         unsigned long long num = 0;
         string thisfqualindexfile, thisrqualindexfile, thisffastafile, thisrfastafile;
         thisfqualindexfile = ""; thisrqualindexfile = "";
@@ -1871,6 +1868,18 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
             else { thisrqualindexfile = ""; }
         }
         
+        //fastq files are read a block at a time, the same way for plain and gz files
+        FastqBuffer* fBuffer = NULL; FastqBuffer* rBuffer = NULL; FastqBuffer* fiBuffer = NULL; FastqBuffer* riBuffer = NULL;
+        if (delim == '@') {
+            istream* inForward = &inFFasta; istream* inReverse = &inRFasta; istream* inFIndex = &inFQualIndex; istream* inRIndex = &inRQualIndex;
+            #ifdef USE_BOOST
+            if (gz) { inForward = &inFF; inReverse = &inRF; inFIndex = &inFQ; inRIndex = &inRQ; }
+            #endif
+            fBuffer = new FastqBuffer(*inForward); rBuffer = new FastqBuffer(*inReverse);
+            if (thisfqualindexfile != "") { fiBuffer = new FastqBuffer(*inFIndex); }
+            if (thisrqualindexfile != "") { riBuffer = new FastqBuffer(*inRIndex); }
+        }
+        
         m->openOutputFile(outputFasta, outFasta);
         m->openOutputFile(outputScrapFasta, outScrapFasta);
         m->openOutputFile(outputMisMatches, outMisMatch);
@@ -1922,12 +1931,14 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
             Sequence findexBarcode("findex", "NONE");  Sequence rindexBarcode("rindex", "NONE");
             
             //read from input files
-            if (gz) {
+            if (delim == '@') {
+                ignore = readFastq(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, *fBuffer, *rBuffer, fiBuffer, riBuffer);
+            }else if (gz) {
                 #ifdef USE_BOOST
-                ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, delim, inFF, inRF, inFQ, inRQ, thisfqualindexfile, thisrqualindexfile);
+                ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, inFF, inRF, inFQ, inRQ, thisfqualindexfile, thisrqualindexfile);
                 #endif
             }else    {
-                ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, delim, inFFasta, inRFasta, inFQualIndex, inRQualIndex, thisfqualindexfile, thisrqualindexfile);
+                ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, inFFasta, inRFasta, inFQualIndex, inRQualIndex, thisfqualindexfile, thisrqualindexfile);
             }
             
             //remove primers and barcodes if neccessary
@@ -2077,17 +2088,15 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
                         outMisMatch << fSeq.getName() << '\t' << contig.length() << '\t' << (oend-oStart) << '\t' << oStart << '\t' << oend << '\t' << numMismatches << '\t' << numNs << endl;
                         
                         if (allFiles) {
-                            ofstream output;
-                            m->openOutputFileAppend(fastaFileNames[barcodeIndex][primerIndex], output);
+                            ostringstream output;
                             output << ">" << fSeq.getName() << '\t' << commentString << endl << contig << endl;
-                            output.close();
+                            groupFiles->write(fastaFileNames[barcodeIndex][primerIndex], output.str());
                             
                             if (hasQuality) {
-                                ofstream output2;
-                                m->openOutputFileAppend(qualFileNames[barcodeIndex][primerIndex], output2);
+                                ostringstream output2;
                                 output2 << ">" << fSeq.getName() << '\t' << commentString << endl;
                                 for (int i = 0; i < contigScores.size(); i++) { output2 << contigScores[i] << " "; }  output2 << endl;
-                                output2.close();
+                                groupFiles->write(qualFileNames[barcodeIndex][primerIndex], output2.str());
                             }
                         }
                     }
@@ -2103,7 +2112,11 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
             num++;
             
             #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-                if (!gz) {
+                if (delim == '@') { //the buffers read ahead of the streams, so they say where the next record is
+                    if (!gz) {
+                        if (fBuffer->eof() || (fBuffer->tell() >= linesInput.end)) { good = false; break; }
+                    }else if (fBuffer->eof() || rBuffer->eof()) { good = false; break; }
+                }else if (!gz) {
                     unsigned long long pos = inFFasta.tellg();
                     if ((pos == -1) || (pos >= linesInput.end)) { good = false; break; }
                 }else {
@@ -2112,7 +2125,9 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
                     #endif
                 }
             #else
-                if (!gz) {
+                if (delim == '@') {
+                    if (fBuffer->eof() || rBuffer->eof()) { good = false; break; }
+                }else if (!gz) {
                     if ((inFFasta.eof()) || (inRFasta.eof())) { good = false; break; }
                 }else {
                     #ifdef USE_BOOST
@@ -2129,6 +2144,9 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
 		if((num) % 1000 != 0){	m->mothurOutJustToScreen(toString(num)+"\n"); }
         
         //close files
+        if (fBuffer != NULL) { delete fBuffer; delete rBuffer; }
+        if (fiBuffer != NULL) { delete fiBuffer; }
+        if (riBuffer != NULL) { delete riBuffer; }
         inFFasta.close();
         inRFasta.close();
         if (gz) {
@@ -2173,6 +2191,7 @@ unsigned long long MakeContigsCommand::driver(vector<string> inputFiles, vector<
         //cleanup memory
         delete alignment;
         if (reorient) { delete rtrimOligos; }
+        if (allFiles) { groupFiles->flush(); delete groupFiles; }
         
         if (m->control_pressed) {
             m->mothurRemove(outputFasta); m->mothurRemove(outputScrapFasta); m->mothurRemove(outputMisMatches);
@@ -2323,82 +2342,37 @@ vector<int> MakeContigsCommand::assembleFragments(vector< vector<double> >&qual_
 }
 /**************************************************************************************************/
 #ifdef USE_BOOST
-//ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, delim,  inFF, inRF, inFQ, inRQ);
-bool MakeContigsCommand::read(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence& findexBarcode, Sequence& rindexBarcode, char delim, boost::iostreams::filtering_istream& inFF, boost::iostreams::filtering_istream& inRF, boost::iostreams::filtering_istream& inFQ, boost::iostreams::filtering_istream& inRQ, string thisfqualindexfile, string thisrqualindexfile) {
+//ignore = read(fSeq, rSeq, fQual, rQual, savedFQual, savedRQual, findexBarcode, rindexBarcode, inFF, inRF, inFQ, inRQ);
+bool MakeContigsCommand::read(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence& findexBarcode, Sequence& rindexBarcode, boost::iostreams::filtering_istream& inFF, boost::iostreams::filtering_istream& inRF, boost::iostreams::filtering_istream& inFQ, boost::iostreams::filtering_istream& inRQ, string thisfqualindexfile, string thisrqualindexfile) {
     try {
         bool ignore = false;
         
-        if (delim == '@') { //fastq files
-            bool tignore;
-            FastqRead fread(inFF, tignore, format);
-            FastqRead rread(inRF, ignore, format);
-            if (!checkName(fread, rread)) {
-                FastqRead f2read(inFF, tignore, format);
-                if (!checkName(f2read, rread)) {
-                    FastqRead r2read(inRF, ignore, format);
-                    if (!checkName(fread, r2read)) {
-                        m->mothurOut("[WARNING]: name mismatch in forward and reverse fastq file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
-                    }else { rread = r2read; }
-                }else { fread = f2read; }
+        //fasta and maybe qual, fastq files go through readFastq
+        Sequence tfSeq(inFF);
+        Sequence trSeq(inRF);
+        if (!checkName(tfSeq, trSeq)) {
+            Sequence t2fSeq(inFF);
+            if (!checkName(t2fSeq, trSeq)) {
+                Sequence t2rSeq(inRF);
+                if (!checkName(tfSeq, t2rSeq)) {
+                    m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true;
+                }else { trSeq = t2fSeq; }
+            }else { tfSeq = t2fSeq; }
+        }
+        fSeq.setName(tfSeq.getName()); fSeq.setAligned(tfSeq.getAligned());
+        rSeq.setName(trSeq.getName()); rSeq.setAligned(trSeq.getAligned());
+        if (thisfqualindexfile != "") {
+            fQual = new QualityScores(inFQ); m->gobble(inFQ);
+            rQual = new QualityScores(inRQ); m->gobble(inRQ);
+            if (!checkName(*fQual, *rQual)) {
+                m->mothurOut("[WARNING]: name mismatch in forward and reverse qual file. Ignoring, " + fQual->getName() + ".\n"); ignore = true;
             }
-            if (tignore) { ignore=true; }
-            fSeq.setName(fread.getName()); fSeq.setAligned(fread.getSeq());
-            rSeq.setName(rread.getName()); rSeq.setAligned(rread.getSeq());
-            fQual = new QualityScores(fread.getName(), fread.getScores());
-            rQual = new QualityScores(rread.getName(), rread.getScores());
             savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
             savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
-            if (thisfqualindexfile != "") { //forward index file
-                FastqRead firead(inFQ, tignore, format);
-                if (tignore) { ignore=true; }
-                findexBarcode.setAligned(firead.getSeq());
-                if (!checkName(fread, firead)) {
-                    FastqRead f2iread(inFQ, tignore, format);
-                    if (tignore) { ignore=true; }
-                    if (!checkName(fread, f2iread)) {
-                        m->mothurOut("[WARNING]: name mismatch in forward index file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
-                    }else { firead = f2iread; findexBarcode.setAligned(firead.getSeq()); }
-                }
-            }
-            if (thisrqualindexfile != "") { //reverse index file
-                FastqRead riread(inRQ, tignore, format);
-                if (tignore) { ignore=true; }
-                rindexBarcode.setAligned(riread.getSeq());
-                if (!checkName(fread, riread)) {
-                    FastqRead r2iread(inRQ, tignore, format); m->gobble(inRQ);
-                    if (tignore) { ignore=true; }
-                    if (!checkName(fread, r2iread)) {
-                        m->mothurOut("[WARNING]: name mismatch in reverse index file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
-                    }else { riread = r2iread; rindexBarcode.setAligned(riread.getSeq()); }
-                }
-            }
-        }else { //reading fasta and maybe qual
-            Sequence tfSeq(inFF);
-            Sequence trSeq(inRF);
-            if (!checkName(tfSeq, trSeq)) {
-                Sequence t2fSeq(inFF);
-                if (!checkName(t2fSeq, trSeq)) {
-                    Sequence t2rSeq(inRF);
-                    if (!checkName(tfSeq, t2rSeq)) {
-                        m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true;
-                    }else { trSeq = t2fSeq; }
-                }else { tfSeq = t2fSeq; }
-            }
-            fSeq.setName(tfSeq.getName()); fSeq.setAligned(tfSeq.getAligned());
-            rSeq.setName(trSeq.getName()); rSeq.setAligned(trSeq.getAligned());
-            if (thisfqualindexfile != "") {
-                fQual = new QualityScores(inFQ); m->gobble(inFQ);
-                rQual = new QualityScores(inRQ); m->gobble(inRQ);
-                if (!checkName(*fQual, *rQual)) {
-                    m->mothurOut("[WARNING]: name mismatch in forward and reverse qual file. Ignoring, " + fQual->getName() + ".\n"); ignore = true;
-                }
-                savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
-                if (fQual->getName() != tfSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
-                if (rQual->getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + trSeq.getName() + ".\n"); ignore = true; }
-            }
-            if (tfSeq.getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
+            if (fQual->getName() != tfSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
+            if (rQual->getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + trSeq.getName() + ".\n"); ignore = true; }
         }
+        if (tfSeq.getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
 
         return ignore;
         
@@ -2411,87 +2385,107 @@ bool MakeContigsCommand::read(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQ
 #endif
 /**************************************************************************************************/
 
-bool MakeContigsCommand::read(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence& findexBarcode, Sequence& rindexBarcode, char delim, ifstream& inFFasta, ifstream& inRFasta, ifstream& inFQualIndex, ifstream& inRQualIndex, string thisfqualindexfile, string thisrqualindexfile) {
+bool MakeContigsCommand::read(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence& findexBarcode, Sequence& rindexBarcode, ifstream& inFFasta, ifstream& inRFasta, ifstream& inFQualIndex, ifstream& inRQualIndex, string thisfqualindexfile, string thisrqualindexfile) {
     try {
         bool ignore = false;
         
-        if (delim == '@') { //fastq files
-            bool tignore;
-            FastqRead fread(inFFasta, tignore, format); m->gobble(inFFasta);
-            FastqRead rread(inRFasta, ignore, format); m->gobble(inRFasta);
-            if (!checkName(fread, rread)) {
-                FastqRead f2read(inFFasta, tignore, format); m->gobble(inFFasta);
-                if (!checkName(f2read, rread)) {
-                    FastqRead r2read(inRFasta, ignore, format); m->gobble(inRFasta);
-                    if (!checkName(fread, r2read)) {
-                        m->mothurOut("[WARNING]: name mismatch in forward and reverse fastq file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
-                    }else { rread = r2read; }
-                }else { fread = f2read; }
+        //fasta and maybe qual, fastq files go through readFastq
+        Sequence tfSeq(inFFasta); m->gobble(inFFasta);
+        Sequence trSeq(inRFasta); m->gobble(inRFasta);
+        if (!checkName(tfSeq, trSeq)) {
+            Sequence t2fSeq(inFFasta); m->gobble(inFFasta);
+            if (!checkName(t2fSeq, trSeq)) {
+                Sequence t2rSeq(inRFasta); m->gobble(inRFasta);
+                if (!checkName(tfSeq, t2rSeq)) {
+                    m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true;
+                }else { trSeq = t2fSeq; }
+            }else { tfSeq = t2fSeq; }
+        }
+        fSeq.setName(tfSeq.getName()); fSeq.setAligned(tfSeq.getAligned());
+        rSeq.setName(trSeq.getName()); rSeq.setAligned(trSeq.getAligned());
+        if (thisfqualindexfile != "") {
+            fQual = new QualityScores(inFQualIndex); m->gobble(inFQualIndex);
+            rQual = new QualityScores(inRQualIndex); m->gobble(inRQualIndex);
+            if (!checkName(*fQual, *rQual)) {
+                m->mothurOut("[WARNING]: name mismatch in forward and reverse qual file. Ignoring, " + fQual->getName() + ".\n"); ignore = true;
             }
-            if (tignore) { ignore=true; }
-            fSeq.setName(fread.getName()); fSeq.setAligned(fread.getSeq());
-            rSeq.setName(rread.getName()); rSeq.setAligned(rread.getSeq());
-            fQual = new QualityScores(fread.getName(), fread.getScores());
-            rQual = new QualityScores(rread.getName(), rread.getScores());
             savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
             savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
-            if (thisfqualindexfile != "") { //forward index file
-                FastqRead firead(inFQualIndex, tignore, format); m->gobble(inFQualIndex);
+            if (fQual->getName() != tfSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
+            if (rQual->getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + trSeq.getName() + ".\n"); ignore = true; }
+        }
+        if (tfSeq.getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
+        
+        return ignore;
+        
+    }
+    catch(exception& e) {
+        m->errorOut(e, "MakeContigsCommand", "read");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//fastq files, plain or gz. The records are copied out of the buffers into the same reads for every pair and the scores stay bytes
+//until they become QualityScores, so reading the files does not allocate per read.
+bool MakeContigsCommand::readFastq(Sequence& fSeq, Sequence& rSeq, QualityScores*& fQual, QualityScores*& rQual, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence& findexBarcode, Sequence& rindexBarcode, FastqBuffer& inForward, FastqBuffer& inReverse, FastqBuffer* inFIndex, FastqBuffer* inRIndex) {
+    try {
+        bool ignore = false;
+        bool tignore;
+        
+        FastqRead& fread = fastqReads.forward; FastqRead& rread = fastqReads.reverse;
+        fread.read(inForward, tignore, format);
+        rread.read(inReverse, ignore, format);
+        if (!checkName(fread, rread)) {
+            FastqRead& f2read = nextFastqRead;
+            f2read.read(inForward, tignore, format);
+            if (!checkName(f2read, rread)) {
+                FastqRead& r2read = nextFastqRead;
+                r2read.read(inReverse, ignore, format);
+                if (!checkName(fread, r2read)) {
+                    m->mothurOut("[WARNING]: name mismatch in forward and reverse fastq file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
+                }else { rread = r2read; }
+            }else { fread = f2read; }
+        }
+        if (tignore) { ignore=true; }
+        fSeq.setName(fread.getName()); fSeq.setAligned(fread.getSeq());
+        rSeq.setName(rread.getName()); rSeq.setAligned(rread.getSeq());
+        fQual = new QualityScores(fread.getName(), fread.getScoreBytes());
+        rQual = new QualityScores(rread.getName(), rread.getScoreBytes());
+        savedFQual = new QualityScores(*fQual);
+        savedRQual = new QualityScores(*rQual);
+        if (inFIndex != NULL) { //forward index file
+            FastqRead& firead = fastqReads.findex;
+            firead.read(*inFIndex, tignore, format);
+            if (tignore) { ignore=true; }
+            findexBarcode.setAligned(firead.getSeq());
+            if (!checkName(fread, firead)) {
+                FastqRead& f2iread = nextFastqRead;
+                f2iread.read(*inFIndex, tignore, format);
                 if (tignore) { ignore=true; }
-                findexBarcode.setAligned(firead.getSeq());
-                if (!checkName(fread, firead)) {
-                    FastqRead f2iread(inFQualIndex, tignore, format); m->gobble(inFQualIndex);
-                    if (tignore) { ignore=true; }
-                    if (!checkName(fread, f2iread)) {
-                        m->mothurOut("[WARNING]: name mismatch in forward index file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
-                    }else { firead = f2iread; findexBarcode.setAligned(firead.getSeq()); }
-                }
+                if (!checkName(fread, f2iread)) {
+                    m->mothurOut("[WARNING]: name mismatch in forward index file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
+                }else { firead = f2iread; findexBarcode.setAligned(firead.getSeq()); }
             }
-            if (thisrqualindexfile != "") { //reverse index file
-                FastqRead riread(inRQualIndex, tignore, format); m->gobble(inRQualIndex);
+        }
+        if (inRIndex != NULL) { //reverse index file
+            FastqRead& riread = fastqReads.rindex;
+            riread.read(*inRIndex, tignore, format);
+            if (tignore) { ignore=true; }
+            rindexBarcode.setAligned(riread.getSeq());
+            if (!checkName(fread, riread)) {
+                FastqRead& r2iread = nextFastqRead;
+                r2iread.read(*inRIndex, tignore, format);
                 if (tignore) { ignore=true; }
-                rindexBarcode.setAligned(riread.getSeq());
-                if (!checkName(fread, riread)) {
-                    FastqRead r2iread(inRQualIndex, tignore, format); m->gobble(inRQualIndex);
-                    if (tignore) { ignore=true; }
-                    if (!checkName(fread, r2iread)) {
-                        m->mothurOut("[WARNING]: name mismatch in reverse index file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
-                    }else { riread = r2iread; rindexBarcode.setAligned(riread.getSeq()); }
-                }
-            }
-        }else { //reading fasta and maybe qual
-            Sequence tfSeq(inFFasta); m->gobble(inFFasta);
-            Sequence trSeq(inRFasta); m->gobble(inRFasta);
-            if (!checkName(tfSeq, trSeq)) {
-                Sequence t2fSeq(inFFasta); m->gobble(inFFasta);
-                if (!checkName(t2fSeq, trSeq)) {
-                    Sequence t2rSeq(inRFasta); m->gobble(inRFasta);
-                    if (!checkName(tfSeq, t2rSeq)) {
-                        m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true;
-                    }else { trSeq = t2fSeq; }
-                }else { tfSeq = t2fSeq; }
-            }
-            fSeq.setName(tfSeq.getName()); fSeq.setAligned(tfSeq.getAligned());
-            rSeq.setName(trSeq.getName()); rSeq.setAligned(trSeq.getAligned());
-            if (thisfqualindexfile != "") {
-                fQual = new QualityScores(inFQualIndex); m->gobble(inFQualIndex);
-                rQual = new QualityScores(inRQualIndex); m->gobble(inRQualIndex);
-                if (!checkName(*fQual, *rQual)) {
-                    m->mothurOut("[WARNING]: name mismatch in forward and reverse qual file. Ignoring, " + fQual->getName() + ".\n"); ignore = true;
-                }
-                savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
-                if (fQual->getName() != tfSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
-                if (rQual->getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + trSeq.getName() + ".\n"); ignore = true; }
+                if (!checkName(fread, r2iread)) {
+                    m->mothurOut("[WARNING]: name mismatch in reverse index file. Ignoring, " + fread.getName() + ".\n"); ignore = true;
+                }else { riread = r2iread; rindexBarcode.setAligned(riread.getSeq()); }
             }
-            if (tfSeq.getName() != trSeq.getName()) { m->mothurOut("[WARNING]: name mismatch in forward and reverse fasta file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
         }
         
         return ignore;
-        
     }
     catch(exception& e) {
-        m->errorOut(e, "MakeContigsCommand", "read");
+        m->errorOut(e, "MakeContigsCommand", "readFastq");
         exit(1);
     }
 }
@@ -21,6 +21,7 @@
 #include "oligos.h"
 #include "fastqread.h"
 #include "kmeralign.h"
+#include "demuxwriter.h"
 
 #        define PROBABILITY(score) (pow(10.0, (-(double)(score)) / 10.0))
 #        define PHREDMAX 46
@@ -76,6 +77,8 @@ private:
     map<string, string> groupMap;
     map<int, string> file2Group;
     vector<double> qual_score;
+    pairFastqRead fastqReads; //records reused for every read of fastq files
+    FastqRead nextFastqRead; //the following record when a file is out of step with the others
     
     int setNameType(string, string);
     int setNameType(string, string, char);
@@ -88,16 +91,17 @@ private:
     unsigned long long processSingleFileOption(map<string, int>&, vector<string>&, map<string, string>&);
     int loadQmatchValues(vector< vector<double> >&, vector< vector<double> >&);
     #ifdef USE_BOOST
-    bool read(Sequence&, Sequence&, QualityScores*&, QualityScores*&, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence&, Sequence&, char, boost::iostreams::filtering_istream&, boost::iostreams::filtering_istream&, boost::iostreams::filtering_istream&, boost::iostreams::filtering_istream&, string, string);
+    bool read(Sequence&, Sequence&, QualityScores*&, QualityScores*&, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence&, Sequence&, boost::iostreams::filtering_istream&, boost::iostreams::filtering_istream&, boost::iostreams::filtering_istream&, boost::iostreams::filtering_istream&, string, string);
     #endif
-    bool read(Sequence&, Sequence&, QualityScores*&, QualityScores*&, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence&, Sequence&, char, ifstream&, ifstream&, ifstream&, ifstream&, string, string);
+    bool read(Sequence&, Sequence&, QualityScores*&, QualityScores*&, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence&, Sequence&, ifstream&, ifstream&, ifstream&, ifstream&, string, string);
+    bool readFastq(Sequence&, Sequence&, QualityScores*&, QualityScores*&, QualityScores*& savedFQual, QualityScores*& savedRQual, Sequence&, Sequence&, FastqBuffer&, FastqBuffer&, FastqBuffer*, FastqBuffer*);
     vector<int> assembleFragments(vector< vector<double> >&qual_match_simple_bayesian, vector< vector<double> >& qual_mismatch_simple_bayesian, Sequence& fSeq, Sequence& rSeq, QualityScores*&, QualityScores*&, QualityScores*& savedFQual, QualityScores*& savedRQual, bool, Alignment*& alignment, string& contig, string&, int&, int&, int&);
     
     //main processing functions
     unsigned long long createProcesses(vector<string>, vector<string>, string, string, string, string, string, vector<vector<string> >, vector<vector<string> >, vector<linePair>, vector<linePair>, string);
     unsigned long long createProcessesGroups(vector< vector<string> >, string compositeGroupFile, string compositeFastaFile, string compositeScrapFastaFile, string compositeQualFile, string compositeScrapQualFile, string compositeMisMatchFile, map<string, int>& totalGroupCounts, map<string, string>&);
     unsigned long long driverGroups(vector<vector<string> >, int, int, string, string, string, string, string, string, map<string, int>&, map<string, string>&);
-    unsigned long long driver(vector<string> files, vector<string> qualOrIndexFiles, string outputFasta, string outputScrapFasta, string outputQual, string outputScrapQual,  string outputMisMatches, vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, linePair, linePair, linePair, linePair, string);
+    unsigned long long driver(vector<string> files, vector<string> qualOrIndexFiles, string outputFasta, string outputScrapFasta, string outputQual, string outputScrapQual,  string outputMisMatches, vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, linePair, linePair, linePair, linePair, string, string);
     int convertProb(double qProb);
     vector< vector<string> > readFileNames(string);
     bool getOligos(vector<vector<string> >&, vector<vector<string> >&, string, map<string, string>&);
@@ -640,6 +644,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
             
             //for(int i = 0; i < pDataArray->linesInput_end; i++){ //end is the number of sequences to process
             bool good = true;
+            FastqRead fread, rread, f2read, r2read, firead, f2iread, riread, r2iread; //refilled for every pair instead of built per read
             while (good) {
                 
                 if (pDataArray->m->control_pressed) { break; }
@@ -657,8 +662,8 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                 if (!pDataArray->gz) {
                     if (pDataArray->delim == '@') { //fastq files
                         bool tignore;
-                        FastqRead fread(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
-                        FastqRead rread(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
+                        fread.read(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
+                        rread.read(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
                         
                         ///bool fixed = checkName(fread, rread);
                         //////////////////////////////////////////////////////////////
@@ -685,7 +690,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                         }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                         /////////////////////////////////////////////////////////////
                         if (!fixed) {
-                            FastqRead f2read(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
+                            f2read.read(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
                             ///bool fixed = checkName(f2read, rread);
                             //////////////////////////////////////////////////////////////
                             fixed = false;
@@ -711,7 +716,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                                 
                             }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                             if (!fixed) {
-                                FastqRead r2read(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
+                                r2read.read(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
                                 ///bool fixed = checkName(fread, r2read);
                                 //////////////////////////////////////////////////////////////
                                 fixed = false;
@@ -747,12 +752,12 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                         if (tignore) { ignore=true; }
                         fSeq.setName(fread.getName()); fSeq.setAligned(fread.getSeq());
                         rSeq.setName(rread.getName()); rSeq.setAligned(rread.getSeq());
-                        fQual = new QualityScores(fread.getName(), fread.getScores());
-                        rQual = new QualityScores(rread.getName(), rread.getScores());
-                        savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                        savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
+                        fQual = new QualityScores(fread.getName(), fread.getScoreBytes());
+                        rQual = new QualityScores(rread.getName(), rread.getScoreBytes());
+                        savedFQual = new QualityScores(*fQual);
+                        savedRQual = new QualityScores(*rQual);
                         if (thisfqualindexfile != "") { //forward index file
-                            FastqRead firead(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
+                            firead.read(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
                             if (tignore) { ignore=true; }
                             findexBarcode.setAligned(firead.getSeq());
                             ///bool fixed = checkName(fread, firead);
@@ -782,7 +787,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             
                             /////////////////////////////////////////////////////////////
                             if (!fixed) {
-                                FastqRead f2iread(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
+                                f2iread.read(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
                                 fixed = false;
                                 if (pDataArray->nameType == poundMatch) {
                                     fixed = poundMatch;
@@ -812,7 +817,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             }
                         }
                         if (thisrqualindexfile != "") { //reverse index file
-                            FastqRead riread(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
+                            riread.read(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
                             if (tignore) { ignore=true; }
                             rindexBarcode.setAligned(riread.getSeq());
                             ///bool fixed = checkName(fread, riread);
@@ -842,7 +847,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             
                             /////////////////////////////////////////////////////////////
                             if (!fixed) {
-                                FastqRead r2iread(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
+                                r2iread.read(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
                                 fixed = false;
                                 if (pDataArray->nameType == poundMatch) {
                                     fixed = poundMatch;
@@ -999,8 +1004,8 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                                     pDataArray->m->mothurOut("[WARNING]: name mismatch in forward and reverse qfile file. Ignoring, " + fQual->getName() + ".\n"); ignore = true; }
                             }
                             
-                            savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                            savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
+                            savedFQual = new QualityScores(*fQual);
+                            savedRQual = new QualityScores(*rQual);
                             if (fQual->getName() != fread.getName()) { pDataArray->m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + fread.getName() + ".\n"); ignore = true; }
                             if (rQual->getName() != rread.getName()) { pDataArray->m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + rread.getName() + ".\n"); ignore = true; }
                         }
@@ -1010,8 +1015,8 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                     #ifdef USE_BOOST
                     if (pDataArray->delim == '@') { //fastq files
                         bool tignore;
-                        FastqRead fread(inFF, tignore, pDataArray->format);
-                        FastqRead rread(inRF, ignore, pDataArray->format);
+                        fread.read(inFF, tignore, pDataArray->format);
+                        rread.read(inRF, ignore, pDataArray->format);
                         
                         ///bool fixed = checkName(fread, rread);
                         //////////////////////////////////////////////////////////////
@@ -1039,7 +1044,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                         
                         /////////////////////////////////////////////////////////////
                         if (!fixed) {
-                            FastqRead f2read(inFF, tignore, pDataArray->format);
+                            f2read.read(inFF, tignore, pDataArray->format);
                             ///bool fixed = checkName(f2read, rread);
                             //////////////////////////////////////////////////////////////
                             fixed = false;
@@ -1065,7 +1070,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                             
                             if (!fixed) {
-                                FastqRead r2read(inRF, ignore, pDataArray->format);
+                                r2read.read(inRF, ignore, pDataArray->format);
                                 ///bool fixed = checkName(fread, r2read);
                                 //////////////////////////////////////////////////////////////
                                 fixed = false;
@@ -1101,12 +1106,12 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                         if (tignore) { ignore=true; }
                         fSeq.setName(fread.getName()); fSeq.setAligned(fread.getSeq());
                         rSeq.setName(rread.getName()); rSeq.setAligned(rread.getSeq());
-                        fQual = new QualityScores(fread.getName(), fread.getScores());
-                        rQual = new QualityScores(rread.getName(), rread.getScores());
-                        savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                        savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
+                        fQual = new QualityScores(fread.getName(), fread.getScoreBytes());
+                        rQual = new QualityScores(rread.getName(), rread.getScoreBytes());
+                        savedFQual = new QualityScores(*fQual);
+                        savedRQual = new QualityScores(*rQual);
                         if (thisfqualindexfile != "") { //forward index file
-                            FastqRead firead(inFQ, tignore, pDataArray->format);
+                            firead.read(inFQ, tignore, pDataArray->format);
                             if (tignore) { ignore=true; }
                             findexBarcode.setAligned(firead.getSeq());
                             ///bool fixed = checkName(fread, firead);
@@ -1134,7 +1139,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                             /////////////////////////////////////////////////////////////
                             if (!fixed) {
-                                FastqRead f2iread(inFQ, tignore, pDataArray->format);
+                                f2iread.read(inFQ, tignore, pDataArray->format);
                                 fixed = false;
                                 if (pDataArray->nameType == poundMatch) {
                                     fixed = poundMatch;
@@ -1162,7 +1167,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             }
                         }
                         if (thisrqualindexfile != "") { //reverse index file
-                            FastqRead riread(inRQ, tignore, pDataArray->format);
+                            riread.read(inRQ, tignore, pDataArray->format);
                             if (tignore) { ignore=true; }
                             rindexBarcode.setAligned(riread.getSeq());
                             ///bool fixed = checkName(fread, riread);
@@ -1190,7 +1195,7 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                             }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                             /////////////////////////////////////////////////////////////
                             if (!fixed) {
-                                FastqRead r2iread(inRQ, tignore, pDataArray->format);
+                                r2iread.read(inRQ, tignore, pDataArray->format);
                                 fixed = false;
                                 if (pDataArray->nameType == poundMatch) {
                                     fixed = poundMatch;
@@ -1343,8 +1348,8 @@ static DWORD WINAPI MyGroupContigsThreadFunction(LPVOID lpParam){
                                     pDataArray->m->mothurOut("[WARNING]: name mismatch in forward and reverse qfile file. Ignoring, " + fQual->getName() + ".\n"); ignore = true; }
                             }
                             
-                            savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                            savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
+                            savedFQual = new QualityScores(*fQual);
+                            savedRQual = new QualityScores(*rQual);
                             if (fQual->getName() != tfSeq.getName()) { pDataArray->m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + tfSeq.getName() + ".\n"); ignore = true; }
                             if (rQual->getName() != trSeq.getName()) { pDataArray->m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + trSeq.getName() + ".\n"); ignore = true; }
                         }
@@ -2184,6 +2189,7 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
             rtrimOligos = new TrimOligos(pDataArray->pdiffs, pDataArray->bdiffs, 0, 0, oligos.getReorientedPairedPrimers(), oligos.getReorientedPairedBarcodes(), hasIndex); numBarcodes = oligos.getReorientedPairedBarcodes().size();
         }
         
+        FastqRead fread, rread, f2read, r2read, firead, f2iread, riread, r2iread; //refilled for every pair instead of built per read
         for(int i = 0; i < pDataArray->linesInput_end; i++){ //end is the number of sequences to process
             
             if (pDataArray->m->control_pressed) { break; }
@@ -2201,8 +2207,8 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
             Sequence findexBarcode("findex", "NONE");  Sequence rindexBarcode("rindex", "NONE");
             if (pDataArray->delim == '@') { //fastq files
                 bool tignore;
-                FastqRead fread(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
-                FastqRead rread(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
+                fread.read(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
+                rread.read(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
                 
                 ///bool fixed = checkName(fread, rread);
                 bool fixed = false;
@@ -2228,7 +2234,7 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                 }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                 /////////////////////////////////////////////////////////////
                 if (!fixed) {
-                    FastqRead f2read(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
+                    f2read.read(inFFasta, tignore, pDataArray->format); pDataArray->m->gobble(inFFasta);
                     ///bool fixed = checkName(f2read, rread);
                     //////////////////////////////////////////////////////////////
                     fixed = false;
@@ -2253,7 +2259,7 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                         
                     }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                     if (!fixed) {
-                        FastqRead r2read(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
+                        r2read.read(inRFasta, ignore, pDataArray->format); pDataArray->m->gobble(inRFasta);
                         ///bool fixed = checkName(fread, r2read);
                         //////////////////////////////////////////////////////////////
                         fixed = false;
@@ -2289,12 +2295,12 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                 if (tignore) { ignore=true; }
                 fSeq.setName(fread.getName()); fSeq.setAligned(fread.getSeq());
                 rSeq.setName(rread.getName()); rSeq.setAligned(rread.getSeq());
-                fQual = new QualityScores(fread.getName(), fread.getScores());
-                rQual = new QualityScores(rread.getName(), rread.getScores());
-                savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
+                fQual = new QualityScores(fread.getName(), fread.getScoreBytes());
+                rQual = new QualityScores(rread.getName(), rread.getScoreBytes());
+                savedFQual = new QualityScores(*fQual);
+                savedRQual = new QualityScores(*rQual);
                 if (thisfqualindexfile != "") { //forward index file
-                    FastqRead firead(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
+                    firead.read(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
                     if (tignore) { ignore=true; }
                     findexBarcode.setAligned(firead.getSeq());
                     ///bool fixed = checkName(fread, firead);
@@ -2322,7 +2328,7 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                     }else if (pDataArray->nameType == perfectMatch) { fixed = true; }
                     /////////////////////////////////////////////////////////////
                     if (!fixed) {
-                        FastqRead f2iread(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
+                        f2iread.read(inFQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inFQualIndex);
                         if (tignore) { ignore=true; }
                         ///bool fixed = checkName(fread, f2iread);
                         /////////////////////////////////////////////////////////////
@@ -2354,7 +2360,7 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                     hasIndex = true;
                 }
                 if (thisrqualindexfile != "") { //reverse index file
-                    FastqRead riread(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
+                    riread.read(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
                     if (tignore) { ignore=true; }
                     rindexBarcode.setAligned(riread.getSeq());
                     ///bool fixed = checkName(fread, riread);
@@ -2383,7 +2389,7 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                     
                     /////////////////////////////////////////////////////////////
                     if (!fixed) {
-                        FastqRead r2iread(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
+                        r2iread.read(inRQualIndex, tignore, pDataArray->format); pDataArray->m->gobble(inRQualIndex);
                         ///bool fixed = checkName(fread, r2iread);
                         /////////////////////////////////////////////////////////////
                         fixed = false;
@@ -2537,8 +2543,8 @@ static DWORD WINAPI MyContigsThreadFunction(LPVOID lpParam){
                             pDataArray->m->mothurOut("[WARNING]: name mismatch in forward and reverse qfile file. Ignoring, " + fQual->getName() + ".\n"); ignore = true; }
                     }
 
-                    savedFQual = new QualityScores(fQual->getName(), fQual->getQualityScores());
-                    savedRQual = new QualityScores(rQual->getName(), rQual->getQualityScores());
+                    savedFQual = new QualityScores(*fQual);
+                    savedRQual = new QualityScores(*rQual);
                     if (fQual->getName() != fread.getName()) { pDataArray->m->mothurOut("[WARNING]: name mismatch in forward quality file. Ignoring, " + fread.getName() + ".\n"); ignore = true; }
                     if (rQual->getName() != rread.getName()) { pDataArray->m->mothurOut("[WARNING]: name mismatch in reverse quality file. Ignoring, " + rread.getName() + ".\n"); ignore = true; }
                 }
@@ -50,7 +50,7 @@ string MetaStatsCommand::getHelpString(){
 		helpString += "The threshold parameter allows you to set the significance level to reject null hypotheses (default 0.05).\n";
 		helpString += "The groups parameter allows you to specify which of the groups in your groupfile you would like included. The group names are separated by dashes.\n";
 		helpString += "The label parameter allows you to select what distance levels you would like, and are also separated by dashes.\n";
-		helpString += "The processors parameter allows you to specify how many processors you would like to use.  The default is 1. \n";
+		helpString += "The processors parameter allows you to specify how many processors you would like to use. The pairwise comparisons are divided between them, or the permutations when you are comparing only two sets.  The default is 1. \n";
 		helpString += "The metastats command should be in the following format: metastats(design=yourDesignFile).\n";
 		helpString += "Example metastats(design=temp.design, groups=A-B-C).\n";
 		helpString += "The default value for groups is all the groups in your groupfile, and all labels in your inputfile will be used.\n";
@@ -251,8 +251,9 @@ int MetaStatsCommand::execute(){
 		}
 	
 		
-		//only 1 combo
-		if (numGroups == 2) { processors = 1; }
+		//only 1 combo, so the processors split its permutations instead
+		permutationProcessors = 1;
+		if (numGroups == 2) { permutationProcessors = processors; processors = 1; }
 		else if (numGroups < 2)	{ m->mothurOut("Not enough sets, I need at least 2 valid sets. Unable to complete command."); m->mothurOutEndLine(); m->control_pressed = true; }
 
         if(processors != 1){
@@ -572,7 +573,7 @@ int MetaStatsCommand::driver(unsigned long long start, unsigned long long num, v
                 if (convertSharedToInput) { convertToInput(subset, outputFileName);  }
 				
 				m->mothurOutEndLine();
-				MothurMetastats mothurMeta(threshold, iters);
+				MothurMetastats mothurMeta(threshold, iters, permutationProcessors);
 				mothurMeta.runMetastats(outputFileName , data2, setACount);
 				m->mothurOutEndLine();
 				m->mothurOutEndLine(); 
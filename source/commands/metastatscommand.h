@@ -47,7 +47,7 @@ private:
 	string groups, label, outputDir, inputDir, designfile, sets, sharedfile;
 	vector<string> Groups, outputNames, Sets;
 	vector< vector<string> > namesOfGroupCombos;
-	int iters, processors;
+	int iters, processors, permutationProcessors;
 	float threshold;
 	
 	int process(vector<SharedRAbundVector*>&);
@@ -140,7 +140,7 @@ static DWORD WINAPI MyMetastatsThreadFunction(LPVOID lpParam){
 				pDataArray->m->mothurOut("Comparing " + setA + " and " + setB + "..."); pDataArray->m->mothurOutEndLine(); 
 				
 				pDataArray->m->mothurOutEndLine();
-				MothurMetastats mothurMeta(pDataArray->threshold, pDataArray->iters);
+				MothurMetastats mothurMeta(pDataArray->threshold, pDataArray->iters, 1);
 				mothurMeta.runMetastats(outputFileName, data2, setACount);
 				pDataArray->m->mothurOutEndLine();
 				pDataArray->m->mothurOutEndLine(); 
@@ -445,14 +445,18 @@ int ParseFastaQCommand::processFile(vector<string> files, TrimOligos*& trimOligo
         if (files[2] != "") { m->openInputFile(files[2], inFIndex);  }
         if (files[3] != "") { m->openInputFile(files[3], inRIndex);  }
         
+        //the files are read a block at a time and the reads are refilled for each pair, so nothing is allocated per read
+        FastqBuffer fBuffer(inf), rBuffer(inr), fiBuffer(inFIndex), riBuffer(inRIndex);
+        FastqRead thisfRead, thisrRead, copyForward, copyReverse, thisfiRead, thisriRead;
+        
         int count = 0;
-        while (!inf.eof() && !inr.eof()) {
+        while (!fBuffer.eof() && !rBuffer.eof()) {
             
             if (m->control_pressed) { break; }
             
             bool ignoref, ignorer;
-            FastqRead thisfRead(inf, ignoref, format);
-            FastqRead thisrRead(inr, ignorer, format);
+            thisfRead.read(fBuffer, ignoref, format);
+            thisrRead.read(rBuffer, ignorer, format);
             
             if (!ignoref && ! ignorer) {
                 if (qual) {
@@ -472,8 +476,8 @@ int ParseFastaQCommand::processFile(vector<string> files, TrimOligos*& trimOligo
                     for (int i = 0; i < rqual.size(); i++) { if (rqual[i] == 0){ rseq[i] = 'N'; } }
                     thisrRead.setSeq(rseq);
                 }
-                FastqRead copyForward = thisfRead;
-                FastqRead copyReverse = thisrRead;
+                copyForward = thisfRead;
+                copyReverse = thisrRead;
                 
                 //print sequence info to files
                 if (fasta) {
@@ -489,12 +493,12 @@ int ParseFastaQCommand::processFile(vector<string> files, TrimOligos*& trimOligo
                         bool ignorefi, ignoreri;
                     
                         if (files[2] != "") {
-                            FastqRead thisfiRead(inFIndex, ignorefi, format);
+                            thisfiRead.read(fiBuffer, ignorefi, format);
                             if (!ignorefi) {  findexBarcode.setAligned(thisfiRead.getSequence().getAligned());  }
                         }
                         
                         if (files[3] != "") {
-                            FastqRead thisriRead(inRIndex, ignoreri, format);
+                            thisriRead.read(riBuffer, ignoreri, format);
                             if (!ignoreri) {  rindexBarcode.setAligned(thisriRead.getSequence().getAligned());  }
                         }
                     }
@@ -595,6 +599,9 @@ int ParseFastaQCommand::processFile(vector<string> files, TrimOligos*& trimOligo
             }
         }
         
+        //the reads are paired by position, so a file that runs out first leaves the rest of the other unmatched
+        if (!m->control_pressed && (fBuffer.eof() != rBuffer.eof())) { m->mothurOut("[WARNING]: " + inputfile + " and " + inputReverse + " do not have the same number of reads, ignoring the reads after the end of the shorter file.\n"); }
+        
         inf.close(); inr.close();
         if (files[2] != "") { inFIndex.close();  }
         if (files[3] != "") { inRIndex.close();  }
@@ -638,13 +645,16 @@ int ParseFastaQCommand::processFile(string inputfile, TrimOligos*& trimOligos, T
         }
         
         
+        FastqBuffer buffer(in); //read a block at a time
+        FastqRead thisRead, copy; //refilled for each read
+        
         int count = 0;
-        while (!in.eof()) {
+        while (!buffer.eof()) {
             
             if (m->control_pressed) { break; }
             
             bool ignore;
-            FastqRead thisRead(in, ignore, format);
+            thisRead.read(buffer, ignore, format);
             
             if (!ignore) {
                 if (qual) {  thisRead.getQuality().printQScores(outQual); }
@@ -657,7 +667,7 @@ int ParseFastaQCommand::processFile(string inputfile, TrimOligos*& trimOligos, T
                     thisRead.setSeq(seq);
                 }
                 
-                FastqRead copy = thisRead;
+                copy = thisRead;
                 
                 //print sequence info to files
                 if (fasta) { thisRead.getSequence().printSequence(outFasta); }
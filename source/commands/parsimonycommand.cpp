@@ -42,7 +42,7 @@ string ParsimonyCommand::getHelpString(){
 		helpString += "The groups parameter allows you to specify which of the groups in your groupfile you would like analyzed.  You must enter at least 1 valid group.\n";
 		helpString += "The group names are separated by dashes.  The iters parameter allows you to specify how many random trees you would like compared to your tree.\n";
 		helpString += "The parsimony command should be in the following format: parsimony(random=yourOutputFilename, groups=yourGroups, iters=yourIters).\n";
-		helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1. The random trees are divided between the processors, each with its own random number stream, so with more than one processor the random trees differ from a run with one processor and the same seed.\n";
 		helpString += "Example parsimony(random=out, iters=500).\n";
 		helpString += "The default value for random is "" (meaning you want to use the trees in your inputfile, randomtree=out means you just want the random distribution of trees outputted to out.rd_parsimony),\n";
 		helpString += "and iters is 1000.  The parsimony command output two files: .parsimony and .psummary their descriptions are in the manual.\n";
@@ -335,88 +335,43 @@ int ParsimonyCommand::execute() {
 				}
 			}
 			
+			//the random trees all have the same leaves, so one tree is made and only its topology changes. The
+			//parsimony calculator only uses the leaves groups, so the non leaf nodes groups aren't merged
+			randT = new Tree(ct);
+			
 			//get pscores for random trees
-			for (int j = 0; j < iters; j++) {
-								
-				//create new tree with same num nodes and leaves as users
-				randT = new Tree(ct);
-
-				//create random relationships between nodes
-				randT->assembleRandomTree();
-
-				//get pscore of random tree
-				randomData = pars.getValues(randT, processors, outputDir);
-				
-				if (m->control_pressed) { 
-					delete reading;  delete output; delete randT;
-					if (randomtree == "") {  outSum.close();  }
-					for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } outputTypes.clear();
-					delete ct; for (int i = 0; i < T.size(); i++) { delete T[i]; }
-					m->clearGroups();
-					return 0;
-				}
-					
-				for(int r = 0; r < numComp; r++) {
-					//add trees pscore to map of scores
-					map<int,double>::iterator it = rscoreFreq[r].find(randomData[r]);
-					if (it != rscoreFreq[r].end()) {//already have that score
-						rscoreFreq[r][randomData[r]]++;
-					}else{//first time we have seen this score
-						rscoreFreq[r][randomData[r]] = 1;
-					}
-			
-					//add randoms score to validscores
-					validScores[randomData[r]] = randomData[r];
-				}
-				
-				//update progress bar
-				reading->update(j);
-				
-				delete randT;
+			vector< vector<double> > randomScores;
+			createProcesses(pars, reading, randomScores);
+			
+			if (m->control_pressed) { 
+				delete reading;  delete output; delete randT;
+				if (randomtree == "") {  outSum.close();  }
+				for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } outputTypes.clear();
+				delete ct; for (int i = 0; i < T.size(); i++) { delete T[i]; }
+				m->clearGroups();
+				return 0;
 			}
+			
+			for (int j = 0; j < iters; j++) { addRandomScores(randomScores[j]); }
+			
+			delete randT;
 
 		}else {
+			//the random trees all have the same leaves, so one tree is made and only its topology changes
+			randT = new Tree(ct);
+			
 			//get pscores for random trees
-			for (int j = 0; j < iters; j++) {
-								
-				//create new tree with same num nodes and leaves as users
-				randT = new Tree(ct);
-				//create random relationships between nodes
-
-				randT->assembleRandomTree();
-				
-				if (m->control_pressed) { 
-					delete reading; delete output; delete randT; delete ct; 
-					for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } outputTypes.clear(); return 0;
-				}
-
-
-				//get pscore of random tree
-				randomData = pars.getValues(randT, processors, outputDir);
-				
-				if (m->control_pressed) { 
-					delete reading; delete output; delete randT; delete ct; 
-					for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } outputTypes.clear(); return 0;
-				}
+			vector< vector<double> > randomScores;
+			createProcesses(pars, reading, randomScores);
 			
-				for(int r = 0; r < numComp; r++) {
-					//add trees pscore to map of scores
-					map<int,double>::iterator it = rscoreFreq[r].find(randomData[r]);
-					if (it != rscoreFreq[r].end()) {//already have that score
-						rscoreFreq[r][randomData[r]]++;
-					}else{//first time we have seen this score
-						rscoreFreq[r][randomData[r]] = 1;
-					}
-			
-					//add randoms score to validscores
-					validScores[randomData[r]] = randomData[r];
-				}
-				
-				//update progress bar
-				reading->update(j);
-				
-				delete randT;
+			if (m->control_pressed) { 
+				delete reading; delete output; delete randT; delete ct; 
+				for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } outputTypes.clear(); return 0;
 			}
+			
+			for (int j = 0; j < iters; j++) { addRandomScores(randomScores[j]); }
+			
+			delete randT;
 		}
 
 		for(int a = 0; a < numComp; a++) {
@@ -597,5 +552,142 @@ void ParsimonyCommand::getUserInput() {
 	}
 }
 /***********************************************************/
+//the random trees are split between the processes. Each child reseeds from a base drawn by the parent, so it only makes
+//the trees in its own share. With one processor the random trees are the same as before.
+int ParsimonyCommand::createProcesses(Parsimony& pars, Progress* reading, vector< vector<double> >& scores) {
+	try {
+		scores.clear(); scores.resize(iters);
+		
+		vector<linePair> lines;
+		int remainingIters = iters; int startIndex = 0;
+		for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
+			int numIters = remainingIters; //case for last processor
+			if (remainingProcessors != 1) { numIters = remainingIters / remainingProcessors; }
+			lines.push_back(linePair(startIndex, numIters));
+			startIndex += numIters;
+			remainingIters -= numIters;
+		}
+		
+		int process = 0;
+		vector<int> processIDS;
+		
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		unsigned int seedBase = 0;
+		if (processors > 1) { seedBase = rand(); }
+		
+		//loop through and create all the processes you want
+		while (process != (processors-1)) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
+				process++;
+			}else if (pid == 0){
+				srand(seedBase + process + 1);
+				driver(pars, NULL, lines[process].start, lines[process].end, scores);
+				
+				if (m->control_pressed) { exit(0); }
+				
+				//pass scores to parent
+				ofstream out;
+				string tempFile = outputDir + m->mothurGetpid(process) + ".parsimony.random.temp";
+				m->openOutputFile(tempFile, out);
+				for (int j = lines[process].start; j < (lines[process].start + lines[process].end); j++) {
+					out << scores[j].size();
+					for (int r = 0; r < scores[j].size(); r++) { out << '\t' << scores[j][r]; }
+					out << endl;
+				}
+				out.close();
+				
+				exit(0);
+			}else { 
+				m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process+1) + "\n");
+				break;
+			}
+		}
+		
+		//the parent scores the shares the children didn't take
+		driver(pars, reading, lines[process].start, iters - lines[process].start, scores);
+		
+		//force parent to wait until all the processes are done
+		for (int i = 0; i < processIDS.size(); i++) { 
+			int temp = processIDS[i];
+			wait(&temp);
+		}
+		
+		for (int i = 0; i < processIDS.size(); i++) {
+			string tempFile = outputDir + toString(processIDS[i]) + ".parsimony.random.temp";
+			
+			if (!m->control_pressed) {
+				ifstream in;
+				m->openInputFile(tempFile, in);
+				
+				for (int j = lines[i].start; j < (lines[i].start + lines[i].end); j++) {
+					int numScores = 0; in >> numScores;
+					scores[j].resize(numScores, 0);
+					for (int r = 0; r < numScores; r++) { in >> scores[j][r]; }
+				}
+				in.close();
+			}
+			m->mothurRemove(tempFile);
+		}
+#else
+		//rand() is kept per thread on windows, so the random trees are all made here
+		driver(pars, reading, 0, iters, scores);
+#endif
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ParsimonyCommand", "createProcesses");
+		exit(1);
+	}
+}
+/***********************************************************/
+int ParsimonyCommand::driver(Parsimony& pars, Progress* reading, int start, int num, vector< vector<double> >& scores) {
+	try {
+		for (int j = start; j < (start+num); j++) {
+			
+			if (m->control_pressed) { return 0; }
+			
+			//create random relationships between nodes
+			randT->randomTopology();
+			
+			//get pscore of random tree
+			scores[j] = pars.getValues(randT, 1, outputDir);
+			
+			//update progress bar
+			if (reading != NULL) { reading->update(j); }
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ParsimonyCommand", "driver");
+		exit(1);
+	}
+}
+/***********************************************************/
+void ParsimonyCommand::addRandomScores(vector<double>& randomScores) {
+	try {
+		for(int r = 0; r < numComp; r++) {
+			//add trees pscore to map of scores
+			map<int,double>::iterator it = rscoreFreq[r].find(randomScores[r]);
+			if (it != rscoreFreq[r].end()) {//already have that score
+				rscoreFreq[r][randomScores[r]]++;
+			}else{//first time we have seen this score
+				rscoreFreq[r][randomScores[r]] = 1;
+			}
+			
+			//add randoms score to validscores
+			validScores[randomScores[r]] = randomScores[r];
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ParsimonyCommand", "addRandomScores");
+		exit(1);
+	}
+}
+/***********************************************************/
 
 
@@ -68,6 +68,9 @@ private:
 	int printUSummaryFile();
 	void getUserInput();
 	int readNamesFile();
+	int createProcesses(Parsimony&, Progress*, vector< vector<double> >&);
+	int driver(Parsimony&, Progress*, int, int, vector< vector<double> >&);
+	void addRandomScores(vector<double>&);
 	
 };
 
@@ -309,7 +309,7 @@ int PhyloDiversityCommand::execute(){
 			//create a vector containing indexes of leaf nodes, randomize it, select nodes to send to calculator
 			vector<int> randomLeaf;
 			for (int j = 0; j < numLeafNodes; j++) {  
-				if (m->inUsersGroups(trees[i]->tree[j].getGroup(), mGroups) == true) { //is this a node from the group the user selected.
+				if (m->inUsersGroups(trees[i]->getGroups(j), mGroups) == true) { //is this a node from the group the user selected.
 					randomLeaf.push_back(j); 
 				}
 			}
@@ -595,57 +595,78 @@ int PhyloDiversityCommand::driver(Tree* t, map< string, vector<float> >& div, ma
 	try {
 		int numLeafNodes = randomLeaf.size();
 		vector<string> mGroups = m->getGroups();
+        int numGroups = mGroups.size();
         
-        map<string, int> rootForGroup = getRootForGroups(t); //maps groupName to root node in tree. "root" for group may not be the trees root and we don't want to include the extra branches.
+        map<string, int> groupIndex;
+        for (int j = 0; j < numGroups; j++) { groupIndex[mGroups[j]] = j; }
         
+        map<string, int> rootForGroupNames = getRootForGroups(t); //maps groupName to root node in tree. "root" for group may not be the trees root and we don't want to include the extra branches.
+        vector<int> rootForGroup; rootForGroup.resize(numGroups, 0);
+        for (int j = 0; j < numGroups; j++) {
+            map<string, int>::iterator it = rootForGroupNames.find(mGroups[j]);
+            if (it != rootForGroupNames.end()) { rootForGroup[j] = it->second; }
+        }
+        
+        //for each leaf, the index of each of its groups in mGroups (-1 if not a users group) and the number of seqs from that group
+        vector< vector<int> > leafGroups; leafGroups.resize(t->getNumLeaves());
+        vector< vector<int> > leafGroupCounts; leafGroupCounts.resize(t->getNumLeaves());
+        for (int k = 0; k < numLeafNodes; k++) {
+            int leaf = randomLeaf[k];
+            for (int j = 0; j < t->tree[leaf].pcount.size(); j++) {
+                int thisGroup = -1; int numSeqsInGroupJ = 0;
+                map<string, int>::iterator it = groupIndex.find(t->getGroupName(t->tree[leaf].pcount[j].first));
+                if (it != groupIndex.end()) {
+                    thisGroup = it->second;
+                    numSeqsInGroupJ = t->tree[leaf].pcount[j].second; //this leaf node contains seqs from group j
+                }
+                leafGroups[leaf].push_back(thisGroup);
+                leafGroupCounts[leaf].push_back(numSeqsInGroupJ);
+            }
+        }
+        
+        vector< vector<float> > groupDiv; groupDiv.resize(numGroups); //div and sumDiv indexed by group
+        vector< vector<float> > groupSumDiv; groupSumDiv.resize(numGroups);
+        for (int j = 0; j < numGroups; j++) { groupDiv[j] = div[mGroups[j]]; groupSumDiv[j] = sumDiv[mGroups[j]]; }
+        
+        //counted[node*numGroups+group] == iteration number if that groups branch lengths from node to root are already included
+        vector<int> counted; counted.resize(t->getNumNodes()*numGroups, 0);
+        vector<float> br;
         
 		for (int l = 0; l < numIters; l++) {
             random_shuffle(randomLeaf.begin(), randomLeaf.end());
             
             //initialize counts
-            map<string, int> counts;
-            vector< map<string, bool> > countedBranch;
-            for (int i = 0; i < t->getNumNodes(); i++) {
-                map<string, bool> temp;
-                for (int j = 0; j < mGroups.size(); j++) { temp[mGroups[j]] = false; }
-                countedBranch.push_back(temp);
-            }
-            
-            for (int j = 0; j < mGroups.size(); j++) {  counts[mGroups[j]] = 0;   }
-            
-            map<string, int> metCount; bool allDone = false;
-            for (int j = 0; j < mGroups.size(); j++) {  counts[mGroups[j]] = false;   }
+            vector<int> counts; counts.resize(numGroups, 0);
+            vector<bool> metCount; metCount.resize(numGroups, false);
+            bool allDone = false;
             for(int k = 0; k < numLeafNodes; k++){
                 
                 if (m->control_pressed) { return 0; }
                 
                 //calc branch length of randomLeaf k
-                vector<float> br = calcBranchLength(t, randomLeaf[k], countedBranch, rootForGroup);
+                calcBranchLength(t, randomLeaf[k], leafGroups[randomLeaf[k]], counted, l+1, numGroups, rootForGroup, br);
                 
                 //for each group in the groups update the total branch length accounting for the names file
-                vector<string> groups = t->tree[randomLeaf[k]].getGroup();
+                vector<int>& groups = leafGroups[randomLeaf[k]];
                 
                 for (int j = 0; j < groups.size(); j++) {
                     
-                    if (m->inUsersGroups(groups[j], mGroups)) {
-                        int numSeqsInGroupJ = 0;
-                        map<string, int>::iterator it;
-                        it = t->tree[randomLeaf[k]].pcount.find(groups[j]);
-                        if (it != t->tree[randomLeaf[k]].pcount.end()) { //this leaf node contains seqs from group j
-                            numSeqsInGroupJ = it->second;
-                        }
+                    int thisGroup = groups[j];
+                    if (thisGroup != -1) {
+                        int numSeqsInGroupJ = leafGroupCounts[randomLeaf[k]][j];
+                        vector<float>& thisDiv = groupDiv[thisGroup];
                         
-                        if (numSeqsInGroupJ != 0) {	div[groups[j]][(counts[groups[j]]+1)] = div[groups[j]][counts[groups[j]]] + br[j];  }
+                        if (numSeqsInGroupJ != 0) {	thisDiv[(counts[thisGroup]+1)] = thisDiv[counts[thisGroup]] + br[j];  }
                         
-                        for (int s = (counts[groups[j]]+2); s <= (counts[groups[j]]+numSeqsInGroupJ); s++) {
-                            div[groups[j]][s] = div[groups[j]][s-1];  //update counts, but don't add in redundant branch lengths
+                        for (int s = (counts[thisGroup]+2); s <= (counts[thisGroup]+numSeqsInGroupJ); s++) {
+                            thisDiv[s] = thisDiv[s-1];  //update counts, but don't add in redundant branch lengths
                         }
-                        counts[groups[j]] += numSeqsInGroupJ;
+                        counts[thisGroup] += numSeqsInGroupJ;
                         if (subsample) {
-                            if (counts[groups[j]] >= subsampleSize) { metCount[groups[j]] = true; }
+                            if (counts[thisGroup] >= subsampleSize) { metCount[thisGroup] = true; }
                             bool allTrue = true;
-                            for (int h = 0; h < mGroups.size(); h++) {
-                                if (!metCount[mGroups[h]]) { allTrue = false; }
+                            for (int h = 0; h < numGroups; h++) {
+                                if (!metCount[h]) { allTrue = false; }
                             }
                             if (allTrue) { allDone = true; }
                         }
@@ -657,17 +678,20 @@ int PhyloDiversityCommand::driver(Tree* t, map< string, vector<float> >& div, ma
             //if you subsample then rarefy=t
             if (rarefy) {
                 //add this diversity to the sum
-                for (int j = 0; j < mGroups.size(); j++) {
-                    for (int g = 0; g < div[mGroups[j]].size(); g++) {
-                        sumDiv[mGroups[j]][g] += div[mGroups[j]][g];
+                for (int j = 0; j < numGroups; j++) {
+                    for (int g = 0; g < groupDiv[j].size(); g++) {
+                        groupSumDiv[j][g] += groupDiv[j][g];
                     }
                 }
             }
             
+            if (((collect) || (summary)) && (l == 0) && doSumCollect) { for (int j = 0; j < numGroups; j++) { div[mGroups[j]] = groupDiv[j]; } }
             if ((collect) && (l == 0) && doSumCollect) {  printData(numSampledList, div, outCollect, 1);  }
             if ((summary) && (l == 0) && doSumCollect) {  printSumData(div, outSum, 1);  }
         }
         
+        for (int j = 0; j < numGroups; j++) { div[mGroups[j]] = groupDiv[j]; sumDiv[mGroups[j]] = groupSumDiv[j]; }
+        
         return 0;
 
 	}
@@ -748,50 +772,42 @@ void PhyloDiversityCommand::printData(set<int>& num, map< string, vector<float>
 	}
 }
 //**********************************************************************************************************************
-//need a vector of floats one branch length for every group the node represents.
-vector<float> PhyloDiversityCommand::calcBranchLength(Tree* t, int leaf, vector< map<string, bool> >& counted, map<string, int> roots){
+//need a vector of floats one branch length for every group the node represents. groups holds the index of each of the leafs groups in mGroups, -1 for groups the user did not select.
+//counted is marked with stamp for each node and group whose branch lengths are included. Every node above a counted node is counted as well, so a groups walk stops at the first one.
+void PhyloDiversityCommand::calcBranchLength(Tree* t, int leaf, vector<int>& groups, vector<int>& counted, int stamp, int numGroups, vector<int>& roots, vector<float>& sums){
 	try {
         
 		//calc the branch length
-		//while you aren't at root
-		vector<float> sums; 
-		int index = leaf;
+		sums.assign(groups.size(), 0.0);
 		
-		vector<string> groups = t->tree[leaf].getGroup();
-		sums.resize(groups.size(), 0.0);
-		
-        
-        //you are a leaf
-		if(t->tree[index].getBranchLength() != -1){	
-			for (int k = 0; k < groups.size(); k++) { 
-                sums[k] += abs(t->tree[index].getBranchLength());	
-			}
-		}
-        
-        
-        index = t->tree[index].getParent();	
+        float leafLength = t->tree[leaf].getBranchLength();
         
-		//while you aren't at root
-		while(t->tree[index].getParent() != -1){
+		for (int k = 0; k < groups.size(); k++) {
+            if (groups[k] == -1) { continue; }
             
-			if (m->control_pressed) {  return sums; }
-			
-			for (int k = 0; k < groups.size(); k++) {
+            //you are a leaf
+            if(leafLength != -1){ sums[k] += abs(leafLength); }
+            
+            int index = t->tree[leaf].getParent();
+            
+            //while you aren't at root
+            while(t->tree[index].getParent() != -1){
                 
-                if (index >= roots[groups[k]]) { counted[index][groups[k]] = true; } //if you are at this groups "root", then say we are done
+                int spot = index*numGroups+groups[k];
+                if (counted[spot] == stamp) { break; } //this groups has already added all br from here to root, so quit early
                 
-                if (!counted[index][groups[k]]){ //if counted[index][groups[k] is true this groups has already added all br from here to root, so quit early
+                counted[spot] = stamp;
+                
+                if (index < roots[groups[k]]) { //if you are at this groups "root", then say we are done
                     if (t->tree[index].getBranchLength() != -1) {
                         sums[k] += abs(t->tree[index].getBranchLength());
                     }
-                    counted[index][groups[k]] = true;
                 }
+                
+                index = t->tree[index].getParent();
             }
-            index = t->tree[index].getParent();	
         }
         
-		return sums;
-        
 	}
 	catch(exception& e) {
 		m->errorOut(e, "PhyloDiversityCommand", "calcBranchLength");
@@ -809,11 +825,12 @@ map<string, int> PhyloDiversityCommand::getRootForGroups(Tree* t){
         
         for (int i = 0; i < t->getNumLeaves(); i++) {
             
-            vector<string> groups = t->tree[i].getGroup();
+            vector<string> groups = t->getGroups(i);
             
             int index = t->tree[i].getParent();
             
             for (int j = 0; j < groups.size(); j++) {
+                int thisGroup = t->getGroupIndex(groups[j]);
                 
                     if (done[groups[j]] == false) { //we haven't found the root for this group yet, initialize it
                         done[groups[j]] = true;
@@ -830,12 +847,10 @@ map<string, int> PhyloDiversityCommand::getRootForGroups(Tree* t){
                         int rc = t->tree[index].getRChild();
                         
                         int LpcountSize = 0;
-                        map<string, int>:: iterator itGroup = t->tree[lc].pcount.find(groups[j]);
-                        if (itGroup != t->tree[lc].pcount.end()) { LpcountSize++;  } 
+                        if (t->tree[lc].getPcount(thisGroup) != 0) { LpcountSize++;  } 
                         
                         int RpcountSize = 0;
-                        itGroup = t->tree[rc].pcount.find(groups[j]);
-                        if (itGroup != t->tree[rc].pcount.end()) { RpcountSize++;  } 
+                        if (t->tree[rc].getPcount(thisGroup) != 0) { RpcountSize++;  } 
                         
                         if ((LpcountSize != 0) && (RpcountSize != 0)) { //possible root
                             if (index > roots[groups[j]]) {  roots[groups[j]] = index; }
@@ -46,7 +46,7 @@ private:
 		int readNamesFile();
 		void printData(set<int>&, map< string, vector<float> >&, ofstream&, int);
 		void printSumData(map< string, vector<float> >&, ofstream&, int);
-        vector<float> calcBranchLength(Tree*, int, vector< map<string, bool> >&, map<string, int>);
+        void calcBranchLength(Tree*, int, vector<int>&, vector<int>&, int, int, vector<int>&, vector<float>&);
 		int driver(Tree*, map< string, vector<float> >&, map<string, vector<float> >&, int, int, vector<int>&, set<int>&, ofstream&, ofstream&, bool);
 		int createProcesses(vector<int>&, Tree*, map< string, vector<float> >&, map<string, vector<float> >&, int, int, vector<int>&, set<int>&, ofstream&, ofstream&);
 
@@ -121,7 +121,7 @@ static DWORD WINAPI MyPhyloDivThreadFunction(LPVOID lpParam){
                 vector<float> br;
                 int index = pDataArray->randomLeaf[k];
                 
-                vector<string> groups = pDataArray->t->tree[pDataArray->randomLeaf[k]].getGroup();
+                vector<string> groups = pDataArray->t->getGroups(pDataArray->randomLeaf[k]);
                 br.resize(groups.size(), 0.0);
 
                 //you are a leaf
@@ -154,17 +154,12 @@ static DWORD WINAPI MyPhyloDivThreadFunction(LPVOID lpParam){
                 /////////////////////////////////////////////////////////////////////////////////////
                 
                 //for each group in the groups update the total branch length accounting for the names file
-                groups = pDataArray->t->tree[pDataArray->randomLeaf[k]].getGroup();
+                groups = pDataArray->t->getGroups(pDataArray->randomLeaf[k]);
                 
                 for (int j = 0; j < groups.size(); j++) {
                     
                     if (pDataArray->m->inUsersGroups(groups[j], mGroups)) {
-                        int numSeqsInGroupJ = 0;
-                        map<string, int>::iterator it;
-                        it = pDataArray->t->tree[pDataArray->randomLeaf[k]].pcount.find(groups[j]);
-                        if (it != pDataArray->t->tree[pDataArray->randomLeaf[k]].pcount.end()) { //this leaf node contains seqs from group j
-                            numSeqsInGroupJ = it->second;
-                        }
+                        int numSeqsInGroupJ = pDataArray->t->getPcount(pDataArray->randomLeaf[k], groups[j]); //seqs this leaf node contains from group j
                         
                         if (numSeqsInGroupJ != 0) {	pDataArray->div[groups[j]][(counts[groups[j]]+1)] = pDataArray->div[groups[j]][counts[groups[j]]] + br[j];  }
                         
@@ -298,6 +298,9 @@ int PreClusterCommand::execute(){
 			ofstream outNames; m->openOutputFile(newNamesFile, outNames);  outNames.close();
 			newMapFile = fileroot + "precluster.";
 			
+			Profiler* profiler = Profiler::getInstance();
+			profiler->startPhase("read");
+			
 			//parse fasta and name file by group
             vector<string> groups;
 			if (countfile != "") {
@@ -309,9 +312,11 @@ int PreClusterCommand::execute(){
                 groups = parser->getNamesOfGroups();
 			}
             
+			profiler->startPhase("precluster");
 			if(processors == 1)	{	driverGroups(newFastaFile, newNamesFile, newMapFile, 0, groups.size(), groups);	}
 			else				{	createProcessesGroups(newFastaFile, newNamesFile, newMapFile, groups);			}
 			
+			profiler->startPhase("merge");
 			if (countfile != "") { 
                 mergeGroupCounts(newCountFile, newNamesFile, newFastaFile);
                 delete cparser; 
@@ -337,11 +342,14 @@ int PreClusterCommand::execute(){
                 m->renameFile(filenames["fasta"][0], newFastaFile);
                 m->renameFile(filenames["name"][0], newNamesFile); 
 			}
+            profiler->endPhase();
             if (m->control_pressed) { for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); 	}	 delete alignment; return 0; }
 			m->mothurOut("It took " + toString(time(NULL) - start) + " secs to run pre.cluster."); m->mothurOutEndLine(); 
 				
 		}else {
             if (processors != 1) { m->mothurOut("When using running without group information mothur can only use 1 processor, continuing."); m->mothurOutEndLine(); processors = 1; }
+			Profiler* profiler = Profiler::getInstance();
+			profiler->startPhase("read");
 			if (namefile != "") { readNameFile(); }
 		
 			//reads fasta file and return number of seqs
@@ -352,7 +360,9 @@ int PreClusterCommand::execute(){
 			if (numSeqs == 0) { m->mothurOut("Error reading fasta file...please correct."); m->mothurOutEndLine(); delete alignment; return 0;  }
 			if (diffs > length) { m->mothurOut("Error: diffs is greater than your sequence length."); m->mothurOutEndLine(); delete alignment; return 0;  }
 			
+			profiler->startPhase("precluster");
 			int count = process(newMapFile);
+			profiler->addRecords(numSeqs);
 			outputNames.push_back(newMapFile); outputTypes["map"].push_back(newMapFile);
 			
 			if (m->control_pressed) { for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); 	} delete alignment; return 0; }
@@ -360,7 +370,9 @@ int PreClusterCommand::execute(){
 			m->mothurOut("Total number of sequences before precluster was " + toString(alignSeqs.size()) + "."); m->mothurOutEndLine();
 			m->mothurOut("pre.cluster removed " + toString(count) + " sequences."); m->mothurOutEndLine(); m->mothurOutEndLine(); 
 			if (countfile != "") { newNamesFile = newCountFile; }
+            profiler->startPhase("write");
             printData(newFastaFile, newNamesFile, "");
+            profiler->endPhase();
             			
 			m->mothurOut("It took " + toString(time(NULL) - start) + " secs to cluster " + toString(numSeqs) + " sequences."); m->mothurOutEndLine(); 
 		}
@@ -433,6 +445,7 @@ int PreClusterCommand::createProcessesGroups(string newFName, string newNName, s
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+                Profiler::getInstance()->startChild();
                 outputNames.clear();
 				num = driverGroups(newFName + m->mothurGetpid(process) + ".temp", newNName + m->mothurGetpid(process) + ".temp", newMFile, lines[process].start, lines[process].end, groups);
                 
@@ -444,6 +457,8 @@ int PreClusterCommand::createProcessesGroups(string newFName, string newNName, s
                 for (int i = 0; i < outputNames.size(); i++) { outTemp << outputNames[i] << endl; }
                 outTemp.close();
                 
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else {
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -488,6 +503,7 @@ int PreClusterCommand::createProcessesGroups(string newFName, string newNName, s
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     outputNames.clear();
                     num = driverGroups(newFName + m->mothurGetpid(process) + ".temp", newNName + m->mothurGetpid(process) + ".temp", newMFile, lines[process].start, lines[process].end, groups);
                     
@@ -499,6 +515,8 @@ int PreClusterCommand::createProcessesGroups(string newFName, string newNName, s
                     for (int i = 0; i < outputNames.size(); i++) { outTemp << outputNames[i] << endl; }
                     outTemp.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else {
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
@@ -517,6 +535,7 @@ int PreClusterCommand::createProcessesGroups(string newFName, string newNName, s
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
         
         for (int i = 0; i < processIDS.size(); i++) {
             string tempFile = toString(processIDS[i]) +  ".outputNames.temp";
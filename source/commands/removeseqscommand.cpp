@@ -12,6 +12,7 @@
 #include "listvector.hpp"
 #include "counttable.h"
 #include "fastqread.h"
+#include "seqindexfile.h"
 
 //**********************************************************************************************************************
 vector<string> RemoveSeqsCommand::setParameters(){	
@@ -27,6 +28,7 @@ vector<string> RemoveSeqsCommand::setParameters(){
 		CommandParameter pqfile("qfile", "InputTypes", "", "", "none", "FNGLT", "none","qfile",false,false); parameters.push_back(pqfile);
 		CommandParameter paccnos("accnos", "InputTypes", "", "", "none", "none", "none","",false,true,true); parameters.push_back(paccnos);
 		CommandParameter pdups("dups", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pdups);
+        CommandParameter pindex("index", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pindex);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pformat("format", "Multiple", "sanger-illumina-solexa-illumina1.8+", "illumina1.8+", "", "", "","",false,false,true); parameters.push_back(pformat);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -47,9 +49,10 @@ string RemoveSeqsCommand::getHelpString(){
 		string helpString = "";
 		helpString += "The remove.seqs command reads an .accnos file and at least one of the following file types: fasta, name, group, count, list, taxonomy, quality, fastq or alignreport file.\n";
 		helpString += "It outputs a file containing the sequences NOT in the .accnos file.\n";
-		helpString += "The remove.seqs command parameters are accnos, fasta, name, group, count, list, taxonomy, qfile, alignreport, fastq and dups.  You must provide accnos and at least one of the file parameters.\n";
+		helpString += "The remove.seqs command parameters are accnos, fasta, name, group, count, list, taxonomy, qfile, alignreport, fastq, dups and index.  You must provide accnos and at least one of the file parameters.\n";
         helpString += "The format parameter is used to indicate whether your sequences are sanger, solexa, illumina1.8+ or illumina, default=illumina1.8+.\n";
 		helpString += "The dups parameter allows you to remove the entire line from a name file if you remove any name from the line. default=true. \n";
+		helpString += "The index parameter allows you to save an index of your fasta, quality or fastq file as filename.idx in the output directory. Later runs with index=t on the same unchanged file use it to read only the sequences they need. default=false.\n";
 		helpString += "The remove.seqs command should be in the following format: remove.seqs(accnos=yourAccnos, fasta=yourFasta).\n";
 		helpString += "Example remove.seqs(accnos=amazon.accnos, fasta=amazon.fasta).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. fasta), '=' and parameters (i.e.yourFasta).\n";
@@ -287,6 +290,9 @@ RemoveSeqsCommand::RemoveSeqsCommand(string option)  {
 			}
 			dups = m->isTrue(temp);
             
+            temp = validParameter.validFile(parameters, "index", false);		if (temp == "not found") { temp = "f"; }
+            index = m->isTrue(temp);
+            
             countfile = validParameter.validFile(parameters, "count", true);
             if (countfile == "not open") { countfile = ""; abort = true; }
             else if (countfile == "not found") { countfile = "";  }	
@@ -427,11 +433,20 @@ int RemoveSeqsCommand::readFasta(){
 		bool wroteSomething = false;
 		int removedCount = 0;
 		
+        //with a current index only the sequences kept are read, the ones not read were removed.
+        //The index is by the names in the file, so not when they are being changed
+        string indexFile = "";
+        if (index) { indexFile = thisOutputDir + m->getSimpleName(fastafile) + ".idx"; }
+        SeqIndexFile seqIndex(fastafile, indexFile);
+        if (uniqueMap.size() == 0) { seqIndex.select(names, false); }
+        unsigned long long numRead = 0;
+        
         set<string> uniqueNames;
-		while(!in.eof()){
+		while(seqIndex.nextRecord(in)){
 			if (m->control_pressed) { in.close();  out.close();  m->mothurRemove(outputFileName);  return 0; }
 			
-			Sequence currSeq(in);
+			Sequence currSeq(in); numRead++;
+            seqIndex.add(currSeq.getName());
             
             if (!dups) {//adjust name if needed
                 map<string, string>::iterator it = uniqueMap.find(currSeq.getName());
@@ -457,6 +472,8 @@ int RemoveSeqsCommand::readFasta(){
 		}
 		in.close();	
 		out.close();
+		if (seqIndex.usingIndex()) { removedCount += (seqIndex.getNumRecords() - numRead); }
+		if (seqIndex.save()) { outputNames.push_back(indexFile); }
 		
 		if (wroteSomething == false) {  m->mothurOut("Your file contains only sequences from the .accnos file."); m->mothurOutEndLine();  }
 		outputTypes["fasta"].push_back(outputFileName);  outputNames.push_back(outputFileName);
@@ -489,17 +506,25 @@ int RemoveSeqsCommand::readFastq(){
 		ofstream out;
 		m->openOutputFile(outputFileName, out);
         
+        //with a current index only the reads kept are read, the ones not read were removed
+        string indexFile = "";
+        if (index) { indexFile = thisOutputDir + m->getSimpleName(fastqfile) + ".idx"; }
+        SeqIndexFile seqIndex(fastqfile, indexFile);
+        seqIndex.select(names, false);
+        unsigned long long numRead = 0;
+        
 		set<string> uniqueNames;
-		while(!in.eof()){
+		while(seqIndex.nextRecord(in)){
 			
 			if (m->control_pressed) { in.close(); out.close(); m->mothurRemove(outputFileName); return 0; }
 			
             //read sequence name
             bool ignore;
-            FastqRead fread(in, ignore, format); m->gobble(in);
+            FastqRead fread(in, ignore, format); m->gobble(in); numRead++;
             
             if (!ignore) {
                 string name = fread.getName();
+                seqIndex.add(name);
                 
                 if (names.count(name) == 0) {
                     if (uniqueNames.count(name) == 0) { //this name hasn't been seen yet
@@ -517,7 +542,8 @@ int RemoveSeqsCommand::readFastq(){
 		}
 		in.close();
 		out.close();
-		
+		if (seqIndex.usingIndex()) { removedCount += (seqIndex.getNumRecords() - numRead); }
+		if (seqIndex.save()) { outputNames.push_back(indexFile); }
 		
 		if (wroteSomething == false) {  m->mothurOut("Your file contains only sequences from the .accnos file."); m->mothurOutEndLine();  }
 		outputTypes["fasta"].push_back(outputFileName);  outputNames.push_back(outputFileName);
@@ -553,13 +579,21 @@ int RemoveSeqsCommand::readQual(){
 		bool wroteSomething = false;
 		int removedCount = 0;
 		
+        //with a current index only the scores kept are read, the ones not read were removed
+        string indexFile = "";
+        if (index) { indexFile = thisOutputDir + m->getSimpleName(qualfile) + ".idx"; }
+        SeqIndexFile seqIndex(qualfile, indexFile);
+        if (uniqueMap.size() == 0) { seqIndex.select(names, false); }
+        unsigned long long numRead = 0;
+        
 		set<string> uniqueNames;
-		while(!in.eof()){	
+		while(seqIndex.nextRecord(in)){	
 			string saveName = "";
 			string name = "";
 			string scores = "";
 			
-			in >> name; 
+			in >> name; numRead++;
+			if (name.length() != 0) { seqIndex.add(name.substr(1)); }
 			
 			if (name.length() != 0) { 
 				saveName = name.substr(1);
@@ -599,7 +633,8 @@ int RemoveSeqsCommand::readQual(){
 		}
 		in.close();
 		out.close();
-		
+		if (seqIndex.usingIndex()) { removedCount += (seqIndex.getNumRecords() - numRead); }
+		if (seqIndex.save()) { outputNames.push_back(indexFile); }
 		
 		if (wroteSomething == false) { m->mothurOut("Your file contains only sequences from the .accnos file."); m->mothurOutEndLine();  }
 		outputNames.push_back(outputFileName);  outputTypes["qfile"].push_back(outputFileName); 
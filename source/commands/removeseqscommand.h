@@ -36,7 +36,7 @@ class RemoveSeqsCommand : public Command {
 	private:
 		set<string> names;
 		string accnosfile, fastafile, fastqfile, namefile, groupfile, countfile, alignfile, listfile, taxfile, qualfile, outputDir, format;
-		bool abort, dups;
+		bool abort, dups, index;
 		vector<string> outputNames;
         map<string, string> uniqueMap;
 		
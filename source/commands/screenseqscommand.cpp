@@ -67,6 +67,7 @@ string ScreenSeqsCommand::getHelpString(){
         helpString += "The contigsreport parameter allows you to use the contigsreport file to determine if a sequence is good. Screening parameters include: minoverlap, ostart, oend and mismatches. \n";
         helpString += "The alignreport parameter allows you to use the alignreport file to determine if a sequence is good. Screening parameters include: minsim, minscore and maxinsert. \n";
         helpString += "The summary parameter allows you to use the summary file from summary.seqs to save time processing.\n";
+        helpString += "If summary.seqs was run on your fasta file with sumstats=t and the same output directory, the sequence stats it saved are used to optimize.\n";
 		helpString += "The taxonomy parameter allows you to remove bad seqs from taxonomy files.\n";
 		helpString += "The start parameter is used to set a position the \"good\" sequences must start by. The default is -1.\n";
 		helpString += "The end parameter is used to set a position the \"good\" sequences must end after. The default is -1.\n";
@@ -445,10 +446,16 @@ int ScreenSeqsCommand::execute(){
         int start = time(NULL);
         int numFastaSeqs = 0;
         
+        Profiler* profiler = Profiler::getInstance();
+        profiler->startPhase("screen");
+        
         if ((contigsreport == "") && (summaryfile == "") && (alignreport == "")) {   numFastaSeqs = screenFasta(badSeqNames);  }
         else {   numFastaSeqs = screenReports(badSeqNames);   }
+        profiler->addRecords(numFastaSeqs);
 		
         if (m->control_pressed) {  for (int i = 0; i < outputNames.size(); i++) { m->mothurRemove(outputNames[i]); } return 0; }
+        
+        profiler->startPhase("screen other files");
                 
 		if(namefile != "" && groupfile != "")	{	
 			screenNameGroupFile(badSeqNames);	
@@ -464,6 +471,7 @@ int ScreenSeqsCommand::execute(){
 
 		if(qualfile != "")						{	screenQual(badSeqNames);			}
 		if(taxonomy != "")						{	screenTaxonomy(badSeqNames);		}
+		profiler->endPhase();
 		
 		if (m->control_pressed) {  for (int i = 0; i < outputNames.size(); i++) { m->mothurRemove(outputNames[i]);  } return 0; }
 
@@ -1248,6 +1256,7 @@ int ScreenSeqsCommand::createProcessesContigsSummary(vector<int>& oLength, vecto
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				num = driverContigsSummary(oLength, ostartPosition, oendPosition, omismatches, numNs, contigsLines[process]);
 				
 				//pass numSeqs to parent
@@ -1265,6 +1274,8 @@ int ScreenSeqsCommand::createProcessesContigsSummary(vector<int>& oLength, vecto
 				
 				out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -1315,6 +1326,7 @@ int ScreenSeqsCommand::createProcessesContigsSummary(vector<int>& oLength, vecto
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     num = driverContigsSummary(oLength, ostartPosition, oendPosition, omismatches, numNs, contigsLines[process]);
                     
                     //pass numSeqs to parent
@@ -1332,6 +1344,8 @@ int ScreenSeqsCommand::createProcessesContigsSummary(vector<int>& oLength, vecto
                     
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else { 
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
@@ -1348,6 +1362,7 @@ int ScreenSeqsCommand::createProcessesContigsSummary(vector<int>& oLength, vecto
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		//parent reads in and combine Filter info
 		for (int i = 0; i < processIDS.size(); i++) {
@@ -1560,6 +1575,7 @@ int ScreenSeqsCommand::createProcessesAlignSummary(vector<float>& sims, vector<f
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				num = driverAlignSummary(sims, scores, inserts, alignLines[process]);
 				
 				//pass numSeqs to parent
@@ -1575,6 +1591,8 @@ int ScreenSeqsCommand::createProcessesAlignSummary(vector<float>& sims, vector<f
 				
 				out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -1623,6 +1641,7 @@ int ScreenSeqsCommand::createProcessesAlignSummary(vector<float>& sims, vector<f
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     num = driverAlignSummary(sims, scores, inserts, alignLines[process]);
                     
                     //pass numSeqs to parent
@@ -1638,6 +1657,8 @@ int ScreenSeqsCommand::createProcessesAlignSummary(vector<float>& sims, vector<f
                     
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else { 
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
@@ -1654,6 +1675,7 @@ int ScreenSeqsCommand::createProcessesAlignSummary(vector<float>& sims, vector<f
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		//parent reads in and combine Filter info
 		for (int i = 0; i < processIDS.size(); i++) {
@@ -1757,8 +1779,14 @@ int ScreenSeqsCommand::getSummary(vector<unsigned long long>& positions){
 		
 
 		int numSeqs = 0;
+        
+        //if summary.seqs has already saved the stats of this fasta file, use them instead of reading the sequences again
+        SummaryStatsFile statsFile(fastafile, outputDir);
 		
-        if(processors == 1){
+        if (statsFile.isCurrent()) {
+            m->mothurOut("Using the sequence stats summary.seqs saved in " + statsFile.getFileName() + " to optimize.\n");
+            numSeqs = readSummaryStats(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, numNs);
+        }else if(processors == 1){
             numSeqs = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, numNs, fastafile, lines[0]);
         }else{
             numSeqs = createProcessesCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, numNs, fastafile);
@@ -1861,6 +1889,53 @@ int ScreenSeqsCommand::driverCreateSummary(vector<int>& startPosition, vector<in
 		exit(1);
 	}
 }
+/**************************************************************************************/
+int ScreenSeqsCommand::readSummaryStats(vector<int>& startPosition, vector<int>& endPosition, vector<int>& seqLength, vector<int>& ambigBases, vector<int>& longHomoPolymer, vector<int>& numNs) {
+	try {
+		
+        SummaryStatsFile statsFile(fastafile, outputDir);
+        
+        ifstream in;
+        if (!statsFile.openForReading(in)) { m->mothurOut("[ERROR]: unable to read " + statsFile.getFileName() + ".\n"); m->control_pressed = true; return 0; }
+        
+		int count = 0;
+        seqSummaryStats current;
+        
+		while (statsFile.readRecord(in, current)) {
+				
+			if (m->control_pressed) { in.close(); return 1; }
+            
+            int num = 1;
+            if ((namefile != "") || (countfile !="")){
+                //make sure this sequence is in the namefile, else error
+                map<string, int>::iterator it = nameMap.find(current.name);
+                
+                if (it == nameMap.end()) { m->mothurOut("[ERROR]: " + current.name + " is not in your namefile, please correct."); m->mothurOutEndLine(); m->control_pressed = true; }
+                else { num = it->second; }
+            }
+            
+            //for each sequence this sequence represents
+            for (int i = 0; i < num; i++) {
+                startPosition.push_back(current.start);
+                endPosition.push_back(current.end);
+                seqLength.push_back(current.length);
+                ambigBases.push_back(current.ambigs);
+                longHomoPolymer.push_back(current.homop);
+                numNs.push_back(current.numNs);
+            }
+            
+            count++;
+		}
+		
+		in.close();
+		
+		return count;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ScreenSeqsCommand", "readSummaryStats");
+		exit(1);
+	}
+}
 /**************************************************************************************************/
 int ScreenSeqsCommand::createProcessesCreateSummary(vector<int>& startPosition, vector<int>& endPosition, vector<int>& seqLength, vector<int>& ambigBases, vector<int>& longHomoPolymer, vector<int>& numNs, string filename) {
 	try {
@@ -1880,6 +1955,7 @@ int ScreenSeqsCommand::createProcessesCreateSummary(vector<int>& startPosition,
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, numNs, fastafile, lines[process]);
 				
 				//pass numSeqs to parent
@@ -1898,6 +1974,8 @@ int ScreenSeqsCommand::createProcessesCreateSummary(vector<int>& startPosition,
 				
 				out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -1944,6 +2022,7 @@ int ScreenSeqsCommand::createProcessesCreateSummary(vector<int>& startPosition,
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, numNs, fastafile, lines[process]);
                     
                     //pass numSeqs to parent
@@ -1962,6 +2041,8 @@ int ScreenSeqsCommand::createProcessesCreateSummary(vector<int>& startPosition,
                     
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else { 
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
@@ -1979,6 +2060,7 @@ int ScreenSeqsCommand::createProcessesCreateSummary(vector<int>& startPosition,
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		//parent reads in and combine Filter info
 		for (int i = 0; i < processIDS.size(); i++) {
@@ -2401,6 +2483,7 @@ int ScreenSeqsCommand::createProcesses(string goodFileName, string badAccnos, st
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
+				Profiler::getInstance()->startChild();
 				num = driver(lines[process], goodFileName + m->mothurGetpid(process) + ".temp", badAccnos + m->mothurGetpid(process) + ".temp", filename, badSeqNames);
 				
 				//pass numSeqs to parent
@@ -2410,6 +2493,8 @@ int ScreenSeqsCommand::createProcesses(string goodFileName, string badAccnos, st
 				out << num << endl;
 				out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -2449,6 +2534,7 @@ int ScreenSeqsCommand::createProcesses(string goodFileName, string badAccnos, st
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
+                    Profiler::getInstance()->startChild();
                     num = driver(lines[process], goodFileName + m->mothurGetpid(process) + ".temp", badAccnos + m->mothurGetpid(process) + ".temp", filename, badSeqNames);
                     
                     //pass numSeqs to parent
@@ -2458,6 +2544,8 @@ int ScreenSeqsCommand::createProcesses(string goodFileName, string badAccnos, st
                     out << num << endl;
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else { 
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
@@ -2474,6 +2562,7 @@ int ScreenSeqsCommand::createProcesses(string goodFileName, string badAccnos, st
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		for (int i = 0; i < processIDS.size(); i++) {
 			ifstream in;
@@ -12,6 +12,7 @@
 #include "mothur.h"
 #include "command.hpp"
 #include "sequence.hpp"
+#include "summarystatsfile.h"
 
 class ScreenSeqsCommand : public Command {
 	
@@ -55,6 +56,7 @@ private:
 	int getSummary(vector<unsigned long long>&);
 	int createProcessesCreateSummary(vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, string);
 	int driverCreateSummary(vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, string, linePair);	
+	int readSummaryStats(vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&);
 	int getSummaryReport();
     int driverContigsSummary(vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, linePair);
     int createProcessesContigsSummary(vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<linePair>);
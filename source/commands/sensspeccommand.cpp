@@ -298,12 +298,28 @@ int SensSpecCommand::execute(){
 
 //***************************************************************************************************************
 
-int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool& getCutoff, string& origCutoff){
+int SensSpecCommand::getNameIndex(string name){
+	try {
+		map<string, int>::iterator it = nameIndex.find(name);
+		if (it != nameIndex.end()) { return it->second; }
+
+		int index = nameIndex.size();
+		nameIndex[name] = index;
+		return index;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SensSpecCommand", "getNameIndex");
+		exit(1);
+	}
+}
+
+//***************************************************************************************************************
+
+int SensSpecCommand::indexLabel(ListVector*& list, bool& getCutoff, string& origCutoff){
 
 	try {
 
 		string label = list->getLabel();
-		int numSeqs = list->getNumSeqs();
 		int numOTUs = list->getNumBins();
 
 		if(getCutoff == 1){
@@ -318,16 +334,123 @@ int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool&
 			}
 		}
 
-		truePositives = 0;
-		falsePositives = 0;
-		trueNegatives = 0;
-		falseNegatives = 0;
+		m->mothurOut(label); m->mothurOutEndLine();
+
+		vector<int> otus(nameIndex.size(), -1);
+		long int sameOTU = 0;
+
+		for(int otu=0;otu<numOTUs;otu++){
+			if (m->control_pressed) { return 0; }
+
+			string seqList = list->get(otu);
+			vector<string> otuVector;
+			m->splitAtComma(seqList, otuVector);
+
+			for(int i=0;i<otuVector.size();i++){
+				int index = getNameIndex(otuVector[i]);
+				if (index >= otus.size()) { otus.resize(index+1, -1); }
+				otus[index] = otu;
+			}
+
+			long int nSeqsInOTU = otuVector.size();
+			sameOTU += nSeqsInOTU * (nSeqsInOTU-1) / 2;
+		}
+
+		labelNames.push_back(label);
+		labelCutoffs.push_back(origCutoff);
+		cutoffs.push_back(cutoff);
+		numSeqsPerLabel.push_back(list->getNumSeqs());
+		pairsInSameOTU.push_back(sameOTU);
+		otuIndices.push_back(otus);
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SensSpecCommand", "indexLabel");
+		exit(1);
+	}
+}
+
+//***************************************************************************************************************
+//a pair within a label's cutoff is a true positive if both sequences are in the same otu, otherwise a false negative
+void SensSpecCommand::countPair(int seqA, int seqB, double distance, vector<long int>& closePairs, vector<long int>& closeInSameOTU){
+	try {
+		for (int i = 0; i < cutoffs.size(); i++) {
+			if (distance <= cutoffs[i]) {
+				closePairs[i]++;
+
+				if (seqA == seqB) { continue; }
+
+				vector<int>& otus = otuIndices[i];
+				if ((seqA >= otus.size()) || (seqB >= otus.size())) { continue; }
+				if ((otus[seqA] != -1) && (otus[seqA] == otus[seqB])) { closeInSameOTU[i]++; }
+			}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SensSpecCommand", "countPair");
+		exit(1);
+	}
+}
+
+//***************************************************************************************************************
+//returns false if the matrix turns out to be square, in which case it needs to be read again counting one half.
+//We keep track of one cell and see if its transpose shows up later, like ReadColumnMatrix does.
+bool SensSpecCommand::scanColumn(bool isSquare, vector<long int>& closePairs, vector<long int>& closeInSameOTU){
+	try {
+		double maxCutoff = *max_element(cutoffs.begin(), cutoffs.end());
+
+		ifstream columnFile;
+		m->openInputFile(distFile, columnFile);
+
+		string seqNameA, seqNameB;
+		float distance;
+		int refRow = -1; int refCol = -1;
+
+		while(columnFile){
+			if (m->control_pressed) { break; }
+
+			columnFile >> seqNameA >> seqNameB >> distance;
+			m->gobble(columnFile);
 
-		map<string, double> distanceMap;
+			if(distance <= maxCutoff){
+				int seqA = getNameIndex(seqNameA);
+				int seqB = getNameIndex(seqNameB);
+
+				if (isSquare) {
+					if (seqA < seqB) { continue; }
+				}else if (seqA != seqB) {
+					if (refRow == -1) { refRow = seqA; refCol = seqB; }
+					else if ((refRow == seqB) && (refCol == seqA)) { columnFile.close(); return false; }
+				}
+
+				countPair(seqA, seqB, distance, closePairs, closeInSameOTU);
+			}
+		}
+		columnFile.close();
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SensSpecCommand", "scanColumn");
+		exit(1);
+	}
+}
+
+//***************************************************************************************************************
+
+int SensSpecCommand::processDistances(){
+	try {
+		int numLabels = labelNames.size();
+		if (numLabels == 0) { return 0; }
+
+		vector<long int> closePairs(numLabels, 0);
+		vector<long int> closeInSameOTU(numLabels, 0);
 
 		//could segfault out if there are sequences in phylip-formatted distance
 		//matrix that aren't in the list file
 		if(format == "phylip"){
+			double maxCutoff = *max_element(cutoffs.begin(), cutoffs.end());
 
 			ifstream phylipFile;
 			m->openInputFile(distFile, phylipFile);
@@ -335,32 +458,20 @@ int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool&
 			phylipFile >> pNumSeqs;
 
 			double distance;
-
-			vector<string> seqNameVector(pNumSeqs);
-			m->mothurOut(label); m->mothurOutEndLine();
+			string seqName;
+			vector<int> rowIndices(pNumSeqs);
 
 			for(int i=0;i<pNumSeqs;i++){
 
-				if (m->control_pressed) { return 0; }
-
-				phylipFile >> seqNameVector[i];
+				if (m->control_pressed) { phylipFile.close(); return 0; }
 
-				//otuIndices[i] = seqMap[seqName];
+				phylipFile >> seqName;
+				rowIndices[i] = getNameIndex(seqName);
 
 				for(int j=0;j<i;j++){
 					phylipFile >> distance;
 
-					if(distance <= cutoff){
-
-						string seqNamePair;
-						if(seqNameVector[i] < seqNameVector[j]){
-							seqNamePair = seqNameVector[i] + '-' + seqNameVector[j];
-						} else {
-							seqNamePair = seqNameVector[j] + '-' + seqNameVector[i];
-						}
-
-						distanceMap[seqNamePair] = distance;
-					}
+					if(distance <= maxCutoff){ countPair(rowIndices[i], rowIndices[j], distance, closePairs, closeInSameOTU); }
 				}
 
 	            m->getline(phylipFile); //get rest of line if square
@@ -369,85 +480,29 @@ int SensSpecCommand::process(map<string, int>& seqMap, ListVector*& list, bool&
 			phylipFile.close();
 		}
 		else if(format == "column"){
-
-			ifstream columnFile;
-			m->openInputFile(distFile, columnFile);
-
-			string seqNameA, seqNameB;
-			float distance;
-
-			while(columnFile){
-				columnFile >> seqNameA >> seqNameB >> distance;
-				m->gobble(columnFile);
-
-				if(distance <= cutoff){
-					string seqNamePair;
-
-					if(seqNameA < seqNameB){
-						seqNamePair = seqNameA + '-' + seqNameB;
-					} else {
-						seqNamePair = seqNameB + '-' + seqNameA;
-					}
-					distanceMap[seqNamePair] = distance;
-				}
+			if (!scanColumn(false, closePairs, closeInSameOTU)) {
+				closePairs.assign(numLabels, 0); closeInSameOTU.assign(numLabels, 0);
+				scanColumn(true, closePairs, closeInSameOTU);
 			}
-			columnFile.close();
 		}
 
-		for(int otu=0;otu<numOTUs;otu++){
-			if (m->control_pressed) { return 0; }
-
-			// get the sequence string from the list vector
-			string seqList = list->get(otu);
-
-			//count number of sequences in the bin
-			int nSeqsInOTU = 1;
-			for(int i=0;i<seqList.length();i++){
-				if(seqList[i] == ','){	nSeqsInOTU++;	}
-			}
+		if (m->control_pressed) { return 0; }
 
-			string seqName = "";
-			istringstream seqListStream(seqList);
+		for (int i = 0; i < numLabels; i++) {
+			long int numSeqs = numSeqsPerLabel[i];
 
-			int index = 0;
-			vector<string> otuVector(nSeqsInOTU);
-			while(getline(seqListStream, seqName, ',')) {
-				otuVector[index++] = seqName;
-			}
+			truePositives = closeInSameOTU[i];
+			falsePositives = pairsInSameOTU[i] - truePositives;
+			falseNegatives = closePairs[i] - truePositives;
+			trueNegatives = numSeqs * (numSeqs-1)/2 - (falsePositives + falseNegatives + truePositives);
 
-			// indicate that a pair of sequences are in the same OTU; will
-			// assume that if they don't show up in the map that they're in
-			// different OTUs
-			for(int i=0;i<otuVector.size();i++){
-				for(int j=0;j<i;j++){
-
-					string seqNamePair = "";
-					if(otuVector[i] < otuVector[j]){
-						seqNamePair = otuVector[i] + '-' + otuVector[j];
-					} else{
-						seqNamePair = otuVector[j] + '-' + otuVector[i];
-					}
-
-					map<string, double>::iterator it = distanceMap.find(seqNamePair);
-
-					if(it != distanceMap.end()){
-						truePositives++;
-						distanceMap.erase(it);
-					} else {
-						falsePositives++;
-					}
-				}
-			}
+			outputStatistics(labelNames[i], labelCutoffs[i]);
 		}
-		falseNegatives = distanceMap.size();
-		trueNegatives = numSeqs * (numSeqs-1)/2 - (falsePositives + falseNegatives + truePositives);
-
-		outputStatistics(label, origCutoff);
 
 		return 0;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "SensSpecCommand", "process");
+		m->errorOut(e, "SensSpecCommand", "processDistances");
 		exit(1);
 	}
 }
@@ -463,8 +518,6 @@ int SensSpecCommand::processListFile(){
 		else if( !hard )	{	origCutoff = toString(cutoff);	cutoff += (0.49 / double(precision));	}
 		else 				{	origCutoff = toString(cutoff);	}
 
-		map<string, int> seqMap;
-
 		InputData input(listFile, "list");
 		ListVector* list = input.getListVector();
 		string lastLabel = list->getLabel();
@@ -481,9 +534,7 @@ int SensSpecCommand::processListFile(){
 				processedLabels.insert(list->getLabel());
 				userLabels.erase(list->getLabel());
 
-				//process
-				// int numSeqs = fillSeqMap(seqMap, list);
-				process(seqMap, list, getCutoff, origCutoff);
+				indexLabel(list, getCutoff, origCutoff);
 			}
 
 			if ((m->anyLabelsToProcess(list->getLabel(), userLabels, "") == true) && (processedLabels.count(lastLabel) != 1)) {
@@ -496,9 +547,7 @@ int SensSpecCommand::processListFile(){
 				processedLabels.insert(list->getLabel());
 				userLabels.erase(list->getLabel());
 
-				//process
-				//int numSeqs = fillSeqMap(seqMap, list);
-				process(seqMap, list, getCutoff, origCutoff);
+				indexLabel(list, getCutoff, origCutoff);
 
 				//restore real lastlabel to save below
 				list->setLabel(saveLabel);
@@ -527,13 +576,14 @@ int SensSpecCommand::processListFile(){
 			if (list != NULL) {	delete list;	}
 			list = input.getListVector(lastLabel);
 
-			//process
-			//int numSeqs = fillSeqMap(seqMap, list);
-			process(seqMap, list, getCutoff, origCutoff);
+			indexLabel(list, getCutoff, origCutoff);
 
 			delete list;
 		}
 
+		//one pass through the distances for all the labels
+		processDistances();
+
 		return 0;
 	}
 	catch(exception& e) {
@@ -53,7 +53,18 @@ private:
 	double cutoff;
 	int precision;
 
-	int process(map<string, int>&, ListVector*&, bool&, string&);
+	//every label is indexed before the distance file is read, so one pass fills in the counts for all of them
+	map<string, int> nameIndex;
+	vector<string> labelNames, labelCutoffs;
+	vector<double> cutoffs;
+	vector<long int> numSeqsPerLabel, pairsInSameOTU;
+	vector< vector<int> > otuIndices; //otuIndices[label][nameIndex] -> otu, -1 if the name is not in the list
+
+	int getNameIndex(string);
+	int indexLabel(ListVector*&, bool&, string&);
+	int processDistances();
+	void countPair(int, int, double, vector<long int>&, vector<long int>&);
+	bool scanColumn(bool, vector<long int>&, vector<long int>&);
 };
 
 #endif
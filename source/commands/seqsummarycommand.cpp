@@ -17,6 +17,7 @@ vector<string> SeqSummaryCommand::setParameters(){
 		CommandParameter pname("name", "InputTypes", "", "", "namecount", "none", "none","",false,false,true); parameters.push_back(pname);
         CommandParameter pcount("count", "InputTypes", "", "", "namecount", "none", "none","",false,false,true); parameters.push_back(pcount);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
+        CommandParameter psumstats("sumstats", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(psumstats);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -35,9 +36,10 @@ string SeqSummaryCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The summary.seqs command reads a fastafile and summarizes the sequences.\n";
-		helpString += "The summary.seqs command parameters are fasta, name, count and processors, fasta is required, unless you have a valid current fasta file.\n";
+		helpString += "The summary.seqs command parameters are fasta, name, count, processors and sumstats, fasta is required, unless you have a valid current fasta file.\n";
 		helpString += "The name parameter allows you to enter a name file associated with your fasta file. \n";
         helpString += "The count parameter allows you to enter a count file associated with your fasta file. \n";
+        helpString += "The sumstats parameter allows you to save the stats of each sequence as fastafile.sumstats in the output directory, so screen.seqs can use them to optimize without reading the fasta file again. default=false.\n";
 		helpString += "The summary.seqs command should be in the following format: \n";
 		helpString += "summary.seqs(fasta=yourFastaFile, processors=2) \n";
 		helpString += "Note: No spaces between parameter labels (i.e. fasta), '=' and parameters (i.e.yourFastaFile).\n";	
@@ -166,6 +168,9 @@ SeqSummaryCommand::SeqSummaryCommand(string option)  {
 			m->setProcessors(temp);
 			m->mothurConvert(temp, processors);
 			
+            temp = validParameter.validFile(parameters, "sumstats", false);		if (temp == "not found") { temp = "f"; }
+            sumstats = m->isTrue(temp);
+			
             if (countfile == "") {
                 if (namefile == "") {
                     vector<string> files; files.push_back(fastafile);
@@ -232,13 +237,33 @@ int SeqSummaryCommand::execute(){
 			#endif
 			
 
+			//with sumstats the per sequence stats are saved so screen.seqs can optimize without reading the fasta again
+			SummaryStatsFile statsFile(fastafile, outputDir);
+			statsFileName = ""; string statsRecordFile = "";
+			if (sumstats) { statsFileName = statsFile.getFileName(); statsRecordFile = statsFileName + m->mothurGetpid(0) + ".temp"; }
+			#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+			#else
+				if (processors != 1) { statsFileName = ""; statsRecordFile = ""; } //threads don't save stats
+			#endif
+			
+			Profiler* profiler = Profiler::getInstance();
+			profiler->startPhase("summarize");
+			
 			if(processors == 1){
-				numSeqs = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, summaryFile, lines[0]);
+				numSeqs = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, summaryFile, statsRecordFile, lines[0]);
 			}else{
-				numSeqs = createProcessesCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, summaryFile); 
+				numSeqs = createProcessesCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, summaryFile, statsRecordFile); 
 			}
 			
-			if (m->control_pressed) {  return 0; }
+			if (m->control_pressed) {  if (statsRecordFile != "") { m->mothurRemove(statsRecordFile); for (int i = 0; i < processIDS.size(); i++) { m->mothurRemove(statsFileName + toString(processIDS[i]) + ".temp"); } } return 0; }
+			
+			if (statsRecordFile != "") {
+				vector<string> statsRecordFiles; statsRecordFiles.push_back(statsRecordFile);
+				for (int i = 0; i < processIDS.size(); i++) { statsRecordFiles.push_back(statsFileName + toString(processIDS[i]) + ".temp"); }
+				if (statsFile.combine(statsRecordFiles) == 0) { outputNames.push_back(statsFileName); }
+			}
+			profiler->addRecords(numSeqs);
+			profiler->endPhase();
 			
 		
         
@@ -387,7 +412,8 @@ int SeqSummaryCommand::execute(){
 		
 		m->mothurOutEndLine();
 		m->mothurOut("Output File Names: "); m->mothurOutEndLine();
-		m->mothurOut(summaryFile); m->mothurOutEndLine();	outputNames.push_back(summaryFile); outputTypes["summary"].push_back(summaryFile);
+		outputNames.push_back(summaryFile); outputTypes["summary"].push_back(summaryFile);
+		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i]); m->mothurOutEndLine();	}
 		m->mothurOutEndLine();
 
         if ((namefile == "") && (countfile == "")) {  m->mothurOut("It took " + toString(time(NULL) - start) + " secs to summarize " + toString(numSeqs) + " sequences.\n");  }
@@ -408,12 +434,18 @@ int SeqSummaryCommand::execute(){
 	}
 }
 /**************************************************************************************/
- long long SeqSummaryCommand::driverCreateSummary(map<int, long long>& startPosition, map<int,  long long>& endPosition, map<int,  long long>& seqLength, map<int,  long long>& ambigBases, map<int,  long long>& longHomoPolymer, string filename, string sumFile, linePair* filePos) {
+ long long SeqSummaryCommand::driverCreateSummary(map<int, long long>& startPosition, map<int,  long long>& endPosition, map<int,  long long>& seqLength, map<int,  long long>& ambigBases, map<int,  long long>& longHomoPolymer, string filename, string sumFile, string statsRecordFile, linePair* filePos) {
 	try {
 		
 		ofstream outSummary;
 		m->openOutputFile(sumFile, outSummary);
         
+        //statsRecordFile is blank when the stats are not being saved
+        SummaryStatsFile statsFile(filename, outputDir);
+        ofstream outStats;
+        bool saveStats = false;
+        if (statsRecordFile != "") { saveStats = statsFile.openRecordFile(statsRecordFile, outStats); }
+        
         ifstream in;
         m->openInputFile(filename, in);
         
@@ -431,7 +463,7 @@ int SeqSummaryCommand::execute(){
         
 		while (!done) {
 				
-			if (m->control_pressed) { in.close(); outSummary.close(); return 1; }
+			if (m->control_pressed) { in.close(); outSummary.close(); if (saveStats) { outStats.close(); } return 1; }
             
             if (m->debug) { m->mothurOut("[DEBUG]: count = " + toString(count) + "\n");  }
             
@@ -481,6 +513,8 @@ int SeqSummaryCommand::execute(){
 				outSummary << thisSeqLength << '\t' << thisAmbig << '\t';
 				outSummary << thisHomoP << '\t' << num << endl;
                 
+                if (saveStats) { statsFile.writeRecord(outStats, current.getName(), thisStartPosition, thisEndPosition, thisSeqLength, thisAmbig, thisHomoP, current.getNumNs()); }
+                
                 if (m->debug) { m->mothurOut("[DEBUG]: " + current.getName() + '\t' + toString(num) + "\n");  }
 			}
 			
@@ -493,6 +527,7 @@ int SeqSummaryCommand::execute(){
 		}
 				
 		in.close();
+		if (saveStats) { outStats.close(); }
 		
 		return count;
 	}
@@ -502,7 +537,7 @@ int SeqSummaryCommand::execute(){
 	}
 }
 /**************************************************************************************************/
- long long SeqSummaryCommand::createProcessesCreateSummary(map<int, long long>& startPosition, map<int, long long>& endPosition, map<int,  long long>& seqLength, map<int,  long long>& ambigBases, map<int,  long long>& longHomoPolymer, string filename, string sumFile) {
+ long long SeqSummaryCommand::createProcessesCreateSummary(map<int, long long>& startPosition, map<int, long long>& endPosition, map<int,  long long>& seqLength, map<int,  long long>& ambigBases, map<int,  long long>& longHomoPolymer, string filename, string sumFile, string statsRecordFile) {
 	try {
 		int process = 1;
 		int num = 0;
@@ -519,7 +554,8 @@ int SeqSummaryCommand::execute(){
 				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
 				process++;
 			}else if (pid == 0){
-				num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, sumFile + m->mothurGetpid(process) + ".temp", lines[process]);
+				Profiler::getInstance()->startChild();
+				num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, sumFile + m->mothurGetpid(process) + ".temp", ((statsFileName == "") ? "" : (statsFileName + m->mothurGetpid(process) + ".temp")), lines[process]);
 				
 				//pass numSeqs to parent
 				ofstream out;
@@ -539,6 +575,8 @@ int SeqSummaryCommand::execute(){
 				for (map<int,  long long>::iterator it = longHomoPolymer.begin(); it != longHomoPolymer.end(); it++)		{		out << it->first << '\t' << it->second << endl; }
 				out.close();
 				
+				Profiler::getInstance()->addRecords(num);
+				Profiler::getInstance()->endChild();
 				exit(0);
 			}else { 
                 m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
@@ -552,6 +590,7 @@ int SeqSummaryCommand::execute(){
                 for (int i=0;i<processIDS.size();i++) {
                     m->mothurRemove(fastafile + (toString(processIDS[i]) + ".num.temp"));
                     m->mothurRemove(sumFile + (toString(processIDS[i]) + ".temp"));
+                    if (statsFileName != "") { m->mothurRemove(statsFileName + (toString(processIDS[i]) + ".temp")); }
                 }
                 recalc = true;
                 break;
@@ -585,7 +624,8 @@ int SeqSummaryCommand::execute(){
                     processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
                     process++;
                 }else if (pid == 0){
-                    num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, sumFile + m->mothurGetpid(process) + ".temp", lines[process]);
+                    Profiler::getInstance()->startChild();
+                    num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, sumFile + m->mothurGetpid(process) + ".temp", ((statsFileName == "") ? "" : (statsFileName + m->mothurGetpid(process) + ".temp")), lines[process]);
                     
                     //pass numSeqs to parent
                     ofstream out;
@@ -605,6 +645,8 @@ int SeqSummaryCommand::execute(){
                     for (map<int,  long long>::iterator it = longHomoPolymer.begin(); it != longHomoPolymer.end(); it++)		{		out << it->first << '\t' << it->second << endl; }
                     out.close();
                     
+                    Profiler::getInstance()->addRecords(num);
+                    Profiler::getInstance()->endChild();
                     exit(0);
                 }else { 
                     m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
@@ -616,13 +658,14 @@ int SeqSummaryCommand::execute(){
 
         
 		//do your part
-		num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, sumFile, lines[0]);
+		num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, sumFile, statsRecordFile, lines[0]);
 
 		//force parent to wait until all the processes are done
 		for (int i=0;i<processIDS.size();i++) { 
 			int temp = processIDS[i];
 			wait(&temp);
 		}
+		Profiler::getInstance()->addChildren(processIDS);
 		
 		//parent reads in and combine Filter info
 		for (int i = 0; i < processIDS.size(); i++) {
@@ -714,7 +757,7 @@ int SeqSummaryCommand::execute(){
 		}
 		
         //do your part
-		num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, (sumFile+toString(processors-1)+".temp"), lines[processors-1]);
+		num = driverCreateSummary(startPosition, endPosition, seqLength, ambigBases, longHomoPolymer, fastafile, (sumFile+toString(processors-1)+".temp"), "", lines[processors-1]); //threads don't save stats
         processIDS.push_back(processors-1);
 
 		//Wait until all threads have terminated.
@@ -13,6 +13,7 @@
 #include "mothur.h"
 #include "command.hpp"
 #include "sequence.hpp"
+#include "summarystatsfile.h"
 
 /**************************************************************************************************/
 
@@ -34,8 +35,8 @@ public:
 	int execute(); 
 	void help() { m->mothurOut(getHelpString()); }		
 private:
-	bool abort;
-	string fastafile, outputDir, namefile, countfile;
+	bool abort, sumstats;
+	string fastafile, outputDir, namefile, countfile, statsFileName;
 	int processors;
 	vector<string> outputNames;
 	map<string, int> nameMap;
@@ -43,8 +44,8 @@ private:
 	vector<linePair*> lines;
 	vector<int> processIDS;
 	
-	long long createProcessesCreateSummary(map<int, long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, string, string);
-	long long driverCreateSummary(map<int, long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, string, string, linePair*);
+	long long createProcessesCreateSummary(map<int, long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, string, string, string);
+	long long driverCreateSummary(map<int, long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, map<int,  long long>&, string, string, string, linePair*);
 
 
 };
@@ -14,7 +14,8 @@
 vector<string> SetLogFileCommand::setParameters(){	
 	try {
 		CommandParameter pappend("append", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pappend);
-		CommandParameter pname("name", "String", "", "", "", "", "","",false,true,true); parameters.push_back(pname);
+		CommandParameter pname("name", "String", "", "", "", "", "","",false,false,true); parameters.push_back(pname);
+        CommandParameter pprofile("profile", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pprofile);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -33,9 +34,11 @@ string SetLogFileCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The set.logfile command can be used to provide a specific name for your logfile and/or to append the log generated by mothur to an existing file.\n";
-		helpString += "The set.logfile command parameters are name and append, name is required. Append is set to false by default.\n";
+		helpString += "The set.logfile command parameters are name, append and profile. Append is set to false by default.\n";
+		helpString += "The profile parameter allows you to record the wall time, cpu time, peak memory, bytes read and written and records processed by each command you run. The profile is written to a tab delimited file with the same root name as your logfile and the extension .profile. The peak memory columns are the peaks since mothur started, not of the command. Default=F.\n";
 		helpString += "The set.logfile command should be in the following format: set.logfile(name=yourLogFileName, append=T).\n";
 		helpString += "Example set.logfile(name=/Users/lab/desktop/output.txt, append=T).\n";
+		helpString += "Example set.logfile(name=/Users/lab/desktop/output.txt, profile=T).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. name), '=' and parameters (i.e.yourLogFileName).\n";
 		return helpString;
 	}
@@ -66,10 +69,17 @@ SetLogFileCommand::SetLogFileCommand(string option)  {
 				if (validParameter.isValidParameter(it->first, myArray, it->second) != true) {  abort = true;  }
 			}
 		
+			string temp = validParameter.validFile(parameters, "profile", false);
+			if (temp == "not found") {  profile = false; setProfile = false; }
+			else { profile = m->isTrue(temp); setProfile = true; }
+			
 			name = validParameter.validFile(parameters, "name", false);			
-			if (name == "not found") {  m->mothurOut("name is a required parameter for the set.logfile command."); abort = true; } 
+			if (name == "not found") {
+                name = "";
+                if (!setProfile) { m->mothurOut("name is a required parameter for the set.logfile command."); abort = true; }
+            }
 			
-			string temp = validParameter.validFile(parameters, "append", false);		if (temp == "not found") {  temp = "F";  }
+			temp = validParameter.validFile(parameters, "append", false);		if (temp == "not found") {  temp = "F";  }
 			append = m->isTrue(temp);
 		}
 	}
@@ -88,11 +98,26 @@ int SetLogFileCommand::execute(){
 		
         commandFactory = CommandFactory::getInstance();
         
-        string directory = m->hasPath(name);
-        if (directory == "") {
-            commandFactory->setLogfileName(name, append);
-        }else if (m->dirCheck(directory)) {
-            commandFactory->setLogfileName(name, append);
+        if (name != "") {
+            string directory = m->hasPath(name);
+            if (directory == "") {
+                commandFactory->setLogfileName(name, append);
+            }else if (m->dirCheck(directory)) {
+                commandFactory->setLogfileName(name, append);
+            }
+        }
+        
+        if (setProfile) {
+            Profiler* profiler = Profiler::getInstance();
+            if (profile) {
+                //profile lives next to the logfile, which is moved to the output directory when mothur quits
+                string logName = commandFactory->getLogfileName();
+                if (logName == "") { logName = m->getSimpleName(m->getFileName()); }
+                string profileName = commandFactory->getOutputDir() + m->getRootName(logName) + "profile";
+                
+                profiler->setProfileFile(profileName);
+                m->mothurOut("Writing command profile to " + profileName + ".\n");
+            }else { profiler->setProfileFile(""); }
         }
 		
 		return 0;
@@ -37,7 +37,7 @@ public:
 private:
 	CommandFactory* commandFactory;
 	string name;
-	bool abort, append;
+	bool abort, append, profile, setProfile;
 	vector<string> outputNames;
 		
 };
@@ -31,6 +31,7 @@ vector<string> SffInfoCommand::setParameters(){
         CommandParameter pldiffs("ldiffs", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pldiffs);
 		CommandParameter psdiffs("sdiffs", "Number", "", "0", "", "", "","",false,false); parameters.push_back(psdiffs);
         CommandParameter ptdiffs("tdiffs", "Number", "", "0", "", "", "","",false,false); parameters.push_back(ptdiffs);
+        CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -49,7 +50,7 @@ string SffInfoCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The sffinfo command reads a sff file and extracts the sequence data, or you can use it to parse a sfftxt file.\n";
-		helpString += "The sffinfo command parameters are sff, fasta, qfile, accnos, flow, sfftxt, oligos, group, bdiffs, tdiffs, ldiffs, sdiffs, pdiffs, checkorient and trim. sff is required. \n";
+		helpString += "The sffinfo command parameters are sff, fasta, qfile, accnos, flow, sfftxt, oligos, group, bdiffs, tdiffs, ldiffs, sdiffs, pdiffs, checkorient, processors and trim. sff is required. \n";
 		helpString += "The sff parameter allows you to enter the sff file you would like to extract data from.  You may enter multiple files by separating them by -'s.\n";
 		helpString += "The fasta parameter allows you to indicate if you would like a fasta formatted file generated.  Default=True. \n";
 		helpString += "The qfile parameter allows you to indicate if you would like a quality file generated.  Default=True. \n";
@@ -66,6 +67,7 @@ string SffInfoCommand::getHelpString(){
 		helpString += "If you want to parse an existing sfftxt file into flow, fasta and quality file, enter the file name using the sfftxt parameter. \n";
 		helpString += "The trim parameter allows you to indicate if you would like a sequences and quality scores trimmed to the clipQualLeft and clipQualRight values.  Default=True. \n";
 		helpString += "The accnos parameter allows you to provide a accnos file containing the names of the sequences you would like extracted. You may enter multiple files by separating them by -'s. \n";
+        helpString += "The processors parameter allows you to specify the number of processors to use when extracting the fasta, qfile, flow and sfftxt files. The oligos and group options use 1 processor. The default is 1.\n";
 		helpString += "Example sffinfo(sff=mySffFile.sff, trim=F).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. sff), '=' and parameters (i.e.yourSffFileName).\n";
 		return helpString;
@@ -498,6 +500,10 @@ SffInfoCommand::SffInfoCommand(string option)  {
             temp = validParameter.validFile(parameters, "checkorient", false);		if (temp == "not found") { temp = "F"; }
 			reorient = m->isTrue(temp);
             
+            temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
+            
 		}
 	}
 	catch(exception& e) {
@@ -621,52 +627,25 @@ int SffInfoCommand::extractSffInfo(string input, string accnos, string oligos){
 		if (sfftxt) {	printCommonHeader(outSfftxt, header);		}
 		if (flow)	{	outFlow << header.numFlowsPerRead << endl;	}
         
-        //ofstream outtemp;
-        //m->openOutputFileBinary("./temp", outtemp);
-        //printCommonHeaderForDebug(header, outtemp, 20000);
-        //outtemp.close();
-		//read through the sff file
-		while (!in.eof()) {
-			
-			bool print = true;
-			
-			//read data
-			seqRead read;  Header readheader;
-            readSeqData(in, read, header.numFlowsPerRead, readheader, trimOligos, rtrimOligos);
-            
-            bool okay = sanityCheck(readheader, read);
-            if (!okay) { break; }
-            //cout << readheader.name << endl;
-			//if you have provided an accosfile and this seq is not in it, then dont print
-			if (seqNames.size() != 0) {   if (seqNames.count(readheader.name) == 0) { print = false; }  }
-			
-			//print 
-			if (print) {
-				if (sfftxt) { printHeader(outSfftxt, readheader); printSffTxtSeqData(outSfftxt, read, readheader); }
-				if (fasta)	{	printFastaSeqData(outFasta, read, readheader);	}
-				if (qual)	{	printQualSeqData(outQual, read, readheader);	}
-				if (flow)	{	printFlowSeqData(outFlow, read, readheader);	}
-			}
-			count++;
-            
-			//report progress
-			if((count+1) % 10000 == 0){	m->mothurOut(toString(count+1)); m->mothurOutEndLine();		}
-		
-			if (m->control_pressed) { count = 0; break;   }
-			
-			if (count >= header.numReads) { break; }
-		}
-		
-		//report progress
-		if (!m->control_pressed) {   if((count) % 10000 != 0){	m->mothurOut(toString(count)); m->mothurOutEndLine();		}  }
-		
-		in.close();
-		
 		if (sfftxt) {  outSfftxt.close();	}
 		if (fasta)	{  outFasta.close();	}
 		if (qual)	{  outQual.close();		}
 		if (flow)	{  outFlow.close();		}
         
+        //the reads start after the padded common header
+        unsigned long long readsStart = in.tellg();
+		in.close();
+        
+        //the split sff files are shared by every read, so splitting stays in one process
+        if ((split > 1) || (processors == 1) || (header.numReads < processors)) {
+            count = driver(input, header, readsStart, header.numReads, sfftxtFileName, outFastaFileName, outQualFileName, outFlowFileName, trimOligos, rtrimOligos);
+        }else {
+            count = createProcesses(input, header, readsStart, sfftxtFileName, outFastaFileName, outQualFileName, outFlowFileName, trimOligos, rtrimOligos);
+        }
+		
+		//report progress
+		if (!m->control_pressed) {   if((count) % 10000 != 0){	m->mothurOut(toString(count)); m->mothurOutEndLine();		}  }
+        
         if (split > 1) {
             //create new common headers for each file with the correct number of reads
             adjustCommonHeader(header);
@@ -730,6 +709,241 @@ int SffInfoCommand::extractSffInfo(string input, string accnos, string oligos){
 	}
 }
 //**********************************************************************************************************************
+//extracts numReads reads starting at start, appending to the output files. All the outputs are written in the one pass.
+int SffInfoCommand::driver(string input, CommonHeader& header, unsigned long long start, int numReads, string sfftxtFileName, string fastaFileName, string qualFileName, string flowFileName, TrimOligos*& trimOligos, TrimOligos*& rtrimOligos){
+	try {
+		ofstream outSfftxt, outFasta, outQual, outFlow;
+		if (sfftxt) { m->openOutputFileAppend(sfftxtFileName, outSfftxt); outSfftxt.setf(ios::fixed, ios::floatfield); outSfftxt.setf(ios::showpoint);  }
+		if (fasta)	{ m->openOutputFileAppend(fastaFileName, outFasta);	}
+		if (qual)	{ m->openOutputFileAppend(qualFileName, outQual);		}
+		if (flow)	{ m->openOutputFileAppend(flowFileName, outFlow);	outFlow.setf(ios::fixed, ios::floatfield); outFlow.setf(ios::showpoint); }
+        
+		ifstream in;
+		m->openInputFileBinary(input, in);
+        in.seekg(start);
+        
+		int count = 0;
+		while (!in.eof() && (count < numReads)) {
+			
+			bool print = true;
+			
+			//read data
+			seqRead read;  Header readheader;
+            bool incomplete = readSeqData(in, read, header.numFlowsPerRead, readheader, trimOligos, rtrimOligos);
+            if (incomplete) { break; }
+            
+            bool okay = sanityCheck(readheader, read);
+            if (!okay) { break; }
+            
+			//if you have provided an accosfile and this seq is not in it, then dont print
+			if (seqNames.size() != 0) {   if (seqNames.count(readheader.name) == 0) { print = false; }  }
+			
+			//print 
+			if (print) {
+				if (sfftxt) { printHeader(outSfftxt, readheader); printSffTxtSeqData(outSfftxt, read, readheader); }
+				if (fasta)	{	printFastaSeqData(outFasta, read, readheader);	}
+				if (qual)	{	printQualSeqData(outQual, read, readheader);	}
+				if (flow)	{	printFlowSeqData(outFlow, read, readheader);	}
+			}
+			count++;
+            
+			//report progress
+			if((count+1) % 10000 == 0){	m->mothurOut(toString(count+1)); m->mothurOutEndLine();		}
+		
+			if (m->control_pressed) { count = 0; break;   }
+		}
+		
+		in.close();
+		
+		if (sfftxt) {  outSfftxt.close();	}
+		if (fasta)	{  outFasta.close();	}
+		if (qual)	{  outQual.close();		}
+		if (flow)	{  outFlow.close();		}
+        
+		return count;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SffInfoCommand", "driver");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+//finds where each process's reads start by stepping over the reads. Only the fixed part of each read header is read,
+//the lengths in it give the size of the rest of the read.
+int SffInfoCommand::findReadRanges(string input, CommonHeader& header, unsigned long long start, vector<unsigned long long>& positions, vector<int>& numReads){
+	try {
+        positions.clear(); numReads.clear();
+        
+        int numReadsPerProcessor = header.numReads / processors;
+        for (int i = 0; i < processors; i++) {
+            if(i == (processors - 1)){	numReadsPerProcessor = header.numReads - i * numReadsPerProcessor; 	}
+            numReads.push_back(numReadsPerProcessor);
+        }
+        
+		ifstream in;
+		m->openInputFileBinary(input, in);
+        
+        unsigned long long spot = start;
+        int process = 0; int nextStart = 0;
+        for (int i = 0; i < header.numReads; i++) {
+            if (i == nextStart) { positions.push_back(spot); nextStart += numReads[process]; process++; }
+            if (process == processors) { break; }
+            
+            in.seekg(spot);
+            char buffer[16];
+            in.read(buffer, 16);
+            if (in.gcount() != 16) { break; }
+            
+            unsigned short nameLength = be_int2(*(unsigned short *)(&buffer[2]));
+            unsigned int numBases =  be_int4(*(unsigned int *)(&buffer[4]));
+            
+            //header and data are each padded to 8 bytes
+            spot += ((16 + nameLength + 7) & ~7);
+            spot += ((header.numFlowsPerRead*2 + numBases*3 + 7) & ~7);
+        }
+		in.close();
+        
+        //a short file leaves the last processes nothing to do
+        while (positions.size() < processors) { positions.push_back(spot); }
+        
+        return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SffInfoCommand", "findReadRanges");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+int SffInfoCommand::createProcesses(string input, CommonHeader& header, unsigned long long start, string sfftxtFileName, string fastaFileName, string qualFileName, string flowFileName, TrimOligos*& trimOligos, TrimOligos*& rtrimOligos){
+	try {
+        int num = 0;
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        vector<unsigned long long> positions;
+        vector<int> numReads;
+        findReadRanges(input, header, start, positions, numReads);
+        
+        vector<int> processIDS;
+        int process = 1;
+        bool recalc = false;
+        
+		//loop through and create all the processes you want
+		while (process != processors) {
+			pid_t pid = fork();
+			
+			if (pid > 0) {
+				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
+				process++;
+			}else if (pid == 0){
+                string pidString = m->mothurGetpid(process) + ".temp";
+				num = driver(input, header, positions[process], numReads[process], sfftxtFileName + pidString, fastaFileName + pidString, qualFileName + pidString, flowFileName + pidString, trimOligos, rtrimOligos);
+				
+				//pass numReads to parent
+				ofstream out;
+				string tempFile = m->mothurGetpid(process) + ".num.temp";
+				m->openOutputFile(tempFile, out);
+				out << num << endl;
+				out.close();
+				
+				exit(0);
+			}else { 
+                m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
+                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+                //wait to die
+                for (int i=0;i<processIDS.size();i++) {
+                    int temp = processIDS[i];
+                    wait(&temp);
+                }
+                m->control_pressed = false;
+                for (int i=0;i<processIDS.size();i++) {
+                    string pidString = toString(processIDS[i]) + ".temp";
+                    m->mothurRemove(sfftxtFileName + pidString); m->mothurRemove(fastaFileName + pidString);
+                    m->mothurRemove(qualFileName + pidString); m->mothurRemove(flowFileName + pidString);
+                    m->mothurRemove(toString(processIDS[i]) + ".num.temp");
+                }
+                recalc = true;
+                break;
+			}
+		}
+        
+        if (recalc) {
+            processIDS.resize(0);
+            process = 1;
+            findReadRanges(input, header, start, positions, numReads);
+            
+            //loop through and create all the processes you want
+            while (process != processors) {
+                pid_t pid = fork();
+                
+                if (pid > 0) {
+                    processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
+                    process++;
+                }else if (pid == 0){
+                    string pidString = m->mothurGetpid(process) + ".temp";
+                    num = driver(input, header, positions[process], numReads[process], sfftxtFileName + pidString, fastaFileName + pidString, qualFileName + pidString, flowFileName + pidString, trimOligos, rtrimOligos);
+                    
+                    //pass numReads to parent
+                    ofstream out;
+                    string tempFile = m->mothurGetpid(process) + ".num.temp";
+                    m->openOutputFile(tempFile, out);
+                    out << num << endl;
+                    out.close();
+                    
+                    exit(0);
+                }else { 
+                    m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine(); 
+                    for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+                    exit(0);
+                }
+            }
+        }
+		
+		//do my part, straight into the output files
+		num = driver(input, header, positions[0], numReads[0], sfftxtFileName, fastaFileName, qualFileName, flowFileName, trimOligos, rtrimOligos);
+		
+		//force parent to wait until all the processes are done
+		for (int i=0;i<processIDS.size();i++) { 
+			int temp = processIDS[i];
+			wait(&temp);
+		}
+		
+        //append the children's reads in file order. A process that stopped at a bad read ends the file there,
+        //like reading it in one process would
+        bool stopped = (num < numReads[0]);
+		for (int i = 0; i < processIDS.size(); i++) {
+			ifstream in;
+			string tempFile =  toString(processIDS[i]) + ".num.temp";
+			m->openInputFile(tempFile, in);
+            int tempNum = 0;
+			if (!in.eof()) { in >> tempNum; }
+			in.close(); m->mothurRemove(tempFile);
+            
+            string pidString = toString(processIDS[i]) + ".temp";
+            if (!stopped) {
+                if (sfftxt) { m->appendFiles(sfftxtFileName + pidString, sfftxtFileName);  }
+                if (fasta)  { m->appendFiles(fastaFileName + pidString, fastaFileName);     }
+                if (qual)   { m->appendFiles(qualFileName + pidString, qualFileName);       }
+                if (flow)   { m->appendFiles(flowFileName + pidString, flowFileName);       }
+                num += tempNum;
+                if (tempNum < numReads[i+1]) { stopped = true; }
+            }
+            m->mothurRemove(sfftxtFileName + pidString); m->mothurRemove(fastaFileName + pidString);
+            m->mothurRemove(qualFileName + pidString); m->mothurRemove(flowFileName + pidString);
+		}
+#else
+        num = driver(input, header, start, header.numReads, sfftxtFileName, fastaFileName, qualFileName, flowFileName, trimOligos, rtrimOligos);
+#endif
+        
+        if (m->control_pressed) { num = 0; }
+        
+		return num;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SffInfoCommand", "createProcesses");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
 int SffInfoCommand::readCommonHeader(ifstream& in, CommonHeader& header){
 	try {
         
@@ -1224,108 +1438,69 @@ int SffInfoCommand::printCommonHeaderForDebug(CommonHeader& header, ofstream& ou
     }
 }
 //**********************************************************************************************************************
+//returns true if the read was cut short by the end of the file
 bool SffInfoCommand::readSeqData(ifstream& in, seqRead& read, int numFlowReads, Header& header, TrimOligos*& trimOligos, TrimOligos*& rtrimOligos){
 	try {
-        unsigned long long startSpotInFile = in.tellg();
 		if (!in.eof()) {
             
+            //the fixed part of the read header gives the size of the rest of the read,
+            //so the read comes in with two reads and is decoded from the buffer
+            if (recordBuffer.size() < 16) { recordBuffer.resize(16); }
+            in.read(&recordBuffer[0], 16);
+            if (in.gcount() != 16) { m->mothurOut("Error reading."); m->mothurOutEndLine(); return true; }
+            
             /*****************************************/
             //read header
             
-            //read header length
-			char buffer [2];
-			in.read(buffer, 2); 
-			header.headerLength = be_int2(*(unsigned short *)(&buffer));
-            
-			//read name length
-			char buffer2 [2];
-			in.read(buffer2, 2);
-			header.nameLength = be_int2(*(unsigned short *)(&buffer2));
-            
-			//read num bases
-			char buffer3 [4];
-			in.read(buffer3, 4);
-			header.numBases =  be_int4(*(unsigned int *)(&buffer3));
-            
-			
-			//read clip qual left
-			char buffer4 [2];
-			in.read(buffer4, 2);
-			header.clipQualLeft =  be_int2(*(unsigned short *)(&buffer4));
-			//header.clipQualLeft = 5;
-			
-			//read clip qual right
-			char buffer5 [2];
-			in.read(buffer5, 2);
-			header.clipQualRight =  be_int2(*(unsigned short *)(&buffer5));
-            
-			//read clipAdapterLeft
-			char buffer6 [2];
-			in.read(buffer6, 2);
-			header.clipAdapterLeft = be_int2(*(unsigned short *)(&buffer6));
+			header.headerLength = be_int2(*(unsigned short *)(&recordBuffer[0]));
+			header.nameLength = be_int2(*(unsigned short *)(&recordBuffer[2]));
+			header.numBases =  be_int4(*(unsigned int *)(&recordBuffer[4]));
+			header.clipQualLeft =  be_int2(*(unsigned short *)(&recordBuffer[8]));
+			header.clipQualRight =  be_int2(*(unsigned short *)(&recordBuffer[10]));
+			header.clipAdapterLeft = be_int2(*(unsigned short *)(&recordBuffer[12]));
+			header.clipAdapterRight = be_int2(*(unsigned short *)(&recordBuffer[14]));
             
+            /* header and data are each padded to 8 chars */
+            unsigned long long dataStart = (16 + header.nameLength + 7) & ~7;
+            unsigned long long dataLength = numFlowReads*2 + header.numBases*3;
+            unsigned long long readLength = dataStart + ((dataLength + 7) & ~7);
             
-			//read clipAdapterRight
-			char buffer7 [2];
-			in.read(buffer7, 2);
-			header.clipAdapterRight = be_int2(*(unsigned short *)(&buffer7));
+            if (recordBuffer.size() < readLength) { recordBuffer.resize(readLength); }
+            in.read(&recordBuffer[16], readLength-16);
+            unsigned long long amountRead = 16 + in.gcount();
             
+            //the last read may be missing its padding
+            if (amountRead < (dataStart + dataLength)) { m->mothurOut("Error reading."); m->mothurOutEndLine(); return true; }
             
 			//read name
-			char* tempBuffer = new char[header.nameLength];
-			in.read(&(*tempBuffer), header.nameLength);
-			header.name = tempBuffer;
-			if (header.name.length() > header.nameLength) { header.name = header.name.substr(0, header.nameLength);  }
-            
-			delete[] tempBuffer;
+			header.name.assign(&recordBuffer[16], header.nameLength);
+            if (header.name.find('\0') != string::npos) { header.name = header.name.substr(0, header.name.find('\0'));  }
 			
 			//extract info from name
 			decodeName(header.timestamp, header.region, header.xy, header.name);
 			
-			/* Pad to 8 chars */
-			unsigned long long spotInFile = in.tellg();
-			unsigned long long spot = (spotInFile + 7)& ~7;
-			in.seekg(spot);
-
             /*****************************************/
             //sequence read 
             
 			//read flowgram
+            const char* flowgram = &recordBuffer[dataStart];
 			read.flowgram.resize(numFlowReads);
-			for (int i = 0; i < numFlowReads; i++) {  
-				char buffer [2];
-				in.read(buffer, 2);
-				read.flowgram[i] = be_int2(*(unsigned short *)(&buffer));
-			}
+			for (int i = 0; i < numFlowReads; i++) {  read.flowgram[i] = be_int2(*(unsigned short *)(&flowgram[2*i])); }
             
 			//read flowIndex
+            const unsigned char* flowIndex = (const unsigned char*)(flowgram + numFlowReads*2);
 			read.flowIndex.resize(header.numBases);
-			for (int i = 0; i < header.numBases; i++) {  
-				char temp[1];
-				in.read(temp, 1);
-				read.flowIndex[i] = be_int1(*(unsigned char *)(&temp));
-			}
+			for (int i = 0; i < header.numBases; i++) {  read.flowIndex[i] = be_int1(flowIndex[i]); }
 	
 			//read bases
-			char* tempBuffer6 = new char[header.numBases];
-			in.read(&(*tempBuffer6), header.numBases);
-			read.bases = tempBuffer6;
-			if (read.bases.length() > header.numBases) { read.bases = read.bases.substr(0, header.numBases);  }
-			delete[] tempBuffer6;
+            const char* bases = (const char*)(flowIndex + header.numBases);
+			read.bases.assign(bases, header.numBases);
+            if (read.bases.find('\0') != string::npos) { read.bases = read.bases.substr(0, read.bases.find('\0'));  }
 
 			//read qual scores
+            const unsigned char* qualScores = (const unsigned char*)(bases + header.numBases);
 			read.qualScores.resize(header.numBases);
-			for (int i = 0; i < header.numBases; i++) {  
-				char temp[1];
-				in.read(temp, 1);
-				read.qualScores[i] = be_int1(*(unsigned char *)(&temp));
-			}
-	
-			/* Pad to 8 chars */
-			spotInFile = in.tellg();
-			spot = (spotInFile + 7)& ~7;
-			in.seekg(spot);
-            
+			for (int i = 0; i < header.numBases; i++) {  read.qualScores[i] = be_int1(qualScores[i]); }
             
             if (split > 1) { 
                
@@ -1335,38 +1510,27 @@ bool SffInfoCommand::readSeqData(ifstream& in, seqRead& read, int numFlowReads,
                 else if (hasGroup)  {  trashCodeLength = findGroup(header, read, barcodeIndex, primerIndex, "groupMode");   }
                 else {  m->mothurOut("[ERROR]: uh oh, we shouldn't be here...\n"); }
 
-                char * mybuffer;
-                mybuffer = new char [spot-startSpotInFile];
-                
-                ifstream in2;
-                m->openInputFileBinary(currentFileName, in2);
-                in2.seekg(startSpotInFile);
-                in2.read(mybuffer,spot-startSpotInFile);
-                
+                //the buffer holds the read as it is in the file
                 if(trashCodeLength == 0){
                     ofstream out;
                     m->openOutputFileBinaryAppend(filehandles[barcodeIndex][primerIndex], out);
-                    out.write(mybuffer, in2.gcount());
+                    out.write(&recordBuffer[0], amountRead);
                     out.close();
                     numSplitReads[barcodeIndex][primerIndex]++;
 				}
 				else{
 					ofstream out;
                     m->openOutputFileBinaryAppend(noMatchFile, out);
-                    out.write(mybuffer, in2.gcount());
+                    out.write(&recordBuffer[0], amountRead);
                     out.close();
                     numNoMatch++;
 				}
-				delete[] mybuffer;
-                in2.close();
         }    
             
 		}else{
 			m->mothurOut("Error reading."); m->mothurOutEndLine();
 		}
         
-        if (in.eof()) {  return true; }
-        
 		return false;
 	}
 	catch(exception& e) {
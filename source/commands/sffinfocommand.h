@@ -40,8 +40,9 @@ private:
 	string sffFilename, sfftxtFilename, outputDir, accnosName, currentFileName, oligosfile, noMatchFile, groupfile;
 	vector<string> filenames, outputNames, accnosFileNames, oligosFileNames, groupFileNames;
 	bool abort, fasta, qual, trim, flow, sfftxt, hasAccnos, hasOligos, hasGroup, reorient, pairedOligos;
-	int mycount, split, numBarcodes, numFPrimers, numLinkers, numSpacers, numRPrimers, pdiffs, bdiffs, ldiffs, sdiffs, tdiffs, numNoMatch;
+	int mycount, split, numBarcodes, numFPrimers, numLinkers, numSpacers, numRPrimers, pdiffs, bdiffs, ldiffs, sdiffs, tdiffs, numNoMatch, processors;
 	set<string> seqNames;
+    vector<char> recordBuffer; //bytes of the read being decoded, reused from read to read
     GroupMap* groupMap;
     map<string, int> GroupToFile;
     vector<vector<int> > numSplitReads;
@@ -51,6 +52,9 @@ private:
     
 	//extract sff file functions
 	int extractSffInfo(string, string, string);
+    int driver(string, CommonHeader&, unsigned long long, int, string, string, string, string, TrimOligos*&, TrimOligos*&);
+    int createProcesses(string, CommonHeader&, unsigned long long, string, string, string, string, TrimOligos*&, TrimOligos*&);
+    int findReadRanges(string, CommonHeader&, unsigned long long, vector<unsigned long long>&, vector<int>&);
 	int readCommonHeader(ifstream&, CommonHeader&);
 	int readHeader(ifstream&, Header&);
 	bool readSeqData(ifstream&, seqRead&, int, Header&, TrimOligos*&, TrimOligos*&);
@@ -351,7 +351,9 @@ int SffMultipleCommand::execute(){
         
         if (m->control_pressed) { return 0; }
         
-        if (sffFiles.size() < processors) { processors = sffFiles.size(); }
+        //processors left over after giving each file one go to sffinfo
+        sffinfoProcessors = 1;
+        if ((sffFiles.size() != 0) && (sffFiles.size() < processors)) { sffinfoProcessors = processors / sffFiles.size(); processors = sffFiles.size(); }
         
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #else
@@ -459,7 +461,7 @@ int SffMultipleCommand::driver(vector<string> sffFiles, vector<string> oligosFil
             string redirects = "";
             if (inputDir != "")     { redirects += ", inputdir=" + inputDir;    }
             if (outputDir != "")    { redirects += ", outputdir=" + outputDir;  }
-            string inputString = "sff=" + sff + ", flow=T";
+            string inputString = "sff=" + sff + ", flow=T, processors=" + toString(sffinfoProcessors);
             if (trim) { inputString += ", trim=T"; }
             if (redirects != "") { inputString += redirects; }
             m->mothurOut("/******************************************/"); m->mothurOutEndLine(); 
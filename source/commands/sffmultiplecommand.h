@@ -41,7 +41,7 @@ private:
 	vector<string> outputNames;
 	bool abort, trim, large, flip, allFiles, keepforward, append, makeGroup;
 	int maxFlows, minFlows, minLength, maxLength, maxHomoP, tdiffs, bdiffs, pdiffs, sdiffs, ldiffs;
-	int processors, maxIters, largeSize;
+	int processors, sffinfoProcessors, maxIters, largeSize;
 	float signal, noise, cutoff, sigma;
     int keepFirst, removeLast, maxAmbig;
     
@@ -760,24 +760,22 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 if (m->control_pressed) { break; }
                 
                 m->mothurOut("Calculating distances between flowgrams...\n");
-                string distFileName = flowFileName.substr(0,flowFileName.find_last_of('.')) + ".shhh.dist";
                 begTime = time(NULL);
                
-                
-                flowDistParentFork(numFlowCells, distFileName, numUniques, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
+                //distances below the cutoff go straight into the sparse matrix used by the clustering
+                SparseDistanceMatrix* matrix = new SparseDistanceMatrix();
+                flowDistParentFork(numFlowCells, matrix, numUniques, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
                 
                 m->mothurOutEndLine();
                 m->mothurOut("Total time: " + toString(time(NULL) - begTime) + '\t' + toString((clock() - begClock)/CLOCKS_PER_SEC) + '\n');
                 
+                ListVector* list = createList(numSeqs, numUniques, seqNameVector, mapSeqToUnique);
                 
-                string namesFileName = flowFileName.substr(0,flowFileName.find_last_of('.')) + ".shhh.names";
-                createNamesFile(numSeqs, numUniques, namesFileName, seqNameVector, mapSeqToUnique, mapUniqueToSeq);
-                
-                if (m->control_pressed) { break; }
+                if (m->control_pressed) { delete matrix; delete list; break; }
                 
                 m->mothurOut("\nClustering flowgrams...\n");
                 string listFileName = flowFileName.substr(0,flowFileName.find_last_of('.')) + ".shhh.list";
-                cluster(listFileName, distFileName, namesFileName);
+                cluster(listFileName, matrix, list);
                 
                 if (m->control_pressed) { break; }
                 
@@ -794,8 +792,6 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 
                 if (m->control_pressed) { break; }
                 
-                m->mothurRemove(distFileName);
-                m->mothurRemove(namesFileName);
                 m->mothurRemove(listFileName);
                 
                 vector<double> dist;		//adDist - distance of sequences to centroids
@@ -1017,18 +1013,16 @@ int ShhherCommand::getFlowData(string filename, vector<string>& thisSeqNameVecto
 }
 /**************************************************************************************************/
 
-int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
+int ShhherCommand::flowDistParentFork(int numFlowCells, SparseDistanceMatrix* matrix, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
 	try{		
         
-		ostringstream outStream;
-		outStream.setf(ios::fixed, ios::floatfield);
-		outStream.setf(ios::dec, ios::basefield);
-		outStream.setf(ios::showpoint);
-		outStream.precision(6);
-		
 		int begTime = time(NULL);
 		double begClock = clock();
         
+        //uniques are the rows of the matrix, in the same order createList gives their bins
+        matrix->resize(stopSeq);
+        
+        char distBuffer[32];
 		for(int i=0;i<stopSeq;i++){
 			
 			if (m->control_pressed) { break; }
@@ -1036,12 +1030,20 @@ int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int
 			for(int j=0;j<i;j++){
 				float flowDistance = calcPairwiseDist(numFlowCells, mapUniqueToSeq[i], mapUniqueToSeq[j], mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
                 
+                //these distances used to be written to a text file with 6 decimal places and read back in,
+                //keep that precision so the clusters and the EM starting point do not change
 				if(flowDistance < 1e-6){
-					outStream << mapUniqueToSeq[i] << '\t' << mapUniqueToSeq[j] << '\t' << 0.000000 << endl;
+                    flowDistance = 0.0;
 				}
 				else if(flowDistance <= cutoff){
-					outStream << mapUniqueToSeq[i] << '\t' << mapUniqueToSeq[j] << '\t' << flowDistance << endl;
+                    sprintf(distBuffer, "%.6f", flowDistance);
+                    flowDistance = strtof(distBuffer, NULL);
 				}
+                
+                if (flowDistance < cutoff) {
+                    PDistCell value(i, flowDistance);
+                    matrix->addCell(j, value);
+                }
 			}
 			if(i % 100 == 0){
 				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - begTime));
@@ -1049,10 +1051,6 @@ int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int
 			}
 		}
 		
-		ofstream distFile(distFileName.c_str());
-		distFile << outStream.str();		
-		distFile.close();
-		
 		if (m->control_pressed) {}
 		else {
 			m->mothurOutJustToScreen(toString(stopSeq-1) + "\t" + toString(time(NULL) - begTime));
@@ -1073,21 +1071,17 @@ float ShhherCommand::calcPairwiseDist(int numFlowCells, int seqA, int seqB, vect
 		int minLength = lengths[mapSeqToUnique[seqA]];
 		if(lengths[seqB] < minLength){	minLength = lengths[mapSeqToUnique[seqB]];	}
 		
-		int ANumFlowCells = seqA * numFlowCells;
-		int BNumFlowCells = seqB * numFlowCells;
+		//walk both flowgrams with pointers, this is called numUniques^2/2 times so keep the inner loop free of checks
+		const short* flowAIntI = &flowDataIntI[seqA * numFlowCells];
+		const short* flowBIntI = &flowDataIntI[seqB * numFlowCells];
+		const double* flowAPrI = &flowDataPrI[seqA * numFlowCells];
+		const double* flowBPrI = &flowDataPrI[seqB * numFlowCells];
+		const double* joint = &jointLookUp[0];
 		
 		float dist = 0;
 		
 		for(int i=0;i<minLength;i++){
-			
-			if (m->control_pressed) { break; }
-			
-			int flowAIntI = flowDataIntI[ANumFlowCells + i];
-			float flowAPrI = flowDataPrI[ANumFlowCells + i];
-			
-			int flowBIntI = flowDataIntI[BNumFlowCells + i];
-			float flowBPrI = flowDataPrI[BNumFlowCells + i];
-			dist += jointLookUp[flowAIntI * NUMBINS + flowBIntI] - flowAPrI - flowBPrI;
+			dist += joint[flowAIntI[i] * NUMBINS + flowBIntI[i]] - (float)flowAPrI[i] - (float)flowBPrI[i];
 		}
 		
 		dist /= (float) minLength;
@@ -1176,7 +1170,7 @@ int ShhherCommand::getUniques(int numSeqs, int numFlowCells, vector<short>& uniq
 	}
 }
 /**************************************************************************************************/
-int ShhherCommand::createNamesFile(int numSeqs, int numUniques, string filename, vector<string>& seqNameVector, vector<int>& mapSeqToUnique, vector<int>& mapUniqueToSeq){
+ListVector* ShhherCommand::createList(int numSeqs, int numUniques, vector<string>& seqNameVector, vector<int>& mapSeqToUnique){
 	try{
 		
 		vector<string> duplicateNames(numUniques, "");
@@ -1184,44 +1178,29 @@ int ShhherCommand::createNamesFile(int numSeqs, int numUniques, string filename,
 			duplicateNames[mapSeqToUnique[i]] += seqNameVector[i] + ',';
 		}
 		
-		ofstream nameFile;
-		m->openOutputFile(filename, nameFile);
+		ListVector* list = new ListVector();
 		
 		for(int i=0;i<numUniques;i++){
 			
 			if (m->control_pressed) { break; }
 			
-            //			nameFile << seqNameVector[mapUniqueToSeq[i]] << '\t' << duplicateNames[i].substr(0, duplicateNames[i].find_last_of(',')) << endl;
-			nameFile << mapUniqueToSeq[i] << '\t' << duplicateNames[i].substr(0, duplicateNames[i].find_last_of(',')) << endl;
+			list->push_back(duplicateNames[i].substr(0, duplicateNames[i].find_last_of(',')));
 		}
 		
-		nameFile.close();
+		list->setLabel("0");
         
-		return 0;
+		return list;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "ShhherCommand", "createNamesFile");
+		m->errorOut(e, "ShhherCommand", "createList");
 		exit(1);
 	}
 }
 //**********************************************************************************************************************
 
-int ShhherCommand::cluster(string filename, string distFileName, string namesFileName){
+int ShhherCommand::cluster(string filename, SparseDistanceMatrix* matrix, ListVector* list){
 	try {
 		
-		ReadMatrix* read = new ReadColumnMatrix(distFileName); 	
-		read->setCutoff(cutoff);
-		
-		NameAssignment* clusterNameMap = new NameAssignment(namesFileName);
-		clusterNameMap->readMap();
-		read->read(clusterNameMap);
-        
-		ListVector* list = read->getListVector();
-		SparseDistanceMatrix* matrix = read->getDMatrix();
-		
-		delete read; 
-		delete clusterNameMap; 
-        
 		RAbundVector* rabund = new RAbundVector(list->getRAbundVector());
 		
         float adjust = -1.0;
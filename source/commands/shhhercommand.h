@@ -67,10 +67,10 @@ private:
     int createProcesses(vector<string>);
     int getFlowData(string, vector<string>&, vector<int>&, vector<short>&, map<string, int>&, int&);
     int getUniques(int, int, vector<short>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
-    int flowDistParentFork(int, string, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
+    int flowDistParentFork(int, SparseDistanceMatrix*, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
     float calcPairwiseDist(int, int, int, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
-    int createNamesFile(int, int, string, vector<string>&, vector<int>&, vector<int>&);
-    int cluster(string, string, string);
+    ListVector* createList(int, int, vector<string>&, vector<int>&);
+    int cluster(string, SparseDistanceMatrix*, ListVector*);
     int getOTUData(int numSeqs, string,  vector<int>&, vector<int>&, vector<int>&, vector<vector<int> >&, vector<vector<int> >&, vector<int>&, vector<int>&,map<string, int>&);
     int calcCentroidsDriver(int numOTUs, vector<int>&, vector<int>&, vector<int>&, vector<short>&, vector<int>&, vector<double>&, vector<int>&, vector<short>&, vector<short>&, vector<int>&, int, vector<int>&);
     double getDistToCentroid(int, int, int, vector<short>&, vector<short>&, int);
@@ -456,7 +456,7 @@ int TrimSeqsCommand::execute(){
 		setLines(fastaFile, qFileName);
 		
         if(processors == 1){
-            driverCreateTrim(fastaFile, qFileName, trimSeqFile, scrapSeqFile, trimQualFile, scrapQualFile, trimNameFile, scrapNameFile, trimCountFile, scrapCountFile, outputGroupFileName, fastaFileNames, qualFileNames, nameFileNames, lines[0], qLines[0]);
+            driverCreateTrim(fastaFile, qFileName, trimSeqFile, scrapSeqFile, trimQualFile, scrapQualFile, trimNameFile, scrapNameFile, trimCountFile, scrapCountFile, outputGroupFileName, fastaFileNames, qualFileNames, nameFileNames, lines[0], qLines[0], "");
         }else{
             createProcessesCreateTrim(fastaFile, qFileName, trimSeqFile, scrapSeqFile, trimQualFile, scrapQualFile, trimNameFile, scrapNameFile, trimCountFile, scrapCountFile, outputGroupFileName, fastaFileNames, qualFileNames, nameFileNames); 
         }	
@@ -616,7 +616,7 @@ int TrimSeqsCommand::execute(){
 }
 		
 /**************************************************************************************/
-int TrimSeqsCommand::driverCreateTrim(string filename, string qFileName, string trimFileName, string scrapFileName, string trimQFileName, string scrapQFileName, string trimNFileName, string scrapNFileName, string trimCFileName, string scrapCFileName, string groupFileName, vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, vector<vector<string> > nameFileNames, linePair line, linePair qline) {	
+int TrimSeqsCommand::driverCreateTrim(string filename, string qFileName, string trimFileName, string scrapFileName, string trimQFileName, string scrapQFileName, string trimNFileName, string scrapNFileName, string trimCFileName, string scrapCFileName, string groupFileName, vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, vector<vector<string> > nameFileNames, linePair line, linePair qline, string demuxFileName) {	
 		
 	try {
 		
@@ -650,7 +650,11 @@ int TrimSeqsCommand::driverCreateTrim(string filename, string qFileName, string
 		
 		ofstream outGroupsFile;
 		if ((createGroup) && (countfile == "")){	m->openOutputFile(groupFileName, outGroupsFile);   }
-		if(allFiles){
+        //a child process spools its group output for the parent, otherwise the group files are written here
+        DemuxWriter* groupFiles = NULL;
+		if(allFiles && (demuxFileName != "")) { groupFiles = new DemuxWriter(demuxFileName); }
+        else if(allFiles){
+            groupFiles = new DemuxWriter();
 			for (int i = 0; i < fastaFileNames.size(); i++) { //clears old file
 				for (int j = 0; j < fastaFileNames[i].size(); j++) { //clears old file
 					if (fastaFileNames[i][j] != "") {
@@ -724,6 +728,7 @@ int TrimSeqsCommand::driverCreateTrim(string filename, string qFileName, string
             
 			if (m->control_pressed) {
                 delete trimOligos; if (reorient) { delete rtrimOligos; }
+                if (allFiles) { delete groupFiles; }
 				inFASTA.close(); trimFASTAFile.close(); scrapFASTAFile.close();
 				if ((createGroup) && (countfile == "")) {	 outGroupsFile.close();   }
                 if(qFileName != "")	{	qFile.close();	scrapQualFile.close(); trimQualFile.close();	}
@@ -1008,23 +1013,20 @@ int TrimSeqsCommand::driverCreateTrim(string filename, string qFileName, string
                         }
                         
                         if(allFiles){
-                            ofstream output;
-                            m->openOutputFileAppend(fastaFileNames[barcodeIndex][primerIndex], output);
+                            ostringstream output;
                             currSeq.printSequence(output);
-                            output.close();
+                            groupFiles->write(fastaFileNames[barcodeIndex][primerIndex], output.str());
                             
                             if(qFileName != ""){
-                                m->openOutputFileAppend(qualFileNames[barcodeIndex][primerIndex], output);
-                                currQual.printQScores(output);
-                                output.close();							
+                                ostringstream outputQual;
+                                currQual.printQScores(outputQual);
+                                groupFiles->write(qualFileNames[barcodeIndex][primerIndex], outputQual.str());
                             }
                             
                             if(nameFile != ""){
                                 map<string, string>::iterator itName = nameMap.find(currSeq.getName());
                                 if (itName != nameMap.end()) { 
-                                    m->openOutputFileAppend(nameFileNames[barcodeIndex][primerIndex], output);
-                                    output << itName->first << '\t' << itName->second << endl; 
-                                    output.close();
+                                    groupFiles->write(nameFileNames[barcodeIndex][primerIndex], itName->first + '\t' + itName->second + '\n');
                                 }else { m->mothurOut("[ERROR]: " + currSeq.getName() + " is not in your namefile, please correct."); m->mothurOutEndLine(); }
                             }
                         }
@@ -1071,6 +1073,7 @@ int TrimSeqsCommand::driverCreateTrim(string filename, string qFileName, string
 		
 		delete trimOligos;
         if (reorient) { delete rtrimOligos; }
+        if (allFiles) { groupFiles->flush(); delete groupFiles; }
 		inFASTA.close();
 		trimFASTAFile.close();
 		scrapFASTAFile.close();
@@ -1107,32 +1110,6 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
 				process++;
 			}else if (pid == 0){
 				
-				vector<vector<string> > tempFASTAFileNames = fastaFileNames;
-				vector<vector<string> > tempPrimerQualFileNames = qualFileNames;
-				vector<vector<string> > tempNameFileNames = nameFileNames;
-
-				if(allFiles){
-					ofstream temp;
-
-					for(int i=0;i<tempFASTAFileNames.size();i++){
-						for(int j=0;j<tempFASTAFileNames[i].size();j++){
-							if (tempFASTAFileNames[i][j] != "") {
-								tempFASTAFileNames[i][j] += toString(getpid()) + ".temp";
-								m->openOutputFile(tempFASTAFileNames[i][j], temp);			temp.close();
-
-								if(qFileName != ""){
-									tempPrimerQualFileNames[i][j] += toString(getpid()) + ".temp";
-									m->openOutputFile(tempPrimerQualFileNames[i][j], temp);		temp.close();
-								}
-								if(nameFile != ""){
-									tempNameFileNames[i][j] += toString(getpid()) + ".temp";
-									m->openOutputFile(tempNameFileNames[i][j], temp);		temp.close();
-								}
-							}
-						}
-					}
-				}
-							
 				driverCreateTrim(filename,
 								 qFileName,
 								 (trimFASTAFileName + toString(getpid()) + ".temp"),
@@ -1144,11 +1121,12 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
                                  (trimCountFileName + toString(getpid()) + ".temp"),
 								 (scrapCountFileName + toString(getpid()) + ".temp"),
 								 (groupFile + toString(getpid()) + ".temp"),
-								 tempFASTAFileNames,
-								 tempPrimerQualFileNames,
-								 tempNameFileNames,
+								 fastaFileNames,
+								 qualFileNames,
+								 nameFileNames,
 								 lines[process],
-								 qLines[process]);
+								 qLines[process],
+                                 (filename + toString(getpid()) + ".demux.temp"));
                 
                 if (m->debug) { m->mothurOut("[DEBUG]: " + toString(lines[process].start) + '\t' + toString(qLines[process].start) + '\t' + toString(getpid()) + '\n'); }
 				
@@ -1194,25 +1172,7 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
                         string tempFile = filename + (toString(processIDS[i])) + ".num.temp";
                         m->mothurRemove(tempFile);
                     }
-                    if(allFiles){
-                        for(int i=0;i<fastaFileNames.size();i++){
-                            for(int j=0;j<fastaFileNames[0].size();j++){
-                                if (fastaFileNames[i][j] != "") {
-                                    string tempFile = fastaFileNames[i][j] +(toString(processIDS[i])) + ".temp";
-                                    m->mothurRemove(tempFile);
-                                    
-                                    if(qFileName != ""){
-                                        string tempFile = qualFileNames[i][j] +(toString(processIDS[i])) + ".temp";
-                                        m->mothurRemove(tempFile);
-                                    }
-                                    if(nameFile != ""){
-                                        string tempFile = nameFileNames[i][j] +(toString(processIDS[i])) + ".temp";
-                                        m->mothurRemove(tempFile);
-                                    }
-                                }
-                            }
-                        }
-                    }
+                    if(allFiles){ m->mothurRemove(filename + toString(processIDS[i]) + ".demux.temp"); }
                 }
                 recalc = true;
                 break;
@@ -1240,32 +1200,6 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
                     process++;
                 }else if (pid == 0){
                     
-                    vector<vector<string> > tempFASTAFileNames = fastaFileNames;
-                    vector<vector<string> > tempPrimerQualFileNames = qualFileNames;
-                    vector<vector<string> > tempNameFileNames = nameFileNames;
-                    
-                    if(allFiles){
-                        ofstream temp;
-                        
-                        for(int i=0;i<tempFASTAFileNames.size();i++){
-                            for(int j=0;j<tempFASTAFileNames[i].size();j++){
-                                if (tempFASTAFileNames[i][j] != "") {
-                                    tempFASTAFileNames[i][j] += toString(getpid()) + ".temp";
-                                    m->openOutputFile(tempFASTAFileNames[i][j], temp);			temp.close();
-                                    
-                                    if(qFileName != ""){
-                                        tempPrimerQualFileNames[i][j] += toString(getpid()) + ".temp";
-                                        m->openOutputFile(tempPrimerQualFileNames[i][j], temp);		temp.close();
-                                    }
-                                    if(nameFile != ""){
-                                        tempNameFileNames[i][j] += toString(getpid()) + ".temp";
-                                        m->openOutputFile(tempNameFileNames[i][j], temp);		temp.close();
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    
                     driverCreateTrim(filename,
                                      qFileName,
                                      (trimFASTAFileName + toString(getpid()) + ".temp"),
@@ -1277,11 +1211,12 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
                                      (trimCountFileName + toString(getpid()) + ".temp"),
                                      (scrapCountFileName + toString(getpid()) + ".temp"),
                                      (groupFile + toString(getpid()) + ".temp"),
-                                     tempFASTAFileNames,
-                                     tempPrimerQualFileNames,
-                                     tempNameFileNames,
+                                     fastaFileNames,
+                                     qualFileNames,
+                                     nameFileNames,
                                      lines[process],
-                                     qLines[process]);
+                                     qLines[process],
+                                     (filename + toString(getpid()) + ".demux.temp"));
                     
                     if (m->debug) { m->mothurOut("[DEBUG]: " + toString(lines[process].start) + '\t' + toString(qLines[process].start) + '\t' + toString(getpid()) + '\n'); }
                     
@@ -1330,7 +1265,7 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
 			m->openOutputFile(scrapCountFileName, temp);		temp.close();
 		}
 
-		driverCreateTrim(filename, qFileName, trimFASTAFileName, scrapFASTAFileName, trimQualFileName, scrapQualFileName, trimNameFileName, scrapNameFileName, trimCountFileName, scrapCountFileName, groupFile, fastaFileNames, qualFileNames, nameFileNames, lines[0], qLines[0]);
+		driverCreateTrim(filename, qFileName, trimFASTAFileName, scrapFASTAFileName, trimQualFileName, scrapQualFileName, trimNameFileName, scrapNameFileName, trimCountFileName, scrapCountFileName, groupFile, fastaFileNames, qualFileNames, nameFileNames, lines[0], qLines[0], "");
 		
 		//force parent to wait until all the processes are done
 		for (int i=0;i<processIDS.size();i++) { 
@@ -1440,7 +1375,7 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
             }
         }
         
-		driverCreateTrim(filename, qFileName, (trimFASTAFileName + toString(processors-1) + ".temp"), (scrapFASTAFileName + toString(processors-1) + ".temp"), (trimQualFileName + toString(processors-1) + ".temp"), (scrapQualFileName + toString(processors-1) + ".temp"), (trimNameFileName + toString(processors-1) + ".temp"), (scrapNameFileName + toString(processors-1) + ".temp"), (trimCountFileName + toString(processors-1) + ".temp"), (scrapCountFileName + toString(processors-1) + ".temp"), (groupFile + toString(processors-1) + ".temp"), tempFASTAFileNames, tempPrimerQualFileNames, tempNameFileNames, lines[processors-1], qLines[processors-1]);
+		driverCreateTrim(filename, qFileName, (trimFASTAFileName + toString(processors-1) + ".temp"), (scrapFASTAFileName + toString(processors-1) + ".temp"), (trimQualFileName + toString(processors-1) + ".temp"), (scrapQualFileName + toString(processors-1) + ".temp"), (trimNameFileName + toString(processors-1) + ".temp"), (scrapNameFileName + toString(processors-1) + ".temp"), (trimCountFileName + toString(processors-1) + ".temp"), (scrapCountFileName + toString(processors-1) + ".temp"), (groupFile + toString(processors-1) + ".temp"), tempFASTAFileNames, tempPrimerQualFileNames, tempNameFileNames, lines[processors-1], qLines[processors-1], "");
         processIDS.push_back(processors-1);
 
         
@@ -1470,6 +1405,10 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
         
         
         //append files
+    #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        //each group file gets its writes in process order, one open per flush
+        DemuxWriter groupFiles;
+    #endif
 		for(int i=0;i<processIDS.size();i++){
 			
 			m->mothurOut("Appending files from process " + toString(processIDS[i])); m->mothurOutEndLine();
@@ -1507,6 +1446,9 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
 			
 			
 			if(allFiles){
+            #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+                groupFiles.appendSpool(filename + toString(processIDS[i]) + ".demux.temp");
+            #else
 				for(int j=0;j<fastaFileNames.size();j++){
 					for(int k=0;k<fastaFileNames[j].size();k++){
 						if (fastaFileNames[j][k] != "") {
@@ -1525,6 +1467,7 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
 						}
 					}
 				}
+            #endif
 			}
 			
             #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
@@ -1563,6 +1506,9 @@ int TrimSeqsCommand::createProcessesCreateTrim(string filename, string qFileName
 			}
             #endif
 		}
+    #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        groupFiles.flush();
+    #endif
 
         return exitCommand;
 	}
@@ -16,6 +16,7 @@
 #include "qualityscores.h"
 #include "trimoligos.h"
 #include "counttable.h"
+#include "demuxwriter.h"
 
 
 class TrimSeqsCommand : public Command {
@@ -74,7 +75,7 @@ private:
 	vector<linePair> lines;
 	vector<linePair> qLines;
 	
-	int driverCreateTrim(string, string, string, string, string, string, string, string, string, string, string, vector<vector<string> >, vector<vector<string> >, vector<vector<string> >, linePair, linePair);	
+	int driverCreateTrim(string, string, string, string, string, string, string, string, string, string, string, vector<vector<string> >, vector<vector<string> >, vector<vector<string> >, linePair, linePair, string);	
 	int createProcessesCreateTrim(string, string, string, string, string, string, string, string, string, string, string, vector<vector<string> >, vector<vector<string> >, vector<vector<string> >);
 	int setLines(string, string);
 };
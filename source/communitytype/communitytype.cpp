@@ -444,10 +444,16 @@ int CommunityTypeFinder::findkMeans(){
                     weights[i] += (double)zMatrix[i][j];
                 }
                 
+                //walk the samples in the outer loop so each relative abundance row is read once and in order.
+                //samples with no weight in this partition add nothing to the centroid.
                 vector<double> averageRelativeAbundance(numOTUs, 0);
-                for(int j=0;j<numOTUs;j++){
-                    for(int k=0;k<numSamples;k++){
-                        averageRelativeAbundance[j] += zMatrix[i][k] * relativeAbundance[k][j];
+                for(int k=0;k<numSamples;k++){
+                    double weight = zMatrix[i][k];
+                    if (weight == 0) { continue; }
+                    
+                    const double* thisRelAbund = &relativeAbundance[k][0];
+                    for(int j=0;j<numOTUs;j++){
+                        averageRelativeAbundance[j] += weight * thisRelAbund[j];
                     }
                 }
                 
@@ -470,20 +476,22 @@ int CommunityTypeFinder::findkMeans(){
                 if (m->control_pressed) {  return 0; }
                 
                 double normalizationFactor = 0;
-                vector<double> totalDistToPartition(numPartitions, 0);
+                vector<double> partitionWeight(numPartitions, 0);
+                const double* thisRelAbund = &relativeAbundance[i][0];
                 
                 for(int j=0;j<numPartitions;j++){
+                    const double* centroid = &alphaMatrix[j][0];
+                    double totalDistToPartition = 0;
                     for(int k=0;k<numOTUs;k++){
-                        double difference = alphaMatrix[j][k] - relativeAbundance[i][k];
-                        totalDistToPartition[j] += difference * difference;
+                        double difference = centroid[k] - thisRelAbund[k];
+                        totalDistToPartition += difference * difference;
                     }
-                    totalDistToPartition[j] = sqrt(totalDistToPartition[j]);
-                    normalizationFactor += exp(-50.0 * totalDistToPartition[j]);
+                    partitionWeight[j] = exp(-50.0 * sqrt(totalDistToPartition));
+                    normalizationFactor += partitionWeight[j];
                 }
                 
-                
                 for(int j=0;j<numPartitions;j++){
-                    zMatrix[j][i] = exp(-50.0 * totalDistToPartition[j]) / normalizationFactor;
+                    zMatrix[j][i] = partitionWeight[j] / normalizationFactor;
                 }
                 
             }
@@ -529,7 +537,7 @@ int CommunityTypeFinder::findkMeans(){
 //results is length numOTUs and holds the distances from x of the sample in d with the min sum of distances to all other samples.
 //Basically the "best" medoid.
 //returns the sum of the distances squared
-double CommunityTypeFinder::rMedoid(vector< vector<double> > x, vector< vector<double> > d){
+double CommunityTypeFinder::rMedoid(vector< vector<double> >& x, vector< vector<double> >& d){
     try {
         vector<double> results; results.resize(numOTUs, 0.0);
         double minSumDist = 1e6;
@@ -573,7 +581,7 @@ double CommunityTypeFinder::rMedoid(vector< vector<double> > x, vector< vector<d
  CHk=Bk/(k−1)/Wk/(n−k)
  
  where Bk is the between-cluster sum of squares (i.e. the squared distances between all points i and j, for which i and j are not in the same cluster) and Wk is the within-clusters sum of squares (i.e. the squared distances between all points i and j, for which i and j are in the same cluster). This measure implements the idea that the clustering is more robust when between-cluster distances are substantially larger than within-cluster distances. Consequently, we chose the number of clusters k such that CHk was maximal.*/
-double CommunityTypeFinder::calcCHIndex(vector< vector< double> > dists){
+double CommunityTypeFinder::calcCHIndex(vector< vector< double> >& dists){
     try {
         double CH = 0.0;
         
@@ -727,7 +735,7 @@ vector<vector<double> > CommunityTypeFinder::calcCenters(vector<vector<double> >
  The formula implies -1 =< S(i) =< 1 . A sample which is much closer to its own cluster than to any other cluster has a high S(i) value, while S(i) close to 0 implies that the given sample lies somewhere between two clusters. Large negative S(i) values indicate that the sample was assigned to the wrong cluster.
  */
 //based on silouette.r which calls sildist.c written by Francois Romain
-vector<double> CommunityTypeFinder::calcSilhouettes(vector<vector<double> > dists) {
+vector<double> CommunityTypeFinder::calcSilhouettes(vector<vector<double> >& dists) {
     try {
         vector<double> silhouettes; silhouettes.resize(numSamples, 0.0);
         if (numPartitions < 2) { return silhouettes; }
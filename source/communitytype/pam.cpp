@@ -10,21 +10,27 @@
 #define DBL_EPSILON 1e-9
 
 /**************************************************************************************************/
-Pam::Pam(vector<vector<int> > c, vector<vector<double> > d, int p) : CommunityTypeFinder() {
+Pam::Pam(vector<vector<int> > c, vector<vector<double> >& d, int p) : CommunityTypeFinder() {
     try {
         countMatrix = c;
         numSamples = (int)d.size();
         numOTUs = (int)c[0].size();
         numPartitions = p;
-        dists = d;
         
+        //the matrix is symmetric, so only keep the lower triangle in one block
+        dists.resize(((size_t)numSamples * (size_t)(numSamples-1)) / 2);
         largestDist = 0;
-        for (int i = 0; i < dists.size(); i++) {
-            for (int j = i; j < dists.size(); j++) {
-                if (m->control_pressed) { break; }
-                if (dists[i][j] > largestDist) { largestDist = dists[i][j]; } 
+        size_t index = 0;
+        for (int i = 0; i < numSamples; i++) {
+            if (m->control_pressed) { break; }
+            for (int j = 0; j < i; j++) {
+                dists[index] = d[i][j]; index++;
+                if (d[i][j] > largestDist) { largestDist = d[i][j]; }
             }
         }
+        
+        isMedoid.assign(numSamples, false);
+        nearest.assign(numSamples, 0);
        
         buildPhase(); //choosing the medoids
         swapPhase(); //optimize clusters
@@ -35,18 +41,36 @@ Pam::Pam(vector<vector<int> > c, vector<vector<double> > d, int p) : CommunityTy
 	}
 }
 /**************************************************************************************************/
+//fills row with the distances from sample i to every sample
+void Pam::getDistRow(int i, vector<double>& row) {
+    try {
+        size_t index = ((size_t)i * (size_t)(i-1)) / 2;
+        for (int j = 0; j < i; j++) { row[j] = dists[index+j]; }
+        
+        row[i] = 0.0;
+        
+        //below the diagonal each row starts one further along than the last
+        index = ((size_t)(i+1) * (size_t)i) / 2 + i;
+        for (int j = i+1; j < numSamples; j++) { row[j] = dists[index]; index += j; }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Pam", "getDistRow");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 //build and swap functions based on pam.c by maechler from R cluster package
-//sets Dp[0] does not set Dp[1]. chooses intial medoids.
+//sets Dp does not set Ep. chooses intial medoids.
 int Pam::buildPhase() {
     try {
         
         if (m->debug) { m->mothurOut("[DEBUG]: building medoids\n"); }
         
         vector<double> gains; gains.resize(numSamples);
+        vector<double> row; row.resize(numSamples);
         
         largestDist *= 1.1 + 1; //make this distance larger than any distance in the matrix
-        Dp.resize(numSamples);
-        for (int i = 0; i < numSamples; i++) { Dp[i].push_back(largestDist); Dp[i].push_back(largestDist); } //2 smallest dists for this sample in this partition
+        Dp.assign(numSamples, largestDist); Ep.assign(numSamples, largestDist); //2 smallest dists for this sample in this partition
         
         zMatrix.resize(numPartitions);
         for(int i=0;i<numPartitions;i++){
@@ -59,14 +83,15 @@ int Pam::buildPhase() {
             double totalGain = 0.0;
             double clusterGain = 0.0;
             
-            for (int i = 0; i < numSamples; i++) {  //does this need to be square?? can we do lt?
+            for (int i = 0; i < numSamples; i++) {
                 if (m->control_pressed) { break; }
         
-                if (medoids.count(i) == 0) { //is this sample is NOT a medoid?
+                if (!isMedoid[i]) { //is this sample is NOT a medoid?
                     gains[i] = 0.0;
+                    getDistRow(i, row);
                 
                     for (int j = 0; j < numSamples; j++) {
-                        totalGain = Dp[j][0] - dists[i][j];
+                        totalGain = Dp[j] - row[j];
                         if (totalGain > 0.0) { gains[i] += totalGain; }
                     }
                     if (m->debug) { m->mothurOut("[DEBUG]: " + toString(i) +  " totalGain = " + toString(totalGain) + "\n"); }
@@ -78,14 +103,18 @@ int Pam::buildPhase() {
                 }
             }
             
+            if (m->control_pressed) { break; }
+            
             //save medoid value
             medoids.insert(medoid);
+            isMedoid[medoid] = true;
             
             if (m->debug) { m->mothurOut("[DEBUG]: new medoid " + toString(medoid) + "\n"); }
             
             //update dp values
+            getDistRow(medoid, row);
             for (int i = 0; i < numSamples; i++) {
-                if (Dp[i][0] > dists[i][medoid]) { Dp[i][0] = dists[i][medoid]; }
+                if (Dp[i] > row[i]) { Dp[i] = row[i]; }
             }
         }
         if (m->debug) { m->mothurOut("[DEBUG]: done building medoids\n"); }
@@ -98,54 +127,65 @@ int Pam::buildPhase() {
 }
 /**************************************************************************************************/
 //goal to swap medoids with non-medoids to see if we can reduce the overall cost
+//Tih, the change in cost of swapping medoid i for sample h, is found for every medoid in one pass over the samples using
+//the nearest and second nearest medoid of each sample (Schubert and Rousseeuw's FastPAM1). A sample that is closer to h than
+//to its nearest medoid moves to h whichever medoid is removed. Otherwise it only changes cost if its own nearest medoid
+//is removed, in which case it moves to h or its second closest medoid.
 int Pam::swapPhase() {
     try {
         if (m->debug) { m->mothurOut("[DEBUG]: swapping  medoids\n"); }
         //calculate cost of initial choice - average distance of samples to their closest medoid
         double sky = 0.0;
         double dzsky = 1.0;
-        for (int i = 0; i < numSamples; i++) { sky += Dp[i][0]; }  //sky /= (double) numSamples;
+        for (int i = 0; i < numSamples; i++) { sky += Dp[i]; }  //sky /= (double) numSamples;
+        
+        vector<int> medoidList(medoids.begin(), medoids.end());
+        vector<double> row; row.resize(numSamples);
+        vector<double> removeCost; removeCost.resize(medoidList.size());
         
         bool done = false;
         int hbest, nbest; hbest = -1; nbest = -1;
         while (!done) {
             if (m->control_pressed) { break; }
             
-            updateDp();
+            updateDp(medoidList);
             
             dzsky = 1;
             
             for (int h = 0; h < numSamples; h++) {
                 if (m->control_pressed) { break; }
-                if (medoids.count(h) == 0) { //this is NOT a medoid
-                    for (int i = 0; i < numSamples; i++) {
-                        if (medoids.count(i) != 0) { //this is a medoid
-                        
-                            double dz = 0.0; //Tih sum of distances between objects and closest medoid caused by swapping i and h. Basically the change in cost. If this < 0 its a "good" swap. When all Tih are > 0, then we stop the algo, because we have the optimal medoids.
-                            for (int j = 0; j < numSamples; j++) {
-                                if (m->control_pressed) { break; }
-                                if (dists[i][j] == Dp[j][0]) {
-                                    double smallValue; smallValue = 0.0;
-                                    if (Dp[j][1] > dists[h][j]) {   smallValue = dists[h][j];    }
-                                    else                        {   smallValue = Dp[j][1];       }
-                                    dz += (- Dp[j][0]+ smallValue);
-                                }else if (dists[h][j] < Dp[j][0]) {
-                                    dz += (- Dp[j][0] + dists[h][j]);
-                                }
-                            }
-                            if (dzsky > dz) {
-                                dzsky = dz;
-                                hbest = h; 
-                                nbest = i;
-                            }
-                        }//end if medoid
-                    }//end for i
-                }//end if NOT medoid
-            }//end if h
+                if (isMedoid[h]) { continue; } //only swap in samples that are NOT medoids
+                
+                getDistRow(h, row);
+                
+                double addCost = 0.0; //change shared by every swap that brings in h
+                removeCost.assign(medoidList.size(), 0.0); //extra change from removing each medoid
+                
+                for (int j = 0; j < numSamples; j++) {
+                    if (row[j] < Dp[j]) {
+                        addCost += (- Dp[j] + row[j]);
+                    }else {
+                        double smallValue; smallValue = 0.0;
+                        if (Ep[j] > row[j])     {   smallValue = row[j];    }
+                        else                    {   smallValue = Ep[j];     }
+                        removeCost[nearest[j]] += (- Dp[j] + smallValue);
+                    }
+                }
+                
+                for (int i = 0; i < medoidList.size(); i++) {
+                    double dz = addCost + removeCost[i]; //Tih. If this < 0 its a "good" swap. When all Tih are > 0, then we stop the algo, because we have the optimal medoids.
+                    if (dzsky > dz) {
+                        dzsky = dz;
+                        hbest = h;
+                        nbest = medoidList[i];
+                    }
+                }
+            }//end for h
             
             if (dzsky < -16 *DBL_EPSILON * fabs(sky)) {
-                medoids.insert(hbest);
-                medoids.erase(nbest);
+                medoids.insert(hbest); isMedoid[hbest] = true;
+                medoids.erase(nbest); isMedoid[nbest] = false;
+                medoidList.assign(medoids.begin(), medoids.end());
                 if (m->debug) { m->mothurOut("[DEBUG]: swapping " + toString(hbest) + " " + toString(nbest) + "\n"); }
                 sky += dzsky;
             }else { done = true; } //stop algo.
@@ -165,10 +205,10 @@ int Pam::swapPhase() {
         laplace = 0;
         for (int i = 0; i < numSamples; i++) {
             int partition = 0;
-            double dist = dists[i][tempMedoids[0]]; //assign to first medoid
+            double dist = getDist(i, tempMedoids[0]); //assign to first medoid
             for (int j = 1; j < tempMedoids.size(); j++) {
-                if (dists[i][tempMedoids[j]] < dist) { //is this medoid closer?
-                    dist = dists[i][tempMedoids[j]];
+                if (getDist(i, tempMedoids[j]) < dist) { //is this medoid closer?
+                    dist = getDist(i, tempMedoids[j]);
                     partition = j;
                 }
             }
@@ -203,22 +243,26 @@ int Pam::swapPhase() {
 }
 
 /**************************************************************************************************/
-int Pam::updateDp() {
+//finds the closest and second closest medoid of every sample, one medoid row at a time
+int Pam::updateDp(vector<int>& medoidList) {
     try {
-        for (int j = 0; j < numSamples; j++) {
+        //initialize dp and ep
+        Dp.assign(numSamples, largestDist); Ep.assign(numSamples, largestDist);
+        nearest.assign(numSamples, 0);
+        
+        vector<double> row; row.resize(numSamples);
+        for (int i = 0; i < medoidList.size(); i++) {
             if (m->control_pressed) { break; }
             
-            //initialize dp and ep
-            Dp[j][0] = largestDist; Dp[j][1] = largestDist;
-        
-            for (int i = 0; i < numSamples; i++) {
-                if (medoids.count(i) != 0) { //is this a medoid? 
-                    if (Dp[j][0] > dists[j][i]) {
-                        Dp[j][0] = Dp[j][1];
-                        Dp[j][0] = dists[j][i];
-                    }else if (Dp[j][1] > dists[j][i]) {
-                        Dp[j][1] = dists[j][i];
-                    }
+            getDistRow(medoidList[i], row);
+            
+            for (int j = 0; j < numSamples; j++) {
+                if (Dp[j] > row[j]) {
+                    Ep[j] = Dp[j];
+                    Dp[j] = row[j];
+                    nearest[j] = i;
+                }else if (Ep[j] > row[j]) {
+                    Ep[j] = row[j];
                 }
             }
         }
@@ -238,7 +282,7 @@ int Pam::updateDp() {
  
  where Bk is the between-cluster sum of squares (i.e. the squared distances between all points i and j, for which i and j are not in the same cluster) and Wk is the within-clusters sum of squares (i.e. the squared distances between all points i and j, for which i and j are in the same cluster). This measure implements the idea that the clustering is more robust when between-cluster distances are substantially larger than within-cluster distances. Consequently, we chose the number of clusters k such that CHk was maximal.*/
 //based on R index.G1.r function
-double Pam::calcCHIndex(vector< vector<double> > dists){ //countMatrix = [numSamples][numOtus]
+double Pam::calcCHIndex(vector< vector<double> >& dists){ //countMatrix = [numSamples][numOtus]
     try {
         double CH = 0.0;
         
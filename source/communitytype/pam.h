@@ -17,19 +17,29 @@
 class Pam : public CommunityTypeFinder {
     
 public:
-    Pam(vector<vector<int> >, vector<vector<double> >, int);
-    double calcCHIndex(vector< vector< double> >);
+    Pam(vector<vector<int> >, vector<vector<double> >&, int);
+    double calcCHIndex(vector< vector< double> >&);
     
 private:
     set<int> medoids;
     map<int, int> medoid2Partition;
     double largestDist;
-    vector<vector<double> > dists;
-    vector<vector< double> > Dp; // [numSamples][2] - It contains Dp and Ep. Dp is in [numSamples][0] and Ep is in [numSamples][1]. Dp is the distance between p and the closest sample in S and Ep is the distance between p and the second closest object in S. Both are used in the build and swap phases.
+    vector<double> dists; //lower triangle of the sample distance matrix, row by row. dist(i,j) for i > j is at i*(i-1)/2 + j
+    vector<bool> isMedoid;
+    vector<int> nearest; //[numSamples] - index into the medoid list of the medoid closest to each sample
+    vector<double> Dp; // [numSamples] - Dp is the distance between p and the closest sample in S. Used in the build and swap phases.
+    vector<double> Ep; // [numSamples] - Ep is the distance between p and the second closest object in S. Used in the swap phase.
     
     int buildPhase();
     int swapPhase();
-    int updateDp();
+    int updateDp(vector<int>&);
+    void getDistRow(int, vector<double>&);
+    
+    double getDist(int i, int j) {
+        if (i == j) { return 0.0; }
+        if (i < j) { int temp = i; i = j; j = temp; }
+        return dists[((size_t)i * (size_t)(i-1)) / 2 + j];
+    }
     
     
     
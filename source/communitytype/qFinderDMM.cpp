@@ -20,6 +20,8 @@ qFinderDMM::qFinderDMM(vector<vector<int> > cm, int p) : CommunityTypeFinder() {
         numSamples = (int)countMatrix.size();
         numOTUs = (int)countMatrix[0].size();
         
+        cacheCountTable();
+        
        // if (m->debug) { m->mothurOut("before kmeans\n"); }
         findkMeans();
        //if (m->debug) { m->mothurOut("done kMeans\n"); }
@@ -595,8 +597,6 @@ int qFinderDMM::bfgs2_Solver(vector<double>& x){
 
 double qFinderDMM::negativeLogEvidenceLambdaPi(vector<double>& x){
     try{
-        vector<double> sumAlphaX(numSamples, 0.0000);
-        
         double logEAlpha = 0.0000;
         double sumLambda = 0.0000;
         double sumAlpha = 0.0000;
@@ -604,32 +604,38 @@ double qFinderDMM::negativeLogEvidenceLambdaPi(vector<double>& x){
         double nu = 0.10000;
         double eta = 0.10000;
         
+        vector<double>& z = zMatrix[currentPartition];
+        
         double weight = 0.00000;
         for(int i=0;i<numSamples;i++){
-            weight += zMatrix[currentPartition][i];
+            weight += z[i];
         }
         
         for(int i=0;i<numOTUs;i++){
             if (m->control_pressed) {  return 0; }
             double lambda = x[i];
             double alpha = exp(x[i]);
-            logEAlpha += lgamma(alpha);
+            double lnGamAlpha = lgamma(alpha);
+            logEAlpha += lnGamAlpha;
             sumLambda += lambda;
             sumAlpha += alpha;
             
-            for(int j=0;j<numSamples;j++){
-                double X = countMatrix[j][i];
-                double alphaX = alpha + X;
-                sumAlphaX[j] += alphaX;
-                
-                logE -= zMatrix[currentPartition][j] * lgamma(alphaX);
+            //samples without this otu contribute lgamma(alpha), so only the non zero counts need their own lgamma
+            double zeroWeight = weight;
+            for(int j=0;j<otuSamples[i].size();j++){
+                int sample = otuSamples[i][j];
+                double alphaX = alpha + otuCounts[i][j];
+                zeroWeight -= z[sample];
+                logE -= z[sample] * lgamma(alphaX);
             }
+            logE -= zeroWeight * lnGamAlpha;
         }
         
         logEAlpha -= lgamma(sumAlpha);
 
+        //sum of alpha + X over the otus is sumAlpha plus the sample size
         for(int i=0;i<numSamples;i++){
-            logE += zMatrix[currentPartition][i] * lgamma(sumAlphaX[i]);
+            logE += z[i] * lgamma(sumAlpha + sampleTotals[i]);
         }
 
         return logE + weight * logEAlpha + nu * sumAlpha - eta * sumLambda;
@@ -644,9 +650,6 @@ double qFinderDMM::negativeLogEvidenceLambdaPi(vector<double>& x){
 
 void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<double>& df){
     try{
-//        cout << "\tstart negativeLogDerivEvidenceLambdaPi" << endl;
-        
-        vector<double> storeVector(numSamples, 0.0000);
         vector<double> derivative(numOTUs, 0.0000);
         vector<double> alpha(numOTUs, 0.0000);
         
@@ -654,42 +657,30 @@ void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<doub
         double nu = 0.1000;
         double eta = 0.1000;
         
+        vector<double>& z = zMatrix[currentPartition];
+        
         double weight = 0.0000;
         for(int i=0;i<numSamples;i++){
-            weight += zMatrix[currentPartition][i];
+            weight += z[i];
         }
 
-        
         for(int i=0;i<numOTUs;i++){
             if (m->control_pressed) {  return; }
-//            cout << "start i loop" << endl;
-//            
-//            cout << i << '\t' << alpha[i] << '\t' << x[i] << '\t' << exp(x[i]) << '\t' << store << endl;
             
             alpha[i] = exp(x[i]);
             store += alpha[i];
             
-//            cout << "before derivative" << endl;
-            
-            derivative[i] = weight * psi(alpha[i]);
-
-//            cout << "after derivative" << endl;
-
-//            cout << i << '\t' << alpha[i] << '\t' << psi(alpha[i]) << '\t' << derivative[i] << endl;
-
-            for(int j=0;j<numSamples;j++){
-                double X = countMatrix[j][i];
-                double alphaX = X + alpha[i];
-                
-                derivative[i] -= zMatrix[currentPartition][j] * psi(alphaX);
-                storeVector[j] += alphaX;
+            //weight * psi(alpha) - sum z * psi(alpha + X), the samples without this otu cancel out
+            double psiAlpha = psi(alpha[i]);
+            for(int j=0;j<otuSamples[i].size();j++){
+                int sample = otuSamples[i][j];
+                derivative[i] += z[sample] * (psiAlpha - psi(alpha[i] + otuCounts[i][j]));
             }
-//            cout << "end i loop" << endl;
         }
 
         double sumStore = 0.0000;
         for(int i=0;i<numSamples;i++){
-            sumStore += zMatrix[currentPartition][i] * psi(storeVector[i]);
+            sumStore += z[i] * psi(store + sampleTotals[i]);
         }
         
         store = weight * psi(store);
@@ -698,10 +689,7 @@ void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<doub
         
         for(int i=0;i<numOTUs;i++){
             df[i] = alpha[i] * (nu + derivative[i] - store + sumStore) - eta;
-//            cout << i << '\t' << df[i] << endl;
         }
-//        cout << df.size() << endl;
-//        cout << "\tend negativeLogDerivEvidenceLambdaPi" << endl;
     }
     catch(exception& e){
          m->errorOut(e, "qFinderDMM", "negativeLogDerivEvidenceLambdaPi");
@@ -711,30 +699,19 @@ void qFinderDMM::negativeLogDerivEvidenceLambdaPi(vector<double>& x, vector<doub
 
 /**************************************************************************************************/
 
-double qFinderDMM::getNegativeLogEvidence(vector<double>& lambda, int group){
+double qFinderDMM::getNegativeLogEvidence(vector<double>& alpha, vector<double>& lnGamAlpha, double sumAlpha, int group){
     try {
-        double sumAlpha = 0.0000;
-        double sumAlphaX = 0.0000;
-        double sumLnGamAlpha = 0.0000;
+        //lgamma(alpha + X) only differs from lgamma(alpha) for the otus present in the sample
         double logEvidence = 0.0000;
         
-        for(int i=0;i<numOTUs;i++){
-            if (m->control_pressed) {  return 0; }
-            double alpha = exp(lambda[i]);
-            double X = countMatrix[group][i];
-            double alphaX = alpha + X;
-            
-            sumLnGamAlpha += lgamma(alpha);
-            sumAlpha += alpha;
-            sumAlphaX += alphaX;
-            
-            logEvidence -= lgamma(alphaX);
+        for(int i=0;i<sampleOTUs[group].size();i++){
+            int otu = sampleOTUs[group][i];
+            logEvidence += lnGamAlpha[otu] - lgamma(alpha[otu] + sampleCounts[group][i]);
         }
         
-        sumLnGamAlpha -= lgamma(sumAlpha);
-        logEvidence += lgamma(sumAlphaX);
+        logEvidence += lgamma(sumAlpha + sampleTotals[group]) - lgamma(sumAlpha);
         
-        return logEvidence + sumLnGamAlpha;
+        return logEvidence;
     }
     catch(exception& e){
         m->errorOut(e, "qFinderDMM", "getNegativeLogEvidence");
@@ -762,13 +739,25 @@ void qFinderDMM::calculatePiK(){
     try {
         vector<double> store(numPartitions);
         
+        //alpha and its lgamma only depend on the partition, so find them once instead of once per sample
+        vector<vector<double> > alpha(numPartitions), lnGamAlpha(numPartitions);
+        vector<double> sumAlpha(numPartitions, 0.0000);
+        for(int j=0;j<numPartitions;j++){
+            alpha[j].resize(numOTUs); lnGamAlpha[j].resize(numOTUs);
+            for(int k=0;k<numOTUs;k++){
+                alpha[j][k] = exp(lambdaMatrix[j][k]);
+                lnGamAlpha[j][k] = lgamma(alpha[j][k]);
+                sumAlpha[j] += alpha[j][k];
+            }
+        }
+        
         for(int i=0;i<numSamples;i++){
             if (m->control_pressed) {  return; }
             double sum = 0.0000;
             double minNegLogEvidence =numeric_limits<double>::max();
             
             for(int j=0;j<numPartitions;j++){
-                double negLogEvidenceJ = getNegativeLogEvidence(lambdaMatrix[j], i);
+                double negLogEvidenceJ = getNegativeLogEvidence(alpha[j], lnGamAlpha[j], sumAlpha[j], i);
                 
                 if(negLogEvidenceJ < minNegLogEvidence){
                     minNegLogEvidence = negLogEvidenceJ;
@@ -804,54 +793,45 @@ double qFinderDMM::getNegativeLogLikelihood(){
         
         vector<double> pi(numPartitions, 0.0000);
         vector<double> logBAlpha(numPartitions, 0.0000);
+        vector<double> sumAlphaK(numPartitions, 0.0000);
+        vector<vector<double> > alpha(numPartitions), lnGamAlpha(numPartitions);
         
         double doubleSum = 0.0000;
         
         for(int i=0;i<numPartitions;i++){
             if (m->control_pressed) {  return 0; }
-            double sumAlphaK = 0.0000;
             
             pi[i] = weights[i] / (double)numSamples;
             
+            alpha[i].resize(numOTUs); lnGamAlpha[i].resize(numOTUs);
             for(int j=0;j<numOTUs;j++){
-                double alpha = exp(lambdaMatrix[i][j]);
-                sumAlphaK += alpha;
+                alpha[i][j] = exp(lambdaMatrix[i][j]);
+                lnGamAlpha[i][j] = lgamma(alpha[i][j]);
+                sumAlphaK[i] += alpha[i][j];
                 
-                logBAlpha[i] += lgamma(alpha);
+                logBAlpha[i] += lnGamAlpha[i][j];
             }
-            logBAlpha[i] -= lgamma(sumAlphaK);
+            logBAlpha[i] -= lgamma(sumAlphaK[i]);
         }
         
         for(int i=0;i<numSamples;i++){
             if (m->control_pressed) {  return 0; }
             
             double probability = 0.0000;
-            double factor = 0.0000;
-            double sum = 0.0000;
             vector<double> logStore(numPartitions, 0.0000);
             double offset = -numeric_limits<double>::max();
             
-            for(int j=0;j<numOTUs;j++){
-                sum += countMatrix[i][j];
-                factor += lgamma(countMatrix[i][j] + 1.0000);
-            }
-            factor -= lgamma(sum + 1.0);
-            
             for(int k=0;k<numPartitions;k++){
                 
-                double sumAlphaKX = 0.0000;
-                double logBAlphaX = 0.0000;
+                //logBAlphaX - logBAlpha[k] only picks up terms from the otus present in the sample
+                double logBAlphaX = logBAlpha[k] + lgamma(sumAlphaK[k]) - lgamma(sumAlphaK[k] + sampleTotals[i]);
                 
-                for(int j=0;j<numOTUs;j++){
-                    double alphaX = exp(lambdaMatrix[k][j]) + (double)countMatrix[i][j];
-                    
-                    sumAlphaKX += alphaX;
-                    logBAlphaX += lgamma(alphaX);
+                for(int j=0;j<sampleOTUs[i].size();j++){
+                    int otu = sampleOTUs[i][j];
+                    logBAlphaX += lgamma(alpha[k][otu] + sampleCounts[i][j]) - lnGamAlpha[k][otu];
                 }
                 
-                logBAlphaX -= lgamma(sumAlphaKX);
-                
-                logStore[k] = logBAlphaX - logBAlpha[k] - factor;
+                logStore[k] = logBAlphaX - logBAlpha[k] - sampleLogFactors[i];
                 if(logStore[k] > offset){
                     offset = logStore[k];
                 }
@@ -874,7 +854,7 @@ double qFinderDMM::getNegativeLogLikelihood(){
         for(int i=0;i<numPartitions;i++){
             for(int j=0;j<numOTUs;j++){
                 if (m->control_pressed) {  return 0; }
-                alphaSum += exp(lambdaMatrix[i][j]);
+                alphaSum += alpha[i][j];
                 lambdaSum += lambdaMatrix[i][j];
             }
         }
@@ -891,3 +871,38 @@ double qFinderDMM::getNegativeLogLikelihood(){
 
 }
 /**************************************************************************************************/
+//shared files are mostly zeros, so keep the non zero counts by sample and by otu along with the
+//sample sizes and log factorial terms that never change while fitting
+void qFinderDMM::cacheCountTable(){
+    try {
+        sampleTotals.assign(numSamples, 0.0000);
+        sampleLogFactors.assign(numSamples, 0.0000);
+        sampleOTUs.assign(numSamples, vector<int>());
+        sampleCounts.assign(numSamples, vector<double>());
+        otuSamples.assign(numOTUs, vector<int>());
+        otuCounts.assign(numOTUs, vector<double>());
+        
+        for(int i=0;i<numSamples;i++){
+            if (m->control_pressed) {  return; }
+            
+            double factor = 0.0000;
+            for(int j=0;j<numOTUs;j++){
+                if (countMatrix[i][j] != 0) {
+                    sampleTotals[i] += countMatrix[i][j];
+                    factor += lgamma(countMatrix[i][j] + 1.0000);
+                    
+                    sampleOTUs[i].push_back(j);
+                    sampleCounts[i].push_back(countMatrix[i][j]);
+                    otuSamples[j].push_back(i);
+                    otuCounts[j].push_back(countMatrix[i][j]);
+                }
+            }
+            sampleLogFactors[i] = factor - lgamma(sampleTotals[i] + 1.0);
+        }
+    }
+    catch(exception& e){
+        m->errorOut(e, "qFinderDMM", "cacheCountTable");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
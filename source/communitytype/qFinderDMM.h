@@ -27,13 +27,18 @@ private:
 
     double negativeLogEvidenceLambdaPi(vector<double>&);
     void negativeLogDerivEvidenceLambdaPi(vector<double>&, vector<double>&);
-    double getNegativeLogEvidence(vector<double>&, int);
+    double getNegativeLogEvidence(vector<double>&, vector<double>&, double, int);
     double getNegativeLogLikelihood();
+    void cacheCountTable();
     
     
     int lineMinimizeFletcher(vector<double>&, vector<double>&, double, double, double, double&, double&, vector<double>&, vector<double>&);
     int bfgs2_Solver(vector<double>&);//, double, double);
     
+    vector<double> sampleTotals, sampleLogFactors;  //reads in each sample, lgamma(N+1) terms of the multinomial
+    vector<vector<int> > sampleOTUs, otuSamples;    //non zero entries of countMatrix by sample and by otu
+    vector<vector<double> > sampleCounts, otuCounts;
+    
    
 
         
@@ -175,8 +175,8 @@ int Consensus::getSets(vector<Tree*>& t) {
 				
 				temp.clear();
 				//go through pcounts and pull out descendants
-				for (it = t[i]->tree[j].pcount.begin(); it != t[i]->tree[j].pcount.end(); it++) {
-					temp.push_back(it->first);
+				for (int k = 0; k < t[i]->tree[j].pcount.size(); k++) {
+					temp.push_back(t[i]->getGroupName(t[i]->tree[j].pcount[k].first));
 				}
 				
 				//sort temp
@@ -200,11 +200,11 @@ int Consensus::getSets(vector<Tree*>& t) {
 			if (m->control_pressed) { return 1; }
             
 			//only need the first one since leaves have no descendants but themselves
-			it = t[0]->tree[j].pcount.begin(); 
-			temp.clear();  temp.push_back(it->first);
+			string leafGroup = t[0]->getGroupName(t[0]->tree[j].pcount[0].first);
+			temp.clear();  temp.push_back(leafGroup);
 			
 			//fill treeSet
-			treeSet.push_back(it->first);
+			treeSet.push_back(leafGroup);
 			
 			//add leaf to list but with sighting value less then all non leaf pairs 
 			nodePairs[temp] = 0;
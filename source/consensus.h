@@ -39,7 +39,6 @@ private:
 	map< vector<string>, vector< vector<string> > > bestSplit;  //maps a group to its best split
 	map< vector<string>, int > nodePairsInitialRate;
 	map< vector<string>, int > nodePairsInTree;
-	map<string, int>::iterator it;
 	map< vector<string>, int>::iterator it2;
 	string outputFile, notIncluded, filename;
 	int numNodes, numLeaves, count, numTrees;  //count is the next available spot in the tree vector
@@ -0,0 +1,115 @@
+//
+//  demuxwriter.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "demuxwriter.h"
+
+#define DEMUX_BUFFER_LIMIT 33554432
+
+/**************************************************************************************************/
+DemuxWriter::DemuxWriter() {
+    try {
+        m = MothurOut::getInstance();
+        spoolFile = ""; bufferSize = 0; bufferLimit = DEMUX_BUFFER_LIMIT;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DemuxWriter", "DemuxWriter");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+DemuxWriter::DemuxWriter(string s) {
+    try {
+        m = MothurOut::getInstance();
+        spoolFile = s; bufferSize = 0; bufferLimit = DEMUX_BUFFER_LIMIT;
+
+        ofstream out;
+        m->openOutputFile(spoolFile, out); out.close();
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DemuxWriter", "DemuxWriter");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void DemuxWriter::write(string filename, string text) {
+    try {
+        buffers[filename] += text;
+        bufferSize += text.length();
+
+        if (bufferSize > bufferLimit) { flush(); }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DemuxWriter", "write");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void DemuxWriter::flush() {
+    try {
+        if (bufferSize == 0) { return; }
+
+        ofstream spool;
+        if (spoolFile != "") { m->openOutputFileBinaryAppend(spoolFile, spool); }
+
+        for (map<string, string>::iterator it = buffers.begin(); it != buffers.end(); it++) {
+            if (it->second.length() == 0) { continue; }
+
+            if (spoolFile != "") {
+                spool << it->first << '\n' << it->second.length() << '\n';
+                spool.write(it->second.c_str(), it->second.length());
+            }else {
+                ofstream out;
+                m->openOutputFileAppend(it->first, out);
+                out.write(it->second.c_str(), it->second.length());
+                out.close();
+            }
+
+            //clear keeps the memory for the next round
+            it->second.clear();
+        }
+
+        if (spoolFile != "") { spool.close(); }
+        bufferSize = 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DemuxWriter", "flush");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+int DemuxWriter::appendSpool(string filename) {
+    try {
+        ifstream in;
+        m->openInputFileBinary(filename, in);
+
+        string text;
+        while (!in.eof()) {
+            if (m->control_pressed) { break; }
+
+            string name = m->getline(in);
+            if (name == "") { break; }
+
+            unsigned long long length = 0;
+            in >> length; in.get();
+
+            text.resize(length);
+            if (length != 0) { in.read(&text[0], length); }
+
+            write(name, text);
+        }
+        in.close();
+
+        m->mothurRemove(filename);
+
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "DemuxWriter", "appendSpool");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
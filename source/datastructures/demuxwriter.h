@@ -0,0 +1,39 @@
+#ifndef DEMUXWRITER_H
+#define DEMUXWRITER_H
+
+//
+//  demuxwriter.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//collects the output for the per group files the allfiles option makes. Text is held per file and written when the
+//buffers fill or flush is called, so each file is opened once per flush instead of once per sequence and only one
+//file is open at a time. With a spool file the buffers go to the spool instead, each piece tagged with the file it
+//belongs to. The parent process replays its children's spools in order with appendSpool.
+
+class DemuxWriter {
+
+public:
+    DemuxWriter(); //writes to the group files
+    DemuxWriter(string); //spool file, cleared here
+    ~DemuxWriter() {}
+
+    void write(string, string); //filename, text
+    void flush();
+    int appendSpool(string); //spool filename, written to the group files and removed
+
+private:
+    MothurOut* m;
+    string spoolFile;
+    unsigned long long bufferSize, bufferLimit;
+
+    map<string, string> buffers; //filename -> text not yet written
+};
+/**************************************************************************************************/
+
+#endif
@@ -0,0 +1,262 @@
+//
+//  dereplicator.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "dereplicator.h"
+
+/**************************************************************************************************/
+//sorts positions in the name buffer by unique, stable so names stay in the order they were added
+struct bufferUniqueOrder {
+    vector<int>* uniques;
+    bufferUniqueOrder(vector<int>* u) : uniques(u) {}
+    bool operator()(int a, int b) const { return ((*uniques)[a] < (*uniques)[b]); }
+};
+/**************************************************************************************************/
+Dereplicator::Dereplicator(bool k, string t) {
+    try {
+        m = MothurOut::getInstance();
+        keepNames = k;
+        tempRoot = t;
+        numUniques = 0; seqBytes = 0; nameBytes = 0; bufferPos = 0;
+
+        //a quarter of the machine, half for the unique sequences and half for the names
+        memoryBudget = m->getTotalRAM() / 4;
+        if (memoryBudget == 0) { memoryBudget = 1073741824; }
+
+        if (m->debug) { m->mothurOut("[DEBUG]: dereplicating with a memory budget of " + toString(memoryBudget) + " bytes.\n"); }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "Dereplicator");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+Dereplicator::~Dereplicator() {
+    for (int i = 0; i < runs.size(); i++) { runs[i]->close(); delete runs[i]; }
+    for (int i = 0; i < runFiles.size(); i++) { m->mothurRemove(runFiles[i]); }
+    if (seqFile != "") { seqs.close(); m->mothurRemove(seqFile); }
+}
+/**************************************************************************************************/
+//two independent 64 bit hashes, FNV-1a and a multiply-xorshift, each finished with the murmur3 mixer
+seqFingerprint Dereplicator::getFingerprint(string& seq) {
+    try {
+        unsigned long long h1 = 14695981039346656037ULL;
+        unsigned long long h2 = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)seq.length();
+
+        const unsigned char* bases = (const unsigned char*)seq.c_str();
+        int length = seq.length();
+        for (int i = 0; i < length; i++) {
+            h1 ^= bases[i]; h1 *= 1099511628211ULL;
+            h2 += bases[i]; h2 *= 0xff51afd7ed558ccdULL; h2 ^= (h2 >> 32);
+        }
+
+        seqFingerprint fingerprint;
+        h1 ^= (h1 >> 33); h1 *= 0xff51afd7ed558ccdULL; h1 ^= (h1 >> 33); h1 *= 0xc4ceb9fe1a85ec53ULL; h1 ^= (h1 >> 33);
+        h2 ^= (h2 >> 33); h2 *= 0xff51afd7ed558ccdULL; h2 ^= (h2 >> 33); h2 *= 0xc4ceb9fe1a85ec53ULL; h2 ^= (h2 >> 33);
+        fingerprint.high = h1; fingerprint.low = h2;
+
+        return fingerprint;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "getFingerprint");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+int Dereplicator::add(string& seq, string name, bool& isNew) {
+    try {
+        seqFingerprint fingerprint = getFingerprint(seq);
+
+        //a fingerprint match is only a candidate, it is merged once the sequence itself matches
+        int index = -1;
+        pair<multimap<seqFingerprint, int>::iterator, multimap<seqFingerprint, int>::iterator> matches = fingerprints.equal_range(fingerprint);
+        for (multimap<seqFingerprint, int>::iterator it = matches.first; it != matches.second; it++) {
+            if (sameSequence(it->second, seq)) { index = it->second; break; }
+        }
+
+        isNew = (index == -1);
+        if (isNew) {
+            index = numUniques; numUniques++;
+            fingerprints.insert(make_pair(fingerprint, index));
+            uniqueLengths.push_back(seq.length());
+
+            if ((seqBytes + seq.length()) <= (memoryBudget / 2)) { uniqueSeqs.push_back(seq); uniqueOffsets.push_back(0); seqBytes += seq.length(); }
+            else { uniqueSeqs.push_back(""); spillSequence(seq); }
+        }
+
+        if (keepNames) {
+            bufferUniques.push_back(index);
+            bufferNames.push_back(name);
+            nameBytes += name.length() + sizeof(string) + sizeof(int);
+
+            if (nameBytes > (memoryBudget / 2)) { spill(); }
+        }
+
+        return index;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "add");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//compares the sequence byte for byte against the unique, reading it back from the sequence file if it was written there
+bool Dereplicator::sameSequence(int thisUnique, string& seq) {
+    try {
+        if (uniqueLengths[thisUnique] != seq.length()) { return false; }
+        if ((uniqueSeqs[thisUnique] != "") || (seq.length() == 0)) { return (uniqueSeqs[thisUnique] == seq); }
+
+        spilledSeq.resize(seq.length());
+        seqs.seekg(uniqueOffsets[thisUnique]);
+        seqs.read(&spilledSeq[0], seq.length());
+        if (!seqs) { m->mothurOut("[ERROR]: unable to read unique sequences back from " + seqFile + ".\n"); m->control_pressed = true; seqs.clear(); return false; }
+
+        return (spilledSeq == seq);
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "sameSequence");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void Dereplicator::spillSequence(string& seq) {
+    try {
+        if (seqFile == "") {
+            seqFile = tempRoot + m->mothurGetpid(0) + ".derep.seqs.temp";
+            seqs.open(seqFile.c_str(), ios::in | ios::out | ios::trunc | ios::binary);
+            if (!seqs) { m->mothurOut("[ERROR]: unable to open " + seqFile + " for the unique sequences that don't fit in memory.\n"); m->control_pressed = true; }
+
+            if (m->debug) { m->mothurOut("[DEBUG]: writing unique sequences past the memory budget to " + seqFile + ".\n"); }
+        }
+
+        seqs.seekp(0, ios::end);
+        uniqueOffsets.push_back(seqs.tellp());
+        seqs.write(seq.c_str(), seq.length());
+        if (!seqs) { m->mothurOut("[ERROR]: unable to write unique sequences to " + seqFile + ".\n"); m->control_pressed = true; seqs.clear(); }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "spillSequence");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void Dereplicator::sortBuffer() {
+    try {
+        bufferOrder.resize(bufferUniques.size());
+        for (int i = 0; i < bufferOrder.size(); i++) { bufferOrder[i] = i; }
+        stable_sort(bufferOrder.begin(), bufferOrder.end(), bufferUniqueOrder(&bufferUniques));
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "sortBuffer");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//runs are written in the order the names arrived, so merging them run by run keeps each unique's names in order
+void Dereplicator::spill() {
+    try {
+        sortBuffer();
+
+        string runFile = tempRoot + m->mothurGetpid(0) + "." + toString(runFiles.size()) + ".derep.temp";
+        runFiles.push_back(runFile);
+
+        if (m->debug) { m->mothurOut("[DEBUG]: writing " + toString(bufferNames.size()) + " names to " + runFile + ".\n"); }
+
+        ofstream out;
+        m->openOutputFile(runFile, out);
+        for (int i = 0; i < bufferOrder.size(); i++) {
+            out << bufferUniques[bufferOrder[i]] << '\t' << bufferNames[bufferOrder[i]] << '\n';
+        }
+        out.close();
+
+        //swap to release the memory, clear keeps it
+        vector<int>().swap(bufferUniques);
+        vector<string>().swap(bufferNames);
+        vector<int>().swap(bufferOrder);
+        nameBytes = 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "spill");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+int Dereplicator::startNames() {
+    try {
+        //nothing on disk, so read straight from the buffer
+        if (runFiles.size() == 0) { sortBuffer(); bufferPos = 0; return 0; }
+
+        if (bufferNames.size() != 0) { spill(); }
+
+        runHeadUniques.resize(runFiles.size(), -1);
+        runHeadNames.resize(runFiles.size(), "");
+        for (int i = 0; i < runFiles.size(); i++) {
+            ifstream* in = new ifstream();
+            m->openInputFile(runFiles[i], *in);
+            runs.push_back(in);
+            readRunHead(i);
+        }
+
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "startNames");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool Dereplicator::readRunHead(int run) {
+    try {
+        int thisUnique; string name;
+        if (*runs[run] >> thisUnique >> name) { runHeadUniques[run] = thisUnique; runHeadNames[run] = name; return true; }
+
+        runHeadUniques[run] = -1;
+        return false;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "readRunHead");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool Dereplicator::getNextNames(int& index, vector<string>& names) {
+    try {
+        names.clear();
+
+        if (runs.size() == 0) {
+            if (bufferPos >= bufferOrder.size()) { return false; }
+
+            index = bufferUniques[bufferOrder[bufferPos]];
+            while ((bufferPos < bufferOrder.size()) && (bufferUniques[bufferOrder[bufferPos]] == index)) {
+                names.push_back(bufferNames[bufferOrder[bufferPos]]);
+                bufferPos++;
+            }
+            return true;
+        }
+
+        //smallest unique at the head of any run
+        index = -1;
+        for (int i = 0; i < runs.size(); i++) {
+            if (runHeadUniques[i] == -1) { continue; }
+            if ((index == -1) || (runHeadUniques[i] < index)) { index = runHeadUniques[i]; }
+        }
+        if (index == -1) { return false; }
+
+        for (int i = 0; i < runs.size(); i++) {
+            while (runHeadUniques[i] == index) {
+                names.push_back(runHeadNames[i]);
+                readRunHead(i);
+            }
+        }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "Dereplicator", "getNextNames");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
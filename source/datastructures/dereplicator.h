@@ -0,0 +1,76 @@
+#ifndef DEREPLICATOR_H
+#define DEREPLICATOR_H
+
+//
+//  dereplicator.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//finds identical sequences without keying on the sequence string. Each sequence is reduced to a 128 bit fingerprint,
+//and a fingerprint match is checked against the stored unique sequence. Uniques that don't fit in the memory budget
+//are written to a temp file and a match is read back from there to check it. Uniques are numbered in the order they are
+//first seen. The names each unique represents are buffered and, when the buffer passes the memory budget, written to
+//disk as a run sorted by unique. The runs are merged when the names are read back.
+
+struct seqFingerprint {
+    unsigned long long high, low;
+
+    seqFingerprint() : high(0), low(0) {}
+    bool operator<(const seqFingerprint& rhs) const { return ((high < rhs.high) || ((high == rhs.high) && (low < rhs.low))); }
+};
+/**************************************************************************************************/
+
+class Dereplicator {
+
+public:
+    Dereplicator(bool, string); //keep names, root for temp files
+    ~Dereplicator();
+
+    int add(string&, string, bool&); //aligned sequence, name, set to true if this is a new unique. returns the index of the unique
+    int getNumUniques() { return numUniques; }
+
+    //names of each unique in the order the uniques were found, each list in the order the names were added
+    int startNames();
+    bool getNextNames(int&, vector<string>&); //unique index, names. false when there are no more uniques
+
+private:
+    MothurOut* m;
+    bool keepNames;
+    string tempRoot;
+    int numUniques;
+    unsigned long long memoryBudget, seqBytes, nameBytes;
+
+    multimap<seqFingerprint, int> fingerprints; //fingerprint -> unique index, more than one index only for a collision
+    vector<string> uniqueSeqs; //blank once the sequences no longer fit in the budget
+    vector<int> uniqueLengths;
+    vector<unsigned long long> uniqueOffsets; //where a blank unique was written in the sequence file
+
+    string seqFile; //uniques past the budget, opened when the first one is written
+    fstream seqs;
+    string spilledSeq;
+
+    vector<int> bufferUniques; //names not yet spilled
+    vector<string> bufferNames;
+    vector<int> bufferOrder; //sorted positions into the buffer, used when nothing was spilled
+    int bufferPos;
+
+    vector<string> runFiles;
+    vector<ifstream*> runs;
+    vector<int> runHeadUniques;
+    vector<string> runHeadNames;
+
+    seqFingerprint getFingerprint(string&);
+    bool sameSequence(int, string&);
+    void spillSequence(string&);
+    void sortBuffer();
+    void spill();
+    bool readRunHead(int);
+};
+/**************************************************************************************************/
+
+#endif
@@ -8,19 +8,28 @@
 
 #include "fastqread.h"
 
-
 /*******************************************************************************/
-FastqRead::FastqRead() {
-    try {
-        m = MothurOut::getInstance();
-        format = "illumina1.8+"; name = ""; sequence = ""; scores.clear();
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
+//goes from solexa to sanger and back. Used fq_all2std.pl as a reference. Filled once for all the reads.
+struct solexaConvertTables {
+    vector<char> convertTable;
+    vector<int> convertBackTable;
+    
+    solexaConvertTables() {
         for (int i = -64; i < 65; i++) {
             char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
             convertTable.push_back(temp);
             convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
         }
     }
+};
+static solexaConvertTables solexaTables;
+
+/*******************************************************************************/
+FastqRead::FastqRead() {
+    try {
+        m = MothurOut::getInstance();
+        format = "illumina1.8+"; name = ""; sequence = ""; scores.clear();
+    }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
         exit(1);
@@ -31,20 +40,14 @@ FastqRead::FastqRead(Sequence s, QualityScores q) {
     try {
         m = MothurOut::getInstance(); format = "illumina1.8+";
         
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
-        
         if (s.getName() != q.getName()) { m->mothurOut("[ERROR]: sequence name does not match quality score name. Cannot construct fastq object.\n"); m->control_pressed = true; }
         else {
             name = s.getName();
             comment = s.getComment();
             sequence = s.getUnaligned();
-            scores = q.getScores();
-            scoreString = convertQual(scores);
+            vector<int> qualScores = q.getScores();
+            scores.assign(qualScores.begin(), qualScores.end());
+            scoreString = convertQual(qualScores);
         }
         
         
@@ -59,20 +62,14 @@ FastqRead::FastqRead(Sequence s, QualityScores q, string f) {
     try {
         m = MothurOut::getInstance(); format = f;
         
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
-        
         if (s.getName() != q.getName()) { m->mothurOut("[ERROR]: sequence name does not match quality score name. Cannot construct fastq object.\n"); m->control_pressed = true; }
         else {
             name = s.getName();
             comment = s.getComment();
             sequence = s.getUnaligned();
-            scores = q.getScores();
-            scoreString = convertQual(scores);
+            vector<int> qualScores = q.getScores();
+            scores.assign(qualScores.begin(), qualScores.end());
+            scoreString = convertQual(qualScores);
         }
         
         
@@ -87,12 +84,6 @@ FastqRead::FastqRead(string f) {
     try {
         m = MothurOut::getInstance();
         format = f; name = ""; sequence = ""; scores.clear();
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
@@ -104,13 +95,7 @@ FastqRead::FastqRead(string f) {
 FastqRead::FastqRead(string f, string n, string s, vector<int> sc) {
     try {
         m = MothurOut::getInstance();
-        format = f; name = n; sequence = s; scores = sc;
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-            convertBackTable.push_back(((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499)));
-        }
+        format = f; name = n; sequence = s; scores.assign(sc.begin(), sc.end());
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
@@ -123,104 +108,124 @@ FastqRead::FastqRead(ifstream& in, bool& ignore, string f) {
     try {
         m = MothurOut::getInstance();
         
-        ignore = false;
+        read(in, ignore, f);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqRead", "FastqRead");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//fills this read from the next record. The strings and scores are assigned in place, so reading a file into the same FastqRead
+//reuses their memory instead of allocating it again for every record.
+void FastqRead::read(istream& in, bool& ignore, string f) {
+    try {
         format = f;
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-        }
-        
-        //read sequence name
-        string line = m->getline(in); m->gobble(in);
-        vector<string> pieces = m->splitWhiteSpace(line);
-        name = "";  if (pieces.size() != 0) { name = pieces[0]; }
-        if (name == "") {  m->mothurOut("[WARNING]: Blank fasta name, ignoring read."); m->mothurOutEndLine(); ignore=true;  }
-        else if (name[0] != '@') { m->mothurOut("[WARNING]: reading " + name + " expected a name with @ as a leading character, ignoring read."); m->mothurOutEndLine(); ignore=true; }
-        else { name = name.substr(1); }
-        if (pieces.size() > 1) { pieces.erase(pieces.begin()); comment = m->getStringFromVector(pieces, " "); }
-        
-        //read sequence
-        sequence = m->getline(in); m->gobble(in);
-        if (sequence == "") {  m->mothurOut("[WARNING]: missing sequence for " + name + ", ignoring."); ignore=true; }
-
-        //read sequence name
-        line = m->getline(in); m->gobble(in);
-        pieces = m->splitWhiteSpace(line);
-        string name2 = "";  if (pieces.size() != 0) { name2 = pieces[0]; }
-        if (name2 == "") {  m->mothurOut("[WARNING]: expected a name with + as a leading character, ignoring."); ignore=true; }
-        else if (name2[0] != '+') { m->mothurOut("[WARNING]: reading " + name2 + " expected a name with + as a leading character, ignoring."); ignore=true; }
-        else { name2 = name2.substr(1); if (name2 == "") { name2 = name; } }
         
-        //read quality scores
-        string quality = m->getline(in); m->gobble(in);
-        if (quality == "") {  m->mothurOut("[WARNING]: missing quality for " + name2 + ", ignoring."); ignore=true; }
+        readLine(in, line);
+        readLine(in, sequence);
+        readLine(in, line2);
+        readLine(in, scoreString);
         
-        //sanity check sequence length and number of quality scores match
-        if (name2 != "") { if (name != name2) { m->mothurOut("[WARNING]: names do not match. read " + name + " for fasta and " + name2 + " for quality, ignoring."); ignore=true; } }
-        if (quality.length() != sequence.length()) { m->mothurOut("[WARNING]: Lengths do not match for sequence " + name + ". Read " + toString(sequence.length()) + " characters for fasta and " + toString(quality.length()) + " characters for quality scores, ignoring read."); ignore=true; }
+        checkRecord(ignore);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqRead", "read");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//same as read(istream&), but copies the record's lines out of the buffer's block
+void FastqRead::read(FastqBuffer& buffer, bool& ignore, string f) {
+    try {
+        format = f;
         
-        scoreString = quality;
-        scores = convertQual(quality);
-        m->checkName(name);
+        buffer.nextRecord();
+        line.assign(buffer.getLine(0), buffer.getLength(0));
+        sequence.assign(buffer.getLine(1), buffer.getLength(1));
+        line2.assign(buffer.getLine(2), buffer.getLength(2));
+        scoreString.assign(buffer.getLine(3), buffer.getLength(3));
         
-        if (m->debug) { m->mothurOut("[DEBUG]: " + name + " " + sequence + " " + quality + "\n"); }
-    
+        checkRecord(ignore);
     }
     catch(exception& e) {
-        m->errorOut(e, "FastqRead", "FastqRead");
+        m->errorOut(e, "FastqRead", "read");
         exit(1);
     }
 }
 //**********************************************************************************************************************
-#ifdef USE_BOOST
-FastqRead::FastqRead(boost::iostreams::filtering_istream& in, bool& ignore, string f) {
+//pulls the name and comment out of the name lines, warns about anything malformed and converts the quality scores
+void FastqRead::checkRecord(bool& ignore) {
     try {
-        m = MothurOut::getInstance();
-        
         ignore = false;
-        format = f;
-        //fill convert table - goes from solexa to sanger. Used fq_all2std.pl as a reference.
-        for (int i = -64; i < 65; i++) {
-            char temp = (char) ((int)(33 + 10*log(1+pow(10,(i/10.0)))/log(10)+0.499));
-            convertTable.push_back(temp);
-        }
+        comment.clear();
         
-        //read sequence name
-        string line = ""; std::getline(in, line); m->gobble(in);
-        vector<string> pieces = m->splitWhiteSpace(line);
-        name = "";  if (pieces.size() != 0) { name = pieces[0]; }
+        //sequence name
+        size_t start = line.find_first_not_of(" \t\n\v\f\r");
+        size_t end = line.find_first_of(" \t\n\v\f\r", start);
+        name.clear();  if (start != string::npos) { name.assign(line, start, end-start); }
         if (name == "") {  m->mothurOut("[WARNING]: Blank fasta name, ignoring read."); m->mothurOutEndLine(); ignore=true;  }
         else if (name[0] != '@') { m->mothurOut("[WARNING]: reading " + name + " expected a name with @ as a leading character, ignoring read."); m->mothurOutEndLine(); ignore=true; }
-        else { name = name.substr(1); }
-        if (pieces.size() > 1) { pieces.erase(pieces.begin()); comment = m->getStringFromVector(pieces, " "); }
+        else { name.erase(0, 1); }
+        if (end != string::npos) { vector<string> pieces = m->splitWhiteSpace(line.substr(end)); if (pieces.size() != 0) { comment = m->getStringFromVector(pieces, " "); } }
         
-        //read sequence
-        std::getline(in, sequence); m->gobble(in);
+        //sequence
         if (sequence == "") {  m->mothurOut("[WARNING]: missing sequence for " + name + ", ignoring."); ignore=true; }
-        
-        //read sequence name
-        line = ""; std::getline(in, line); m->gobble(in);
-        pieces = m->splitWhiteSpace(line);
-        string name2 = "";  if (pieces.size() != 0) { name2 = pieces[0]; }
+
+        //quality name
+        start = line2.find_first_not_of(" \t\n\v\f\r");
+        end = line2.find_first_of(" \t\n\v\f\r", start);
+        string name2 = "";  if (start != string::npos) { name2.assign(line2, start, end-start); }
         if (name2 == "") {  m->mothurOut("[WARNING]: expected a name with + as a leading character, ignoring."); ignore=true; }
         else if (name2[0] != '+') { m->mothurOut("[WARNING]: reading " + name2 + " expected a name with + as a leading character, ignoring."); ignore=true; }
-        else { name2 = name2.substr(1); if (name2 == "") { name2 = name; } }
+        else { name2.erase(0, 1); if (name2 == "") { name2 = name; } }
         
-        //read quality scores
-        string quality = ""; std::getline(in, quality); m->gobble(in);
-        if (quality == "") {  m->mothurOut("[WARNING]: missing quality for " + name2 + ", ignoring."); ignore=true; }
+        //quality scores
+        if (scoreString == "") {  m->mothurOut("[WARNING]: missing quality for " + name2 + ", ignoring."); ignore=true; }
         
         //sanity check sequence length and number of quality scores match
         if (name2 != "") { if (name != name2) { m->mothurOut("[WARNING]: names do not match. read " + name + " for fasta and " + name2 + " for quality, ignoring."); ignore=true; } }
-        if (quality.length() != sequence.length()) { m->mothurOut("[WARNING]: Lengths do not match for sequence " + name + ". Read " + toString(sequence.length()) + " characters for fasta and " + toString(quality.length()) + " characters for quality scores, ignoring read."); ignore=true; }
+        if (scoreString.length() != sequence.length()) { m->mothurOut("[WARNING]: Lengths do not match for sequence " + name + ". Read " + toString(sequence.length()) + " characters for fasta and " + toString(scoreString.length()) + " characters for quality scores, ignoring read."); ignore=true; }
         
-        scoreString = quality;
-        scores = convertQual(quality);
+        convertQual(scoreString, scores);
         m->checkName(name);
         
-        if (m->debug) { m->mothurOut("[DEBUG]: " + name + " " + sequence + " " + quality + "\n"); }
+        if (m->debug) { m->mothurOut("[DEBUG]: " + name + " " + sequence + " " + scoreString + "\n"); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqRead", "checkRecord");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//same as m->getline followed by m->gobble, but takes the characters straight from the file's buffer. line is cleared rather than
+//replaced, so it keeps its memory when the caller reuses it
+void FastqRead::readLine(istream& in, string& line) {
+    try {
+        line.clear();
+        if (!in) { return; }
+        
+        streambuf* buffer = in.rdbuf();
+        int c = buffer->sbumpc();
+        while ((c != EOF) && (c != '\n') && (c != '\r') && (c != '\f')) { line += (char)c; c = buffer->sbumpc(); }
         
+        //gobble the white space before the next line
+        if (c != EOF) { c = buffer->sgetc(); while ((c != EOF) && isspace(c)) { c = buffer->snextc(); } }
+        
+        if (c == EOF) { in.setstate(ios::eofbit | ios::failbit); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqRead", "readLine");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+#ifdef USE_BOOST
+FastqRead::FastqRead(boost::iostreams::filtering_istream& in, bool& ignore, string f) {
+    try {
+        m = MothurOut::getInstance();
+        
+        read(in, ignore, f);
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "FastqRead");
@@ -231,31 +236,45 @@ FastqRead::FastqRead(boost::iostreams::filtering_istream& in, bool& ignore, stri
 //**********************************************************************************************************************
 vector<int> FastqRead::convertQual(string qual) {
     try {
-        vector<int> qualScores;
+        vector<unsigned char> qualScores;
+        convertQual(qual, qualScores);
+        return vector<int>(qualScores.begin(), qualScores.end());
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqRead", "convertQual");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+//fills qualScores in place, so a read that is reused keeps the memory of its scores. Scores below zero are set to 0 and reported.
+void FastqRead::convertQual(const string& qual, vector<unsigned char>& qualScores) {
+    try {
+        int length = qual.length();
+        qualScores.resize(length);
+        const unsigned char* quality = (const unsigned char*)qual.c_str();
         bool negativeScores = false;
         
-        for (int i = 0; i < qual.length(); i++) {
-            
-            int temp = 0;
-            temp = int(qual[i]);
-            if (format == "illumina") {
-                temp -= 64; //char '@'
-            }else if (format == "illumina1.8+") {
-                temp -= int('!'); //char '!' //33
-            }else if (format == "solexa") {
-                temp = int(convertTable[temp]); //convert to sanger
-                temp -= int('!'); //char '!' //33
-            }else {
-                temp -= int('!'); //char '!' //33
+        if (format == "solexa") {
+            for (int i = 0; i < length; i++) {
+                int temp = int(solexaTables.convertTable[quality[i]]) - int('!'); //convert to sanger, char '!' //33
+                if (temp < 0) { negativeScores = true; temp = 0; }
+                qualScores[i] = temp;
             }
+        }else {
+            unsigned char offset = '!'; //33
+            if (format == "illumina") { offset = '@'; } //64
             
-            if (temp < 0) { negativeScores = true; temp = 0; }
-            qualScores.push_back(temp);
+            //byte arithmetic with no branches, so the compiler turns it into vector subtracts
+            unsigned char belowOffset = 0;
+            for (int i = 0; i < length; i++) {
+                unsigned char below = (quality[i] < offset);
+                belowOffset |= below;
+                qualScores[i] = below ? 0 : (unsigned char)(quality[i] - offset);
+            }
+            negativeScores = (belowOffset != 0);
         }
         
         if (negativeScores) { m->mothurOut("[ERROR]: finding negative quality scores, do you have the right format selected? http://en.wikipedia.org/wiki/FASTQ_format#Encoding \n");  m->control_pressed = true;  }
-        
-        return qualScores;
     }
     catch(exception& e) {
         m->errorOut(e, "FastqRead", "convertQual");
@@ -265,19 +284,18 @@ vector<int> FastqRead::convertQual(string qual) {
 //**********************************************************************************************************************
 string FastqRead::convertQual(vector<int> qual) {
     try {
-        string scoreString = "";
+        string scoreString(qual.size(), ' ');
+        
+        int controlChar = int('!');
+        if (format == "illumina") {  controlChar = int('@');  }
+        bool solexa = (format == "solexa");
         
         for (int i = 0; i < qual.size(); i++) {
-            int controlChar = int('!');
-            if (format == "illumina") {  controlChar = int('@');  }
-
             int temp = qual[i] + controlChar;
             
-            if (format == "solexa") { temp = convertBackTable[temp];  }
+            if (solexa) { temp = solexaTables.convertBackTable[temp];  }
             
-            char qualChar = (char) temp;
-            
-            scoreString += qualChar;
+            scoreString[i] = (char) temp;
         }
         
         return scoreString;
@@ -325,3 +343,93 @@ QualityScores FastqRead::getQuality() {
 }
 
 /*******************************************************************************/
+FastqBuffer::FastqBuffer(istream& i) : in(i) {
+    try {
+        m = MothurOut::getInstance();
+        
+        block.resize(1048576); //1M, grown if a record does not fit
+        current = 0; filled = 0; recordStart = 0; atEnd = false;
+        for (int j = 0; j < 4; j++) { lineStarts[j] = 0; lineLengths[j] = 0; }
+        
+        //make.contigs seeks each process to its part of the file before reading, gz streams can't say where they are
+        streamoff start = in.tellg();
+        blockPosition = 0; if (start > 0) { blockPosition = start; }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqBuffer", "FastqBuffer");
+        exit(1);
+    }
+}
+/*******************************************************************************/
+//finds the name, sequence, + and quality lines of the next record. Past the end of the file the lines are blank.
+void FastqBuffer::nextRecord() {
+    try {
+        recordStart = current;
+        for (int i = 0; i < 4; i++) { readLine(i); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqBuffer", "nextRecord");
+        exit(1);
+    }
+}
+/*******************************************************************************/
+//a line ends at \n, \r or \f like m->getline, then the white space before the next line is skipped like m->gobble
+void FastqBuffer::readLine(int i) {
+    try {
+        lineStarts[i] = current - recordStart; lineLengths[i] = 0;
+        if (atEnd) { return; }
+        
+        size_t pos = current;
+        while (true) {
+            const char* data = &block[0];
+            while ((pos < filled) && (data[pos] != '\n') && (data[pos] != '\r') && (data[pos] != '\f')) { pos++; }
+            if (pos < filled) { break; }
+            
+            size_t lineStart = recordStart + lineStarts[i];
+            if (!fill()) { //last line of the file has no newline
+                lineLengths[i] = pos - lineStart; current = pos; atEnd = true;
+                return;
+            }
+            pos = recordStart + lineStarts[i] + (pos - lineStart); //the block moved under us
+        }
+        lineLengths[i] = pos - (recordStart + lineStarts[i]);
+        current = pos + 1;
+        
+        //gobble the white space before the next line
+        while (true) {
+            if (current == filled) { if (!fill()) { atEnd = true; break; } }
+            if (isspace((unsigned char)block[current])) { current++; }
+            else { break; }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqBuffer", "readLine");
+        exit(1);
+    }
+}
+/*******************************************************************************/
+//moves the record being read to the front of the block and reads in behind it. Returns false when there is nothing left to read.
+bool FastqBuffer::fill() {
+    try {
+        if (!in) { return false; }
+        
+        if (recordStart != 0) {
+            size_t keep = filled - recordStart;
+            if (keep != 0) { memmove(&block[0], &block[recordStart], keep); }
+            blockPosition += recordStart;
+            current -= recordStart; filled = keep; recordStart = 0;
+        }
+        if (filled == block.size()) { block.resize(block.size() * 2); }
+        
+        in.read(&block[filled], block.size() - filled);
+        size_t numRead = in.gcount();
+        filled += numRead;
+        
+        return (numRead != 0);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FastqBuffer", "fill");
+        exit(1);
+    }
+}
+/*******************************************************************************/
@@ -25,6 +25,35 @@
  
  */
 
+/* Reads a fastq file a block at a time. nextRecord finds the four lines of the next record inside the block and getLine points
+ at them, so nothing is copied until the caller wants it. The pointers are good until the next call to nextRecord. Lines end and
+ white space is skipped the same way as m->getline followed by m->gobble. Works on plain files and the boost gz streams. */
+
+class FastqBuffer {
+public:
+    FastqBuffer(istream&);
+    ~FastqBuffer() {}
+    
+    void nextRecord();
+    const char* getLine(int i) { return &block[recordStart + lineStarts[i]]; }
+    int getLength(int i) { return lineLengths[i]; }
+    bool eof() { return atEnd; }
+    unsigned long long tell() { return blockPosition + current; } //file position of the next record, same as tellg on the stream would give
+    
+private:
+    MothurOut* m;
+    istream& in;
+    vector<char> block;
+    size_t current, filled, recordStart;
+    unsigned long long blockPosition; //file position of block[0]
+    size_t lineStarts[4]; //from recordStart, so they stay right when the record is moved to the front of the block
+    int lineLengths[4];
+    bool atEnd;
+    
+    void readLine(int);
+    bool fill();
+};
+
 class FastqRead {
 public:
     
@@ -43,14 +72,19 @@ public:
     #endif
     ~FastqRead() {}
     
+    //reads the next record into this read, reusing its memory. Loops over large files read into one FastqRead per stream.
+    void read(istream&, bool&, string f);
+    void read(FastqBuffer&, bool&, string f);
+    
     void setFormat(string f) { format = f; }
     string getFormat() { return format; }
     string getName() { return name; }
     void setName(string n) { name = n; }
     string getSeq() { return sequence; }
     void setSeq(string s) { sequence = s; }
-    vector<int> getScores() { return scores; }
-    void setScores(vector<int> s) { scores = s;  }
+    vector<int> getScores() { return vector<int>(scores.begin(), scores.end()); }
+    const vector<unsigned char>& getScoreBytes() { return scores; }
+    void setScores(vector<int> s) { scores.assign(s.begin(), s.end());  }
     void printFastq(ostream&);
     
     Sequence getSequence();
@@ -59,16 +93,18 @@ public:
 
 private:
     MothurOut* m;
-    vector<int> scores;
+    vector<unsigned char> scores; //phred scores fit in a byte
     string name, comment;
     string sequence;
     string scoreString;
     string format;
-    vector<char> convertTable;
-    vector<int> convertBackTable;
+    string line, line2; //name lines are read here, kept between reads
     
     vector<int> convertQual(string qual);
+    void convertQual(const string&, vector<unsigned char>&);
     string convertQual(vector<int>);
+    void readLine(istream&, string&);
+    void checkRecord(bool&);
     
 };
 
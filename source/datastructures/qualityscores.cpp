@@ -37,6 +37,19 @@ QualityScores::QualityScores(string n, vector<int> s){
 	}
 }
 /**************************************************************************************************/
+//scores as stored by FastqRead, widened straight into qScores
+QualityScores::QualityScores(string n, const vector<unsigned char>& s){
+	try {
+		m = MothurOut::getInstance();
+		setName(n);
+        qScores.assign(s.begin(), s.end()); seqLength = qScores.size();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "QualityScores", "QualityScores");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 
 QualityScores::QualityScores(ifstream& qFile){
 	try {
@@ -24,6 +24,7 @@ public:
 	QualityScores();
     ~QualityScores() {}
     QualityScores(string n, vector<int> qs);
+    QualityScores(string n, const vector<unsigned char>& qs);
 	QualityScores(ifstream&);
     #ifdef USE_BOOST
     QualityScores(boost::iostreams::filtering_istream&);
@@ -0,0 +1,338 @@
+//
+//  seqindexfile.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "seqindexfile.h"
+#include <sys/stat.h>
+
+#define SEQ_INDEX_TAG "mthridx2"
+#define SEQ_INDEX_HEADER 40 //tag, file size, modification time, modifynames, number of records
+
+/**************************************************************************************************/
+//orders entries by fingerprint alone, so a name's fingerprint finds every record with that name
+struct fingerprintOrder {
+    bool operator()(const seqIndexEntry& a, const seqIndexEntry& b) const { return ((a.high < b.high) || ((a.high == b.high) && (a.low < b.low))); }
+};
+/**************************************************************************************************/
+SeqIndexFile::SeqIndexFile(string f, string i) {
+    try {
+        m = MothurOut::getInstance();
+        seqFile = m->getFullPathName(f);
+        indexFile = i;
+        numRecords = 0; lastPosition = 0; nextPosition = 0;
+        usePositions = false; building = false;
+
+        memoryBudget = m->getTotalRAM() / 8;
+        if (memoryBudget == 0) { memoryBudget = 536870912; }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "SeqIndexFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//two independent 64 bit hashes of the name, FNV-1a and a multiply-xorshift, each finished with the murmur3 mixer
+seqIndexEntry SeqIndexFile::getFingerprint(string& name) {
+    try {
+        unsigned long long h1 = 14695981039346656037ULL;
+        unsigned long long h2 = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)name.length();
+
+        for (int i = 0; i < name.length(); i++) {
+            unsigned char c = name[i];
+            h1 ^= c; h1 *= 1099511628211ULL;
+            h2 += c; h2 *= 0xff51afd7ed558ccdULL; h2 ^= (h2 >> 32);
+        }
+
+        seqIndexEntry entry;
+        h1 ^= (h1 >> 33); h1 *= 0xff51afd7ed558ccdULL; h1 ^= (h1 >> 33); h1 *= 0xc4ceb9fe1a85ec53ULL; h1 ^= (h1 >> 33);
+        h2 ^= (h2 >> 33); h2 *= 0xff51afd7ed558ccdULL; h2 ^= (h2 >> 33); h2 *= 0xc4ceb9fe1a85ec53ULL; h2 ^= (h2 >> 33);
+        entry.high = h1; entry.low = h2;
+
+        return entry;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "getFingerprint");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//modified is in nanoseconds, so a file rewritten within the same second as its index was made is still caught
+bool SeqIndexFile::getFileStamp(unsigned long long& size, long long& modified) {
+    try {
+        struct stat fileInfo;
+        if (stat(seqFile.c_str(), &fileInfo) != 0) { return false; }
+
+        size = fileInfo.st_size;
+        long long nanoseconds = 0;
+    #if defined (__APPLE__) || (__MACH__)
+        nanoseconds = fileInfo.st_mtimespec.tv_nsec;
+    #elif defined (linux) || (__linux) || (__linux__)
+        nanoseconds = fileInfo.st_mtim.tv_nsec;
+    #endif
+        modified = ((long long)fileInfo.st_mtime * 1000000000LL) + nanoseconds;
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "getFileStamp");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//names are fingerprinted after the readers change them, so an index made with a different modifynames setting is stale
+bool SeqIndexFile::openIndex(ifstream& in) {
+    try {
+        in.open(indexFile.c_str(), ios::binary);
+        if (!in) { return false; }
+
+        char tag[8];
+        unsigned long long size, modifyNames; long long modified;
+
+        in.read(tag, 8);
+        in.read((char*)&size, sizeof(size));
+        in.read((char*)&modified, sizeof(modified));
+        in.read((char*)&modifyNames, sizeof(modifyNames));
+        in.read((char*)&numRecords, sizeof(numRecords));
+        if (!in) { in.close(); return false; }
+
+        unsigned long long fileSize; long long fileModified;
+        bool current = (strncmp(tag, SEQ_INDEX_TAG, 8) == 0) && getFileStamp(fileSize, fileModified);
+        current = current && (size == fileSize) && (modified == fileModified) && (modifyNames == (unsigned long long)m->modifyNames);
+
+        //a partly written index is not current either
+        if (current) {
+            in.seekg(0, ios::end);
+            current = ((unsigned long long)in.tellg() == (SEQ_INDEX_HEADER + numRecords * 3 * sizeof(unsigned long long)));
+        }
+
+        if (!current) { in.close(); numRecords = 0; }
+
+        return current;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "openIndex");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool SeqIndexFile::readEntry(ifstream& in, unsigned long long i, seqIndexEntry& entry) {
+    try {
+        unsigned long long values[3];
+
+        in.seekg(SEQ_INDEX_HEADER + i * sizeof(values));
+        in.read((char*)values, sizeof(values));
+        if (!in) { return false; }
+
+        entry.high = values[0]; entry.low = values[1]; entry.position = values[2];
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "readEntry");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//binary search of the index for each name, used when only a few names are wanted
+bool SeqIndexFile::findNames(ifstream& in, vector<seqIndexEntry>& wanted, unsigned long long limit) {
+    try {
+        fingerprintOrder order;
+        seqIndexEntry entry;
+
+        for (int i = 0; i < wanted.size(); i++) {
+            if (m->control_pressed) { return false; }
+
+            //first record not before the name
+            unsigned long long low = 0; unsigned long long high = numRecords;
+            while (low < high) {
+                unsigned long long mid = low + (high - low) / 2;
+                if (!readEntry(in, mid, entry)) { return false; }
+                if (order(entry, wanted[i])) { low = mid + 1; }
+                else { high = mid; }
+            }
+
+            for (unsigned long long j = low; j < numRecords; j++) {
+                if (!readEntry(in, j, entry)) { return false; }
+                if ((entry.high != wanted[i].high) || (entry.low != wanted[i].low)) { break; }
+                positions.push_back(entry.position);
+            }
+
+            if (positions.size() > limit) { return false; }
+        }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "findNames");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//reads the whole index, which is still a small fraction of the sequence file
+bool SeqIndexFile::scanNames(ifstream& in, vector<seqIndexEntry>& wanted, bool inNames, unsigned long long limit) {
+    try {
+        fingerprintOrder order;
+        seqIndexEntry entry;
+        vector<unsigned long long> block(3 * 65536);
+
+        in.seekg(SEQ_INDEX_HEADER);
+        unsigned long long count = 0;
+        while (count < numRecords) {
+            if (m->control_pressed) { return false; }
+
+            unsigned long long numInBlock = min((unsigned long long)65536, numRecords - count);
+            in.read((char*)&block[0], numInBlock * 3 * sizeof(unsigned long long));
+            if (!in) { return false; }
+
+            for (int i = 0; i < numInBlock; i++) {
+                entry.high = block[i*3]; entry.low = block[i*3+1];
+                if (binary_search(wanted.begin(), wanted.end(), entry, order) == inNames) { positions.push_back(block[i*3+2]); }
+            }
+            count += numInBlock;
+
+            if (positions.size() > limit) { return false; }
+        }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "scanNames");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//positioned reads pay off when a small part of the file is wanted, past a quarter of the records it is read through
+bool SeqIndexFile::select(set<string>& names, bool inNames) {
+    try {
+        positions.clear();
+        if (indexFile == "") { return false; }
+
+        ifstream in;
+        if (!openIndex(in)) { building = true; return false; }
+
+        vector<seqIndexEntry> wanted;
+        for (set<string>::iterator it = names.begin(); it != names.end(); it++) {
+            string name = *it;
+            wanted.push_back(getFingerprint(name));
+        }
+        sort(wanted.begin(), wanted.end(), fingerprintOrder());
+
+        unsigned long long limit = numRecords / 4;
+        bool found = false;
+        if (inNames && ((wanted.size() * 64) < numRecords)) { found = findNames(in, wanted, limit); }
+        else { found = scanNames(in, wanted, inNames, limit); }
+        in.close();
+
+        if (!found) { positions.clear(); return false; }
+
+        //read the records in file order
+        sort(positions.begin(), positions.end());
+        usePositions = true; nextPosition = 0;
+
+        if (m->debug) { m->mothurOut("[DEBUG]: reading " + toString(positions.size()) + " of " + toString(numRecords) + " records using " + indexFile + ".\n"); }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "select");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool SeqIndexFile::nextRecord(ifstream& in) {
+    try {
+        if (usePositions) {
+            if (nextPosition >= positions.size()) { return false; }
+
+            in.clear();
+            in.seekg(positions[nextPosition]);
+            nextPosition++;
+
+            return true;
+        }
+
+        if (in.eof()) { return false; }
+        if (building) { lastPosition = in.tellg(); }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "nextRecord");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//an index that won't fit in the memory budget is not built
+void SeqIndexFile::add(string name) {
+    try {
+        if (!building || (name == "")) { return; }
+
+        seqIndexEntry entry = getFingerprint(name);
+        entry.position = lastPosition;
+        entries.push_back(entry);
+
+        if ((entries.size() * sizeof(seqIndexEntry)) > memoryBudget) {
+            if (m->debug) { m->mothurOut("[DEBUG]: " + seqFile + " has too many sequences to index in memory, not saving an index.\n"); }
+            building = false;
+            vector<seqIndexEntry>().swap(entries);
+        }
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "add");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the file is only a cache, so if it can't be written the command carries on without it
+bool SeqIndexFile::save() {
+    try {
+        if (!building || m->control_pressed) { return false; }
+        building = false;
+
+        unsigned long long size; long long modified;
+        if (!getFileStamp(size, modified)) { vector<seqIndexEntry>().swap(entries); return false; }
+
+        string tempFile = indexFile + ".temp";
+        ofstream out;
+        out.open(tempFile.c_str(), ios::trunc | ios::binary);
+        if (!out) {
+            if (m->debug) { m->mothurOut("[DEBUG]: unable to open " + tempFile + ", not saving an index.\n"); }
+            vector<seqIndexEntry>().swap(entries);
+            return false;
+        }
+
+        sort(entries.begin(), entries.end());
+
+        unsigned long long modifyNames = m->modifyNames;
+        unsigned long long numEntries = entries.size();
+        out.write(SEQ_INDEX_TAG, 8);
+        out.write((char*)&size, sizeof(size));
+        out.write((char*)&modified, sizeof(modified));
+        out.write((char*)&modifyNames, sizeof(modifyNames));
+        out.write((char*)&numEntries, sizeof(numEntries));
+
+        for (int i = 0; i < entries.size(); i++) {
+            unsigned long long values[3];
+            values[0] = entries[i].high; values[1] = entries[i].low; values[2] = entries[i].position;
+            out.write((char*)values, sizeof(values));
+        }
+
+        bool written = out.good();
+        out.close();
+        vector<seqIndexEntry>().swap(entries);
+
+        //only a complete file gets the real name
+        if (written) { m->renameFile(tempFile, indexFile); }
+        else { m->mothurRemove(tempFile); }
+
+        return written;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SeqIndexFile", "save");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
@@ -0,0 +1,68 @@
+#ifndef SEQINDEXFILE_H
+#define SEQINDEXFILE_H
+
+//
+//  seqindexfile.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//binary index of a fasta, qual or fastq file, saved as filename.idx in the output directory when get.seqs or remove.seqs
+//are run with index=t. Each record is the fingerprint of a sequence name and the position of its record in the file,
+//sorted by fingerprint. The header records the size and modification time, to the nanosecond, of the file it was made
+//from, so a stale index is ignored. With a current index the commands seek to the sequences they want instead of
+//reading the whole file. When there is none the file is read as before and the index is built from that read.
+
+struct seqIndexEntry {
+    unsigned long long high, low, position;
+
+    seqIndexEntry() : high(0), low(0), position(0) {}
+    bool operator<(const seqIndexEntry& rhs) const {
+        if (high != rhs.high) { return (high < rhs.high); }
+        if (low != rhs.low) { return (low < rhs.low); }
+        return (position < rhs.position);
+    }
+};
+/**************************************************************************************************/
+
+class SeqIndexFile {
+
+public:
+    SeqIndexFile(string, string); //fasta, qual or fastq file, index file. No index is used or saved if the index file is ""
+    ~SeqIndexFile() {}
+
+    //finds the records whose names are (true) or are not (false) in the set. Returns false if the file should be read
+    //from the start instead, because there is no current index or too much of the file is selected
+    bool select(set<string>&, bool);
+    bool usingIndex() { return usePositions; }
+    unsigned long long getNumRecords() { return numRecords; } //records in the file, when usingIndex
+
+    //positions the file at the next record to read, false when there are none left
+    bool nextRecord(ifstream&);
+    void add(string); //name of the record just read, saved if the index is being built
+    bool save(); //true if a new index file was written
+
+private:
+    MothurOut* m;
+    string seqFile, indexFile;
+    unsigned long long numRecords, memoryBudget, lastPosition;
+    bool usePositions, building;
+    unsigned long long nextPosition;
+
+    vector<unsigned long long> positions;
+    vector<seqIndexEntry> entries; //built while reading the sequence file
+
+    seqIndexEntry getFingerprint(string&);
+    bool getFileStamp(unsigned long long&, long long&);
+    bool openIndex(ifstream&);
+    bool readEntry(ifstream&, unsigned long long, seqIndexEntry&);
+    bool findNames(ifstream&, vector<seqIndexEntry>&, unsigned long long);
+    bool scanNames(ifstream&, vector<seqIndexEntry>&, bool, unsigned long long);
+};
+/**************************************************************************************************/
+
+#endif
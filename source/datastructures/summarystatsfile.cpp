@@ -0,0 +1,190 @@
+//
+//  summarystatsfile.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "summarystatsfile.h"
+#include <sys/stat.h>
+
+#define STATS_FILE_TAG "mthrsum2"
+
+/**************************************************************************************************/
+SummaryStatsFile::SummaryStatsFile(string f, string outputDir) {
+    try {
+        m = MothurOut::getInstance();
+        fastafile = m->getFullPathName(f);
+        statsFile = outputDir + m->getSimpleName(fastafile) + ".sumstats";
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "SummaryStatsFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//modified is in nanoseconds, so a fasta file rewritten within the same second as the stats were saved is still caught
+bool SummaryStatsFile::getFastaStamp(unsigned long long& size, long long& modified) {
+    try {
+        struct stat fileInfo;
+        if (stat(fastafile.c_str(), &fileInfo) != 0) { return false; }
+
+        size = fileInfo.st_size;
+        long long nanoseconds = 0;
+    #if defined (__APPLE__) || (__MACH__)
+        nanoseconds = fileInfo.st_mtimespec.tv_nsec;
+    #elif defined (linux) || (__linux) || (__linux__)
+        nanoseconds = fileInfo.st_mtim.tv_nsec;
+    #endif
+        modified = ((long long)fileInfo.st_mtime * 1000000000LL) + nanoseconds;
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "getFastaStamp");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool SummaryStatsFile::readHeader(ifstream& in) {
+    try {
+        char tag[8];
+        unsigned long long size; long long modified;
+
+        in.read(tag, 8);
+        in.read((char*)&size, sizeof(size));
+        in.read((char*)&modified, sizeof(modified));
+        if (!in) { return false; }
+
+        if (strncmp(tag, STATS_FILE_TAG, 8) != 0) { return false; }
+
+        unsigned long long fastaSize; long long fastaModified;
+        if (!getFastaStamp(fastaSize, fastaModified)) { return false; }
+
+        return ((size == fastaSize) && (modified == fastaModified));
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "readHeader");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool SummaryStatsFile::isCurrent() {
+    try {
+        ifstream in;
+        bool current = openForReading(in);
+        if (current) { in.close(); }
+        return current;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "isCurrent");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool SummaryStatsFile::openForReading(ifstream& in) {
+    try {
+        in.open(statsFile.c_str(), ios::binary);
+        if (!in) { return false; }
+
+        if (!readHeader(in)) { in.close(); return false; }
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "openForReading");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool SummaryStatsFile::readRecord(ifstream& in, seqSummaryStats& stats) {
+    try {
+        int values[7]; //name length, start, end, nbases, ambigs, polymer, numns
+        in.read((char*)values, sizeof(values));
+        if (!in) { return false; }
+
+        stats.name.resize(values[0]);
+        if (values[0] != 0) { in.read(&stats.name[0], values[0]); }
+        if (!in) { return false; }
+
+        stats.start = values[1]; stats.end = values[2]; stats.length = values[3];
+        stats.ambigs = values[4]; stats.homop = values[5]; stats.numNs = values[6];
+
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "readRecord");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the file is only a cache, so if it can't be written the command carries on without it
+bool SummaryStatsFile::openRecordFile(string filename, ofstream& out) {
+    try {
+        out.open(filename.c_str(), ios::trunc | ios::binary);
+        if (!out) {
+            if (m->debug) { m->mothurOut("[DEBUG]: unable to open " + filename + ", not saving summary stats.\n"); }
+            return false;
+        }
+        return true;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "openRecordFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void SummaryStatsFile::writeRecord(ofstream& out, string name, int start, int end, int length, int ambigs, int homop, int numNs) {
+    try {
+        int values[7];
+        values[0] = (int)name.length();
+        values[1] = start; values[2] = end; values[3] = length;
+        values[4] = ambigs; values[5] = homop; values[6] = numNs;
+
+        out.write((char*)values, sizeof(values));
+        out.write(name.c_str(), name.length());
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "writeRecord");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//record files are removed once they are added
+int SummaryStatsFile::combine(vector<string> recordFiles) {
+    try {
+        string tempFile = statsFile + ".temp";
+
+        unsigned long long size; long long modified;
+        bool stamped = getFastaStamp(size, modified);
+
+        ofstream out;
+        if (stamped) { stamped = openRecordFile(tempFile, out); }
+        if (!stamped) {
+            for (int i = 0; i < recordFiles.size(); i++) { m->mothurRemove(recordFiles[i]); }
+            return 1;
+        }
+
+        out.write(STATS_FILE_TAG, 8);
+        out.write((char*)&size, sizeof(size));
+        out.write((char*)&modified, sizeof(modified));
+        out.close();
+
+        for (int i = 0; i < recordFiles.size(); i++) {
+            m->appendBinaryFiles(recordFiles[i], tempFile);
+            m->mothurRemove(recordFiles[i]);
+        }
+
+        if (m->control_pressed) { m->mothurRemove(tempFile); return 1; }
+
+        //only a complete file gets the real name
+        m->renameFile(tempFile, statsFile);
+
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SummaryStatsFile", "combine");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
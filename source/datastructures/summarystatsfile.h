@@ -0,0 +1,53 @@
+#ifndef SUMMARYSTATSFILE_H
+#define SUMMARYSTATSFILE_H
+
+//
+//  summarystatsfile.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//binary file of the per sequence stats summary.seqs calculates, saved as fastafile.sumstats in the output directory
+//when summary.seqs is run with sumstats=t. The header records the size and modification time, to the nanosecond, of the
+//fasta file it was made from, so a stale file is ignored. screen.seqs looks for it in its own output directory to find
+//its optimize values without reading the fasta file an extra time.
+
+struct seqSummaryStats {
+    string name;
+    int start, end, length, ambigs, homop, numNs;
+
+    seqSummaryStats() : name(""), start(0), end(0), length(0), ambigs(0), homop(0), numNs(0) {}
+};
+/**************************************************************************************************/
+
+class SummaryStatsFile {
+
+public:
+    SummaryStatsFile(string, string); //fastafile, outputDir
+    ~SummaryStatsFile() {}
+
+    string getFileName() { return statsFile; }
+    bool isCurrent(); //file exists and matches the fasta file
+
+    //each process writes its records to its own file, combine puts them behind the header in fasta order
+    bool openRecordFile(string, ofstream&);
+    void writeRecord(ofstream&, string, int, int, int, int, int, int); //name, start, end, nbases, ambigs, polymer, numns
+    int combine(vector<string>);
+
+    bool openForReading(ifstream&); //leaves the file positioned at the first record, false if the file is not current
+    bool readRecord(ifstream&, seqSummaryStats&);
+
+private:
+    MothurOut* m;
+    string fastafile, statsFile;
+
+    bool getFastaStamp(unsigned long long&, long long&); //size, modification time
+    bool readHeader(ifstream&);
+};
+/**************************************************************************************************/
+
+#endif
@@ -18,6 +18,7 @@ Tree::Tree(int num, CountTable* t) : ct(t) {
 		numNodes = 2*numLeaves - 1;
         
 		tree.resize(numNodes);
+		setGroupNames();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Tree", "Tree - numNodes");
@@ -48,8 +49,8 @@ Tree::Tree(CountTable* t) : ct(t) {
 		tree.resize(numNodes);
 			
 		//initialize groupNodeInfo
-        vector<string> namesOfGroups = ct->getNamesOfGroups();
-		for (int i = 0; i < namesOfGroups.size(); i++) {  groupNodeInfo[namesOfGroups[i]].resize(0);  }
+		setGroupNames();
+		for (int i = 0; i < groupNames.size(); i++) {  groupNodeInfo[groupNames[i]].resize(0);  }
 		
 		//initialize tree with correct number of nodes, name and group info.
 		for (int i = 0; i < numNodes; i++) {
@@ -58,40 +59,13 @@ Tree::Tree(CountTable* t) : ct(t) {
 				tree[i].setName(m->Treenames[i]);
 				
 				//save group info
-                int maxPars = 1;
-				vector<string> group;
                 vector<int> counts = ct->getGroupCounts(m->Treenames[i]);
-				for (int j = 0; j < namesOfGroups.size(); j++) {  
-                    if (counts[j] != 0) { //you have seqs from this group
-                        groupNodeInfo[namesOfGroups[j]].push_back(i);
-                        group.push_back(namesOfGroups[j]);
-                        tree[i].pGroups[namesOfGroups[j]] = counts[j];
-                        tree[i].pcount[namesOfGroups[j]] = counts[j];
-                        //keep highest group
-						if(counts[j] > maxPars){ maxPars = counts[j]; }
-                    }  
-                }
-				tree[i].setGroup(group);
+				setLeafGroups(i, counts);
 				setIndex(m->Treenames[i], i);
                 
-                if (maxPars > 1) { //then we have some more dominant groups
-					//erase all the groups that are less than maxPars because you found a more dominant group.
-					for(it=tree[i].pGroups.begin();it!=tree[i].pGroups.end();){
-						if(it->second < maxPars){
-							tree[i].pGroups.erase(it++);
-						}else { it++; }
-					}
-					//set one remaining groups to 1
-					for(it=tree[i].pGroups.begin();it!=tree[i].pGroups.end();it++){
-						tree[i].pGroups[it->first] = 1;
-					}
-				}//end if
-                
 			//intialize non leaf nodes
 			}else if (i > (numLeaves-1)) {
 				tree[i].setName("");
-				vector<string> tempGroups;
-				tree[i].setGroup(tempGroups);
 			}
 		}
 		
@@ -102,6 +76,25 @@ Tree::Tree(CountTable* t) : ct(t) {
 	}
 }
 /*****************************************************************/
+Tree::Tree(const Tree& copy) : ct(copy.ct) {
+	try {
+		m = MothurOut::getInstance();
+		
+		numLeaves = copy.numLeaves;
+		numNodes = copy.numNodes;
+		
+		tree = copy.tree;
+		groupNodeInfo = copy.groupNodeInfo;
+		indexes = copy.indexes;
+		groupNames = copy.groupNames;
+		groupIndexes = copy.groupIndexes;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Tree", "Tree - copy");
+		exit(1);
+	}
+}
+/*****************************************************************/
 Tree::Tree(CountTable* t, vector< vector<double> >& sims) : ct(t) {
 	try {
 		m = MothurOut::getInstance();
@@ -113,8 +106,8 @@ Tree::Tree(CountTable* t, vector< vector<double> >& sims) : ct(t) {
 		tree.resize(numNodes);
         
 		//initialize groupNodeInfo
-        vector<string> namesOfGroups = ct->getNamesOfGroups();
-		for (int i = 0; i < namesOfGroups.size(); i++) {  groupNodeInfo[namesOfGroups[i]].resize(0);  }
+		setGroupNames();
+		for (int i = 0; i < groupNames.size(); i++) {  groupNodeInfo[groupNames[i]].resize(0);  }
 		
 		//initialize tree with correct number of nodes, name and group info.
 		for (int i = 0; i < numNodes; i++) {
@@ -123,40 +116,13 @@ Tree::Tree(CountTable* t, vector< vector<double> >& sims) : ct(t) {
 				tree[i].setName(m->Treenames[i]);
 				
 				//save group info
-                int maxPars = 1;
-				vector<string> group;
                 vector<int> counts = ct->getGroupCounts(m->Treenames[i]);
-				for (int j = 0; j < namesOfGroups.size(); j++) {  
-                    if (counts[j] != 0) { //you have seqs from this group
-                        groupNodeInfo[namesOfGroups[j]].push_back(i);
-                        group.push_back(namesOfGroups[j]);
-                        tree[i].pGroups[namesOfGroups[j]] = counts[j];
-                        tree[i].pcount[namesOfGroups[j]] = counts[j];
-                        //keep highest group
-						if(counts[j] > maxPars){ maxPars = counts[j]; }
-                    }  
-                }
-				tree[i].setGroup(group);
+				setLeafGroups(i, counts);
 				setIndex(m->Treenames[i], i);
                 
-                if (maxPars > 1) { //then we have some more dominant groups
-					//erase all the groups that are less than maxPars because you found a more dominant group.
-					for(it=tree[i].pGroups.begin();it!=tree[i].pGroups.end();){
-						if(it->second < maxPars){
-							tree[i].pGroups.erase(it++);
-						}else { it++; }
-					}
-					//set one remaining groups to 1
-					for(it=tree[i].pGroups.begin();it!=tree[i].pGroups.end();it++){
-						tree[i].pGroups[it->first] = 1;
-					}
-				}//end if
-                
                 //intialize non leaf nodes
 			}else if (i > (numLeaves-1)) {
 				tree[i].setName("");
-				vector<string> tempGroups;
-				tree[i].setGroup(tempGroups);
 			}
 		}
 
@@ -358,6 +324,90 @@ void Tree::setIndex(string searchName, int index) {
 	}
 }
 /*****************************************************************/
+//the nodes refer to the groups by their index in the count table's group names, which are sorted
+void Tree::setGroupNames() {
+	try {
+		groupNames = ct->getNamesOfGroups();
+		groupIndexes.clear();
+		for (int i = 0; i < groupNames.size(); i++) { groupIndexes[groupNames[i]] = i; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Tree", "setGroupNames");
+		exit(1);
+	}
+}
+/*****************************************************************/
+int Tree::getGroupIndex(string groupName) {
+	try {
+		map<string, int>::iterator itGroup = groupIndexes.find(groupName);
+		if (itGroup != groupIndexes.end()) { return itGroup->second; }
+		return -1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Tree", "getGroupIndex");
+		exit(1);
+	}
+}
+/*****************************************************************/
+//names of the groups a leaf has seqs from, the non leaf nodes have none
+vector<string> Tree::getGroups(int node) {
+	try {
+		vector<string> groups;
+		if (node < numLeaves) {
+			for (int j = 0; j < tree[node].pcount.size(); j++) { groups.push_back(groupNames[tree[node].pcount[j].first]); }
+		}
+		return groups;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Tree", "getGroups");
+		exit(1);
+	}
+}
+/*****************************************************************/
+int Tree::getPcount(int node, string groupName) {
+	try {
+		int group = getGroupIndex(groupName);
+		if (group == -1) { return 0; }
+		return tree[node].getPcount(group);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Tree", "getPcount");
+		exit(1);
+	}
+}
+/*****************************************************************/
+//counts are in the order of the count table's groups
+void Tree::setLeafGroups(int i, vector<int>& counts) {
+	try {
+		tree[i].pGroups.clear(); tree[i].pcount.clear();
+		
+		int maxPars = 1;
+		for (int j = 0; j < counts.size(); j++) {
+			if (counts[j] != 0) { //you have seqs from this group
+				groupNodeInfo[groupNames[j]].push_back(i);
+				tree[i].pGroups.push_back(make_pair(j, counts[j]));
+				tree[i].pcount.push_back(make_pair(j, counts[j]));
+				//keep highest group
+				if(counts[j] > maxPars){ maxPars = counts[j]; }
+			}
+		}
+		
+		if (maxPars > 1) { //then we have some more dominant groups
+			//erase all the groups that are less than maxPars because you found a more dominant group.
+			//set the remaining groups to 1
+			int numKept = 0;
+			for (int j = 0; j < tree[i].pGroups.size(); j++) {
+				if (tree[i].pGroups[j].second == maxPars) { tree[i].pGroups[numKept] = make_pair(tree[i].pGroups[j].first, 1); numKept++; }
+			}
+			tree[i].pGroups.resize(numKept);
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Tree", "setLeafGroups");
+		exit(1);
+	}
+}
+/*****************************************************************/
 int Tree::assembleTree() {
 	try {		
 		//build the pGroups in non leaf nodes to be used in the parsimony calcs.
@@ -388,8 +438,8 @@ void Tree::getSubTree(Tree* Ctree, vector<string> Groups) {
 		//we want to select some of the leaf nodes to create the output tree
 		//go through the input Tree starting at parents of leaves
         //initialize groupNodeInfo
-        vector<string> namesOfGroups = ct->getNamesOfGroups();
-		for (int i = 0; i < namesOfGroups.size(); i++) {  groupNodeInfo[namesOfGroups[i]].resize(0);  }
+		setGroupNames();
+		for (int i = 0; i < groupNames.size(); i++) {  groupNodeInfo[groupNames[i]].resize(0);  }
 		
 		//initialize tree with correct number of nodes, name and group info.
 		for (int i = 0; i < numNodes; i++) {
@@ -398,40 +448,13 @@ void Tree::getSubTree(Tree* Ctree, vector<string> Groups) {
 				tree[i].setName(Groups[i]);
 				
 				//save group info
-                int maxPars = 1;
-				vector<string> group;
                 vector<int> counts = ct->getGroupCounts(Groups[i]);
-				for (int j = 0; j < namesOfGroups.size(); j++) {  
-                    if (counts[j] != 0) { //you have seqs from this group
-                        groupNodeInfo[namesOfGroups[j]].push_back(i);
-                        group.push_back(namesOfGroups[j]);
-                        tree[i].pGroups[namesOfGroups[j]] = counts[j];
-                        tree[i].pcount[namesOfGroups[j]] = counts[j];
-                        //keep highest group
-						if(counts[j] > maxPars){ maxPars = counts[j]; }
-                    }  
-                }
-				tree[i].setGroup(group);
+				setLeafGroups(i, counts);
 				setIndex(Groups[i], i);
                 
-                if (maxPars > 1) { //then we have some more dominant groups
-					//erase all the groups that are less than maxPars because you found a more dominant group.
-					for(it=tree[i].pGroups.begin();it!=tree[i].pGroups.end();){
-						if(it->second < maxPars){
-							tree[i].pGroups.erase(it++);
-						}else { it++; }
-					}
-					//set one remaining groups to 1
-					for(it=tree[i].pGroups.begin();it!=tree[i].pGroups.end();it++){
-						tree[i].pGroups[it->first] = 1;
-					}
-				}//end if
-                
                 //intialize non leaf nodes
 			}else if (i > (numLeaves-1)) {
 				tree[i].setName("");
-				vector<string> tempGroups;
-				tree[i].setGroup(tempGroups);
 			}
 		}
 
@@ -651,9 +674,6 @@ void Tree::getCopy(Tree* copy) {
 		for (int i = 0; i < numNodes; i++) {
 			//copy name
 			tree[i].setName(copy->tree[i].getName());
-		
-			//copy group
-			tree[i].setGroup(copy->tree[i].getGroup());
 			
 			//copy branch length
 			tree[i].setBranchLength(copy->tree[i].getBranchLength());
@@ -677,6 +697,10 @@ void Tree::getCopy(Tree* copy) {
 		
 		groupNodeInfo = copy->groupNodeInfo;
 		
+		//the copied group info refers to the copy's group names
+		groupNames = copy->groupNames;
+		groupIndexes = copy->groupIndexes;
+		
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Tree", "getCopy");
@@ -689,44 +713,43 @@ void Tree::getCopy(Tree* copy) {
 // p[white] = 1 and p[black] = 1.  Now go up a level and merge that with a node who has p[white] = 1
 //and you get p[white] = 2, p[black] = 1, but you erase the p[black] because you have a p value higher than 1.
 
-map<string, int> Tree::mergeGroups(int i) {
+vector< pair<int, int> > Tree::mergeGroups(int i) {
 	try {
 		int lc = tree[i].getLChild();
 		int rc = tree[i].getRChild();
 
-		//set parsimony groups to left child
-		map<string,int> parsimony = tree[lc].pGroups;
+		//both children's groups are in order, so they are merged in one pass and each group is added at the end.
+		//groups of the right child add 1 to the left child's count and update maxPars.
+		vector< pair<int, int> >& left = tree[lc].pGroups;
+		vector< pair<int, int> >& right = tree[rc].pGroups;
+		vector< pair<int, int> > parsimony; parsimony.reserve(left.size() + right.size());
 		
 		int maxPars = 1;
-
-		//look at right child groups and update maxPars if right child has something higher for that group.
-		for(it=tree[rc].pGroups.begin();it!=tree[rc].pGroups.end();it++){
-			it2 = parsimony.find(it->first);
-			if (it2 != parsimony.end()) {
-				parsimony[it->first]++;
+		
+		int l = 0; int r = 0;
+		while ((l < left.size()) || (r < right.size())) {
+			if ((r == right.size()) || ((l < left.size()) && (left[l].first < right[r].first))) {
+				parsimony.push_back(left[l]); l++;
+			}else if ((l == left.size()) || (right[r].first < left[l].first)) {
+				parsimony.push_back(make_pair(right[r].first, 1)); r++;
 			}else {
-				parsimony[it->first] = 1;
-			}
-			
-			if(parsimony[it->first] > maxPars){
-				maxPars = parsimony[it->first];
+				int count = left[l].second + 1;
+				parsimony.push_back(make_pair(left[l].first, count));
+				if(count > maxPars){ maxPars = count; }
+				l++; r++;
 			}
 		}
 	
 		// this is true if right child had a greater parsimony for a certain group
 		if(maxPars > 1){
 			//erase all the groups that are only 1 because you found something with 2.
-			for(it=parsimony.begin();it!=parsimony.end();){
-				if(it->second == 1){
-					parsimony.erase(it++);
-				}else { it++; }
-			}
-			//set one remaining groups to 1
+			//set the remaining groups to 1
 			//so with our above example p[white] = 2 would be left and it would become p[white] = 1
-			for(it=parsimony.begin();it!=parsimony.end();it++){
-				parsimony[it->first] = 1;
+			int numKept = 0;
+			for (int j = 0; j < parsimony.size(); j++) {
+				if (parsimony[j].second != 1) { parsimony[numKept] = make_pair(parsimony[j].first, 1); numKept++; }
 			}
-		
+			parsimony.resize(numKept);
 		}
 	
 		return parsimony;
@@ -742,60 +765,25 @@ map<string, int> Tree::mergeGroups(int i) {
 // p[white] = 1 and p[black] = 1.  Now go up a level and merge that with a node who has p[white] = 1
 //and you get p[white] = 2, p[black] = 1, but you erase the p[black] because you have a p value higher than 1.
 
-map<string, int> Tree::mergeUserGroups(int i, vector<string> g) {
+vector< pair<int, int> > Tree::mergeUserGroups(int i, vector<string> g) {
 	try {
 	
 		int lc = tree[i].getLChild();
 		int rc = tree[i].getRChild();
 		
 		//loop through nodes groups removing the ones the user doesn't want
-		for(it=tree[lc].pGroups.begin();it!=tree[lc].pGroups.end();){
-				if (m->inUsersGroups(it->first, g) != true) {
-					tree[lc].pGroups.erase(it++);
-				}else { it++; }
-		}
-
-		//loop through nodes groups removing the ones the user doesn't want
-		for(it=tree[rc].pGroups.begin();it!=tree[rc].pGroups.end();){
-				if (m->inUsersGroups(it->first, g) != true) {
-					tree[rc].pGroups.erase(it++);
-				}else { it++; }
-		}
-
-		//set parsimony groups to left child
-		map<string,int> parsimony = tree[lc].pGroups;
-		
-		int maxPars = 1;
-
-		//look at right child groups and update maxPars if right child has something higher for that group.
-		for(it=tree[rc].pGroups.begin();it!=tree[rc].pGroups.end();it++){
-			it2 = parsimony.find(it->first);
-			if (it2 != parsimony.end()) {
-				parsimony[it->first]++;
-			}else {
-				parsimony[it->first] = 1;
-			}
-			
-			if(parsimony[it->first] > maxPars){
-				maxPars = parsimony[it->first];
+		int children[2] = { lc, rc };
+		for (int c = 0; c < 2; c++) {
+			vector< pair<int, int> >& groups = tree[children[c]].pGroups;
+			int numKept = 0;
+			for (int j = 0; j < groups.size(); j++) {
+				if (m->inUsersGroups(groupNames[groups[j].first], g)) { groups[numKept] = groups[j]; numKept++; }
 			}
+			groups.resize(numKept);
 		}
-			
-		// this is true if right child had a greater parsimony for a certain group
-		if(maxPars > 1){
-			//erase all the groups that are only 1 because you found something with 2.
-			for(it=parsimony.begin();it!=parsimony.end();){
-				if(it->second == 1){
-					parsimony.erase(it++);
-				}else { it++; }
-			}
-
-			for(it=parsimony.begin();it!=parsimony.end();it++){
-				parsimony[it->first] = 1;
-			}
-		}		
 		
-		return parsimony;
+		//the rest is the same as merging all the groups
+		return mergeGroups(i);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Tree", "mergeUserGroups");
@@ -806,17 +794,25 @@ map<string, int> Tree::mergeUserGroups(int i, vector<string> g) {
 
 /**************************************************************************************************/
 
-map<string,int> Tree::mergeGcounts(int position) {
+vector< pair<int, int> > Tree::mergeGcounts(int position) {
 	try{
-		map<string,int>::iterator pos;
-	
 		int lc = tree[position].getLChild();
 		int rc = tree[position].getRChild();
 	
-		map<string,int> sum = tree[lc].pcount;
+		//merged in one pass like mergeGroups
+		vector< pair<int, int> >& left = tree[lc].pcount;
+		vector< pair<int, int> >& right = tree[rc].pcount;
+		vector< pair<int, int> > sum; sum.reserve(left.size() + right.size());
     
-		for(it=tree[rc].pcount.begin();it!=tree[rc].pcount.end();it++){
-			sum[it->first] += it->second;
+		int l = 0; int r = 0;
+		while ((l < left.size()) || (r < right.size())) {
+			if ((r == right.size()) || ((l < left.size()) && (left[l].first < right[r].first))) {
+				sum.push_back(left[l]); l++;
+			}else if ((l == left.size()) || (right[r].first < left[l].first)) {
+				sum.push_back(right[r]); r++;
+			}else {
+				sum.push_back(make_pair(left[l].first, left[l].second + right[r].second)); l++; r++;
+			}
 		}
 		return sum;
 	}
@@ -843,30 +839,22 @@ void Tree::randomLabels(vector<string> g) {
 			//if either of the leaf nodes you are about to switch are not in the users groups then you don't want to switch them.
 			bool treez, treei;
 		
-			treez = m->inUsersGroups(tree[z].getGroup(), g);
-			treei = m->inUsersGroups(tree[i].getGroup(), g);
+			treez = m->inUsersGroups(getGroups(z), g);
+			treei = m->inUsersGroups(getGroups(i), g);
 			
 			if ((treez == true) && (treei == true)) {
 				//switches node i and node z's info.
-				map<string,int> lib_hold = tree[z].pGroups;
-				tree[z].pGroups = (tree[i].pGroups);
-				tree[i].pGroups = (lib_hold);
-				
-				vector<string> zgroup = tree[z].getGroup();
-				tree[z].setGroup(tree[i].getGroup());
-				tree[i].setGroup(zgroup);
+				tree[z].pGroups.swap(tree[i].pGroups);
 				
 				string zname = tree[z].getName();
 				tree[z].setName(tree[i].getName());
 				tree[i].setName(zname);
 				
-				map<string,int> gcount_hold = tree[z].pcount;
-				tree[z].pcount = (tree[i].pcount);
-				tree[i].pcount = (gcount_hold);
+				tree[z].pcount.swap(tree[i].pcount);
 			}
 			
-			for (int k = 0; k < (tree[i].getGroup()).size(); k++) {  groupNodeInfo[(tree[i].getGroup())[k]].push_back(i); }
-			for (int k = 0; k < (tree[z].getGroup()).size(); k++) {  groupNodeInfo[(tree[z].getGroup())[k]].push_back(z); }
+			for (int k = 0; k < tree[i].pcount.size(); k++) {  groupNodeInfo[groupNames[tree[i].pcount[k].first]].push_back(i); }
+			for (int k = 0; k < tree[z].pcount.size(); k++) {  groupNodeInfo[groupNames[tree[z].pcount[k].first]].push_back(z); }
 		}
 	}
 	catch(exception& e) {
@@ -918,27 +906,25 @@ void Tree::randomTopology() {
 		for(int i=numLeaves;i<numNodes;i++){
 			tree[i].setChildren(-1, -1); 
 		}
+		
+		//nodes without a parent, so each join picks its children from them directly instead of drawing until it finds one
+		vector<int> orphans; orphans.reserve(numLeaves);
+		for(int i=0;i<numLeaves;i++){ orphans.push_back(i); }
     
 		for(int i=numLeaves;i<numNodes;i++){
-			int escape =0;
-			int rnd_index1, rnd_index2;
-			while(escape == 0){
-				rnd_index1 = (int)(((double)rand() / (double) RAND_MAX)*i);
-				if(tree[rnd_index1].getParent() == -1){escape = 1;}
-			}
+			int pick = (int)(((double)rand() / ((double)RAND_MAX + 1.0)) * orphans.size());
+			int rnd_index1 = orphans[pick];
+			orphans[pick] = orphans.back(); orphans.pop_back();
 		
-			escape = 0;
-			while(escape == 0){
-				rnd_index2 = (int)(((double)rand() / (double) RAND_MAX)*i);
-				if(rnd_index2 != rnd_index1 && tree[rnd_index2].getParent() == -1){
-					escape = 1;
-				}		
-			}
+			pick = (int)(((double)rand() / ((double)RAND_MAX + 1.0)) * orphans.size());
+			int rnd_index2 = orphans[pick];
+			orphans[pick] = orphans.back(); orphans.pop_back();
 	
 			tree[i].setChildren(rnd_index1,rnd_index2);
 			tree[i].setParent(-1);
 			tree[rnd_index1].setParent(i);
 			tree[rnd_index2].setParent(i);
+			orphans.push_back(i);
 		}
 	}
 	catch(exception& e) {
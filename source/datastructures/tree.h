@@ -19,6 +19,7 @@ public:
 	Tree(string);  //do not use tree generated by this constructor its just to extract the treenames, its a chicken before the egg thing that needs to be revisited.
 	Tree(int, CountTable*); 
 	Tree(CountTable*);		//to generate a tree from a file
+	Tree(const Tree&);		//copies the nodes and group info, used to start each tree in a file from the same leaves
     Tree(CountTable*, vector< vector<double> >&); //create tree from sim matrix
 	~Tree();
 	
@@ -29,6 +30,7 @@ public:
     //int getSubTree(Tree* originalToCopy, vector<string> seqToInclude, map<string, string> nameMap);  //used with (int, TreeMap) constructor. SeqsToInclude contains subsample wanted - assumes these are unique seqs and size of vector=numLeaves passed into constructor. nameMap is unique -> redundantList can be empty if no namesfile was provided. 
     
 	void assembleRandomTree();
+	void randomTopology();  //random relationships between nodes without merging the groups of the non leaf nodes, for calculators that only use the leaves groups
 	void assembleRandomUnifracTree(vector<string>);
 	void assembleRandomUnifracTree(string, string);
     
@@ -37,7 +39,14 @@ public:
 	void setIndex(string, int);
 	int getNumNodes() { return numNodes; }
 	int getNumLeaves(){	return numLeaves; }
-	map<string, int> mergeUserGroups(int, vector<string>);  //returns a map with a groupname and the number of times that group was seen in the children
+	vector< pair<int, int> > mergeUserGroups(int, vector<string>);  //returns the groups and the number of times each group was seen in the children
+	
+	//the nodes keep their groups by index, these convert for code that uses the group names
+	int getGroupIndex(string);  //-1 if the tree has no seqs from the group
+	string getGroupName(int i) { return groupNames[i]; }
+	int getNumGroups() { return groupNames.size(); }
+	vector<string> getGroups(int);  //groups of a leaf node
+	int getPcount(int, string);  //number of the nodes descendants from the group
 	void printTree();
 	void print(ostream&);
 	void print(ostream&, string);
@@ -57,13 +66,15 @@ private:
 	string filename;
 	
     //map<string, string> names;
-	map<string, int>::iterator it, it2;
-	map<string, int> mergeGroups(int);  //returns a map with a groupname and the number of times that group was seen in the children
-	map<string,int> mergeGcounts(int);
+	vector< pair<int, int> > mergeGroups(int);  //returns the groups and the number of times each group was seen in the children
+	vector< pair<int, int> > mergeGcounts(int);
     map<string, int> indexes; //maps seqName -> index in tree vector
+	vector<string> groupNames; //the count table's groups, the nodes group info refers to them by index
+	map<string, int> groupIndexes; //maps groupName -> index in groupNames
 	
+	void setGroupNames();
+	void setLeafGroups(int, vector<int>&);	
 	void addNamesToCounts(map<string, string>);
-	void randomTopology();
 	void randomBlengths();
 	void randomLabels(vector<string>);
 	//void randomLabels(string, string);
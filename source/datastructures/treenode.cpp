@@ -26,8 +26,6 @@ Node::Node() {
 /****************************************************************/
 void Node::setName(string Name) {  name = Name; }
 /****************************************************************/
-void Node::setGroup(vector<string> groups)  { group =groups; }
-/****************************************************************/
 void Node::setBranchLength(float l) { branchLength = l; }
 /****************************************************************/
 void Node::setLabel(string l) { label = l; }
@@ -42,8 +40,6 @@ void Node::setChildren(int lc, int rc) { lchild = lc; rchild = rc; }	//leftchild
 /****************************************************************/
 string Node::getName() { return name; }
 /****************************************************************/
-vector<string> Node::getGroup() { return group; }
-/****************************************************************/
 float Node::getBranchLength() { return branchLength; }
 /****************************************************************/
 string Node::getLabel() { return label; }
@@ -88,4 +84,25 @@ void Node::printNode() {
 		exit(1);
 	}
 }
-/****************************************************************/	
+/****************************************************************/
+//position of the group in the group info, -1 if it is not there
+int Node::findGroup(vector< pair<int, int> >& groups, int group) {
+	int low = 0; int high = groups.size();
+	while (low < high) {
+		int mid = (low + high) / 2;
+		if (groups[mid].first < group) { low = mid + 1; }
+		else { high = mid; }
+	}
+	
+	if ((low < groups.size()) && (groups[low].first == group)) { return low; }
+	return -1;
+}
+/****************************************************************/
+int Node::getPcount(int group) {
+	int index = findGroup(pcount, group);
+	if (index == -1) { return 0; }
+	return pcount[index].second;
+}
+/****************************************************************/
+bool Node::inPGroups(int group) { return (findGroup(pGroups, group) != -1); }
+/****************************************************************/
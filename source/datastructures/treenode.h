@@ -22,7 +22,6 @@ class Node  {
 		~Node() { pGroups.clear(); pcount.clear(); };
 		
 		void setName(string);
-		void setGroup(vector<string>);  
 		void setBranchLength(float);
 		void setLabel(string);
 		void setParent(int);
@@ -31,7 +30,6 @@ class Node  {
 		void setLengthToLeaves(float);
 		
 		string getName();
-		vector<string> getGroup();  
 		float getBranchLength();
 		float getLengthToLeaves();
 		string getLabel();
@@ -40,6 +38,8 @@ class Node  {
 		int getRChild();
 		int getIndex();
 		void printNode();   //prints out the name and the branch length
+		int getPcount(int);  //number of the nodes descendants from the group, 0 if it has none
+		bool inPGroups(int);  //is the group one of the nodes parsimony groups
 		
 		
 		//pGroup is the parsimony group info.  i.e. for a leaf node it would contain 1 enter pGroup["groupname"] = 1;
@@ -47,19 +47,22 @@ class Node  {
 		//would have at least two entries pgroup["groupnameOfLeftChild"] = 1, pgroup["groupnameOfRightChild"] = 1.
 		//pCount is the nodes descendant group infomation.  i.e. pCount["black"] = 20 would mean that 20 of the nodes 
 		//descendant are from group black.
+		//The groups are stored by their index in the trees group names, Tree::getGroupIndex and Tree::getGroupName
+		//convert, and each vector is in group order. A leaf's groups are the groups in its pcount.
 
-		map<string, int> pGroups; //leaf nodes will only have 1 group, but branch nodes may have multiple groups.
-		map<string, int> pcount;	
+		vector< pair<int, int> > pGroups; //leaf nodes will only have 1 group, but branch nodes may have multiple groups.
+		vector< pair<int, int> > pcount;	
 			
 	private:
 		string			name, label;
-		vector<string>	group; 
 		float			branchLength, length2leaf;
 		int				parent;
 		int				lchild;
 		int				rchild;
 		int				vectorIndex;
 		MothurOut* m;
+		
+		int findGroup(vector< pair<int, int> >&, int);
 };		
 
 #endif
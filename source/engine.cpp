@@ -19,6 +19,7 @@ Engine::Engine(){
 	try {
 		cFactory = CommandFactory::getInstance();
 		mout = MothurOut::getInstance();
+        profiler = Profiler::getInstance();
 	}
 	catch(exception& e) {
 		mout->errorOut(e, "Engine", "Engine");
@@ -98,7 +99,11 @@ bool InteractEngine::getInput(){
 							
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
-					else { quitCommandCalled = command->execute(); }
+					else {
+                        profiler->startCommand(commandName);
+                        quitCommandCalled = command->execute();
+                        profiler->endCommand(quitCommandCalled);
+                    }
 							
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -253,7 +258,11 @@ bool BatchEngine::getInput(){
 							
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
-					else { quitCommandCalled = command->execute(); }
+					else {
+                        profiler->startCommand(commandName);
+                        quitCommandCalled = command->execute();
+                        profiler->endCommand(quitCommandCalled);
+                    }
 							
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -387,7 +396,11 @@ bool ScriptEngine::getInput(){
 
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
-					else { quitCommandCalled = command->execute(); }
+					else {
+                        profiler->startCommand(commandName);
+                        quitCommandCalled = command->execute();
+                        profiler->endCommand(quitCommandCalled);
+                    }
 					
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
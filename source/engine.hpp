@@ -17,6 +17,7 @@
 #include "command.hpp"
 #include "commandfactory.hpp"
 #include "mothurout.h"
+#include "profiler.h"
 
 class Engine {
 public:
@@ -33,6 +34,7 @@ protected:
 	vector<string> options;
 	CommandFactory* cFactory;
 	MothurOut* mout;
+	Profiler* profiler;
 };
 
 
@@ -1324,6 +1324,85 @@ double LinearAlgebra::calcKruskalWallis(vector<spearmanRank>& values, double& pV
 	}
 }
 /*********************************************************************************************************************************/
+//sorts positions by the value at that position
+struct kruskalWallisOrder {
+    vector<float>* scores;
+    kruskalWallisOrder(vector<float>* s) : scores(s) {}
+    bool operator()(int a, int b) const { return ((*scores)[a] < (*scores)[b]); }
+};
+/*********************************************************************************************************************************/
+//same test as above with the treatments given as indexes, so no strings are copied or looked up for each value
+double LinearAlgebra::calcKruskalWallis(vector<double>& values, vector<int>& treatmentIndex, int numTreatments, double& pValue){
+	try {
+        double H;
+        size_t numValues = values.size();
+        
+        //ranks are held as floats, like the spearmanRank scores
+        vector<float> scores; scores.resize(numValues);
+        vector<int> order; order.resize(numValues);
+        for (int j = 0; j < numValues; j++) { scores[j] = values[j]; order[j] = j; }
+        
+        //rank values
+        sort(order.begin(), order.end(), kruskalWallisOrder(&scores));
+        vector<float> ranks; ranks.resize(numValues);
+        int rankTotal = 0;
+        int tieStart = 0;
+        vector<int> TIES;
+        for (int j = 0; j < numValues; j++) {
+            rankTotal += (j+1);
+            
+            if ((j == numValues-1) || (scores[order[j]] != scores[order[j+1]])) { // you are done with ties, rank them and continue
+                int numTies = j - tieStart + 1;
+                if (numTies > 1) { TIES.push_back(numTies); }
+                double thisrank = rankTotal / (double) numTies;
+                for (int k = tieStart; k <= j; k++) { ranks[k] = thisrank; }
+                tieStart = j+1;
+                rankTotal = 0;
+            }
+        }
+        
+        // H = 12/(N*(N+1)) * (sum Ti^2/n) - 3(N+1)
+        vector<double> sums; sums.resize(numTreatments, 0.0);
+        vector<double> counts; counts.resize(numTreatments, 0.0);
+        for (int j = 0; j < numValues; j++) {
+            sums[treatmentIndex[order[j]]] += ranks[j];
+            counts[treatmentIndex[order[j]]] += 1.0;
+        }
+        
+        size_t numPresent = 0;
+        double middleTerm = 0.0;
+        for (int i = 0; i < numTreatments; i++) {
+            if (counts[i] == 0) { continue; } //treatment not represented
+            middleTerm += ((sums[i]*sums[i])/counts[i]);
+            numPresent++;
+        }
+        
+        double firstTerm = 12 / (double) (numValues*(numValues+1));
+        double lastTerm = 3 * (numValues+1);
+        
+        H = firstTerm * middleTerm - lastTerm;
+       
+        //adjust for ties
+        if (TIES.size() != 0) {
+            double sum = 0.0;
+            for (int j = 0; j < TIES.size(); j++) { sum += ((TIES[j]*TIES[j]*TIES[j])-TIES[j]); }
+            double result = 1.0 - (sum / (double) ((numValues*numValues*numValues)-numValues));
+            H /= result;
+        }
+        
+        if (isnan(H) || isinf(H)) { H = 0; }
+        
+        //Numerical Recipes pg221
+        pValue = 1.0 - (gammp(((numPresent-1)/(double)2.0), H/2.0));
+        
+        return H;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "LinearAlgebra", "calcKruskalWallis");
+		exit(1);
+	}
+}
+/*********************************************************************************************************************************/
 double LinearAlgebra::normalvariate(double mean, double standardDeviation) {
     try {
         double u1 = ((double)(rand()) + 1.0 )/( (double)(RAND_MAX) + 1.0);
@@ -2124,16 +2203,10 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
             stdF1[i] = sqrt(stdF1[i]);
         }
         
-        vector< vector<double> > scaling; //[numOTUS][numOTUS]
-        for (int i = 0; i < numOtus; i++) {
-            vector<double> temp;
-            for (int j = 0; j < numOtus; j++) {
-                if (i == j) { temp.push_back(1.0/stdF1[i]); }
-                else { temp.push_back(0.0); }
-                
-            }
-            scaling.push_back(temp);
-        }
+        //scaling is the diagonal matrix [numOTUS][numOTUS] of 1/stdF1, so only the diagonal is stored and the products with it below are done a row at a time
+        vector<double> diagScaling; diagScaling.resize(numOtus);
+        for (int i = 0; i < numOtus; i++) { diagScaling[i] = 1.0/stdF1[i]; }
+        vector< vector<double> > scaling;
         /*
          cout << "scaling = " << endl;
          for (int i = 0; i < scaling.size(); i++) {
@@ -2146,11 +2219,10 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
         //((x - group.means[g, ]) %*% scaling)
         //matrix multiplication of randCov and scaling
         LinearAlgebra linear;
-        X = linear.matrix_mult(scaling, randCov); //[numOTUS][numOTUS] * [numOTUS][numSampled] = [numOTUS][numSampled]
         fac = sqrt(fac);
         
-        for (int i = 0; i < X.size(); i++) {
-            for (int j = 0; j < X[i].size(); j++) { X[i][j] *= fac;  }
+        for (int i = 0; i < X.size(); i++) { //[numOTUS][numOTUS] * [numOTUS][numSampled] = [numOTUS][numSampled]
+            for (int j = 0; j < X[i].size(); j++) { double sum = diagScaling[i] * X[i][j]; X[i][j] = sum * fac;  }
         }
         
         vector<double> d;
@@ -2174,13 +2246,15 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
          */
         
         int rank = 0;
-        set<int> goodColumns;
-        //cout << "d = " << endl;
-        for (int i = 0; i < d.size(); i++) {  if (d[i] > 0.0000000001) { rank++; goodColumns.insert(i); } } //cout << d[i] << endl;
+        vector<int> goodColumns; //largest singular value first, the order R's svd returns them in
+        vector< pair<double, int> > sortedD;
+        for (int i = 0; i < d.size(); i++) {  if (d[i] > 0.0000000001) { rank++; sortedD.push_back(make_pair(d[i], i)); } }
+        sort(sortedD.rbegin(), sortedD.rend());
+        for (int i = 0; i < sortedD.size(); i++) { goodColumns.push_back(sortedD[i].second); }
         
         if (rank == 0) {
             ignore=true; //m->mothurOut("[ERROR]: rank = 0: variables are numerically const\n"); m->control_pressed = true;
-            return scaling; }
+            return scaling; } //empty
         
         //scaling <- scaling %*% X.s$v[, 1L:rank] %*% diag(1/X.s$d[1L:rank], , rank)
         //X.s$v[, 1L:rank] = columns in Xcopy that correspond to "good" d values
@@ -2211,7 +2285,7 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
          [3,] 0.0000000 0.000000 0.435417
          */
         if (transpose) {
-            Xcopy = linear.transpose(v);
+            Xcopy = v;
             /*
             cout << "Xcopy = " << endl;
             for (int i = 0; i < Xcopy.size(); i++) {
@@ -2221,18 +2295,25 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
         }
         v.clear(); //store "good" columns - X.s$v[, 1L:rank]
         v.resize(Xcopy.size()); //[numOTUS]["good" columns]
-        for (set<int>::iterator it = goodColumns.begin(); it != goodColumns.end(); it++) {
+        for (vector<int>::iterator it = goodColumns.begin(); it != goodColumns.end(); it++) {
             for (int i = 0; i < Xcopy.size(); i++) {
                 v[i].push_back(Xcopy[i][*it]);
             }
         }
         
-        vector< vector<double> > diagRanks; diagRanks.resize(rank);
-        for (int i = 0; i < rank; i++) { diagRanks[i].resize(rank, 0.0); }
-        count = 0;
-        for (set<int>::iterator it = goodColumns.begin(); it != goodColumns.end(); it++) {  diagRanks[count][count] = 1.0 / d[*it]; count++; }
+        vector<double> diagRanks; //diagonal of the ["good" columns]["good" columns] matrix
+        for (vector<int>::iterator it = goodColumns.begin(); it != goodColumns.end(); it++) {  diagRanks.push_back(1.0 / d[*it]); }
         
-        scaling = linear.matrix_mult(linear.matrix_mult(scaling, v), diagRanks); //([numOTUS][numOTUS]*[numOTUS]["good" columns]) = [numOTUS]["good" columns] then ([numOTUS]["good" columns] * ["good" columns]["good" columns] = scaling = [numOTUS]["good" columns]
+        //([numOTUS][numOTUS]*[numOTUS]["good" columns]) = [numOTUS]["good" columns] then ([numOTUS]["good" columns] * ["good" columns]["good" columns] = scaling = [numOTUS]["good" columns]
+        scaling.resize(numOtus);
+        for (int i = 0; i < numOtus; i++) {
+            scaling[i].resize(rank);
+            for (int j = 0; j < rank; j++) {
+                double sum = diagScaling[i] * v[i][j];
+                double product = sum * diagRanks[j];
+                scaling[i][j] = product;
+            }
+        }
         
         /*cout << "scaling = " << endl;
         for (int i = 0; i < scaling.size(); i++) {
@@ -2265,7 +2346,7 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
         //X <- temp * scaledMeans
         X.clear(); X = scaledMeans; //[numGroups]["good"columns]
         for (int i = 0; i < X.size(); i++) {
-            for (int j = 0; j < X[i].size(); j++) {  X[i][j] *= temp[j];  }
+            for (int j = 0; j < X[i].size(); j++) {  X[i][j] *= temp[i];  }
         }
         /*
         cout << "X = " << endl;
@@ -2299,18 +2380,20 @@ vector< vector<double> > LinearAlgebra::lda(vector< vector<double> >& a, vector<
         //rank <- sum(X.s$d > tol * X.s$d[1L])
         //X.s$d[1L] = larger value in d vector
         double largeD = m->max(d);
-        rank = 0; goodColumns.clear();
-        for (int i = 0; i < d.size(); i++) { if (d[i] > (0.0000000001*largeD)) { rank++; goodColumns.insert(i); } }
+        rank = 0; goodColumns.clear(); sortedD.clear();
+        for (int i = 0; i < d.size(); i++) { if (d[i] > (0.0000000001*largeD)) { rank++; sortedD.push_back(make_pair(d[i], i)); } }
+        sort(sortedD.rbegin(), sortedD.rend()); //LD1 is the discriminant with the largest singular value
+        for (int i = 0; i < sortedD.size(); i++) { goodColumns.push_back(sortedD[i].second); }
         
         if (rank == 0) {
             ignore=true;//m->mothurOut("[ERROR]: rank = 0: class means are numerically identical.\n"); m->control_pressed = true;
             return scaling; }
         
-        if (transpose) { Xcopy = linear.transpose(v);  }
+        if (transpose) { Xcopy = v;  }
         //scaling <- scaling %*% X.s$v[, 1L:rank] - scaling * "good" columns
         v.clear(); //store "good" columns - X.s$v[, 1L:rank]
         v.resize(Xcopy.size()); //Xcopy = ["good"columns][numGroups]
-        for (set<int>::iterator it = goodColumns.begin(); it != goodColumns.end(); it++) {
+        for (vector<int>::iterator it = goodColumns.begin(); it != goodColumns.end(); it++) {
             for (int i = 0; i < Xcopy.size(); i++) {
                 v[i].push_back(Xcopy[i][*it]);
             }
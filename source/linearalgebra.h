@@ -33,6 +33,7 @@ public:
 	double calcSpearman(vector<vector<double> >&, vector<vector<double> >&);
 	double calcKendall(vector<vector<double> >&, vector<vector<double> >&);
     double calcKruskalWallis(vector<spearmanRank>&, double&);
+    double calcKruskalWallis(vector<double>&, vector<int>&, int, double&); //values, treatment index of each value, number of treatments, pValue
     double calcWilcoxon(vector<double>&, vector<double>&, double&);
 	
 	double calcPearson(vector<double>&, vector<double>&, double&);
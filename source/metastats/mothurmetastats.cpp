@@ -11,11 +11,12 @@
 #include "mothurfisher.h"
 
 /***********************************************************/
-MothurMetastats::MothurMetastats(double t, int n) {
+MothurMetastats::MothurMetastats(double t, int n, int p) {
 	try {
 		m = MothurOut::getInstance(); 
 		threshold = t;
 		numPermutations = n;
+		processors = p;
 		
 	}catch(exception& e) {
 		m->errorOut(e, "MothurMetastats", "MothurMetastats");
@@ -247,13 +248,14 @@ vector<double> MothurMetastats::permuted_pvalues(vector< vector<double> >& Imatr
 	try {
         //# matrix stores tstats for each taxa(row) for each permuted trial(column)
         vector<double> ps;  ps.resize(row, 0.0); //# to store the pvalues
-        vector< vector<double> > permuted_ttests; permuted_ttests.resize(numPermutations);            
-        for (int i = 0; i < numPermutations; i++) { permuted_ttests[i].resize(row, 0.0);  } 
+        vector< vector<double> > permuted_ttests;
  
         //# calculate null version of tstats using B permutations.
-        for (int i = 0; i < numPermutations; i++) {   
-            permuted_ttests[i] = permute_and_calc_ts(Imatrix);
-        }
+        if (processors == 1) {
+            for (int i = 0; i < numPermutations; i++) { permuted_ttests.push_back(permute_and_calc_ts(Imatrix)); }
+        }else { createProcesses(Imatrix, permuted_ttests); }
+        
+        if (m->control_pressed) { return ps; }
         
         //# calculate each pvalue using the null ts
         if ((secondGroupingStart) < 8 || (column-secondGroupingStart) < 8){
@@ -273,14 +275,20 @@ vector<double> MothurMetastats::permuted_pvalues(vector< vector<double> >& Imatr
             }
             
             //#now for each taxa
+            //sorted once, so each taxa's count is a binary search instead of a pass over every pooled t. NaNs never count as greater
+            vector<double> pooled;
+            for (int j = 0; j < numPermutations; j++) {
+                for (int k = 0; k < cleanedpermuted_ttests[j].size(); k++) {
+                    if (!isnan(cleanedpermuted_ttests[j][k])) { pooled.push_back(cleanedpermuted_ttests[j][k]); }
+                }
+            }
+            sort(pooled.begin(), pooled.end());
+            
             for (int i = 0; i < row; i++) { 
                 //number of cleanedpermuted_ttests greater than tstat[i]
                 int numGreater = 0;
-                for (int j = 0; j < numPermutations; j++) {
-                    for (int k = 0; k < hfc; k++) {
-                        if (cleanedpermuted_ttests[j][k] > abs(tstats[i])) { numGreater++; }
-                    }
-                }
+                double thisT = abs(tstats[i]);
+                if (!isnan(thisT)) { numGreater = pooled.end() - upper_bound(pooled.begin(), pooled.end(), thisT); }
                 
                 ps[i] = (1/(double)(numPermutations*hfc))*numGreater;
             }
@@ -301,55 +309,131 @@ vector<double> MothurMetastats::permuted_pvalues(vector< vector<double> >& Imatr
     }	
 }
 /***********************************************************/
-vector<double> MothurMetastats::permute_and_calc_ts(vector< vector<double> >& Imatrix) {
+//the permutations are divided between processes like indicator's pvalues, each seeded from one draw of the parent's generator
+int MothurMetastats::createProcesses(vector< vector<double> >& Imatrix, vector< vector<double> >& permuted_ttests) {
 	try {
-        vector< vector<double> > permutedMatrix = Imatrix;
+        vector<int> procIters;
+        int numItersPerProcessor = numPermutations / processors;
+        for (int h = 0; h < processors; h++) {
+            if(h == processors - 1){ numItersPerProcessor = numPermutations - h * numItersPerProcessor; }
+            procIters.push_back(numItersPerProcessor);
+        }
+        
+        vector<int> processIDS;
+        int process = 1;
+        
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        unsigned int seedBase = rand();
+        
+        //loop through and create all the processes you want
+        while (process != processors) {
+            pid_t pid = fork();
+            
+            if (pid > 0) {
+                processIDS.push_back(pid);
+                process++;
+            }else if (pid == 0){
+                srand(seedBase + process);
+                
+                //pass the permuted ts to the parent, binary so NaNs survive
+                ofstream out;
+                string tempFile = m->mothurGetpid(process) + ".permuted.temp";
+                m->openOutputFileBinary(tempFile, out);
+                
+                for (int i = 0; i < procIters[process]; i++) {
+                    if (m->control_pressed) { break; }
+                    vector<double> Ts = permute_and_calc_ts(Imatrix);
+                    if (row != 0) { out.write((char*)&Ts[0], row * sizeof(double)); }
+                }
+                out.close();
+                
+                exit(0);
+            }else {
+                m->mothurOut("[ERROR]: unable to spawn the processes for the permutations, running them in one process.\n");
+                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
+                //wait to die
+                for (int i=0;i<processIDS.size();i++) {
+                    int temp = processIDS[i];
+                    wait(&temp);
+                }
+                m->control_pressed = false;
+                for (int i=0;i<processIDS.size();i++) { m->mothurRemove(toString(processIDS[i]) + ".permuted.temp"); }
+                processIDS.clear();
+                procIters.assign(1, numPermutations);
+                break;
+            }
+        }
+        
+        //do my part
+        for (int i = 0; i < procIters[0]; i++) { permuted_ttests.push_back(permute_and_calc_ts(Imatrix)); }
+        
+        //force parent to wait until all the processes are done
+        for (int i=0;i<processIDS.size();i++) {
+            int temp = processIDS[i];
+            wait(&temp);
+        }
+        
+        //combine results
+        for (int i = 0; i < processIDS.size(); i++) {
+            ifstream in;
+            string tempFile = toString(processIDS[i]) + ".permuted.temp";
+            m->openInputFileBinary(tempFile, in);
+            
+            for (int j = 0; j < procIters[i+1]; j++) {
+                vector<double> Ts; Ts.resize(row, 0.0);
+                if (row != 0) { in.read((char*)&Ts[0], row * sizeof(double)); }
+                if (!in) { m->mothurOut("[ERROR]: unable to read the permutations in " + tempFile + ".\n"); m->control_pressed = true; break; }
+                permuted_ttests.push_back(Ts);
+            }
+            in.close(); m->mothurRemove(tempFile);
+        }
+#else
+        //no threads here, rand is not safe to share between them
+        for (int i = 0; i < numPermutations; i++) { permuted_ttests.push_back(permute_and_calc_ts(Imatrix)); }
+#endif
         
-        //randomize columns, ie group abundances.
-        map<int, int> randomMap;
+        return 0;
+    }catch(exception& e) {
+        m->errorOut(e, "MothurMetastats", "createProcesses");
+        exit(1);
+    }
+}
+/***********************************************************/
+vector<double> MothurMetastats::permute_and_calc_ts(vector< vector<double> >& Imatrix) {
+	try {
+        //randomize columns, ie group abundances. The matrix is read through the permuted column order, not copied
         vector<int> randoms;
         for (int i = 0; i < column; i++) { randoms.push_back(i); }
         random_shuffle(randoms.begin(), randoms.end());
-        for (int i = 0; i < randoms.size(); i++) {   randomMap[i] = randoms[i];   }
         
-        //calc ts
-        vector< vector<double> > C1; C1.resize(row);
-        for (int i = 0; i < row; i++) { C1[i].resize(3, 0.0);  } // statistic profiles for class1 and class 2
-        vector< vector<double> > C2; C2.resize(row);            // mean[1], variance[2], standard error[3] 
-        for (int i = 0; i < row; i++) { C2[i].resize(3, 0.0);  } 
         vector<double> Ts; Ts.resize(row, 0.0); // a place to store the true t-statistics 
-
+        
         //#*************************************
-        //#  generate statistics mean, var, stderr    
+        //#  generate statistics mean, var, stderr and the two sample t-statistic for each taxa
         //#*************************************
         for(int i = 0; i < row; i++){ // for each taxa
+            vector<double>& taxa = Imatrix[i];
+            
             //# find the mean of each group
             double g1Total = 0.0; double g2Total = 0.0;
-            for (int j = 0; j < secondGroupingStart; j++)       {     g1Total += permutedMatrix[i][randomMap[j]]; }
-            C1[i][0] = g1Total/(double)(secondGroupingStart);
-            for (int j = secondGroupingStart; j < column; j++)  {     g2Total += permutedMatrix[i][randomMap[j]]; }
-            C2[i][0] = g2Total/(double)(column-secondGroupingStart);
+            for (int j = 0; j < secondGroupingStart; j++)       {     g1Total += taxa[randoms[j]]; }
+            double mean1 = g1Total/(double)(secondGroupingStart);
+            for (int j = secondGroupingStart; j < column; j++)  {     g2Total += taxa[randoms[j]]; }
+            double mean2 = g2Total/(double)(column-secondGroupingStart);
             
             //# find the variance of each group
             double g1Var = 0.0; double g2Var = 0.0;
-            for (int j = 0; j < secondGroupingStart; j++)       {     g1Var += pow((permutedMatrix[i][randomMap[j]]-C1[i][0]), 2);  }
-            C1[i][1] = g1Var/(double)(secondGroupingStart-1);
-            for (int j = secondGroupingStart; j < column; j++)  {     g2Var += pow((permutedMatrix[i][randomMap[j]]-C2[i][0]), 2);  }
-            C2[i][1] = g2Var/(double)(column-secondGroupingStart-1);
+            for (int j = 0; j < secondGroupingStart; j++)       {     double diff = taxa[randoms[j]]-mean1; g1Var += diff * diff;  }
+            double var1 = g1Var/(double)(secondGroupingStart-1);
+            for (int j = secondGroupingStart; j < column; j++)  {     double diff = taxa[randoms[j]]-mean2; g2Var += diff * diff;  }
+            double var2 = g2Var/(double)(column-secondGroupingStart-1);
             
-            //# find the std error of each group -std err^2 (will change to std err at end)
-            C1[i][2] = C1[i][1]/(double)(secondGroupingStart);    
-            C2[i][2] = C2[i][1]/(double)(column-secondGroupingStart);
-        }
-        
-        
-
-        //#*************************************
-        //#  two sample t-statistics
-        //#*************************************
-        for(int i = 0; i < row; i++){                  // # for each taxa
-            double xbar_diff = C1[i][0] - C2[i][0]; 
-            double denom = sqrt(C1[i][2] + C2[i][2]);
+            //# find the std error of each group -std err^2
+            double err1 = var1/(double)(secondGroupingStart);    
+            double err2 = var2/(double)(column-secondGroupingStart);
+            
+            double xbar_diff = mean1 - mean2; 
+            double denom = sqrt(err1 + err2);
             Ts[i] = abs(xbar_diff/denom);  // calculate two sample t-statistic
         }
 
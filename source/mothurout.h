@@ -35,6 +35,7 @@ class MothurOut {
 	public:
 		static MothurOut* getInstance();
 		void setFileName(string);
+		string getFileName() { return logFileName; }
 		
 		void mothurOut(string); //writes to cout and the logfile
 		void mothurOutEndLine(); //writes to cout and the logfile
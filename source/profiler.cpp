@@ -0,0 +1,238 @@
+//
+//  profiler.cpp
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "profiler.h"
+
+//needed for testing project
+//Profiler* Profiler::_uniqueInstance;
+
+/***********************************************************************/
+Profiler* Profiler::getInstance() {
+	if( _uniqueInstance == 0) {
+		_uniqueInstance = new Profiler();
+	}
+	return _uniqueInstance;
+}
+/***********************************************************************/
+void Profiler::setProfileFile(string filename) {
+	try {
+        profileFile = filename;
+
+        if (profileFile == "") { return; }
+
+        //header is only written once so appended runs stay parsable
+        ifstream in;
+        bool exists = (m->openInputFile(profileFile, in, "no error") == 0);
+        bool blank = true;
+        if (exists) { blank = (in.peek() == EOF); in.close(); }
+
+        if (blank) {
+            ofstream out;
+            m->openOutputFile(profileFile, out);
+            out << "command\tphase\twall_seconds\tuser_cpu_seconds\tsys_cpu_seconds\tchild_user_cpu_seconds\tchild_sys_cpu_seconds\tlifetime_peak_rss_bytes\tlargest_child_peak_rss_bytes\tbytes_read\tbytes_written\trecords" << endl;
+            out.close();
+        }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "setProfileFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::startCommand(string name) {
+	try {
+        if (!isEnabled()) { return; }
+
+        commandName = name; phaseName = "";
+        commandRecords = 0; phaseRecords = 0;
+        commandStart = takeSnapshot();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "startCommand");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::endCommand(int returnCode) {
+	try {
+        if (!isEnabled()) { return; }
+        if (commandName == "") { return; }
+
+        endPhase();
+
+        string phase = "total";
+        if (returnCode == 2) { phase = "total(aborted)"; }
+
+        profileSnapshot commandEnd = takeSnapshot();
+        printRow(profileFile, commandName, phase, commandStart, commandEnd, commandRecords);
+
+        commandName = "";
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "endCommand");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::startPhase(string name) {
+	try {
+        if (!isEnabled()) { return; }
+        if (commandName == "") { return; }
+
+        endPhase();
+
+        phaseName = name; phaseRecords = 0;
+        phaseStart = takeSnapshot();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "startPhase");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::endPhase() {
+	try {
+        if (!isEnabled()) { return; }
+        if (phaseName == "") { return; }
+
+        profileSnapshot phaseEnd = takeSnapshot();
+        printRow(profileFile, commandName, phaseName, phaseStart, phaseEnd, phaseRecords);
+
+        phaseName = ""; phaseRecords = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "endPhase");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the usage of a forked process starts at zero, the snapshot is for its wall time
+void Profiler::startChild() {
+	try {
+        if (!isEnabled()) { return; }
+
+        commandRecords = 0; phaseRecords = 0;
+        childStart = takeSnapshot();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "startChild");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::endChild() {
+	try {
+        if (!isEnabled()) { return; }
+        if (commandName == "") { return; }
+
+        string phase = "child " + m->mothurGetpid(0);
+        if (phaseName != "") { phase = phaseName + " " + phase; }
+
+        profileSnapshot childEnd = takeSnapshot();
+        printRow(profileFile + m->mothurGetpid(0) + ".temp", commandName, phase, childStart, childEnd, commandRecords);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "endChild");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::addChildren(vector<int>& processIDS) {
+	try {
+        if (!isEnabled()) { return; }
+
+        for (int i = 0; i < processIDS.size(); i++) {
+            string tempFile = profileFile + toString(processIDS[i]) + ".temp";
+            ifstream in;
+            if (m->openInputFile(tempFile, in, "no error") != 0) { continue; }
+            in.close();
+
+            m->appendFiles(tempFile, profileFile);
+            m->mothurRemove(tempFile);
+        }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "addChildren");
+		exit(1);
+	}
+}
+/***********************************************************************/
+profileSnapshot Profiler::takeSnapshot() {
+	try {
+        profileSnapshot snap;
+
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        snap.wall = now.tv_sec + (now.tv_usec / 1000000.0);
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        struct rusage selfUsage, childUsage;
+        getrusage(RUSAGE_SELF, &selfUsage);
+        getrusage(RUSAGE_CHILDREN, &childUsage);
+
+        snap.userCPU = selfUsage.ru_utime.tv_sec + (selfUsage.ru_utime.tv_usec / 1000000.0);
+        snap.sysCPU = selfUsage.ru_stime.tv_sec + (selfUsage.ru_stime.tv_usec / 1000000.0);
+        snap.childUserCPU = childUsage.ru_utime.tv_sec + (childUsage.ru_utime.tv_usec / 1000000.0);
+        snap.childSysCPU = childUsage.ru_stime.tv_sec + (childUsage.ru_stime.tv_usec / 1000000.0);
+
+    #if defined (__APPLE__) || (__MACH__)
+        /* Mac: ru_maxrss gives the size in bytes */
+        snap.peakRSS = selfUsage.ru_maxrss;
+        snap.childPeakRSS = childUsage.ru_maxrss;
+    #else
+        /* Linux: ru_maxrss gives the size in kilobytes  */
+        snap.peakRSS = selfUsage.ru_maxrss * 1024;
+        snap.childPeakRSS = childUsage.ru_maxrss * 1024;
+
+        //rchar and wchar include the io of children we have waited on
+        ifstream in("/proc/self/io");
+        if (in) {
+            string key; unsigned long long value;
+            while (in >> key >> value) {
+                if (key == "rchar:")        { snap.bytesRead = value;       }
+                else if (key == "wchar:")   { snap.bytesWritten = value;    }
+            }
+            in.close();
+        }
+    #endif
+#else
+        FILETIME createTime, exitTime, kernelTime, userTime;
+        if (GetProcessTimes(GetCurrentProcess(), &createTime, &exitTime, &kernelTime, &userTime)) {
+            snap.userCPU = ((((unsigned long long)userTime.dwHighDateTime) << 32) + userTime.dwLowDateTime) / 10000000.0;
+            snap.sysCPU = ((((unsigned long long)kernelTime.dwHighDateTime) << 32) + kernelTime.dwLowDateTime) / 10000000.0;
+        }
+        snap.peakRSS = m->getRAMUsed();
+#endif
+
+        return snap;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "takeSnapshot");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void Profiler::printRow(string filename, string command, string phase, profileSnapshot& start, profileSnapshot& end, unsigned long long records) {
+	try {
+        ofstream out;
+        m->openOutputFileAppend(filename, out);
+        out.setf(ios::fixed, ios::floatfield); out.setf(ios::showpoint);
+
+        out << command << '\t' << phase << '\t' << setprecision(3) << (end.wall - start.wall) << '\t'
+            << (end.userCPU - start.userCPU) << '\t' << (end.sysCPU - start.sysCPU) << '\t'
+            << (end.childUserCPU - start.childUserCPU) << '\t' << (end.childSysCPU - start.childSysCPU) << '\t'
+            << end.peakRSS << '\t' << end.childPeakRSS << '\t'
+            << (end.bytesRead - start.bytesRead) << '\t' << (end.bytesWritten - start.bytesWritten) << '\t' << records << endl;
+
+        out.close();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "printRow");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,66 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+//
+//  profiler.h
+//  Mothur
+//
+//  Copyright (c) 2016 Schloss Lab. All rights reserved.
+//
+
+#include "mothurout.h"
+
+/***********************************************************************/
+//records wall time, cpu time, peak RSS, bytes read and written and records processed for each command and each phase
+//of a command. Enabled by set.logfile(profile=T). Rows are appended to a tab delimited file as each phase or command
+//finishes, so a killed run still leaves a usable profile. Processes created by fork are reported in the child columns
+//once the parent has waited on them, as one total. The peak RSS columns are the peaks over the life of mothur and of its
+//largest child, not of the row, because getrusage does not reset them. Commands that call startChild and endChild in
+//their forked processes and addChildren after waiting on them also get a row per child process.
+
+struct profileSnapshot {
+    double wall;
+    double userCPU, sysCPU, childUserCPU, childSysCPU;
+    unsigned long long peakRSS, childPeakRSS, bytesRead, bytesWritten;
+
+    profileSnapshot() : wall(0), userCPU(0), sysCPU(0), childUserCPU(0), childSysCPU(0), peakRSS(0), childPeakRSS(0), bytesRead(0), bytesWritten(0) {}
+};
+/***********************************************************************/
+
+class Profiler {
+
+public:
+    static Profiler* getInstance();
+
+    void setProfileFile(string); //turns profiling on, "" turns it off
+    string getProfileFile()     { return profileFile;           }
+    bool isEnabled()            { return (profileFile != "");   }
+
+    void startCommand(string); //command name
+    void endCommand(int); //return code of execute
+    void startPhase(string); //read, compute, write... closes the current phase if one is open
+    void endPhase();
+    void addRecords(unsigned long long n) { phaseRecords += n; commandRecords += n; }
+
+    void startChild(); //called by a forked process before it starts its work
+    void endChild(); //called by a forked process before it exits, writes its row to profilefile<pid>.temp
+    void addChildren(vector<int>&); //called by the parent after waiting on processIDS, adds their rows to the profile
+
+private:
+    static Profiler* _uniqueInstance;
+    Profiler( const Profiler& ); // Disable copy constructor
+    void operator=( const Profiler& ); // Disable assignment operator
+    Profiler() { m = MothurOut::getInstance(); profileFile = ""; commandName = ""; phaseName = ""; commandRecords = 0; phaseRecords = 0; }
+    ~Profiler() {}
+
+    MothurOut* m;
+    string profileFile, commandName, phaseName;
+    unsigned long long commandRecords, phaseRecords;
+    profileSnapshot commandStart, phaseStart, childStart;
+
+    profileSnapshot takeSnapshot();
+    void printRow(string, string, string, profileSnapshot&, profileSnapshot&, unsigned long long); //filename, command, phase
+};
+/***********************************************************************/
+
+#endif
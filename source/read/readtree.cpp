@@ -42,10 +42,10 @@ int ReadTree::AssembleTrees() {
 	}
 }
 /***********************************************************************/
-int ReadTree::readSpecialChar(istream& f, char c, string name) {
+int ReadTree::readSpecialChar(TreeBuffer& f, char c, string name) {
     try {
 	
-		m->gobble(f);
+		f.gobble();
 		char d = f.get();
 	
 		if(d == EOF){
@@ -57,7 +57,7 @@ int ReadTree::readSpecialChar(istream& f, char c, string name) {
 			exit(1);
 		}
 		if(d == ')' && f.peek() == '\n'){
-			m->gobble(f);
+			f.gobble();
 		}	
 		return d;
 	}
@@ -68,10 +68,10 @@ int ReadTree::readSpecialChar(istream& f, char c, string name) {
 }
 /**************************************************************************************************/
 
-int ReadTree::readNodeChar(istream& f) {
+int ReadTree::readNodeChar(TreeBuffer& f) {
 	try {
 //		while(isspace(d=f.get()))		{;}
-		m->gobble(f);
+		f.gobble();
 		char d = f.get();
 
 		if(d == EOF){
@@ -88,15 +88,15 @@ int ReadTree::readNodeChar(istream& f) {
 
 /**************************************************************************************************/
 
-float ReadTree::readBranchLength(istream& f) {
+float ReadTree::readBranchLength(TreeBuffer& f) {
     try {
 		float b;
 	
-		if(!(f >> b)){
+		if(!f.getFloat(b)){
 			m->mothurOut("Error: Missing branch length in input tree.\n");
 			exit(1);
 		}
-		m->gobble(f);
+		f.gobble();
 		return b;
 	}
 	catch(exception& e) {
@@ -138,7 +138,7 @@ int ReadNewickTree::read(CountTable* ct) {
 				}
 
 				//make new tree
-				T = new Tree(ct); 
+				T = newTree(ct); 
 
 				numNodes = T->getNumNodes();
 				numLeaves = T->getNumLeaves();
@@ -177,7 +177,7 @@ int ReadNewickTree::read(CountTable* ct) {
 				filehandle.putback(c);  //put back first ( of tree.
 				
 				//make new tree
-				T = new Tree(ct); 
+				T = newTree(ct); 
 				numNodes = T->getNumNodes();
 				numLeaves = T->getNumLeaves();
 				
@@ -201,6 +201,21 @@ int ReadNewickTree::read(CountTable* ct) {
 	}
 }
 /**************************************************************************************************/
+//Every tree in the file has the same leaves, so their names and groups are looked up in the count table once
+//and copied for each tree. Names missing from the count table are added to it while reading, so then the
+//leaves are made again.
+Tree* ReadNewickTree::newTree(CountTable* ct) {
+	try {
+		if (leaves == NULL) { leaves = new Tree(ct); }
+		
+		return (new Tree(*leaves));
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadNewickTree", "newTree");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 //This function read the file through the translation of the sequences names and updates treemap.
 string ReadNewickTree::nexusTranslation(CountTable* ct) {
 	try {
@@ -250,24 +265,29 @@ int ReadNewickTree::readTreeString(CountTable* ct) {
 		int ch = filehandle.peek();	
 		
 		if(ch == '('){
+			//read the tree string through the ';' and parse it from memory
+			TreeBuffer f;
+			getline(filehandle, f.text, ';');
+			if (!filehandle.eof()) { f.text += ';'; }
+			
 			n = numLeaves;  //number of leaves / sequences, we want node 1 to start where the leaves left off
 
-			lc = readNewickInt(filehandle, n, T, ct);
+			lc = readNewickInt(f, n, T, ct);
 			if (lc == -1) { m->mothurOut("error with lc"); m->mothurOutEndLine(); m->control_pressed = true; return -1; } //reports an error in reading
 	
-			if(filehandle.peek()==','){							
-				readSpecialChar(filehandle,',',"comma");
+			if(f.peek()==','){							
+				readSpecialChar(f,',',"comma");
 			}
 			// ';' means end of tree.												
-			else if((ch=filehandle.peek())==';' || ch=='['){		
+			else if((ch=f.peek())==';' || ch=='['){		
 				rooted = 1;									
 			}	
 		
 			if(rooted != 1){								
-				rc = readNewickInt(filehandle, n, T, ct);
+				rc = readNewickInt(f, n, T, ct);
 				if (rc == -1) { m->mothurOut("error with rc"); m->mothurOutEndLine(); m->control_pressed = true; return -1; } //reports an error in reading
-				if(filehandle.peek() == ')'){					
-					readSpecialChar(filehandle,')',"right parenthesis");
+				if(f.peek() == ')'){					
+					readSpecialChar(f,')',"right parenthesis");
 				}											
 			}	
 		}
@@ -286,9 +306,9 @@ int ReadNewickTree::readTreeString(CountTable* ct) {
 				readOk = -1; return -1;
 			}
 			lc = rc = -1;
+			
+			while(((ch=filehandle.get())!=';') && (filehandle.eof() != true)){;}
 		} 
-		
-		while(((ch=filehandle.get())!=';') && (filehandle.eof() != true)){;}  	
 							
 		if(rooted != 1){									
 			T->tree[n].setChildren(lc,rc);
@@ -309,7 +329,7 @@ int ReadNewickTree::readTreeString(CountTable* ct) {
 }
 /**************************************************************************************************/
 
-int ReadNewickTree::readNewickInt(istream& f, int& n, Tree* T, CountTable* ct) {
+int ReadNewickTree::readNewickInt(TreeBuffer& f, int& n, Tree* T, CountTable* ct) {
 	try {
 		
 		if (m->control_pressed) { return -1; } 
@@ -356,9 +376,9 @@ int ReadNewickTree::readNewickInt(istream& f, int& n, Tree* T, CountTable* ct) {
 			if(f.peek()==')'){	
 				readSpecialChar(f,')',"right parenthesis");	
 				//to pass over labels in trees
-				c=filehandle.get();
-				while((c!=',') && (c != -1) && (c!= ':') && (c!=';')&& (c!=')')){ c=filehandle.get(); }
-				filehandle.putback(c);
+				c=f.get();
+				while((c!=',') && (c != -1) && (c!= ':') && (c!=';')&& (c!=')')){ c=f.get(); }
+				f.putback(c);
 			}			
 		
 			if(f.peek() == ':'){									      
@@ -387,14 +407,13 @@ int ReadNewickTree::readNewickInt(istream& f, int& n, Tree* T, CountTable* ct) {
 		
 			f.putback(d);
 		
-			//set group info
-			vector<string> group = ct->getGroups(name);
-            //cout << name << endl;	
 			//find index in tree of name
 			int n1 = T->getIndex(name);
+			if (n1 == -1) { m->mothurOut("[ERROR]: " + name + " is not among the tree's leaves or in your count table, all trees must contain the same sequences.\n"); readOk = -1; return -1; }
 			
+			//the leaves were copied with their groups, only names missing from the count table have none
 			//adds sequence names that are not in group file to the "xxx" group
-			if(group.size() == 0) {
+			if((T->tree[n1].pcount.size() == 0) && (ct->getGroups(name).size() == 0)) {
 				m->mothurOut("Name: " + name + " is not in your groupfile, and will be disregarded. \n");  //readOk = -1; return n1;
 				
                 vector<string> currentGroups = ct->getNamesOfGroups();
@@ -405,10 +424,8 @@ int ReadNewickTree::readNewickInt(istream& f, int& n, Tree* T, CountTable* ct) {
                     if (currentGroups[h] == "xxx") {  thisCounts[h] = 1;  break; }
                 }
                 ct->push_back(name, thisCounts);
-                
-				group.push_back("xxx");
-			}			
-			T->tree[n1].setGroup(group);
+                if (leaves != NULL) { delete leaves; leaves = NULL; } //the next tree's leaves need the new group
+			}
 			T->tree[n1].setChildren(-1,-1);
 		
 			if(blen == 1){	
@@ -18,6 +18,40 @@
 
 class Tree;
 
+/****************************************************************************/
+//one tree string held in memory, so the parser steps through it without a stream call for every character.
+//get, peek and putback behave like their istream counterparts.
+
+class TreeBuffer {
+	public:
+		TreeBuffer() : pos(0), atEnd(false) {}
+		
+		string text;
+		
+		int get() {
+			if (pos < text.length()) { return (unsigned char)text[pos++]; }
+			atEnd = true; return EOF;
+		}
+		int peek() { if (pos < text.length()) { return (unsigned char)text[pos]; } return EOF; }
+		void putback(int c) { if (atEnd) { atEnd = false; } else if (pos > 0) { pos--; } }
+		bool eof() { return atEnd; }
+		void gobble() { while ((pos < text.length()) && isspace(text[pos])) { pos++; } }
+		
+		bool getFloat(float& value) {
+			if (pos >= text.length()) { return false; }
+			const char* start = text.c_str() + pos;
+			char* end;
+			value = strtof(start, &end);
+			if (end == start) { return false; }
+			pos += (end - start);
+			return true;
+		}
+	
+	private:
+		size_t pos;
+		bool atEnd;
+};
+
 /****************************************************************************/
 
 class ReadTree {
@@ -26,9 +60,9 @@ class ReadTree {
 		virtual ~ReadTree() {};
 		
 		virtual int read(CountTable*) = 0;
-		int readSpecialChar(istream&, char, string);
-		int readNodeChar(istream& f);
-		float readBranchLength(istream& f);
+		int readSpecialChar(TreeBuffer&, char, string);
+		int readNodeChar(TreeBuffer& f);
+		float readBranchLength(TreeBuffer& f);
 	
 		vector<Tree*> getTrees() { return Trees; }
 		int AssembleTrees();
@@ -47,13 +81,15 @@ class ReadTree {
 class ReadNewickTree : public ReadTree {
 	
 public:
-	ReadNewickTree(string file) : treeFile(file) { m->openInputFile(file, filehandle); readOk = 0; } 
-	~ReadNewickTree() {};
+	ReadNewickTree(string file) : treeFile(file) { m->openInputFile(file, filehandle); readOk = 0; leaves = NULL; } 
+	~ReadNewickTree() { if (leaves != NULL) { delete leaves; } };
 	int read(CountTable*);
 	
 private:
 	Tree* T;
-	int readNewickInt(istream&, int&, Tree*, CountTable*);
+	Tree* leaves; //leaf names and groups from the count table, copied to start each tree in the file
+	Tree* newTree(CountTable*);
+	int readNewickInt(TreeBuffer&, int&, Tree*, CountTable*);
 	int readTreeString(CountTable*);
 	string nexusTranslation(CountTable*);
 	ifstream filehandle;
@@ -336,197 +336,70 @@ int SplitMatrix::splitDistanceFileByTax(map<string, int>& seqGroup, int numGroup
 /***********************************************************************/
 int SplitMatrix::splitDistanceLarge(){
 	try {
-		vector<set<string> > groups;
+		//first pass finds the groups, second pass writes each groups distances
+		map<string, int> nameIndex;
+		vector<int> seqGroup;
+		int numGroups = findDistanceGroups(nameIndex, seqGroup, NULL);
+		
+		if (m->control_pressed) { return 0; }
+		
+		vector<string> tempDistFiles;
+		for (int i = 0; i < numGroups; i++) {
+			string fileName = distFile + "." + toString(i) + ".temp";
+			tempDistFiles.push_back(fileName);
+			m->mothurRemove(fileName);
+		}
 		
 		//for buffering the io to improve speed
-		 //allow for 30 dists to be stored, then output.
-		vector<string> outputs;
-		vector<int> numOutputs;
-		vector<bool> wroteOutPut;
+		//allow for 60 dists to be stored, then output.
+		vector<string> outputs; outputs.resize(numGroups, "");
+		vector<int> numOutputs; numOutputs.resize(numGroups, 0);
 		
-		int numGroups = 0;
-
-		//ofstream outFile;
 		ifstream dFile;
 		m->openInputFile(distFile, dFile);
-	
+		
+		string seqA, seqB;
+		float dist;
 		while(dFile){
-			string seqA, seqB;
-			float dist;
-
 			dFile >> seqA >> seqB >> dist;
 			
-			if (m->control_pressed) {   dFile.close();  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  m->mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
-					
+			if (m->control_pressed) {   dFile.close();  for(int i=0;i<numGroups;i++){	m->mothurRemove(tempDistFiles[i]); } return 0; }
+			
 			if(dist < cutoff){
-				//cout << "in cutoff: " << dist << endl;
-				int groupIDA = -1;
-				int groupIDB = -1;
-				int groupID = -1;
+				int groupID = seqGroup[nameIndex[seqA]];
 				
-				for(int i=0;i<numGroups;i++){
-					set<string>::iterator aIt = groups[i].find(seqA);
-					set<string>::iterator bIt = groups[i].find(seqB);
-					
-					if(groupIDA == -1 && aIt != groups[i].end()){//seqA is not already assigned to a group and is in group[i], so assign seqB to group[i]
-						groups[i].insert(seqB);
-						groupIDA = i;
-						groupID = groupIDA;
-
-						//cout << "in aIt: " << groupID << endl;
-	//					break;
-					}
-					else if(groupIDB == -1 && bIt != groups[i].end()){//seqB is not already assigned to a group and is in group[i], so assign seqA to group[i]
-						groups[i].insert(seqA);
-						groupIDB = i;
-						groupID = groupIDB;
-
-					//	cout << "in bIt: " << groupID << endl;
-	//					break;
-					}
-				
-					if(groupIDA != -1 && groupIDB != -1){//both ifs above have been executed, so we need to decide who to assign them to
-						if(groupIDA < groupIDB){
-						//	cout << "A: " << groupIDA << "\t" << groupIDB << endl;
-							groups[groupIDA].insert(groups[groupIDB].begin(), groups[groupIDB].end()); //merge two groups into groupIDA
-							groups[groupIDB].clear(); 
-							groupID = groupIDA;
-						}
-						else{
-						//	cout << "B: " << groupIDA << "\t" << groupIDB << endl;
-							groups[groupIDB].insert(groups[groupIDA].begin(), groups[groupIDA].end()); //merge two groups into groupIDB
-							groups[groupIDA].clear();  
-							groupID = groupIDB;
-						}
-						break;
-					}
-				}
+				outputs[groupID] += seqA + '\t' + seqB + '\t' + toString(dist) + '\n';
+				numOutputs[groupID]++;
 				
-	//windows is gonna gag on the reuse of outFile, will need to make it local...
-				
-				if(groupIDA == -1 && groupIDB == -1){ //we need a new group
-					set<string> newGroup;
-					newGroup.insert(seqA);
-					newGroup.insert(seqB);
-					groups.push_back(newGroup);
-									
-					string tempOut = seqA + '\t' + seqB + '\t' + toString(dist) + '\n';
-					outputs.push_back(tempOut);
-					numOutputs.push_back(1);
-					wroteOutPut.push_back(false);
+				//have we reached the max buffer size
+				if (numOutputs[groupID] > 60) {
+					ofstream outFile;
+					outFile.open(tempDistFiles[groupID].c_str(), ios::app);
+					outFile << outputs[groupID];
+					outFile.close();
 					
-					numGroups++;
-				}
-				else{
-					string fileName = distFile + "." + toString(groupID) + ".temp";
-											
-					//have we reached the max buffer size
-					if (numOutputs[groupID] > 60) { //write out sequence
-                        ofstream outFile;
-						outFile.open(fileName.c_str(), ios::app);
-						outFile << outputs[groupID] << seqA << '\t' << seqB << '\t' << dist << endl;
-						outFile.close();
-						
-						outputs[groupID] = "";
-						numOutputs[groupID] = 0;
-						wroteOutPut[groupID] = true;
-					}else {
-						outputs[groupID] +=  seqA + '\t' + seqB + '\t' + toString(dist)  + '\n';
-						numOutputs[groupID]++;
-					}
-					
-					if(groupIDA != -1 && groupIDB != -1){ //merge distance files of two groups you merged above
-						string row, column, distance;
-						if(groupIDA<groupIDB){
-							
-							//merge memory
-							numOutputs[groupID] += numOutputs[groupIDB];
-							outputs[groupID] += outputs[groupIDB];
-							
-							outputs[groupIDB] = "";
-							numOutputs[groupIDB] = 0;
-							
-							//if groupB is written to file it is above buffer size so read and write to new merged file
-							if (wroteOutPut[groupIDB]) {
-								string fileName2 = distFile + "." + toString(groupIDB) + ".temp";
-                                m->appendFiles(fileName2, fileName);
-								m->mothurRemove(fileName2);
-                        
-								
-								//write out the merged memory
-								if (numOutputs[groupID] > 60) {
-                                    ofstream tempOut;
-                                    m->openOutputFile(fileName, tempOut);
-									tempOut << outputs[groupID];
-									outputs[groupID] = "";
-									numOutputs[groupID] = 0;
-                                    tempOut.close();
-								}
-								
-								//outFile.close();
-								
-								wroteOutPut[groupID] = true;
-								wroteOutPut[groupIDB] = false;
-							}else{ } //just merge b's memory with a's memory 
-						}
-						else{
-							numOutputs[groupID] += numOutputs[groupIDA];
-							outputs[groupID] += outputs[groupIDA];
-							
-							outputs[groupIDA] = "";
-							numOutputs[groupIDA] = 0;
-							
-							if (wroteOutPut[groupIDA]) {
-								string fileName2 = distFile + "." + toString(groupIDA) + ".temp";
-                                m->appendFiles(fileName2, fileName);
-								m->mothurRemove(fileName2);
-								
-								//write out the merged memory
-								if (numOutputs[groupID] > 60) {
-                                    ofstream tempOut;
-                                    m->openOutputFile(fileName, tempOut);
-									tempOut << outputs[groupID];
-									outputs[groupID] = "";
-									numOutputs[groupID] = 0;
-                                    tempOut.close();
-								}
-								
-								//outFile.close();
-								
-								wroteOutPut[groupID] = true;
-								wroteOutPut[groupIDA] = false;
-							}else { } //just merge memory
-						}					
-					}
+					outputs[groupID] = "";
+					numOutputs[groupID] = 0;
 				}
 			}
 			m->gobble(dFile);
 		}
 		dFile.close();
-        
-		vector<string> tempDistFiles;
+		
 		for (int i = 0; i < numGroups; i++) {
-            string fileName = distFile + "." + toString(i) + ".temp";
-            tempDistFiles.push_back(fileName);
-            //remove old names files just in case
-			
 			if (numOutputs[i] > 0) {
-                ofstream outFile;
-				outFile.open(fileName.c_str(), ios::app);
+				ofstream outFile;
+				outFile.open(tempDistFiles[i].c_str(), ios::app);
 				outFile << outputs[i];
 				outFile.close();
 			}
 		}
-        
-        map<string, int> seqGroup;
-        for (int i = 0; i < groups.size(); i++) {
-            for (set<string>::iterator itNames = groups[i].begin(); itNames != groups[i].end();) {
-                seqGroup[*itNames] = i;
-                groups[i].erase(itNames++);
-            }
-        }
-        
-		splitNames(seqGroup, numGroups, tempDistFiles);
+		
+		map<string, int> seqGroups;
+		for (map<string, int>::iterator it = nameIndex.begin(); it != nameIndex.end(); it++) { seqGroups[it->first] = seqGroup[it->second]; }
+		nameIndex.clear();
+		
+		splitNames(seqGroups, numGroups, tempDistFiles);
 				
 		return 0;			
 	}
@@ -536,6 +409,84 @@ int SplitMatrix::splitDistanceLarge(){
 	}
 }
 //********************************************************************************************************************
+//root of a sequences group, halving the path as it goes
+int SplitMatrix::findRoot(vector<int>& parent, int seq){
+	try {
+		while (parent[seq] != seq) {
+			parent[seq] = parent[parent[seq]];
+			seq = parent[seq];
+		}
+		return seq;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "findRoot");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
+//reads the column file once, joining the sequences of every distance below the cutoff. Names are given indexes in nameIndex
+//and seqGroup holds the group of each index. Groups are numbered in the order they are started in the file, so a group keeps
+//the number of the first distance that created it. If dists is not NULL the distances below the cutoff are saved in it.
+int SplitMatrix::findDistanceGroups(map<string, int>& nameIndex, vector<int>& seqGroup, vector<seqDist>* dists){
+	try {
+		vector<int> parent;
+		vector<int> groupSize;
+		vector<int> groupNumber; //number of the group, valid for roots
+		int numGroups = 0;
+		
+		ifstream dFile;
+		m->openInputFile(distFile, dFile);
+		
+		string seqA, seqB;
+		float dist;
+		while(dFile){
+			dFile >> seqA >> seqB >> dist;
+			
+			if (m->control_pressed) { dFile.close(); return 0; }
+			
+			if(dist < cutoff){
+				int indexA, indexB;
+				bool newA = false; bool newB = false;
+				
+				map<string, int>::iterator it = nameIndex.find(seqA);
+				if (it == nameIndex.end()) { indexA = parent.size(); nameIndex[seqA] = indexA; parent.push_back(indexA); groupSize.push_back(1); groupNumber.push_back(-1); newA = true; }
+				else { indexA = it->second; }
+				
+				it = nameIndex.find(seqB);
+				if (it == nameIndex.end()) { indexB = parent.size(); nameIndex[seqB] = indexB; parent.push_back(indexB); groupSize.push_back(1); groupNumber.push_back(-1); newB = true; }
+				else { indexB = it->second; }
+				
+				int rootA = findRoot(parent, indexA);
+				int rootB = findRoot(parent, indexB);
+				
+				if (newA && newB)	{ groupNumber[rootA] = numGroups; groupNumber[rootB] = numGroups; numGroups++; } //we need a new group
+				else if (newA)		{ groupNumber[rootA] = groupNumber[rootB]; }
+				else if (newB)		{ groupNumber[rootB] = groupNumber[rootA]; }
+				
+				if (rootA != rootB) { //merge the smaller group into the larger, keeping the lower group number
+					if (groupSize[rootA] < groupSize[rootB]) { int temp = rootA; rootA = rootB; rootB = temp; }
+					parent[rootB] = rootA;
+					groupSize[rootA] += groupSize[rootB];
+					if (groupNumber[rootB] < groupNumber[rootA]) { groupNumber[rootA] = groupNumber[rootB]; }
+				}
+				
+				if (dists != NULL) { dists->push_back(seqDist(indexA, indexB, dist)); }
+			}
+			m->gobble(dFile);
+		}
+		dFile.close();
+		
+		seqGroup.resize(parent.size());
+		for (int i = 0; i < parent.size(); i++) { seqGroup[i] = groupNumber[findRoot(parent, i)]; }
+		
+		return numGroups;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "findDistanceGroups");
+		exit(1);
+	}
+}
+//********************************************************************************************************************
 int SplitMatrix::splitNames(map<string, int>& seqGroup, int numGroups, vector<string>& tempDistFiles){
 	try {
         ofstream outFile;
@@ -755,120 +706,49 @@ int SplitMatrix::splitNamesVsearch(map<string, int>& seqGroup, int numGroups, ve
 //********************************************************************************************************************
 int SplitMatrix::splitDistanceRAM(){
 	try {
-		vector<set<string> > groups;
-		vector<string> outputs;
+		//distances below the cutoff are kept as indexes so the file is only read once
+		map<string, int> nameIndex;
+		vector<int> seqGroup;
+		vector<seqDist> dists;
+		int numGroups = findDistanceGroups(nameIndex, seqGroup, &dists);
 		
-		int numGroups = 0;
-
-		ifstream dFile;
-		m->openInputFile(distFile, dFile);
-
-		while(dFile){
-			string seqA, seqB;
-			float dist;
-
-			dFile >> seqA >> seqB >> dist;
-			
-			if (m->control_pressed) {   dFile.close();  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  m->mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
-					
-			if(dist < cutoff){
-				//cout << "in cutoff: " << dist << endl;
-				int groupIDA = -1;
-				int groupIDB = -1;
-				int groupID = -1;
-				
-				for(int i=0;i<numGroups;i++){
-					set<string>::iterator aIt = groups[i].find(seqA);
-					set<string>::iterator bIt = groups[i].find(seqB);
-					
-					if(groupIDA == -1 && aIt != groups[i].end()){//seqA is not already assigned to a group and is in group[i], so assign seqB to group[i]
-						groups[i].insert(seqB);
-						groupIDA = i;
-						groupID = groupIDA;
-
-						//cout << "in aIt: " << groupID << endl;
-	//					break;
-					}
-					else if(groupIDB == -1 && bIt != groups[i].end()){//seqB is not already assigned to a group and is in group[i], so assign seqA to group[i]
-						groups[i].insert(seqA);
-						groupIDB = i;
-						groupID = groupIDB;
-
-					//	cout << "in bIt: " << groupID << endl;
-	//					break;
-					}
-				
-					if(groupIDA != -1 && groupIDB != -1){//both ifs above have been executed, so we need to decide who to assign them to
-						if(groupIDA < groupIDB){
-						//	cout << "A: " << groupIDA << "\t" << groupIDB << endl;
-							groups[groupIDA].insert(groups[groupIDB].begin(), groups[groupIDB].end()); //merge two groups into groupIDA
-							groups[groupIDB].clear(); 
-							groupID = groupIDA;
-						}
-						else{
-						//	cout << "B: " << groupIDA << "\t" << groupIDB << endl;
-							groups[groupIDB].insert(groups[groupIDA].begin(), groups[groupIDA].end()); //merge two groups into groupIDB
-							groups[groupIDA].clear();  
-							groupID = groupIDB;
-						}
-						break;
-					}
-				}
-				
-	//windows is gonna gag on the reuse of outFile, will need to make it local...
-				
-				if(groupIDA == -1 && groupIDB == -1){ //we need a new group
-					set<string> newGroup;
-					newGroup.insert(seqA);
-					newGroup.insert(seqB);
-					groups.push_back(newGroup);
-									
-					string tempOut = seqA + '\t' + seqB + '\t' + toString(dist) + '\n';
-					outputs.push_back(tempOut);
-					numGroups++;
-				}
-				else{
-											
-					outputs[groupID] +=  seqA + '\t' + seqB + '\t' + toString(dist)  + '\n';
-					
-					if(groupIDA != -1 && groupIDB != -1){ //merge distance files of two groups you merged above
-						string row, column, distance;
-						if(groupIDA<groupIDB){
-							//merge memory
-							outputs[groupID] += outputs[groupIDB];
-							outputs[groupIDB] = "";
-						}else{
-							outputs[groupID] += outputs[groupIDA];
-							outputs[groupIDA] = "";
-						}					
-					}
-				}
-			}
-			m->gobble(dFile);
+		if (m->control_pressed) { return 0; }
+		
+		vector<string> names; names.resize(nameIndex.size());
+		map<string, int> seqGroups;
+		for (map<string, int>::iterator it = nameIndex.begin(); it != nameIndex.end(); it++) {
+			names[it->second] = it->first;
+			seqGroups[it->first] = seqGroup[it->second];
 		}
-		dFile.close();
+		nameIndex.clear();
+		
+		//order the distances by group, keeping file order within a group
+		vector<int> groupStart; groupStart.resize(numGroups+1, 0);
+		for (int i = 0; i < dists.size(); i++) { groupStart[seqGroup[dists[i].seq1]+1]++; }
+		for (int i = 0; i < numGroups; i++) { groupStart[i+1] += groupStart[i]; }
+		vector<int> order; order.resize(dists.size());
+		vector<int> next = groupStart;
+		for (int i = 0; i < dists.size(); i++) { order[next[seqGroup[dists[i].seq1]]++] = i; }
 		
         vector<string> tempDistFiles;
 		for (int i = 0; i < numGroups; i++) {
             string fileName = distFile + "." + toString(i) + ".temp";
             tempDistFiles.push_back(fileName);
-			if (outputs[i] != "") {
+			
+			if (m->control_pressed) { for (int j = 0; j < i; j++) { m->mothurRemove(tempDistFiles[j]); } return 0; }
+			
+			if (groupStart[i] != groupStart[i+1]) {
 				ofstream outFile;
-				outFile.open(fileName.c_str(), ios::ate);
-				outFile << outputs[i];
+				m->openOutputFile(fileName, outFile);
+				for (int j = groupStart[i]; j < groupStart[i+1]; j++) {
+					seqDist& thisDist = dists[order[j]];
+					outFile << names[thisDist.seq1] << '\t' << names[thisDist.seq2] << '\t' << (float)thisDist.dist << '\n';
+				}
 				outFile.close();
-			}
+			}else { m->mothurRemove(fileName); }
 		}
-        
-        map<string, int> seqGroup;
-        for (int i = 0; i < groups.size(); i++) {
-            for (set<string>::iterator itNames = groups[i].begin(); itNames != groups[i].end();) {
-                seqGroup[*itNames] = i;
-                groups[i].erase(itNames++);
-            }
-        }
-        
-		splitNames(seqGroup, numGroups, tempDistFiles);
+		
+		splitNames(seqGroups, numGroups, tempDistFiles);
 				
 		return 0;			
 	}
@@ -40,6 +40,8 @@ class SplitMatrix  {
 		int splitClassify();
 		int splitDistanceLarge();
 		int splitDistanceRAM();
+		int findDistanceGroups(map<string, int>&, vector<int>&, vector<seqDist>*); //nameIndex, seqGroup, distances below the cutoff or NULL. returns number of groups
+		int findRoot(vector<int>&, int);
 		int splitNames(map<string, int>& groups, int, vector<string>&);
         int splitNamesVsearch(map<string, int>& groups, int, vector<string>&);
 		int splitDistanceFileByTax(map<string, int>&, int);
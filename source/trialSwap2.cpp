@@ -12,10 +12,8 @@ double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, vector<int> ro
         double D;
         double normcscore = 0.0;
         int nonzeros = 0;
-        //int ncols = co_matrix[0].size(); int nrows = rowtotal.size();
-        vector<vector<double> > s; s.resize(nrows);
-        for (int i = 0; i < nrows; i++) { s[i].resize(nrows,0.0); }//only fill half the matrix
         
+        vector<vector<unsigned long long> > rows = packRows(co_matrix, ncols, nrows);
         
         for(int i=0;i<nrows-1;i++)
         {
@@ -23,24 +21,11 @@ double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, vector<int> ro
             for(int j=i+1;j<nrows;j++)
             {
                 if (m->control_pressed) { return 0; }
-                for(int k=0;k<ncols;k++)
-                {
-                    if((co_matrix[i][k]==1)&&(co_matrix[j][k]==1)) //if both are 1s ie co-occurrence
-                        s[i][j]++; //s counts co-occurrences
-                }
+                int s = countCooccurrence(rows[i], rows[j]); //s counts co-occurrences
                 
-                //rowtotal[i] = A, rowtotal[j] = B, ncols = P, s[i][j] = J
-                cscore += (rowtotal[i]-s[i][j])*(rowtotal[j]-s[i][j]);///(nrows*(nrows-1)/2);
-                D = (rowtotal[i]-s[i][j])*(rowtotal[j]-s[i][j]);
-                
-                if(ncols < (rowtotal[i] + rowtotal[j]))
-                {
-                    maxD = (ncols-rowtotal[i])*(ncols-rowtotal[j]);
-                }
-                else
-                {
-                    maxD = rowtotal[i] * rowtotal[j];
-                }
+                //rowtotal[i] = A, rowtotal[j] = B, ncols = P, s = J
+                D = (rowtotal[i]-s)*(rowtotal[j]-s);
+                maxD = getMaxD(rowtotal[i], rowtotal[j], ncols);
                 
                 if(maxD != 0)
                 {
@@ -51,7 +36,6 @@ double TrialSwap2::calc_c_score (vector<vector<int> > &co_matrix, vector<int> ro
         }
         
         //cscore = cscore/(double)(nrows*(nrows-1)/2);  //not normalized
-        //cout << "normalized c score: " << normcscore/nonzeros << endl;
         cscore = normcscore/(double)nonzeros;
 
         return cscore;
@@ -66,33 +50,19 @@ int TrialSwap2::calc_checker (vector<vector<int> > &co_matrix, vector<int> rowto
 {
     try {
         int cunits=0;
-        //int s[nrows][ncols];
-        //int ncols = co_matrix[0].size(); int nrows = rowtotal.size();
-        vector<vector<int> > s; s.resize(nrows);
-        for (int i = 0; i < nrows; i++) { s[i].resize(nrows,0); }//only fill half the matrix
+        
+        vector<vector<unsigned long long> > rows = packRows(co_matrix, ncols, nrows);
         
         for(int i=0;i<nrows-1;i++)
         {
             for(int j=i+1;j<nrows;j++)
             {
                 if (m->control_pressed) { return 0; }
-                //s[i][j]=0;
-                for(int k=0;k<ncols;k++)
-                {
-                    //cout << s[i][j] << endl;
-                    //iterates through the row and counts co-occurrences. The total number of co-occurrences for each row pair is kept in matrix s at location s[i][j].
-                    if((co_matrix[i][k]==1)&&(co_matrix[j][k]==1)) //if both are 1s ie co-occurrence
-                        s[i][j]++; //s counts co-occurrences
-                    
-                }
-                //cout << "rowtotal: " << rowtotal[i] << endl;
-                //cout << "co-occurrences: " << s[i][j] << endl;
-                //cunits+=(rowtotal[i]-s[i][j])*(rowtotal[j]-s[i][j]);
-                if (s[i][j] == 0)
+                //rows that never co-occur are a checkerboard unit
+                if (countCooccurrence(rows[i], rows[j]) == 0)
                 {
                     cunits+=1;
                 }
-                //cunits+=s[i][j];
             }
         }
         
@@ -104,6 +74,166 @@ int TrialSwap2::calc_checker (vector<vector<int> > &co_matrix, vector<int> rowto
     }
 }
 /**************************************************************************************************/
+vector<vector<unsigned long long> > TrialSwap2::packRows (vector<vector<int> > &co_matrix, int ncols, int nrows)
+{
+    try {
+        int numWords = (ncols + 63) / 64;
+        vector<vector<unsigned long long> > rows(nrows, vector<unsigned long long>(numWords, 0));
+        
+        for (int i = 0; i < nrows; i++) {
+            for (int k = 0; k < ncols; k++) {
+                if (co_matrix[i][k] == 1) { rows[i][k / 64] |= (1ULL << (k % 64)); }
+            }
+        }
+        
+        return rows;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "packRows");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int TrialSwap2::countCooccurrence (vector<unsigned long long> &rowA, vector<unsigned long long> &rowB)
+{
+    try {
+        int count = 0;
+        for (int w = 0; w < rowA.size(); w++) {
+            unsigned long long x = rowA[w] & rowB[w];
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            count += (int)((x * 0x0101010101010101ULL) >> 56);
+        }
+        return count;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "countCooccurrence");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+double TrialSwap2::getMaxD (int rowtotalA, int rowtotalB, int ncols)
+{
+    try {
+        if(ncols < (rowtotalA + rowtotalB)) { return (ncols-rowtotalA)*(ncols-rowtotalB); }
+        
+        return rowtotalA * rowtotalB;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "getMaxD");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int TrialSwap2::startChain (vector<vector<int> > &co_matrix, vector<int> rowtotal, int ncols, int nrows)
+{
+    try {
+        chainRowTotals = rowtotal;
+        chainCols = ncols;
+        chainChecker = 0; chainNonZeros = 0; chainNormCScore = 0.0;
+        chainPairs.assign(((long long)nrows * (nrows-1)) / 2, 0);
+        
+        vector<vector<unsigned long long> > rows = packRows(co_matrix, ncols, nrows);
+        
+        for(int i=0;i<nrows-1;i++)
+        {
+            for(int j=i+1;j<nrows;j++)
+            {
+                if (m->control_pressed) { return 0; }
+                int s = countCooccurrence(rows[i], rows[j]);
+                chainPairs[((long long)j * (j-1)) / 2 + i] = s;
+                if (s == 0) { chainChecker++; }
+                
+                double D = (rowtotal[i]-s)*(rowtotal[j]-s);
+                double maxD = getMaxD(rowtotal[i], rowtotal[j], ncols);
+                if(maxD != 0) { chainNormCScore += D/maxD; chainNonZeros++; }
+            }
+        }
+        
+        chainStarted = true;
+        
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "startChain");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+double TrialSwap2::getChainCScore ()
+{
+    try {
+        return (double)(chainNormCScore/(long double)chainNonZeros);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "getChainCScore");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+int TrialSwap2::getChainChecker ()
+{
+    try {
+        return chainChecker;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "getChainChecker");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//rows i and j just swapped columns k and l. The row that moved into l gains a co-occurrence with every row that has l
+//but not k and loses one with every row that has k but not l, the other row the reverse. Their own count is unchanged.
+void TrialSwap2::updateChain (vector<vector<int> > &co_matrix, int i, int j, int k, int l)
+{
+    try {
+        int movedToL = i; int movedToK = j;
+        if (co_matrix[i][l] != 1) { movedToL = j; movedToK = i; }
+        
+        for (int x = 0; x < co_matrix.size(); x++) {
+            if ((x == i) || (x == j)) { continue; }
+            
+            int delta = co_matrix[x][l] - co_matrix[x][k];
+            if (delta == 0) { continue; }
+            
+            updateChainPair(movedToL, x, delta);
+            updateChainPair(movedToK, x, -delta);
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "updateChain");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void TrialSwap2::updateChainPair (int a, int b, int delta)
+{
+    try {
+        int low = min(a, b); int high = max(a, b);
+        long long index = ((long long)high * (high-1)) / 2 + low;
+        
+        int oldS = chainPairs[index];
+        int newS = oldS + delta;
+        chainPairs[index] = newS;
+        
+        //the row totals are fixed, so only D changes
+        double maxD = getMaxD(chainRowTotals[low], chainRowTotals[high], chainCols);
+        if (maxD != 0) {
+            long double oldD = (chainRowTotals[low]-oldS)*(chainRowTotals[high]-oldS);
+            long double newD = (chainRowTotals[low]-newS)*(chainRowTotals[high]-newS);
+            chainNormCScore += (newD - oldD) / maxD;
+        }
+        
+        if (oldS == 0) { chainChecker--; }
+        if (newS == 0) { chainChecker++; }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrialSwap2", "updateChainPair");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
 double TrialSwap2::calc_vratio (int nrows, int ncols, vector<int> rowtotal, vector<int> columntotal)
 {
     try {
@@ -210,7 +340,8 @@ int TrialSwap2::swap_checkerboards (vector<vector<int> > &co_matrix, int ncols,
                 co_matrix[i][l]=1-co_matrix[i][l];
                 co_matrix[j][k]=1-co_matrix[j][k];
                 co_matrix[j][l]=1-co_matrix[j][l];
-
+                
+                if (chainStarted) { updateChain(co_matrix, i, j, k, l); }
             }
         }
         
@@ -16,7 +16,7 @@
 class TrialSwap2 {
     
 public:
-    TrialSwap2(){ m = MothurOut::getInstance(); };
+    TrialSwap2(){ m = MothurOut::getInstance(); chainStarted = false; };
     ~TrialSwap2(){};
     
     double calc_pvalue_lessthan (vector<double>, double);
@@ -29,6 +29,13 @@ public:
     double get_zscore (double, double, double);
     double getSD (int, vector<double>, double);
     
+    //swap chain for sim9. The co-occurrence count of every pair of rows is kept, and a swap only changes the
+    //counts between its two rows and the rest, so the counts and checker total are updated instead of recounted.
+    //The c score is kept as a running sum that each changed pair adjusts by its change in D/maxD. The row totals
+    //never change, so maxD and the number of scored pairs are fixed from the start of the chain.
+    int startChain (vector<vector<int> > &, vector<int>, int, int);
+    double getChainCScore ();
+    int getChainChecker ();
     
 private:
     MothurOut* m;
@@ -36,6 +43,18 @@ private:
     double t_test (double, int, double, vector<double>);
     int print_matrix(vector<vector<int> > &, int, int);
     
+    //presence/absence rows packed 64 columns to a word, so co-occurrence is an and and a bit count
+    vector<vector<unsigned long long> > packRows (vector<vector<int> > &, int, int);
+    int countCooccurrence (vector<unsigned long long> &, vector<unsigned long long> &);
+    double getMaxD (int, int, int);
+    
+    bool chainStarted;
+    int chainCols, chainChecker, chainNonZeros;
+    long double chainNormCScore; //extended precision so the running sum stays within rounding of a full recount
+    vector<int> chainRowTotals, chainPairs; //chainPairs[j*(j-1)/2+i] = co-occurrences of rows i < j
+    void updateChain (vector<vector<int> > &, int, int, int, int);
+    void updateChainPair (int, int, int);
+
     
         
 };